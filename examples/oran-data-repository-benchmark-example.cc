@@ -0,0 +1,401 @@
+/**
+ * NIST-developed software is provided by NIST as a public service. You may
+ * use, copy and distribute copies of the software in any medium, provided that
+ * you keep intact this entire notice. You may improve, modify and create
+ * derivative works of the software or any portion of the software, and you may
+ * copy and distribute such modifications or works. Modified works should carry
+ * a notice stating that you changed the software and should note the date and
+ * nature of any such change. Please explicitly acknowledge the National
+ * Institute of Standards and Technology as the source of the software.
+ *
+ * NIST-developed software is expressly provided "AS IS." NIST MAKES NO
+ * WARRANTY OF ANY KIND, EXPRESS, IMPLIED, IN FACT OR ARISING BY OPERATION OF
+ * LAW, INCLUDING, WITHOUT LIMITATION, THE IMPLIED WARRANTY OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE, NON-INFRINGEMENT AND DATA ACCURACY. NIST
+ * NEITHER REPRESENTS NOR WARRANTS THAT THE OPERATION OF THE SOFTWARE WILL BE
+ * UNINTERRUPTED OR ERROR-FREE, OR THAT ANY DEFECTS WILL BE CORRECTED. NIST
+ * DOES NOT WARRANT OR MAKE ANY REPRESENTATIONS REGARDING THE USE OF THE
+ * SOFTWARE OR THE RESULTS THEREOF, INCLUDING BUT NOT LIMITED TO THE
+ * CORRECTNESS, ACCURACY, RELIABILITY, OR USEFULNESS OF THE SOFTWARE.
+ *
+ * You are solely responsible for determining the appropriateness of using and
+ * distributing the software and you assume all risks associated with its use,
+ * including but not limited to the risks and costs of program errors,
+ * compliance with applicable laws, damage to or loss of data, programs or
+ * equipment, and the unavailability or interruption of operation. This
+ * software is not intended to be used in any situation where a failure could
+ * cause risk of injury or damage to property. The software developed by NIST
+ * employees is not subject to copyright protection within the United States.
+ */
+
+#include "ns3/core-module.h"
+#include "ns3/oran-module.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#ifndef _WIN32
+#include <sys/resource.h>
+#endif // _WIN32
+
+using namespace ns3;
+
+NS_LOG_COMPONENT_DEFINE("OranDataRepositoryBenchmarkExample");
+
+/**
+ * Get a percentile of a collection of latencies.
+ *
+ * @param latencies The latencies, which are sorted by this function.
+ * @param percentile The percentile, between 0 and 100.
+ *
+ * @return The latency at the percentile, or 0 if there are no latencies.
+ */
+static double
+GetPercentile(std::vector<double>& latencies, double percentile)
+{
+    if (latencies.empty())
+    {
+        return 0;
+    }
+
+    std::sort(latencies.begin(), latencies.end());
+    std::size_t rank = static_cast<std::size_t>(std::ceil(percentile / 100 * latencies.size()));
+    return latencies[std::max<std::size_t>(rank, 1) - 1];
+}
+
+/**
+ * Get the files written by a Data Repository. The files are found through the
+ * "DatabaseFile", "LogFile", and "DumpFile" attributes of the repository,
+ * including the write-ahead log and shared memory of a database and the
+ * segments of a log.
+ *
+ * @param repository The Data Repository.
+ *
+ * @return The paths of the files that exist.
+ */
+static std::vector<std::string>
+GetStorageFiles(Ptr<OranDataRepository> repository)
+{
+    std::vector<std::string> files;
+    auto addFile = [&files](const std::string& path) {
+        std::error_code ec;
+        bool exists = std::filesystem::exists(path, ec);
+        if (exists)
+        {
+            files.push_back(path);
+        }
+        return exists;
+    };
+
+    TypeId tid = repository->GetInstanceTypeId();
+    TypeId::AttributeInformation info;
+    StringValue path;
+
+    for (const std::string attribute : {"DatabaseFile", "DumpFile"})
+    {
+        if (tid.LookupAttributeByName(attribute, &info))
+        {
+            repository->GetAttribute(attribute, path);
+            addFile(path.Get());
+            addFile(path.Get() + "-wal");
+            addFile(path.Get() + "-shm");
+        }
+    }
+    if (tid.LookupAttributeByName("LogFile", &info))
+    {
+        repository->GetAttribute("LogFile", path);
+        for (uint32_t segment = 0; addFile(path.Get() + "." + std::to_string(segment)); segment++)
+        {
+        }
+    }
+
+    return files;
+}
+
+/**
+ * Get the size of the files written by a Data Repository.
+ *
+ * @param repository The Data Repository.
+ *
+ * @return The size of the files, in bytes.
+ */
+static uint64_t
+GetStorageSize(Ptr<OranDataRepository> repository)
+{
+    uint64_t size = 0;
+    for (const auto& file : GetStorageFiles(repository))
+    {
+        std::error_code ec;
+        uint64_t fileSize = std::filesystem::file_size(file, ec);
+        if (!ec)
+        {
+            size += fileSize;
+        }
+    }
+
+    return size;
+}
+
+/**
+ * Get the peak resident set size of the process.
+ *
+ * @return The peak resident set size, in kB, or 0 if it is not available.
+ */
+static uint64_t
+GetPeakRss()
+{
+#ifndef _WIN32
+    struct rusage usage;
+    if (getrusage(RUSAGE_SELF, &usage) == 0)
+    {
+        return usage.ru_maxrss;
+    }
+#endif // _WIN32
+    return 0;
+}
+
+/**
+ * Benchmark of the Data Repository backends. A synthetic workload is stored
+ * in the repository selected by its TypeId: a number of LTE UEs send, in
+ * every reporting period, the number of location, cell information,
+ * application loss, and RSRP/RSRQ reports given by the report mix, and every
+ * few periods the repository is read as a Logic Module would. The attributes
+ * of the repository can be set from the command line (e.g.,
+ * "--ns3::OranDataRepositorySqlite::AsyncWrites=true"), and the repository
+ * can be wrapped in an OranDataRepositoryCache.
+ *
+ * The insert rate, the median and 99th percentile of the latency of the
+ * reads, the size of the files written by the repository, and the peak
+ * resident set size of the process are written as a line of CSV. Since the
+ * resident set size is measured for the whole process, each backend should
+ * be benchmarked in a separate run.
+ */
+int
+main(int argc, char* argv[])
+{
+    std::string repositoryType = "ns3::OranDataRepositorySqlite";
+    bool useCache = false;
+    uint32_t numUes = 100;
+    uint32_t numEnbs = 4;
+    uint32_t numPeriods = 100;
+    std::string reportMix = "1:1:1:1";
+    uint32_t rsrpCells = 3;
+    std::string readPattern = "snapshot";
+    uint32_t readInterval = 10;
+    std::string csvFileName = "";
+    bool csvHeader = true;
+
+    CommandLine cmd(__FILE__);
+    cmd.AddValue("repository", "The TypeId of the Data Repository", repositoryType);
+    cmd.AddValue("cache", "Wrap the Data Repository in an OranDataRepositoryCache", useCache);
+    cmd.AddValue("num-ues", "Number of LTE UEs", numUes);
+    cmd.AddValue("num-enbs", "Number of LTE eNBs", numEnbs);
+    cmd.AddValue("num-periods", "Number of reporting periods of 100 ms", numPeriods);
+    cmd.AddValue("report-mix",
+                 "Number of location, cell information, application loss, and RSRP/RSRQ "
+                 "reports sent by each UE per period, separated by colons",
+                 reportMix);
+    cmd.AddValue("rsrp-cells", "Number of cells measured in each RSRP/RSRQ report", rsrpCells);
+    cmd.AddValue("read-pattern",
+                 "The reads of the Logic Module: \"snapshot\" (snapshots of the UEs and eNBs), "
+                 "\"per-node\" (latest information of each UE), or \"history\" (the last 10 "
+                 "positions of each UE)",
+                 readPattern);
+    cmd.AddValue("read-interval", "Number of periods between reads", readInterval);
+    cmd.AddValue("csv-file", "File to append the results to, instead of the output", csvFileName);
+    cmd.AddValue("csv-header", "Write the header of the CSV", csvHeader);
+    cmd.Parse(argc, argv);
+
+    // Parse the report mix
+    uint32_t numLocations = 0;
+    uint32_t numCellInfos = 0;
+    uint32_t numAppLosses = 0;
+    uint32_t numRsrpRsrqs = 0;
+    char sep1;
+    char sep2;
+    char sep3;
+    std::istringstream mixStream(reportMix);
+    mixStream >> numLocations >> sep1 >> numCellInfos >> sep2 >> numAppLosses >> sep3 >>
+        numRsrpRsrqs;
+    NS_ABORT_MSG_IF(mixStream.fail() || sep1 != ':' || sep2 != ':' || sep3 != ':',
+                    "Invalid report mix \"" << reportMix << "\"");
+    NS_ABORT_MSG_IF(readPattern != "snapshot" && readPattern != "per-node" &&
+                        readPattern != "history",
+                    "Invalid read pattern \"" << readPattern << "\"");
+    NS_ABORT_MSG_IF(numEnbs == 0, "At least one eNB is needed");
+    NS_ABORT_MSG_IF(readInterval == 0, "The read interval must be positive");
+
+    ObjectFactory repositoryFactory;
+    repositoryFactory.SetTypeId(repositoryType);
+    Ptr<OranDataRepository> backend = repositoryFactory.Create<OranDataRepository>();
+    // Start from empty files, so that the results of earlier runs are not measured
+    for (const auto& file : GetStorageFiles(backend))
+    {
+        std::filesystem::remove(file);
+    }
+    Ptr<OranDataRepository> repository = backend;
+    if (useCache)
+    {
+        repository = CreateObject<OranDataRepositoryCache>();
+        repository->SetAttribute("Backend", PointerValue(backend));
+    }
+    repository->Activate();
+
+    std::vector<uint64_t> enbIds;
+    for (uint32_t i = 0; i < numEnbs; i++)
+    {
+        enbIds.push_back(repository->RegisterNodeLteEnb(i + 1, i + 1));
+        repository->SavePosition(enbIds.back(), Vector(1000.0 * i, 0, 30), Seconds(0));
+    }
+    std::vector<uint64_t> ueIds;
+    for (uint32_t i = 0; i < numUes; i++)
+    {
+        ueIds.push_back(repository->RegisterNodeLteUe(numEnbs + i + 1, i + 1));
+    }
+
+    uint64_t numInserts = 0;
+    std::chrono::steady_clock::duration insertTime{0};
+    std::vector<double> latencies;
+
+    // Measure each read of the Logic Module separately
+    auto timeRead = [&latencies](auto&& read) {
+        auto start = std::chrono::steady_clock::now();
+        read();
+        latencies.push_back(std::chrono::duration<double, std::micro>(
+                                std::chrono::steady_clock::now() - start)
+                                .count());
+    };
+
+    // Send the reports of each period at its end, so that the time of the
+    // simulation advances and the time-based policies of the repository apply
+    auto runPeriod = [&](uint32_t period) {
+        auto start = std::chrono::steady_clock::now();
+        for (uint32_t i = 0; i < numUes; i++)
+        {
+            uint64_t e2NodeId = ueIds[i];
+            uint16_t rnti = i + 1;
+            uint16_t servingCellId = 1 + (i + period / 10) % numEnbs;
+
+            // Spread the reports of each type over the period
+            for (uint32_t r = 0; r < numLocations; r++)
+            {
+                Time t = MilliSeconds(100 * period + 100 * r / numLocations);
+                repository->SavePosition(e2NodeId, Vector(t.GetSeconds(), i, 1.5), t);
+            }
+            for (uint32_t r = 0; r < numCellInfos; r++)
+            {
+                Time t = MilliSeconds(100 * period + 100 * r / numCellInfos);
+                repository->SaveLteUeCellInfo(e2NodeId, servingCellId, rnti, t);
+            }
+            for (uint32_t r = 0; r < numAppLosses; r++)
+            {
+                Time t = MilliSeconds(100 * period + 100 * r / numAppLosses);
+                repository->SaveAppLoss(e2NodeId, 0.01 * (r + 1), t);
+            }
+            for (uint32_t r = 0; r < numRsrpRsrqs; r++)
+            {
+                Time t = MilliSeconds(100 * period + 100 * r / numRsrpRsrqs);
+                for (uint32_t c = 0; c < rsrpCells; c++)
+                {
+                    uint16_t cellId = 1 + (servingCellId - 1 + c) % numEnbs;
+                    repository->SaveLteUeRsrpRsrq(e2NodeId,
+                                                  t,
+                                                  rnti,
+                                                  cellId,
+                                                  -80.0 - c,
+                                                  -10.0,
+                                                  c == 0,
+                                                  0);
+                }
+            }
+        }
+        insertTime += std::chrono::steady_clock::now() - start;
+        numInserts +=
+            static_cast<uint64_t>(numUes) *
+            (numLocations + numCellInfos + numAppLosses + numRsrpRsrqs * rsrpCells);
+
+        if ((period + 1) % readInterval != 0)
+        {
+            return;
+        }
+
+        Time now = Simulator::Now();
+        if (readPattern == "snapshot")
+        {
+            timeRead([&repository]() { repository->GetLteUeSnapshot(); });
+            timeRead([&repository]() { repository->GetLteEnbSnapshot(); });
+        }
+        else if (readPattern == "per-node")
+        {
+            for (auto e2NodeId : ueIds)
+            {
+                timeRead([&repository, e2NodeId]() { repository->GetLteUeCellInfo(e2NodeId); });
+                timeRead(
+                    [&repository, e2NodeId]() { repository->GetLatestNodePosition(e2NodeId); });
+                timeRead([&repository, e2NodeId]() { repository->GetAppLoss(e2NodeId); });
+                timeRead([&repository, e2NodeId]() { repository->GetLteUeRsrpRsrq(e2NodeId); });
+            }
+        }
+        else
+        {
+            for (auto e2NodeId : ueIds)
+            {
+                timeRead([&repository, e2NodeId, now]() {
+                    repository->GetNodePositions(e2NodeId, Seconds(0), now, 10);
+                });
+            }
+        }
+    };
+    for (uint32_t period = 0; period < numPeriods; period++)
+    {
+        Simulator::Schedule(MilliSeconds(100 * (period + 1)), runPeriod, period);
+    }
+    // The repository reschedules its own prune and checkpoint events
+    Simulator::Stop(MilliSeconds(100 * numPeriods));
+    Simulator::Run();
+
+    // Include the writes that are still pending
+    auto start = std::chrono::steady_clock::now();
+    repository->Deactivate();
+    auto closeTime = std::chrono::steady_clock::now() - start;
+
+    double insertSeconds = std::chrono::duration<double>(insertTime).count();
+    uint64_t numReads = latencies.size();
+    double p50 = GetPercentile(latencies, 50);
+    double p99 = GetPercentile(latencies, 99);
+    uint64_t storageSize = GetStorageSize(backend);
+
+    repository->Dispose();
+    Simulator::Destroy();
+
+    std::ofstream csvFile;
+    if (!csvFileName.empty())
+    {
+        csvFile.open(csvFileName, std::ios::app);
+        NS_ABORT_MSG_IF(!csvFile.is_open(), "Cannot open CSV file \"" << csvFileName << "\"");
+    }
+    std::ostream& csv = csvFileName.empty() ? std::cout : csvFile;
+
+    if (csvHeader)
+    {
+        csv << "repository,cache,ues,enbs,periods,report_mix,rsrp_cells,read_pattern,inserts,"
+               "insert_s,inserts_per_s,close_s,reads,read_p50_us,read_p99_us,storage_bytes,"
+               "peak_rss_kb"
+            << std::endl;
+    }
+    csv << repositoryType << "," << useCache << "," << numUes << "," << numEnbs << ","
+        << numPeriods << "," << reportMix << "," << rsrpCells << "," << readPattern << ","
+        << numInserts << "," << insertSeconds << ","
+        << (insertSeconds > 0 ? numInserts / insertSeconds : 0) << ","
+        << std::chrono::duration<double>(closeTime).count() << "," << numReads << "," << p50
+        << "," << p99 << "," << storageSize << "," << GetPeakRss() << std::endl;
+
+    return 0;
+}
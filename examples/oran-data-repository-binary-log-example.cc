@@ -0,0 +1,116 @@
+/**
+ * NIST-developed software is provided by NIST as a public service. You may
+ * use, copy and distribute copies of the software in any medium, provided that
+ * you keep intact this entire notice. You may improve, modify and create
+ * derivative works of the software or any portion of the software, and you may
+ * copy and distribute such modifications or works. Modified works should carry
+ * a notice stating that you changed the software and should note the date and
+ * nature of any such change. Please explicitly acknowledge the National
+ * Institute of Standards and Technology as the source of the software.
+ *
+ * NIST-developed software is expressly provided "AS IS." NIST MAKES NO
+ * WARRANTY OF ANY KIND, EXPRESS, IMPLIED, IN FACT OR ARISING BY OPERATION OF
+ * LAW, INCLUDING, WITHOUT LIMITATION, THE IMPLIED WARRANTY OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE, NON-INFRINGEMENT AND DATA ACCURACY. NIST
+ * NEITHER REPRESENTS NOR WARRANTS THAT THE OPERATION OF THE SOFTWARE WILL BE
+ * UNINTERRUPTED OR ERROR-FREE, OR THAT ANY DEFECTS WILL BE CORRECTED. NIST
+ * DOES NOT WARRANT OR MAKE ANY REPRESENTATIONS REGARDING THE USE OF THE
+ * SOFTWARE OR THE RESULTS THEREOF, INCLUDING BUT NOT LIMITED TO THE
+ * CORRECTNESS, ACCURACY, RELIABILITY, OR USEFULNESS OF THE SOFTWARE.
+ *
+ * You are solely responsible for determining the appropriateness of using and
+ * distributing the software and you assume all risks associated with its use,
+ * including but not limited to the risks and costs of program errors,
+ * compliance with applicable laws, damage to or loss of data, programs or
+ * equipment, and the unavailability or interruption of operation. This
+ * software is not intended to be used in any situation where a failure could
+ * cause risk of injury or damage to property. The software developed by NIST
+ * employees is not subject to copyright protection within the United States.
+ */
+#include "ns3/core-module.h"
+#include "ns3/oran-module.h"
+
+#include <chrono>
+#include <cstdio>
+#include <iostream>
+#include <string>
+#include <vector>
+
+using namespace ns3;
+
+NS_LOG_COMPONENT_DEFINE("OranDataRepositoryBinaryLogExample");
+
+/**
+ * Example of the binary log Data Repository and its converter. A number of
+ * location and application loss reports are stored through an
+ * OranDataRepositoryBinaryLog, and the average time per report is shown.
+ * The log is then loaded into an SQLite database with the schema of
+ * OranDataRepositorySqlite. With "convert-only", the reports are not
+ * generated, and an existing log (e.g., from a previous run of a sweep) is
+ * converted.
+ */
+int
+main(int argc, char* argv[])
+{
+    uint32_t numNodes = 100;
+    uint32_t numReports = 1000;
+    uint32_t segmentSize = 64 * 1024 * 1024;
+    std::string logFileName = "oran-repository.bin";
+    std::string dbFileName = "oran-repository.db";
+    bool convertOnly = false;
+
+    CommandLine cmd(__FILE__);
+    cmd.AddValue("num-nodes", "Number of E2 Nodes", numNodes);
+    cmd.AddValue("num-reports", "Number of reports of each type per E2 Node", numReports);
+    cmd.AddValue("segment-size", "Size of each segment of the log, in bytes", segmentSize);
+    cmd.AddValue("log-file", "Path of the log, without the segment number", logFileName);
+    cmd.AddValue("db-file", "Path of the database to convert the log to", dbFileName);
+    cmd.AddValue("convert-only", "Only convert an existing log", convertOnly);
+    cmd.Parse(argc, argv);
+
+    if (!convertOnly)
+    {
+        Ptr<OranDataRepository> repository = CreateObject<OranDataRepositoryBinaryLog>();
+        repository->SetAttribute("LogFile", StringValue(logFileName));
+        repository->SetAttribute("SegmentSize", UintegerValue(segmentSize));
+        repository->Activate();
+
+        std::vector<uint64_t> e2NodeIds;
+        for (uint32_t i = 0; i < numNodes; i++)
+        {
+            e2NodeIds.push_back(repository->RegisterNodeLteUe(0, i + 1));
+        }
+
+        auto start = std::chrono::steady_clock::now();
+        for (uint32_t r = 0; r < numReports; r++)
+        {
+            Time t = MilliSeconds(100 * r);
+            for (auto e2NodeId : e2NodeIds)
+            {
+                repository->SavePosition(e2NodeId, Vector(r, e2NodeId, 1.5), t);
+                repository->SaveAppLoss(e2NodeId, 0.01, t);
+            }
+        }
+        auto elapsed = std::chrono::steady_clock::now() - start;
+
+        repository->Deactivate();
+        repository->Dispose();
+
+        uint64_t numStored = 2 * static_cast<uint64_t>(numNodes) * numReports;
+        std::cout << "Stored " << numStored << " reports in "
+                  << std::chrono::duration<double>(elapsed).count() << " s ("
+                  << std::chrono::duration<double, std::nano>(elapsed).count() / numStored
+                  << " ns per report)" << std::endl;
+    }
+
+    std::remove(dbFileName.c_str());
+
+    auto start = std::chrono::steady_clock::now();
+    uint64_t numRecords = OranDataRepositoryBinaryLog::Convert(logFileName, dbFileName);
+    auto elapsed = std::chrono::steady_clock::now() - start;
+
+    std::cout << "Converted " << numRecords << " records into " << dbFileName << " in "
+              << std::chrono::duration<double>(elapsed).count() << " s" << std::endl;
+
+    return 0;
+}
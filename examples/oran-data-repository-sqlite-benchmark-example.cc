@@ -0,0 +1,165 @@
+/**
+ * NIST-developed software is provided by NIST as a public service. You may
+ * use, copy and distribute copies of the software in any medium, provided that
+ * you keep intact this entire notice. You may improve, modify and create
+ * derivative works of the software or any portion of the software, and you may
+ * copy and distribute such modifications or works. Modified works should carry
+ * a notice stating that you changed the software and should note the date and
+ * nature of any such change. Please explicitly acknowledge the National
+ * Institute of Standards and Technology as the source of the software.
+ *
+ * NIST-developed software is expressly provided "AS IS." NIST MAKES NO
+ * WARRANTY OF ANY KIND, EXPRESS, IMPLIED, IN FACT OR ARISING BY OPERATION OF
+ * LAW, INCLUDING, WITHOUT LIMITATION, THE IMPLIED WARRANTY OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE, NON-INFRINGEMENT AND DATA ACCURACY. NIST
+ * NEITHER REPRESENTS NOR WARRANTS THAT THE OPERATION OF THE SOFTWARE WILL BE
+ * UNINTERRUPTED OR ERROR-FREE, OR THAT ANY DEFECTS WILL BE CORRECTED. NIST
+ * DOES NOT WARRANT OR MAKE ANY REPRESENTATIONS REGARDING THE USE OF THE
+ * SOFTWARE OR THE RESULTS THEREOF, INCLUDING BUT NOT LIMITED TO THE
+ * CORRECTNESS, ACCURACY, RELIABILITY, OR USEFULNESS OF THE SOFTWARE.
+ *
+ * You are solely responsible for determining the appropriateness of using and
+ * distributing the software and you assume all risks associated with its use,
+ * including but not limited to the risks and costs of program errors,
+ * compliance with applicable laws, damage to or loss of data, programs or
+ * equipment, and the unavailability or interruption of operation. This
+ * software is not intended to be used in any situation where a failure could
+ * cause risk of injury or damage to property. The software developed by NIST
+ * employees is not subject to copyright protection within the United States.
+ */
+
+#include "ns3/core-module.h"
+#include "ns3/oran-module.h"
+
+#include <chrono>
+#include <cstdio>
+#include <iostream>
+#include <string>
+#include <vector>
+
+using namespace ns3;
+
+NS_LOG_COMPONENT_DEFINE("OranDataRepositorySqliteBenchmarkExample");
+
+/**
+ * The time taken by the inserts and by the lookups of a benchmark run.
+ */
+struct BenchmarkTimes
+{
+    std::chrono::steady_clock::duration insert; //!< The time taken by the inserts.
+    std::chrono::steady_clock::duration lookup; //!< The time taken by the lookups.
+};
+
+/**
+ * Remove a database file and its write-ahead log and shared memory files.
+ *
+ * @param dbFileName The database file.
+ */
+static void
+RemoveDbFiles(const std::string& dbFileName)
+{
+    std::remove(dbFileName.c_str());
+    std::remove((dbFileName + "-wal").c_str());
+    std::remove((dbFileName + "-shm").c_str());
+}
+
+/**
+ * Insert and look up the location reports of a number of E2 Nodes in an
+ * OranDataRepositorySqlite.
+ *
+ * @param dbFileName The database file.
+ * @param cacheStatements Flag that indicates if the statements are cached.
+ * @param numNodes The number of E2 Nodes.
+ * @param numReports The number of location reports per E2 Node.
+ *
+ * @return The time taken by the inserts and by the lookups.
+ */
+static BenchmarkTimes
+RunBenchmark(const std::string& dbFileName,
+             bool cacheStatements,
+             uint32_t numNodes,
+             uint32_t numReports)
+{
+    RemoveDbFiles(dbFileName);
+
+    Ptr<OranDataRepository> repository = CreateObject<OranDataRepositorySqlite>();
+    repository->SetAttribute("DatabaseFile", StringValue(dbFileName));
+    repository->SetAttribute("CacheStatements", BooleanValue(cacheStatements));
+    repository->Activate();
+
+    std::vector<uint64_t> e2NodeIds;
+    for (uint32_t n = 1; n <= numNodes; n++)
+    {
+        e2NodeIds.push_back(repository->RegisterNode(OranNearRtRic::NodeType::WIRED, n));
+    }
+
+    BenchmarkTimes times;
+
+    auto start = std::chrono::steady_clock::now();
+    for (uint32_t r = 0; r < numReports; r++)
+    {
+        for (auto e2NodeId : e2NodeIds)
+        {
+            repository->SavePosition(e2NodeId, Vector(1.0, 2.0, 1.5), Seconds(r));
+        }
+    }
+    times.insert = std::chrono::steady_clock::now() - start;
+
+    start = std::chrono::steady_clock::now();
+    for (uint32_t r = 0; r < numReports; r++)
+    {
+        for (auto e2NodeId : e2NodeIds)
+        {
+            repository->GetNodePositions(e2NodeId, Seconds(0), Seconds(numReports), 1);
+        }
+    }
+    times.lookup = std::chrono::steady_clock::now() - start;
+
+    repository->Deactivate();
+    repository->Dispose();
+    RemoveDbFiles(dbFileName);
+
+    return times;
+}
+
+/**
+ * Benchmark that shows the cost of compiling SQL statements on every call.
+ * The same location reports are inserted into, and looked up from, an
+ * OranDataRepositorySqlite that compiles its statements once, when the DB
+ * is opened, and one that compiles and finalizes them for every call, so
+ * both cases run the same SQL. The average time per insert and per lookup
+ * is reported for both cases.
+ */
+int
+main(int argc, char* argv[])
+{
+    uint32_t numNodes = 100;
+    uint32_t numReports = 100;
+    std::string dbFileName = "oran-repository-benchmark.db";
+
+    CommandLine cmd(__FILE__);
+    cmd.AddValue("num-nodes", "Number of E2 Nodes", numNodes);
+    cmd.AddValue("num-reports", "Number of location reports per E2 Node", numReports);
+    cmd.AddValue("db-file", "Base name of the database files", dbFileName);
+    cmd.Parse(argc, argv);
+
+    BenchmarkTimes cached = RunBenchmark(dbFileName, true, numNodes, numReports);
+    BenchmarkTimes uncached = RunBenchmark("uncached-" + dbFileName, false, numNodes, numReports);
+
+    double ops = static_cast<double>(numNodes) * numReports;
+    auto usPerOp = [ops](std::chrono::steady_clock::duration d) {
+        return std::chrono::duration<double, std::micro>(d).count() / ops;
+    };
+
+    std::cout << "Operations per case: " << ops << std::endl;
+    std::cout << "Insert (us/op): uncached = " << usPerOp(uncached.insert)
+              << "; cached = " << usPerOp(cached.insert)
+              << "; saving = " << usPerOp(uncached.insert) - usPerOp(cached.insert) << std::endl;
+    std::cout << "Lookup (us/op): uncached = " << usPerOp(uncached.lookup)
+              << "; cached = " << usPerOp(cached.lookup)
+              << "; saving = " << usPerOp(uncached.lookup) - usPerOp(cached.lookup) << std::endl;
+
+    Simulator::Destroy();
+
+    return 0;
+}
@@ -43,6 +43,7 @@
 #include "ns3/oran-reporter.h"
 #include "ns3/pointer.h"
 #include "ns3/string.h"
+#include "ns3/uinteger.h"
 
 namespace ns3
 {
@@ -81,6 +82,13 @@ OranHelper::GetTypeId()
                           MakeEnumAccessor<OranNearRtRic::LateCommandPolicy>(
                               &OranHelper::m_ricLmQueryLateCommandPolicy),
                           MakeEnumChecker(OranNearRtRic::DROP, "DROP", OranNearRtRic::SAVE, "SAVE"))
+            .AddAttribute("LmThreads",
+                          "The number of worker threads used to run the Logic Modules of a query "
+                          "cycle in parallel in the Near-RT RIC. A value of \"0\" runs them one "
+                          "after another.",
+                          UintegerValue(0),
+                          MakeUintegerAccessor(&OranHelper::m_ricLmThreads),
+                          MakeUintegerChecker<uint32_t>())
             .AddAttribute("E2NodeInactivityThreshold",
                           "The amount of time since an E2 node's last registration request before "
                           "deregistration.",
@@ -418,6 +426,7 @@ OranHelper::CreateNearRtRic()
                             PointerValue(m_e2NodeInactivityIntervalRv));
     nearRtRic->SetAttribute("LmQueryMaxWaitTime", TimeValue(m_ricLmQueryMaxWaitTime));
     nearRtRic->SetAttribute("LmQueryLateCommandPolicy", EnumValue(m_ricLmQueryLateCommandPolicy));
+    nearRtRic->SetAttribute("LmThreads", UintegerValue(m_ricLmThreads));
 
     for (auto lmFactory : m_lmFactories)
     {
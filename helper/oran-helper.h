@@ -486,6 +486,10 @@ class OranHelper : public Object
      * The policy to apply when a late command is received from a Logic Module.
      */
     OranNearRtRic::LateCommandPolicy m_ricLmQueryLateCommandPolicy;
+    /**
+     * The number of worker threads used to run the Logic Modules in parallel.
+     */
+    uint32_t m_ricLmThreads;
     /**
      * The random variable used (in seconds) to calculate the transmission delay for a command.
      */
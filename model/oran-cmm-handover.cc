@@ -45,6 +45,20 @@ NS_LOG_COMPONENT_DEFINE("OranCmmHandover");
 
 NS_OBJECT_ENSURE_REGISTERED(OranCmmHandover);
 
+namespace
+{
+
+/**
+ * The event that logs that a pending handover command is excluded.
+ */
+const OranDataRepository::LogEvent LOG_CMM_EXCLUDING_HANDOVER =
+    OranDataRepository::RegisterLogEvent(
+        "ns3::OranCmmHandover",
+        "Excluding a pending command: OranCommandLte2LteHandover(TargetE2NodeId = %d; "
+        "TargetCellId = %d; TargetRnti = %d)");
+
+} // namespace
+
 TypeId
 OranCmmHandover::GetTypeId()
 {
@@ -118,7 +132,10 @@ OranCmmHandover::Filter(
                 }
                 else
                 {
-                    LogLogicToStorage("Excluding a pending command: " + cmd->ToString());
+                    LogLogicToStorage(LOG_CMM_EXCLUDING_HANDOVER,
+                                      handoverCmd->GetTargetE2NodeId(),
+                                      handoverCmd->GetTargetCellId(),
+                                      handoverCmd->GetTargetRnti());
                 }
             }
             else
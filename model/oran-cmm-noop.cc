@@ -88,7 +88,7 @@ OranCmmNoop::Filter(
     NS_ABORT_MSG_IF(m_nearRtRic == nullptr,
                     "Attempting to run Conflict Mitigation Module with NULL Near-RT RIC");
 
-    LogLogicToStorage("No action taken");
+    LogLogicToStorage(OranDataRepository::LOG_NO_ACTION);
 
     std::vector<Ptr<OranCommand>> commands;
     for (auto commandSet : inputCommands)
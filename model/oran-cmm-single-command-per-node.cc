@@ -45,6 +45,51 @@ NS_LOG_COMPONENT_DEFINE("OranCmmSingleCommandPerNode");
 
 NS_OBJECT_ENSURE_REGISTERED(OranCmmSingleCommandPerNode);
 
+namespace
+{
+
+/**
+ * The event that logs that a handover command is evaluated.
+ */
+const OranDataRepository::LogEvent LOG_CMM_EVALUATING_HANDOVER =
+    OranDataRepository::RegisterLogEvent(
+        "ns3::OranCmmSingleCommandPerNode",
+        "Evaluating LTE-to-LTE Handover command affecting E2 Node %d");
+
+/**
+ * The event that logs that a command is evaluated.
+ */
+const OranDataRepository::LogEvent LOG_CMM_EVALUATING_COMMAND =
+    OranDataRepository::RegisterLogEvent("ns3::OranCmmSingleCommandPerNode",
+                                         "Evaluating commands affecting E2 Node %d");
+
+/**
+ * The event that logs that a command replaces the previous one.
+ */
+const OranDataRepository::LogEvent LOG_CMM_REPLACING_COMMAND =
+    OranDataRepository::RegisterLogEvent(
+        "ns3::OranCmmSingleCommandPerNode",
+        "There was a command for this node, but the new command was issued by the default "
+        "LM, so new replaces old.");
+
+/**
+ * The event that logs that a command with lower precedence is ignored.
+ */
+const OranDataRepository::LogEvent LOG_CMM_IGNORING_COMMAND =
+    OranDataRepository::RegisterLogEvent(
+        "ns3::OranCmmSingleCommandPerNode",
+        "There was a command for this node, and the new command has lower precedence (old "
+        "default? %d; new default? %d). Ignoring new command.");
+
+/**
+ * The event that logs that a command is saved.
+ */
+const OranDataRepository::LogEvent LOG_CMM_SAVING_COMMAND =
+    OranDataRepository::RegisterLogEvent("ns3::OranCmmSingleCommandPerNode",
+                                         "There was no command for this node; Saving new command.");
+
+} // namespace
+
 TypeId
 OranCmmSingleCommandPerNode::GetTypeId()
 {
@@ -96,7 +141,9 @@ OranCmmSingleCommandPerNode::Filter(
             bool defaultLm = std::get<1>(commandSet.first);
             uint64_t affectedNodeId;
 
-            LogLogicToStorage("Checking commands from LM " + std::get<0>(commandSet.first));
+            LogLogicToStorage([&commandSet]() {
+                return "Checking commands from LM " + std::get<0>(commandSet.first);
+            });
             for (auto command : commandSet.second)
             {
                 // Get the affected node E2 Node Id depending on the command type
@@ -110,16 +157,14 @@ OranCmmSingleCommandPerNode::Filter(
                         cellId,
                         (command->GetObject<OranCommandLte2LteHandover>())->GetTargetRnti());
 
-                    LogLogicToStorage("Evaluating LTE-to-LTE Handover command affecting E2 Node " +
-                                      std::to_string(affectedNodeId));
+                    LogLogicToStorage(LOG_CMM_EVALUATING_HANDOVER, affectedNodeId);
                 }
                 else
                 {
                     // Default: Use the target E2 Node Id
                     affectedNodeId = command->GetTargetE2NodeId();
 
-                    LogLogicToStorage("Evaluating commands affecting E2 Node " +
-                                      std::to_string(affectedNodeId));
+                    LogLogicToStorage(LOG_CMM_EVALUATING_COMMAND, affectedNodeId);
                 }
 
                 if (affectedNodes.find(affectedNodeId) != affectedNodes.end())
@@ -132,16 +177,13 @@ OranCmmSingleCommandPerNode::Filter(
                         affectedNodes[affectedNodeId] = defaultLm;
                         selectedCommands[affectedNodeId] = command;
 
-                        LogLogicToStorage("There was a command for this node, but the new command "
-                                          "was issued by the default LM, so new replaces old.");
+                        LogLogicToStorage(LOG_CMM_REPLACING_COMMAND);
                     }
                     else
                     {
-                        LogLogicToStorage("There was a command for this node, and the new command "
-                                          "has lower precedence (old default? " +
-                                          std::to_string(affectedNodes[affectedNodeId]) +
-                                          "; new default? " + std::to_string(defaultLm) +
-                                          "). Ignoring new command.");
+                        LogLogicToStorage(LOG_CMM_IGNORING_COMMAND,
+                                          affectedNodes[affectedNodeId],
+                                          defaultLm);
                     }
                 }
                 else
@@ -150,7 +192,7 @@ OranCmmSingleCommandPerNode::Filter(
                     affectedNodes[affectedNodeId] = defaultLm;
                     selectedCommands[affectedNodeId] = command;
 
-                    LogLogicToStorage("There was no command for this node; Saving new command.");
+                    LogLogicToStorage(LOG_CMM_SAVING_COMMAND);
                 }
             }
         }
@@ -146,4 +146,21 @@ OranCmm::LogLogicToStorage(const std::string& msg) const
     }
 }
 
+void
+OranCmm::LogLogicToStorage(OranDataRepository::LogEvent event,
+                           double arg0,
+                           double arg1,
+                           double arg2,
+                           double arg3) const
+{
+    NS_LOG_FUNCTION(this << event << arg0 << arg1 << arg2 << arg3);
+
+    NS_ABORT_MSG_IF(m_nearRtRic == nullptr, "Attempting to log CMM logic with NULL Near-RT RIC");
+
+    if (m_verbose)
+    {
+        m_nearRtRic->Data()->LogEventCmm(m_name, event, arg0, arg1, arg2, arg3);
+    }
+}
+
 } // namespace ns3
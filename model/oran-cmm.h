@@ -31,10 +31,13 @@
 #ifndef ORAN_CMM_H
 #define ORAN_CMM_H
 
+#include "oran-data-repository.h"
+
 #include "ns3/object.h"
 
 #include <map>
 #include <string>
+#include <type_traits>
 #include <vector>
 
 namespace ns3
@@ -124,6 +127,37 @@ class OranCmm : public Object
      * @param msg The message to log.
      */
     void LogLogicToStorage(const std::string& msg) const;
+    /**
+     * Log a message to the data storage, building it only if the CMM is
+     * verbose. This avoids the cost of formatting the message when it would
+     * be discarded.
+     *
+     * @param buildMsg The callable that returns the message to log.
+     */
+    template <typename MsgBuilder,
+              typename = std::enable_if_t<std::is_invocable_r_v<std::string, MsgBuilder>>>
+    void LogLogicToStorage(MsgBuilder&& buildMsg) const
+    {
+        if (m_verbose)
+        {
+            LogLogicToStorage(std::string(buildMsg()));
+        }
+    }
+    /**
+     * Log an event to the data storage. The event is stored with its
+     * arguments, and its text is only rendered when it is queried.
+     *
+     * @param event The event.
+     * @param arg0 The first argument of the event.
+     * @param arg1 The second argument of the event.
+     * @param arg2 The third argument of the event.
+     * @param arg3 The fourth argument of the event.
+     */
+    void LogLogicToStorage(OranDataRepository::LogEvent event,
+                           double arg0 = 0,
+                           double arg1 = 0,
+                           double arg2 = 0,
+                           double arg3 = 0) const;
 
     /**
      * Pointer to the Near RT-RIC.
@@ -0,0 +1,1308 @@
+/**
+ * NIST-developed software is provided by NIST as a public service. You may
+ * use, copy and distribute copies of the software in any medium, provided that
+ * you keep intact this entire notice. You may improve, modify and create
+ * derivative works of the software or any portion of the software, and you may
+ * copy and distribute such modifications or works. Modified works should carry
+ * a notice stating that you changed the software and should note the date and
+ * nature of any such change. Please explicitly acknowledge the National
+ * Institute of Standards and Technology as the source of the software.
+ *
+ * NIST-developed software is expressly provided "AS IS." NIST MAKES NO
+ * WARRANTY OF ANY KIND, EXPRESS, IMPLIED, IN FACT OR ARISING BY OPERATION OF
+ * LAW, INCLUDING, WITHOUT LIMITATION, THE IMPLIED WARRANTY OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE, NON-INFRINGEMENT AND DATA ACCURACY. NIST
+ * NEITHER REPRESENTS NOR WARRANTS THAT THE OPERATION OF THE SOFTWARE WILL BE
+ * UNINTERRUPTED OR ERROR-FREE, OR THAT ANY DEFECTS WILL BE CORRECTED. NIST
+ * DOES NOT WARRANT OR MAKE ANY REPRESENTATIONS REGARDING THE USE OF THE
+ * SOFTWARE OR THE RESULTS THEREOF, INCLUDING BUT NOT LIMITED TO THE
+ * CORRECTNESS, ACCURACY, RELIABILITY, OR USEFULNESS OF THE SOFTWARE.
+ *
+ * You are solely responsible for determining the appropriateness of using and
+ * distributing the software and you assume all risks associated with its use,
+ * including but not limited to the risks and costs of program errors,
+ * compliance with applicable laws, damage to or loss of data, programs or
+ * equipment, and the unavailability or interruption of operation. This
+ * software is not intended to be used in any situation where a failure could
+ * cause risk of injury or damage to property. The software developed by NIST
+ * employees is not subject to copyright protection within the United States.
+ */
+
+#include "oran-data-repository-binary-log.h"
+
+#include "oran-data-repository-sqlite.h"
+
+#include "ns3/abort.h"
+#include "ns3/boolean.h"
+#include "ns3/log.h"
+#include "ns3/simulator.h"
+#include "ns3/string.h"
+#include "ns3/uinteger.h"
+
+#include <algorithm>
+#include <cerrno>
+#include <fcntl.h>
+#include <random>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+namespace ns3
+{
+
+NS_LOG_COMPONENT_DEFINE("OranDataRepositoryBinaryLog");
+
+NS_OBJECT_ENSURE_REGISTERED(OranDataRepositoryBinaryLog);
+
+namespace
+{
+
+/**
+ * The magic number at the start of each segment.
+ */
+const char BINARY_LOG_MAGIC[8] = {'O', 'R', 'A', 'N', 'B', 'L', 'O', 'G'};
+/**
+ * The version of the log format.
+ */
+const uint32_t BINARY_LOG_VERSION = 3;
+
+/**
+ * The header at the start of each segment.
+ */
+struct FileHeader
+{
+    char magic[8];       //!< The magic number.
+    uint32_t version;    //!< The version of the log format.
+    uint32_t segment;    //!< The segment number.
+    uint64_t logId;      //!< The random ID of the log.
+    int32_t resolution;  //!< The time resolution of the time steps in the records.
+    uint32_t reserved;   //!< Reserved; always zero.
+};
+
+/**
+ * The payload of a node record.
+ */
+struct NodePayload
+{
+    uint32_t type;     //!< The node type.
+    uint32_t reserved; //!< Reserved; always zero.
+};
+
+/**
+ * The payload of an LTE UE record.
+ */
+struct LteUePayload
+{
+    uint64_t imsi; //!< The IMSI.
+};
+
+/**
+ * The payload of an LTE eNB record.
+ */
+struct LteEnbPayload
+{
+    uint16_t cellId;      //!< The cell ID.
+    uint16_t reserved[3]; //!< Reserved; always zero.
+};
+
+/**
+ * The payload of a (de)registration record.
+ */
+struct RegistrationPayload
+{
+    uint8_t registered;  //!< The registration state.
+    uint8_t reserved[7]; //!< Reserved; always zero.
+};
+
+/**
+ * The payload of a location record.
+ */
+struct PositionPayload
+{
+    double x; //!< The x coordinate.
+    double y; //!< The y coordinate.
+    double z; //!< The z coordinate.
+};
+
+/**
+ * The payload of an LTE UE cell information record.
+ */
+struct CellInfoPayload
+{
+    uint16_t cellId;   //!< The cell ID.
+    uint16_t rnti;     //!< The RNTI.
+    uint32_t reserved; //!< Reserved; always zero.
+};
+
+/**
+ * The payload of an application loss record.
+ */
+struct AppLossPayload
+{
+    double appLoss; //!< The application loss.
+};
+
+/**
+ * The payload of an RSRP and RSRQ record.
+ */
+struct RsrpRsrqPayload
+{
+    double rsrp;                //!< The RSRP.
+    double rsrq;                //!< The RSRQ.
+    uint16_t rnti;              //!< The RNTI.
+    uint16_t cellId;            //!< The cell ID.
+    uint8_t isServingCell;      //!< The serving cell flag.
+    uint8_t componentCarrierId; //!< The component carrier ID.
+    uint8_t reserved[2];        //!< Reserved; always zero.
+};
+
+/**
+ * The lengths of the strings of a text record, which follow them.
+ */
+struct TextPayload
+{
+    uint32_t firstLength;  //!< The length of the first string.
+    uint32_t secondLength; //!< The length of the second string.
+};
+
+/**
+ * The payload of an LM or CMM event record.
+ */
+struct EventPayload
+{
+    uint16_t event;    //!< The event code.
+    uint16_t reserved; //!< Reserved; always zero.
+    uint32_t moduleId; //!< The ID of the module that logged the event.
+    double args[4];    //!< The arguments of the event.
+};
+
+static_assert(sizeof(FileHeader) == 32, "Unexpected padding in the segment header");
+static_assert(sizeof(RsrpRsrqPayload) == 24, "Unexpected padding in the RSRP and RSRQ payload");
+
+/**
+ * Round a record size up to a multiple of 8 bytes, so that all the records
+ * start at an aligned offset.
+ *
+ * @param size The size.
+ *
+ * @return The aligned size.
+ */
+std::size_t
+AlignRecordSize(std::size_t size)
+{
+    return (size + 7) & ~static_cast<std::size_t>(7);
+}
+
+/**
+ * Read a value from a record.
+ *
+ * @param data The location of the value.
+ *
+ * @return The value.
+ */
+template <typename T>
+T
+ReadValue(const uint8_t* data)
+{
+    T value;
+    std::memcpy(&value, data, sizeof(T));
+    return value;
+}
+
+} // namespace
+
+TypeId
+OranDataRepositoryBinaryLog::GetTypeId()
+{
+    static TypeId tid =
+        TypeId("ns3::OranDataRepositoryBinaryLog")
+            .SetParent<OranDataRepository>()
+            .AddConstructor<OranDataRepositoryBinaryLog>()
+            .AddAttribute("LogFile",
+                          "The path of the log. The segment number is appended to it to get "
+                          "the file path of each segment.",
+                          StringValue("oran-repository.bin"),
+                          MakeStringAccessor(&OranDataRepositoryBinaryLog::m_logPath),
+                          MakeStringChecker())
+            .AddAttribute("SegmentSize",
+                          "The size of each segment of the log, in bytes.",
+                          UintegerValue(64 * 1024 * 1024),
+                          MakeUintegerAccessor(&OranDataRepositoryBinaryLog::m_segmentSize),
+                          MakeUintegerChecker<uint32_t>(4096));
+
+    return tid;
+}
+
+OranDataRepositoryBinaryLog::OranDataRepositoryBinaryLog()
+    : OranDataRepository(),
+      m_logId(0),
+      m_nextE2NodeId(1),
+      m_pruneCursor(0)
+{
+    NS_LOG_FUNCTION(this);
+}
+
+OranDataRepositoryBinaryLog::~OranDataRepositoryBinaryLog()
+{
+    NS_LOG_FUNCTION(this);
+}
+
+void
+OranDataRepositoryBinaryLog::Activate()
+{
+    NS_LOG_FUNCTION(this);
+
+    OranDataRepository::Activate();
+
+    if (m_segments.empty())
+    {
+        // Remove the segments of an earlier log with the same name, as a
+        // shorter log would not overwrite all of them.
+        for (uint32_t segment = 0;; segment++)
+        {
+            std::string path = GetSegmentPath(m_logPath, segment);
+            if (unlink(path.c_str()) != 0)
+            {
+                NS_ABORT_MSG_IF(errno != ENOENT,
+                                "Unable to remove binary log segment " << path << ": "
+                                                                       << std::strerror(errno));
+                break;
+            }
+        }
+
+        std::random_device device;
+        m_logId = (static_cast<uint64_t>(device()) << 32) | device();
+
+        OpenSegment();
+    }
+}
+
+void
+OranDataRepositoryBinaryLog::Deactivate()
+{
+    NS_LOG_FUNCTION(this);
+
+    CloseLog();
+
+    OranDataRepository::Deactivate();
+}
+
+bool
+OranDataRepositoryBinaryLog::IsNodeRegistered(uint64_t e2NodeId)
+{
+    NS_LOG_FUNCTION(this << e2NodeId);
+
+    return GetRegisteredNode(e2NodeId) != nullptr;
+}
+
+uint64_t
+OranDataRepositoryBinaryLog::RegisterNode(OranNearRtRic::NodeType type, uint64_t id)
+{
+    NS_LOG_FUNCTION(this << type << id);
+
+    uint64_t e2NodeId = 0;
+
+    if (m_active)
+    {
+        e2NodeId = (id == 0 ? m_nextE2NodeId : id);
+        m_nextE2NodeId = std::max(m_nextE2NodeId, e2NodeId + 1);
+
+        NodeIndex& node = m_nodes[e2NodeId];
+        node.type = type;
+        node.SetRegistration(true, Simulator::Now());
+
+        Append(RECORD_NODE,
+               e2NodeId,
+               Simulator::Now(),
+               NodePayload{static_cast<uint32_t>(type), 0});
+        Append(RECORD_NODE_REGISTRATION, e2NodeId, Simulator::Now(), RegistrationPayload{1, {}});
+
+        m_nodeRegisteredTrace(e2NodeId);
+    }
+
+    return e2NodeId;
+}
+
+uint64_t
+OranDataRepositoryBinaryLog::RegisterNodeLteUe(uint64_t id, uint64_t imsi)
+{
+    NS_LOG_FUNCTION(this << id << imsi);
+
+    uint64_t e2NodeId = 0;
+
+    if (m_active)
+    {
+        e2NodeId = RegisterNode(OranNearRtRic::NodeType::LTEUE, id);
+
+        m_nodes[e2NodeId].SetLteUe();
+
+        Append(RECORD_NODE_LTE_UE, e2NodeId, Simulator::Now(), LteUePayload{imsi});
+    }
+    return e2NodeId;
+}
+
+uint64_t
+OranDataRepositoryBinaryLog::RegisterNodeLteEnb(uint64_t id, uint16_t cellId)
+{
+    NS_LOG_FUNCTION(this << id << cellId);
+
+    uint64_t e2NodeId = 0;
+
+    if (m_active)
+    {
+        e2NodeId = RegisterNode(OranNearRtRic::NodeType::LTEENB, id);
+
+        m_nodes[e2NodeId].SetLteEnb(cellId);
+
+        Append(RECORD_NODE_LTE_ENB, e2NodeId, Simulator::Now(), LteEnbPayload{cellId, {}});
+    }
+    return e2NodeId;
+}
+
+uint64_t
+OranDataRepositoryBinaryLog::DeregisterNode(uint64_t e2NodeId)
+{
+    NS_LOG_FUNCTION(this << e2NodeId);
+
+    uint64_t retVal = 0;
+    if (m_active)
+    {
+        retVal = e2NodeId;
+
+        auto it = m_nodes.find(e2NodeId);
+        if (it != m_nodes.end())
+        {
+            it->second.SetRegistration(false, Simulator::Now());
+        }
+
+        Append(RECORD_NODE_REGISTRATION, e2NodeId, Simulator::Now(), RegistrationPayload{0, {}});
+
+        m_nodeDeregisteredTrace(e2NodeId);
+    }
+    return retVal;
+}
+
+void
+OranDataRepositoryBinaryLog::SavePosition(uint64_t e2NodeId, Vector pos, Time t)
+{
+    NS_LOG_FUNCTION(this << e2NodeId << pos << t);
+
+    NodeIndex* node = GetRegisteredNode(e2NodeId);
+    if (node != nullptr)
+    {
+        PositionPayload payload{pos.x, pos.y, pos.z};
+        uint8_t* data = AppendRecord(RECORD_NODE_LOCATION, e2NodeId, t, sizeof(payload));
+        std::memcpy(data, &payload, sizeof(payload));
+
+        auto& positions = node->positions;
+        if (!positions.empty() && t.GetTimeStep() < positions.back().time)
+        {
+            node->positionsSorted = false;
+        }
+        positions.push_back({t.GetTimeStep(),
+                             static_cast<uint32_t>(m_segments.size() - 1),
+                             static_cast<uint32_t>(data - m_segments.back().data)});
+
+        node->UpdatePosition(pos, t);
+    }
+}
+
+void
+OranDataRepositoryBinaryLog::SaveLteUeCellInfo(uint64_t e2NodeId,
+                                               uint16_t cellId,
+                                               uint16_t rnti,
+                                               Time t)
+{
+    NS_LOG_FUNCTION(this << e2NodeId << (uint32_t)cellId << (uint32_t)rnti << t);
+
+    NodeIndex* node = GetRegisteredNode(e2NodeId);
+    if (node != nullptr)
+    {
+        Append(RECORD_LTE_UE_CELL, e2NodeId, t, CellInfoPayload{cellId, rnti, 0});
+
+        node->UpdateLteUeCellInfo(cellId, rnti, t);
+
+        m_lteUeByCellInfo[std::make_tuple(cellId, rnti)] = e2NodeId;
+    }
+}
+
+void
+OranDataRepositoryBinaryLog::SaveAppLoss(uint64_t e2NodeId, double appLoss, Time t)
+{
+    NS_LOG_FUNCTION(this << e2NodeId << appLoss << t);
+
+    NodeIndex* node = GetRegisteredNode(e2NodeId);
+    if (node != nullptr)
+    {
+        Append(RECORD_NODE_APPLOSS, e2NodeId, t, AppLossPayload{appLoss});
+        node->UpdateAppLoss(appLoss);
+    }
+}
+
+void
+OranDataRepositoryBinaryLog::SaveLteUeRsrpRsrq(uint64_t e2NodeId,
+                                               Time t,
+                                               uint16_t rnti,
+                                               uint16_t cellId,
+                                               double rsrp,
+                                               double rsrq,
+                                               bool isServingCell,
+                                               uint8_t componentCarrierId)
+{
+    NS_LOG_FUNCTION(this << e2NodeId << t << +rnti << +cellId << rsrp << rsrq << isServingCell
+                         << +componentCarrierId);
+
+    NodeIndex* node = GetRegisteredNode(e2NodeId);
+    if (node != nullptr)
+    {
+        Append(RECORD_LTE_UE_RSRP_RSRQ,
+               e2NodeId,
+               t,
+               RsrpRsrqPayload{rsrp,
+                               rsrq,
+                               rnti,
+                               cellId,
+                               static_cast<uint8_t>(isServingCell),
+                               componentCarrierId,
+                               {}});
+        node->UpdateLteUeRsrpRsrq(t, rnti, cellId, rsrp, rsrq, isServingCell, componentCarrierId);
+    }
+}
+
+std::map<Time, Vector>
+OranDataRepositoryBinaryLog::GetNodePositions(uint64_t e2NodeId,
+                                              Time fromTime,
+                                              Time toTime,
+                                              uint64_t maxEntries)
+{
+    NS_LOG_FUNCTION(this << e2NodeId << fromTime << toTime << maxEntries);
+
+    std::map<Time, Vector> nodePositions;
+
+    NodeIndex* node = GetRegisteredNode(e2NodeId);
+    if (node != nullptr)
+    {
+        const auto& positions = node->positions;
+        std::vector<std::size_t> matches;
+
+        if (node->positionsSorted)
+        {
+            // Walk back from the newest reference within the interval
+            auto end = std::upper_bound(positions.begin(),
+                                        positions.end(),
+                                        toTime.GetTimeStep(),
+                                        [](int64_t t, const PositionRef& ref) {
+                                            return t < ref.time;
+                                        });
+            for (std::size_t i = end - positions.begin();
+                 i > 0 && positions[i - 1].time >= fromTime.GetTimeStep() &&
+                 matches.size() < maxEntries;
+                 i--)
+            {
+                matches.push_back(i - 1);
+            }
+        }
+        else
+        {
+            for (std::size_t i = positions.size(); i > 0; i--)
+            {
+                int64_t t = positions[i - 1].time;
+                if (t >= fromTime.GetTimeStep() && t <= toTime.GetTimeStep())
+                {
+                    matches.push_back(i - 1);
+                }
+            }
+            std::stable_sort(matches.begin(),
+                             matches.end(),
+                             [&positions](std::size_t a, std::size_t b) {
+                                 return positions[a].time > positions[b].time;
+                             });
+            if (matches.size() > maxEntries)
+            {
+                matches.resize(maxEntries);
+            }
+        }
+
+        for (auto i : matches)
+        {
+            nodePositions[Time(positions[i].time)] = ReadPosition(positions[i]);
+        }
+    }
+    return nodePositions;
+}
+
+std::tuple<bool, uint16_t, uint16_t>
+OranDataRepositoryBinaryLog::GetLteUeCellInfo(uint64_t e2NodeId)
+{
+    NS_LOG_FUNCTION(this << e2NodeId);
+
+    auto retVal = std::make_tuple(false, 0, 0);
+
+    NodeIndex* node = GetRegisteredNode(e2NodeId);
+    if (node != nullptr && node->hasCellInfo)
+    {
+        retVal = std::make_tuple(true, node->cellInfoCellId, node->cellInfoRnti);
+    }
+    return retVal;
+}
+
+std::vector<uint64_t>
+OranDataRepositoryBinaryLog::GetLteUeE2NodeIds()
+{
+    NS_LOG_FUNCTION(this);
+
+    std::vector<uint64_t> e2NodeIds;
+
+    if (m_active)
+    {
+        for (const auto& entry : m_nodes)
+        {
+            if (entry.second.registered && entry.second.isLteUe)
+            {
+                e2NodeIds.push_back(entry.first);
+            }
+        }
+    }
+    return e2NodeIds;
+}
+
+uint64_t
+OranDataRepositoryBinaryLog::GetLteUeE2NodeIdFromCellInfo(uint16_t cellId, uint16_t rnti)
+{
+    NS_LOG_FUNCTION(this << cellId << rnti);
+
+    uint64_t id = 0;
+    if (m_active)
+    {
+        auto it = m_lteUeByCellInfo.find(std::make_tuple(cellId, rnti));
+        if (it != m_lteUeByCellInfo.end())
+        {
+            id = it->second;
+        }
+    }
+    return id;
+}
+
+std::tuple<bool, uint16_t>
+OranDataRepositoryBinaryLog::GetLteEnbCellInfo(uint64_t e2NodeId)
+{
+    NS_LOG_FUNCTION(this << e2NodeId);
+
+    auto retVal = std::make_tuple(false, 0);
+
+    NodeIndex* node = GetRegisteredNode(e2NodeId);
+    if (node != nullptr && node->isLteEnb)
+    {
+        retVal = std::make_tuple(true, node->cellId);
+    }
+    return retVal;
+}
+
+std::vector<uint64_t>
+OranDataRepositoryBinaryLog::GetLteEnbE2NodeIds()
+{
+    NS_LOG_FUNCTION(this);
+
+    std::vector<uint64_t> e2NodeIds;
+
+    if (m_active)
+    {
+        for (const auto& entry : m_nodes)
+        {
+            if (entry.second.registered && entry.second.isLteEnb)
+            {
+                e2NodeIds.push_back(entry.first);
+            }
+        }
+    }
+    return e2NodeIds;
+}
+
+std::vector<std::tuple<uint64_t, Time>>
+OranDataRepositoryBinaryLog::GetLastRegistrationRequests()
+{
+    NS_LOG_FUNCTION(this);
+
+    std::vector<std::tuple<uint64_t, Time>> requests;
+
+    if (m_active)
+    {
+        for (const auto& entry : m_nodes)
+        {
+            if (entry.second.registered)
+            {
+                requests.emplace_back(entry.first, entry.second.lastRequestTime);
+            }
+        }
+    }
+    return requests;
+}
+
+double
+OranDataRepositoryBinaryLog::GetAppLoss(uint64_t e2NodeId)
+{
+    NS_LOG_FUNCTION(this << e2NodeId);
+
+    double loss = 0;
+
+    NodeIndex* node = GetRegisteredNode(e2NodeId);
+    if (node != nullptr)
+    {
+        loss = node->appLoss;
+    }
+    return loss;
+}
+
+std::vector<std::tuple<uint16_t, uint16_t, double, double, bool, uint8_t>>
+OranDataRepositoryBinaryLog::GetLteUeRsrpRsrq(uint64_t e2NodeId)
+{
+    NS_LOG_FUNCTION(this << e2NodeId);
+
+    std::vector<std::tuple<uint16_t, uint16_t, double, double, bool, uint8_t>> retVal;
+
+    NodeIndex* node = GetRegisteredNode(e2NodeId);
+    if (node != nullptr)
+    {
+        retVal = node->rsrpRsrq;
+    }
+    return retVal;
+}
+
+OranDataRepository::LteUeSnapshot
+OranDataRepositoryBinaryLog::GetLteUeSnapshot()
+{
+    NS_LOG_FUNCTION(this);
+
+    LteUeSnapshot snapshot;
+
+    if (m_active)
+    {
+        for (const auto& entry : m_nodes)
+        {
+            const NodeIndex& node = entry.second;
+            if (node.registered && node.isLteUe && node.hasCellInfo && node.hasPosition)
+            {
+                snapshot.e2NodeIds.push_back(entry.first);
+                snapshot.cellIds.push_back(node.cellInfoCellId);
+                snapshot.rntis.push_back(node.cellInfoRnti);
+                snapshot.positions.push_back(node.position);
+                snapshot.appLosses.push_back(node.appLoss);
+            }
+        }
+    }
+    return snapshot;
+}
+
+OranDataRepository::LteEnbSnapshot
+OranDataRepositoryBinaryLog::GetLteEnbSnapshot()
+{
+    NS_LOG_FUNCTION(this);
+
+    LteEnbSnapshot snapshot;
+
+    if (m_active)
+    {
+        for (const auto& entry : m_nodes)
+        {
+            const NodeIndex& node = entry.second;
+            if (node.registered && node.isLteEnb && node.hasPosition)
+            {
+                snapshot.e2NodeIds.push_back(entry.first);
+                snapshot.cellIds.push_back(node.cellId);
+                snapshot.positions.push_back(node.position);
+            }
+        }
+    }
+    return snapshot;
+}
+
+std::tuple<bool, Time, Vector>
+OranDataRepositoryBinaryLog::GetLatestNodePosition(uint64_t e2NodeId)
+{
+    NS_LOG_FUNCTION(this << e2NodeId);
+
+    auto retVal = std::make_tuple(false, Time(), Vector());
+
+    NodeIndex* node = GetRegisteredNode(e2NodeId);
+    if (node != nullptr && node->hasPosition)
+    {
+        retVal = std::make_tuple(true, node->positionTime, node->position);
+    }
+    return retVal;
+}
+
+void
+OranDataRepositoryBinaryLog::ForEachNodePosition(uint64_t e2NodeId,
+                                                 Time fromTime,
+                                                 Time toTime,
+                                                 uint64_t maxEntries,
+                                                 const NodePositionVisitor& visitor)
+{
+    NS_LOG_FUNCTION(this << e2NodeId << fromTime << toTime << maxEntries);
+
+    NodeIndex* node = GetRegisteredNode(e2NodeId);
+    if (node != nullptr)
+    {
+        if (!node->positionsSorted)
+        {
+            // The matching references have to be sorted first
+            OranDataRepository::ForEachNodePosition(e2NodeId,
+                                                    fromTime,
+                                                    toTime,
+                                                    maxEntries,
+                                                    visitor);
+            return;
+        }
+
+        // Walk back from the newest reference within the interval
+        const auto& positions = node->positions;
+        auto end = std::upper_bound(positions.begin(),
+                                    positions.end(),
+                                    toTime.GetTimeStep(),
+                                    [](int64_t t, const PositionRef& ref) { return t < ref.time; });
+        uint64_t visited = 0;
+        for (std::size_t i = end - positions.begin();
+             i > 0 && positions[i - 1].time >= fromTime.GetTimeStep() && visited < maxEntries;
+             i--)
+        {
+            visitor(Time(positions[i - 1].time), ReadPosition(positions[i - 1]));
+            visited++;
+        }
+    }
+}
+
+void
+OranDataRepositoryBinaryLog::ForEachLteUeRsrpRsrq(uint64_t e2NodeId,
+                                                  const LteUeRsrpRsrqVisitor& visitor)
+{
+    NS_LOG_FUNCTION(this << e2NodeId);
+
+    NodeIndex* node = GetRegisteredNode(e2NodeId);
+    if (node != nullptr)
+    {
+        for (const auto& measurement : node->rsrpRsrq)
+        {
+            std::apply(visitor, measurement);
+        }
+    }
+}
+
+void
+OranDataRepositoryBinaryLog::LogCommandE2Terminator(Ptr<OranCommand> cmd)
+{
+    NS_LOG_FUNCTION(this);
+
+    if (IsNodeRegistered(cmd->GetTargetE2NodeId()))
+    {
+        AppendText(RECORD_COMMAND_E2_TERMINATOR,
+                   cmd->GetTargetE2NodeId(),
+                   Simulator::Now(),
+                   "",
+                   cmd->ToString());
+    }
+}
+
+void
+OranDataRepositoryBinaryLog::LogCommandLm(std::string lm, Ptr<OranCommand> cmd)
+{
+    NS_LOG_FUNCTION(this);
+
+    if (m_active)
+    {
+        AppendText(RECORD_COMMAND_LM, 0, Simulator::Now(), lm, cmd->ToString());
+    }
+}
+
+void
+OranDataRepositoryBinaryLog::LogActionLm(std::string lm, std::string logStr)
+{
+    NS_LOG_FUNCTION(this << lm << logStr);
+
+    if (m_active)
+    {
+        AppendText(RECORD_ACTION_LM, 0, Simulator::Now(), lm, logStr);
+    }
+}
+
+void
+OranDataRepositoryBinaryLog::LogActionCmm(std::string cmm, std::string logStr)
+{
+    NS_LOG_FUNCTION(this << cmm << logStr);
+
+    if (m_active)
+    {
+        AppendText(RECORD_ACTION_CMM, 0, Simulator::Now(), cmm, logStr);
+    }
+}
+
+void
+OranDataRepositoryBinaryLog::LogEventLm(const std::string& lm,
+                                        LogEvent event,
+                                        double arg0,
+                                        double arg1,
+                                        double arg2,
+                                        double arg3)
+{
+    NS_LOG_FUNCTION(this << lm << event << arg0 << arg1 << arg2 << arg3);
+
+    if (m_active)
+    {
+        AppendEvent(RECORD_EVENT_LM, lm, event, arg0, arg1, arg2, arg3);
+    }
+}
+
+void
+OranDataRepositoryBinaryLog::LogEventCmm(const std::string& cmm,
+                                         LogEvent event,
+                                         double arg0,
+                                         double arg1,
+                                         double arg2,
+                                         double arg3)
+{
+    NS_LOG_FUNCTION(this << cmm << event << arg0 << arg1 << arg2 << arg3);
+
+    if (m_active)
+    {
+        AppendEvent(RECORD_EVENT_CMM, cmm, event, arg0, arg1, arg2, arg3);
+    }
+}
+
+uint64_t
+OranDataRepositoryBinaryLog::Convert(const std::string& logPath, const std::string& dbPath)
+{
+    NS_LOG_FUNCTION(logPath << dbPath);
+
+    Ptr<OranDataRepositorySqlite> db = CreateObject<OranDataRepositorySqlite>();
+    db->SetAttribute("DatabaseFile", StringValue(dbPath));
+    db->SetAttribute("WriteBatching", BooleanValue(true));
+    db->Activate();
+
+    uint64_t records = 0;
+    uint64_t logId = 0;
+    std::map<uint64_t, std::string> modules;
+    std::map<uint64_t, LogEvent> events;
+    for (uint32_t segment = 0;; segment++)
+    {
+        std::string path = GetSegmentPath(logPath, segment);
+        int fd = open(path.c_str(), O_RDONLY);
+        if (fd < 0)
+        {
+            NS_ABORT_MSG_IF(segment == 0, "Unable to open binary log " << path);
+            break;
+        }
+
+        struct stat st;
+        NS_ABORT_MSG_IF(fstat(fd, &st) != 0, "Unable to get the size of " << path);
+        std::size_t size = st.st_size;
+        void* map = nullptr;
+        if (size > 0)
+        {
+            map = mmap(nullptr, size, PROT_READ, MAP_PRIVATE, fd, 0);
+        }
+        close(fd);
+        NS_ABORT_MSG_IF(map == MAP_FAILED, "Unable to map " << path);
+
+        const uint8_t* data = static_cast<const uint8_t*>(map);
+        NS_ABORT_MSG_IF(size < sizeof(FileHeader), "Truncated binary log segment " << path);
+        FileHeader fileHeader = ReadValue<FileHeader>(data);
+        NS_ABORT_MSG_IF(std::memcmp(fileHeader.magic, BINARY_LOG_MAGIC, sizeof(BINARY_LOG_MAGIC)) !=
+                                0 ||
+                            fileHeader.version != BINARY_LOG_VERSION,
+                        "Unsupported binary log segment " << path);
+        NS_ABORT_MSG_IF(fileHeader.resolution != static_cast<int32_t>(Time::GetResolution()),
+                        "The binary log segment " << path
+                                                  << " uses a different time resolution");
+        NS_ABORT_MSG_IF(fileHeader.segment != segment,
+                        "The binary log segment " << path << " has segment number "
+                                                  << fileHeader.segment);
+        if (segment == 0)
+        {
+            logId = fileHeader.logId;
+        }
+        NS_ABORT_MSG_IF(fileHeader.logId != logId,
+                        "The binary log segment " << path
+                                                  << " belongs to a different log than "
+                                                  << GetSegmentPath(logPath, 0));
+
+        // The records end at the end of the file, or at the first zero-filled
+        // header if the segment was not truncated
+        std::size_t offset = sizeof(FileHeader);
+        while (offset + sizeof(RecordHeader) <= size)
+        {
+            RecordHeader header = ReadValue<RecordHeader>(data + offset);
+            if (header.type == RECORD_END || header.size < sizeof(RecordHeader) ||
+                header.size > size - offset)
+            {
+                break;
+            }
+
+            const uint8_t* payload = data + offset + sizeof(RecordHeader);
+            Time t(header.time);
+            switch (header.type)
+            {
+            case RECORD_NODE: {
+                auto p = ReadValue<NodePayload>(payload);
+                db->ImportNode(header.e2NodeId, static_cast<OranNearRtRic::NodeType>(p.type));
+                break;
+            }
+            case RECORD_NODE_LTE_UE:
+                db->ImportNodeLteUe(header.e2NodeId, ReadValue<LteUePayload>(payload).imsi);
+                break;
+            case RECORD_NODE_LTE_ENB:
+                db->ImportNodeLteEnb(header.e2NodeId, ReadValue<LteEnbPayload>(payload).cellId);
+                break;
+            case RECORD_NODE_REGISTRATION:
+                db->ImportNodeRegistration(header.e2NodeId,
+                                           ReadValue<RegistrationPayload>(payload).registered != 0,
+                                           t);
+                break;
+            case RECORD_NODE_LOCATION: {
+                auto p = ReadValue<PositionPayload>(payload);
+                db->ImportPosition(header.e2NodeId, Vector(p.x, p.y, p.z), t);
+                break;
+            }
+            case RECORD_LTE_UE_CELL: {
+                auto p = ReadValue<CellInfoPayload>(payload);
+                db->ImportLteUeCellInfo(header.e2NodeId, p.cellId, p.rnti, t);
+                break;
+            }
+            case RECORD_NODE_APPLOSS:
+                db->ImportAppLoss(header.e2NodeId, ReadValue<AppLossPayload>(payload).appLoss, t);
+                break;
+            case RECORD_LTE_UE_RSRP_RSRQ: {
+                auto p = ReadValue<RsrpRsrqPayload>(payload);
+                db->ImportLteUeRsrpRsrq(header.e2NodeId,
+                                        t,
+                                        p.rnti,
+                                        p.cellId,
+                                        p.rsrp,
+                                        p.rsrq,
+                                        p.isServingCell != 0,
+                                        p.componentCarrierId);
+                break;
+            }
+            case RECORD_COMMAND_E2_TERMINATOR:
+            case RECORD_COMMAND_LM:
+            case RECORD_ACTION_LM:
+            case RECORD_ACTION_CMM:
+            case RECORD_LOG_MODULE:
+            case RECORD_LOG_EVENT: {
+                auto p = ReadValue<TextPayload>(payload);
+                NS_ABORT_MSG_IF(sizeof(RecordHeader) + sizeof(TextPayload) + p.firstLength +
+                                        p.secondLength >
+                                    header.size,
+                                "Corrupted text record in " << path);
+                const char* text = reinterpret_cast<const char*>(payload + sizeof(TextPayload));
+                std::string first(text, p.firstLength);
+                std::string second(text + p.firstLength, p.secondLength);
+                if (header.type == RECORD_COMMAND_E2_TERMINATOR)
+                {
+                    db->ImportCommandE2Terminator(header.e2NodeId, t, second);
+                }
+                else if (header.type == RECORD_COMMAND_LM)
+                {
+                    db->ImportCommandLm(first, t, second);
+                }
+                else if (header.type == RECORD_ACTION_LM)
+                {
+                    db->ImportActionLm(first, t, second);
+                }
+                else if (header.type == RECORD_ACTION_CMM)
+                {
+                    db->ImportActionCmm(first, t, second);
+                }
+                else if (header.type == RECORD_LOG_MODULE)
+                {
+                    modules[header.e2NodeId] = first;
+                }
+                else
+                {
+                    // The codes of the events may differ between processes, so
+                    // the format is registered again in this one
+                    events[header.e2NodeId] = RegisterLogEvent(first, second);
+                }
+                break;
+            }
+            case RECORD_EVENT_LM:
+            case RECORD_EVENT_CMM: {
+                auto p = ReadValue<EventPayload>(payload);
+                auto it = modules.find(p.moduleId);
+                NS_ABORT_MSG_IF(it == modules.end(),
+                                "Event of unknown module " << p.moduleId << " in " << path);
+                auto event = events.find(p.event);
+                NS_ABORT_MSG_IF(event == events.end(),
+                                "Event of unknown format " << p.event << " in " << path);
+                if (header.type == RECORD_EVENT_LM)
+                {
+                    db->ImportEventLm(it->second,
+                                      t,
+                                      event->second,
+                                      p.args[0],
+                                      p.args[1],
+                                      p.args[2],
+                                      p.args[3]);
+                }
+                else
+                {
+                    db->ImportEventCmm(it->second,
+                                       t,
+                                       event->second,
+                                       p.args[0],
+                                       p.args[1],
+                                       p.args[2],
+                                       p.args[3]);
+                }
+                break;
+            }
+            default:
+                NS_ABORT_MSG("Unknown record type " << header.type << " in " << path);
+            }
+
+            records++;
+            offset += header.size;
+        }
+
+        if (map != nullptr)
+        {
+            munmap(map, size);
+        }
+    }
+
+    db->Deactivate();
+    db->Dispose();
+
+    return records;
+}
+
+void
+OranDataRepositoryBinaryLog::DoDispose()
+{
+    NS_LOG_FUNCTION(this);
+
+    CloseLog();
+
+    OranDataRepository::DoDispose();
+}
+
+void
+OranDataRepositoryBinaryLog::DoPruneHistory(HistoryType type,
+                                            Time minTime,
+                                            uint64_t maxRows,
+                                            uint32_t maxDeletes)
+{
+    NS_LOG_FUNCTION(this << type << minTime << maxRows << maxDeletes);
+
+    // Only the references to the location records are kept for more than the
+    // latest report, and the log itself is never pruned
+    if (type != NODE_LOCATION)
+    {
+        return;
+    }
+
+    int64_t minTs = minTime.GetTimeStep();
+    OranDataRepositoryPruneNodes(
+        m_nodes,
+        m_pruneCursor,
+        maxDeletes,
+        [minTs, maxRows](NodeIndex& node, std::size_t budget) {
+            // Remove the oldest references, always keeping the newest one. The
+            // references are in arrival order, so an out-of-order position may
+            // be kept a little longer than its age allows.
+            auto& positions = node.positions;
+            std::size_t count = 0;
+            if (maxRows > 0 && positions.size() > maxRows)
+            {
+                count = positions.size() - maxRows;
+            }
+            while (minTs > 0 && count + 1 < positions.size() && positions[count].time < minTs)
+            {
+                count++;
+            }
+            count = std::min(count, budget);
+            positions.erase(positions.begin(), positions.begin() + count);
+            return count;
+        });
+}
+
+std::string
+OranDataRepositoryBinaryLog::GetSegmentPath(const std::string& logPath, uint32_t segment)
+{
+    return logPath + "." + std::to_string(segment);
+}
+
+void
+OranDataRepositoryBinaryLog::OpenSegment()
+{
+    NS_LOG_FUNCTION(this);
+
+    // The previous segment is full: shrink its file to the data it holds. It
+    // stays mapped, as the index may still refer to its location records.
+    if (!m_segments.empty())
+    {
+        const Segment& previous = m_segments.back();
+        NS_ABORT_MSG_IF(truncate(previous.path.c_str(), previous.used) != 0,
+                        "Unable to truncate binary log segment " << previous.path << ": "
+                                                                 << std::strerror(errno));
+    }
+
+    Segment segment;
+    segment.path = GetSegmentPath(m_logPath, m_segments.size());
+
+    int fd = open(segment.path.c_str(), O_RDWR | O_CREAT | O_TRUNC, 0644);
+    NS_ABORT_MSG_IF(fd < 0,
+                    "Unable to create binary log segment " << segment.path << ": "
+                                                           << std::strerror(errno));
+    NS_ABORT_MSG_IF(ftruncate(fd, m_segmentSize) != 0,
+                    "Unable to resize binary log segment " << segment.path << ": "
+                                                           << std::strerror(errno));
+    void* map = mmap(nullptr, m_segmentSize, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+    close(fd);
+    NS_ABORT_MSG_IF(map == MAP_FAILED,
+                    "Unable to map binary log segment " << segment.path << ": "
+                                                        << std::strerror(errno));
+
+    FileHeader header = {};
+    std::memcpy(header.magic, BINARY_LOG_MAGIC, sizeof(BINARY_LOG_MAGIC));
+    header.version = BINARY_LOG_VERSION;
+    header.segment = m_segments.size();
+    header.logId = m_logId;
+    header.resolution = static_cast<int32_t>(Time::GetResolution());
+
+    segment.data = static_cast<uint8_t*>(map);
+    std::memcpy(segment.data, &header, sizeof(header));
+    segment.used = sizeof(header);
+
+    m_segments.push_back(segment);
+}
+
+void
+OranDataRepositoryBinaryLog::CloseLog()
+{
+    NS_LOG_FUNCTION(this);
+
+    for (const auto& segment : m_segments)
+    {
+        munmap(segment.data, m_segmentSize);
+        NS_ABORT_MSG_IF(truncate(segment.path.c_str(), segment.used) != 0,
+                        "Unable to truncate binary log segment " << segment.path << ": "
+                                                                 << std::strerror(errno));
+    }
+    m_segments.clear();
+
+    m_nodes.clear();
+    m_lteUeByCellInfo.clear();
+    m_nextE2NodeId = 1;
+    m_pruneCursor = 0;
+    m_logModuleIds.clear();
+    m_logEvents.clear();
+}
+
+uint8_t*
+OranDataRepositoryBinaryLog::AppendRecord(RecordType type,
+                                          uint64_t e2NodeId,
+                                          Time t,
+                                          std::size_t payloadSize)
+{
+    NS_LOG_FUNCTION(this << type << e2NodeId << t << payloadSize);
+
+    std::size_t size = AlignRecordSize(sizeof(RecordHeader) + payloadSize);
+    NS_ABORT_MSG_IF(size > m_segmentSize - sizeof(FileHeader),
+                    "A record of " << size << " bytes does not fit in a binary log segment");
+
+    if (m_segments.back().used + size > m_segmentSize)
+    {
+        OpenSegment();
+    }
+
+    // The segment is zero-filled, so the padding needs no writes
+    Segment& segment = m_segments.back();
+    uint8_t* record = segment.data + segment.used;
+    RecordHeader header{type, 0, static_cast<uint32_t>(size), t.GetTimeStep(), e2NodeId};
+    std::memcpy(record, &header, sizeof(header));
+    segment.used += size;
+
+    return record + sizeof(header);
+}
+
+void
+OranDataRepositoryBinaryLog::AppendText(RecordType type,
+                                        uint64_t e2NodeId,
+                                        Time t,
+                                        const std::string& first,
+                                        const std::string& second)
+{
+    NS_LOG_FUNCTION(this << type << e2NodeId << t << first << second);
+
+    TextPayload lengths{static_cast<uint32_t>(first.size()), static_cast<uint32_t>(second.size())};
+    uint8_t* data =
+        AppendRecord(type, e2NodeId, t, sizeof(lengths) + first.size() + second.size());
+    std::memcpy(data, &lengths, sizeof(lengths));
+    std::memcpy(data + sizeof(lengths), first.data(), first.size());
+    std::memcpy(data + sizeof(lengths) + first.size(), second.data(), second.size());
+}
+
+void
+OranDataRepositoryBinaryLog::AppendEvent(RecordType type,
+                                         const std::string& name,
+                                         LogEvent event,
+                                         double arg0,
+                                         double arg1,
+                                         double arg2,
+                                         double arg3)
+{
+    NS_LOG_FUNCTION(this << type << name << event << arg0 << arg1 << arg2 << arg3);
+
+    // The name of each module is written once, and the events refer to it by ID
+    auto it = m_logModuleIds.find(name);
+    if (it == m_logModuleIds.end())
+    {
+        it = m_logModuleIds.emplace(name, m_logModuleIds.size() + 1).first;
+        AppendText(RECORD_LOG_MODULE, it->second, Simulator::Now(), name, "");
+    }
+
+    // The same goes for the format of each event
+    if (m_logEvents.insert(event).second)
+    {
+        const auto& formats = GetLogEventFormats();
+        auto format = formats.find(event);
+        NS_ABORT_MSG_IF(format == formats.end(), "Unknown log event " << event);
+        AppendText(RECORD_LOG_EVENT,
+                   event,
+                   Simulator::Now(),
+                   format->second.module,
+                   format->second.format);
+    }
+
+    Append(type,
+           0,
+           Simulator::Now(),
+           EventPayload{static_cast<uint16_t>(event), 0, it->second, {arg0, arg1, arg2, arg3}});
+}
+
+OranDataRepositoryBinaryLog::NodeIndex*
+OranDataRepositoryBinaryLog::GetRegisteredNode(uint64_t e2NodeId)
+{
+    NS_LOG_FUNCTION(this << e2NodeId);
+
+    NodeIndex* node = nullptr;
+    if (m_active)
+    {
+        auto it = m_nodes.find(e2NodeId);
+        if (it != m_nodes.end() && it->second.registered)
+        {
+            node = &it->second;
+        }
+    }
+    return node;
+}
+
+Vector
+OranDataRepositoryBinaryLog::ReadPosition(const PositionRef& ref) const
+{
+    NS_LOG_FUNCTION(this);
+
+    auto p = ReadValue<PositionPayload>(m_segments[ref.segment].data + ref.offset);
+    return Vector(p.x, p.y, p.z);
+}
+
+} // namespace ns3
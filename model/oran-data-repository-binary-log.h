@@ -0,0 +1,388 @@
+/**
+ * NIST-developed software is provided by NIST as a public service. You may
+ * use, copy and distribute copies of the software in any medium, provided that
+ * you keep intact this entire notice. You may improve, modify and create
+ * derivative works of the software or any portion of the software, and you may
+ * copy and distribute such modifications or works. Modified works should carry
+ * a notice stating that you changed the software and should note the date and
+ * nature of any such change. Please explicitly acknowledge the National
+ * Institute of Standards and Technology as the source of the software.
+ *
+ * NIST-developed software is expressly provided "AS IS." NIST MAKES NO
+ * WARRANTY OF ANY KIND, EXPRESS, IMPLIED, IN FACT OR ARISING BY OPERATION OF
+ * LAW, INCLUDING, WITHOUT LIMITATION, THE IMPLIED WARRANTY OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE, NON-INFRINGEMENT AND DATA ACCURACY. NIST
+ * NEITHER REPRESENTS NOR WARRANTS THAT THE OPERATION OF THE SOFTWARE WILL BE
+ * UNINTERRUPTED OR ERROR-FREE, OR THAT ANY DEFECTS WILL BE CORRECTED. NIST
+ * DOES NOT WARRANT OR MAKE ANY REPRESENTATIONS REGARDING THE USE OF THE
+ * SOFTWARE OR THE RESULTS THEREOF, INCLUDING BUT NOT LIMITED TO THE
+ * CORRECTNESS, ACCURACY, RELIABILITY, OR USEFULNESS OF THE SOFTWARE.
+ *
+ * You are solely responsible for determining the appropriateness of using and
+ * distributing the software and you assume all risks associated with its use,
+ * including but not limited to the risks and costs of program errors,
+ * compliance with applicable laws, damage to or loss of data, programs or
+ * equipment, and the unavailability or interruption of operation. This
+ * software is not intended to be used in any situation where a failure could
+ * cause risk of injury or damage to property. The software developed by NIST
+ * employees is not subject to copyright protection within the United States.
+ */
+
+#ifndef ORAN_DATA_REPOSITORY_BINARY_LOG_H
+#define ORAN_DATA_REPOSITORY_BINARY_LOG_H
+
+#include "oran-data-repository-node-state.h"
+#include "oran-data-repository.h"
+
+#include <cstring>
+#include <map>
+#include <set>
+#include <string>
+#include <tuple>
+#include <vector>
+
+namespace ns3
+{
+
+/**
+ * @ingroup oran
+ *
+ * A Data Repository implementation that appends every stored item to a
+ * memory-mapped binary log, for runs in which the data is only analyzed
+ * after the simulation.
+ *
+ * The log is split in segments of "SegmentSize" bytes, named after the
+ * "LogFile" attribute with the segment number appended (e.g.,
+ * "oran-repository.bin.0"). Each segment starts with a file header, followed
+ * by records that consist of a fixed-size header (the type and size of the
+ * record, the time, and the E2 Node ID) and a fixed-size payload for each
+ * type of record. Only the Commands and logs carry variable-length text.
+ * Storing a report is a copy into the mapped segment, and a new segment is
+ * created when the current one is full. Segments are truncated to the data
+ * they contain when the repository is deactivated. The file header carries
+ * the segment number and a random ID of the log, so that the segments left
+ * by a different run are never loaded as part of the log.
+ *
+ * The Data Access API is served from an in-memory index that keeps the
+ * registration state and the latest report of each type of each node, as
+ * well as references to the location records in the log. The retention
+ * policy of the location history limits the references kept in the index;
+ * the log itself is never pruned.
+ *
+ * The log can be loaded into an SQLite database with the schema of
+ * OranDataRepositorySqlite after the run with the Convert method.
+ */
+class OranDataRepositoryBinaryLog : public OranDataRepository
+{
+  public:
+    /**
+     * Gets the TypeId of the OranDataRepositoryBinaryLog class.
+     *
+     * @return The TypeId.
+     */
+    static TypeId GetTypeId();
+    /**
+     * Creates an instance of the OranDataRepositoryBinaryLog class.
+     */
+    OranDataRepositoryBinaryLog();
+    /**
+     * The destructor of the OranDataRepositoryBinaryLog class.
+     */
+    ~OranDataRepositoryBinaryLog() override;
+    /**
+     * Activate the data storage. A new log is started, removing all the
+     * existing segments with the same name.
+     */
+    void Activate() override;
+    /**
+     * Deactivate the data storage. The segments are unmapped and truncated,
+     * and the index is cleared.
+     */
+    void Deactivate() override;
+
+    /* Data Storage API */
+    bool IsNodeRegistered(uint64_t e2NodeId) override;
+
+    uint64_t RegisterNode(OranNearRtRic::NodeType type, uint64_t id) override;
+    uint64_t RegisterNodeLteUe(uint64_t id, uint64_t imsi) override;
+    uint64_t RegisterNodeLteEnb(uint64_t id, uint16_t cellId) override;
+    uint64_t DeregisterNode(uint64_t e2NodeId) override;
+    void SavePosition(uint64_t e2NodeId, Vector pos, Time t) override;
+    void SaveLteUeCellInfo(uint64_t e2NodeId, uint16_t cellId, uint16_t rnti, Time t) override;
+    void SaveAppLoss(uint64_t e2NodeId, double appLoss, Time t) override;
+    void SaveLteUeRsrpRsrq(uint64_t e2NodeId,
+                           Time t,
+                           uint16_t rnti,
+                           uint16_t cellId,
+                           double rsrp,
+                           double rsrq,
+                           bool isServingCell,
+                           uint8_t componentCarrierId) override;
+
+    std::map<Time, Vector> GetNodePositions(uint64_t e2NodeId,
+                                            Time fromTime,
+                                            Time toTime,
+                                            uint64_t maxEntries = 1) override;
+    std::tuple<bool, uint16_t, uint16_t> GetLteUeCellInfo(uint64_t e2NodeId) override;
+    std::vector<uint64_t> GetLteUeE2NodeIds() override;
+    uint64_t GetLteUeE2NodeIdFromCellInfo(uint16_t cellId, uint16_t rnti) override;
+    std::tuple<bool, uint16_t> GetLteEnbCellInfo(uint64_t e2NodeId) override;
+    std::vector<uint64_t> GetLteEnbE2NodeIds() override;
+    std::vector<std::tuple<uint64_t, Time>> GetLastRegistrationRequests() override;
+    double GetAppLoss(uint64_t e2NodeId) override;
+    std::vector<std::tuple<uint16_t, uint16_t, double, double, bool, uint8_t>> GetLteUeRsrpRsrq(
+        uint64_t e2NodeId) override;
+    LteUeSnapshot GetLteUeSnapshot() override;
+    LteEnbSnapshot GetLteEnbSnapshot() override;
+    std::tuple<bool, Time, Vector> GetLatestNodePosition(uint64_t e2NodeId) override;
+    void ForEachNodePosition(uint64_t e2NodeId,
+                             Time fromTime,
+                             Time toTime,
+                             uint64_t maxEntries,
+                             const NodePositionVisitor& visitor) override;
+    void ForEachLteUeRsrpRsrq(uint64_t e2NodeId, const LteUeRsrpRsrqVisitor& visitor) override;
+
+    void LogCommandE2Terminator(Ptr<OranCommand> cmd) override;
+    void LogCommandLm(std::string lm, Ptr<OranCommand> cmd) override;
+    void LogActionLm(std::string lm, std::string logstr) override;
+    void LogActionCmm(std::string cmm, std::string logstr) override;
+    void LogEventLm(const std::string& lm,
+                    LogEvent event,
+                    double arg0,
+                    double arg1,
+                    double arg2,
+                    double arg3) override;
+    void LogEventCmm(const std::string& cmm,
+                     LogEvent event,
+                     double arg0,
+                     double arg1,
+                     double arg2,
+                     double arg3) override;
+
+    /**
+     * Load a binary log into an SQLite database with the schema used by
+     * OranDataRepositorySqlite. The segments are read in order until one is
+     * missing, and each segment is read until the end of its data. The
+     * simulation aborts if a segment does not have the expected segment
+     * number, or belongs to a different log than the first one.
+     *
+     * @param logPath The path of the log, without the segment number.
+     * @param dbPath The file path of the database.
+     *
+     * @return The number of records loaded.
+     */
+    static uint64_t Convert(const std::string& logPath, const std::string& dbPath);
+
+  protected:
+    void DoDispose() override;
+    void DoPruneHistory(HistoryType type,
+                        Time minTime,
+                        uint64_t maxRows,
+                        uint32_t maxDeletes) override;
+
+    /**
+     * The types of records in the log.
+     */
+    enum RecordType : uint16_t
+    {
+        RECORD_END = 0,
+        RECORD_NODE,
+        RECORD_NODE_LTE_UE,
+        RECORD_NODE_LTE_ENB,
+        RECORD_NODE_REGISTRATION,
+        RECORD_NODE_LOCATION,
+        RECORD_LTE_UE_CELL,
+        RECORD_NODE_APPLOSS,
+        RECORD_LTE_UE_RSRP_RSRQ,
+        RECORD_COMMAND_E2_TERMINATOR,
+        RECORD_COMMAND_LM,
+        RECORD_ACTION_LM,
+        RECORD_ACTION_CMM,
+        RECORD_LOG_MODULE,
+        RECORD_EVENT_LM,
+        RECORD_EVENT_CMM,
+        RECORD_LOG_EVENT
+    };
+
+    /**
+     * The header of each record.
+     */
+    struct RecordHeader
+    {
+        uint16_t type;     //!< The type of record.
+        uint16_t reserved; //!< Reserved; always zero.
+        uint32_t size;     //!< The size of the record, including the header and padding.
+        int64_t time;      //!< The time step of the record.
+        uint64_t e2NodeId; //!< The E2 Node ID, or zero if not applicable.
+    };
+
+    /**
+     * The reference to a location record in the log.
+     */
+    struct PositionRef
+    {
+        int64_t time;     //!< The time step of the location.
+        uint32_t segment; //!< The segment of the record.
+        uint32_t offset;  //!< The offset of the record in the segment.
+    };
+
+    /**
+     * The index entry of an E2 Node.
+     */
+    struct NodeIndex : public OranDataRepositoryNodeState
+    {
+        OranNearRtRic::NodeType type;       //!< The node type.
+        bool positionsSorted = true;        //!< Flag that indicates if positions arrived in order.
+        std::vector<PositionRef> positions; //!< The location records of the node.
+    };
+
+    /**
+     * A mapped segment of the log.
+     */
+    struct Segment
+    {
+        std::string path;        //!< The file path of the segment.
+        uint8_t* data = nullptr; //!< The start of the mapping.
+        std::size_t used = 0;    //!< The number of bytes written.
+    };
+
+    /**
+     * Get the file path of a segment of a log.
+     *
+     * @param logPath The path of the log.
+     * @param segment The segment number.
+     *
+     * @return The file path of the segment.
+     */
+    static std::string GetSegmentPath(const std::string& logPath, uint32_t segment);
+    /**
+     * Create and map the next segment of the log.
+     */
+    void OpenSegment();
+    /**
+     * Unmap and truncate all the segments of the log, and clear the index.
+     */
+    void CloseLog();
+    /**
+     * Reserve space for a record at the end of the log, creating a new
+     * segment if the current one cannot hold it, and write its header.
+     *
+     * @param type The type of record.
+     * @param e2NodeId The E2 Node ID, or zero if not applicable.
+     * @param t The time of the record.
+     * @param payloadSize The size of the payload of the record.
+     *
+     * @return A pointer to the payload of the record in the mapped segment.
+     */
+    uint8_t* AppendRecord(RecordType type, uint64_t e2NodeId, Time t, std::size_t payloadSize);
+    /**
+     * Append a record with a fixed-size payload.
+     *
+     * @param type The type of record.
+     * @param e2NodeId The E2 Node ID, or zero if not applicable.
+     * @param t The time of the record.
+     * @param payload The payload.
+     */
+    template <typename T>
+    void Append(RecordType type, uint64_t e2NodeId, Time t, const T& payload)
+    {
+        std::memcpy(AppendRecord(type, e2NodeId, t, sizeof(T)), &payload, sizeof(T));
+    }
+    /**
+     * Append a record with two strings as the payload, each one preceded by
+     * its length.
+     *
+     * @param type The type of record.
+     * @param e2NodeId The E2 Node ID, or zero if not applicable.
+     * @param t The time of the record.
+     * @param first The first string, which may be empty.
+     * @param second The second string.
+     */
+    void AppendText(RecordType type,
+                    uint64_t e2NodeId,
+                    Time t,
+                    const std::string& first,
+                    const std::string& second);
+    /**
+     * Append a structured LM or CMM event record, preceded by a record with
+     * the name of the module the first time that it logs an event, and by a
+     * record with the format of the event the first time that it is logged.
+     *
+     * @param type The type of record.
+     * @param name The name of the LM or CMM.
+     * @param event The event code.
+     * @param arg0 The first argument of the event.
+     * @param arg1 The second argument of the event.
+     * @param arg2 The third argument of the event.
+     * @param arg3 The fourth argument of the event.
+     */
+    void AppendEvent(RecordType type,
+                     const std::string& name,
+                     LogEvent event,
+                     double arg0,
+                     double arg1,
+                     double arg2,
+                     double arg3);
+    /**
+     * Get the index entry of a registered E2 Node.
+     *
+     * @param e2NodeId The E2 Node ID.
+     *
+     * @return A pointer to the index entry, or nullptr if the node is not registered.
+     */
+    NodeIndex* GetRegisteredNode(uint64_t e2NodeId);
+    /**
+     * Read the location of a location record.
+     *
+     * @param ref The reference to the record.
+     *
+     * @return The location.
+     */
+    Vector ReadPosition(const PositionRef& ref) const;
+
+  private:
+    /**
+     * The path of the log, to which the segment number is appended.
+     */
+    std::string m_logPath;
+    /**
+     * The size of each segment of the log, in bytes.
+     */
+    uint32_t m_segmentSize;
+    /**
+     * The segments of the log.
+     */
+    std::vector<Segment> m_segments;
+    /**
+     * The random ID of the current log, written in the header of its segments.
+     */
+    uint64_t m_logId;
+    /**
+     * The index entries of the E2 Nodes, indexed by E2 Node ID.
+     */
+    std::map<uint64_t, NodeIndex> m_nodes;
+    /**
+     * The E2 Node ID to assign to the next node registered without an ID.
+     */
+    uint64_t m_nextE2NodeId;
+    /**
+     * The E2 Node ID of the LTE UE that last reported each cell ID and RNTI pair.
+     */
+    std::map<std::tuple<uint16_t, uint16_t>, uint64_t> m_lteUeByCellInfo;
+    /**
+     * The E2 Node ID of the next node to prune the location history of.
+     */
+    uint64_t m_pruneCursor;
+    /**
+     * The IDs assigned to the names of the modules that logged events.
+     */
+    std::map<std::string, uint32_t> m_logModuleIds;
+    /**
+     * The event codes whose format has been written to the current log.
+     */
+    std::set<LogEvent> m_logEvents;
+}; // class OranDataRepositoryBinaryLog
+
+} // namespace ns3
+
+#endif /* ORAN_DATA_REPOSITORY_BINARY_LOG_H */
@@ -0,0 +1,740 @@
+/**
+ * NIST-developed software is provided by NIST as a public service. You may
+ * use, copy and distribute copies of the software in any medium, provided that
+ * you keep intact this entire notice. You may improve, modify and create
+ * derivative works of the software or any portion of the software, and you may
+ * copy and distribute such modifications or works. Modified works should carry
+ * a notice stating that you changed the software and should note the date and
+ * nature of any such change. Please explicitly acknowledge the National
+ * Institute of Standards and Technology as the source of the software.
+ *
+ * NIST-developed software is expressly provided "AS IS." NIST MAKES NO
+ * WARRANTY OF ANY KIND, EXPRESS, IMPLIED, IN FACT OR ARISING BY OPERATION OF
+ * LAW, INCLUDING, WITHOUT LIMITATION, THE IMPLIED WARRANTY OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE, NON-INFRINGEMENT AND DATA ACCURACY. NIST
+ * NEITHER REPRESENTS NOR WARRANTS THAT THE OPERATION OF THE SOFTWARE WILL BE
+ * UNINTERRUPTED OR ERROR-FREE, OR THAT ANY DEFECTS WILL BE CORRECTED. NIST
+ * DOES NOT WARRANT OR MAKE ANY REPRESENTATIONS REGARDING THE USE OF THE
+ * SOFTWARE OR THE RESULTS THEREOF, INCLUDING BUT NOT LIMITED TO THE
+ * CORRECTNESS, ACCURACY, RELIABILITY, OR USEFULNESS OF THE SOFTWARE.
+ *
+ * You are solely responsible for determining the appropriateness of using and
+ * distributing the software and you assume all risks associated with its use,
+ * including but not limited to the risks and costs of program errors,
+ * compliance with applicable laws, damage to or loss of data, programs or
+ * equipment, and the unavailability or interruption of operation. This
+ * software is not intended to be used in any situation where a failure could
+ * cause risk of injury or damage to property. The software developed by NIST
+ * employees is not subject to copyright protection within the United States.
+ */
+
+#include "oran-data-repository-cache.h"
+
+#include "ns3/abort.h"
+#include "ns3/log.h"
+#include "ns3/pointer.h"
+#include "ns3/simulator.h"
+
+#include <algorithm>
+
+namespace ns3
+{
+
+NS_LOG_COMPONENT_DEFINE("OranDataRepositoryCache");
+
+NS_OBJECT_ENSURE_REGISTERED(OranDataRepositoryCache);
+
+TypeId
+OranDataRepositoryCache::GetTypeId()
+{
+    static TypeId tid =
+        TypeId("ns3::OranDataRepositoryCache")
+            .SetParent<OranDataRepository>()
+            .AddConstructor<OranDataRepositoryCache>()
+            .AddAttribute("Backend",
+                          "The Data Repository that stores the data.",
+                          PointerValue(nullptr),
+                          MakePointerAccessor(&OranDataRepositoryCache::m_backend),
+                          MakePointerChecker<OranDataRepository>());
+
+    return tid;
+}
+
+OranDataRepositoryCache::OranDataRepositoryCache()
+    : OranDataRepository()
+{
+    NS_LOG_FUNCTION(this);
+}
+
+OranDataRepositoryCache::~OranDataRepositoryCache()
+{
+    NS_LOG_FUNCTION(this);
+}
+
+void
+OranDataRepositoryCache::Activate()
+{
+    NS_LOG_FUNCTION(this);
+
+    NS_ABORT_MSG_IF(m_backend == nullptr, "Attempting to activate a cache without a backend");
+
+    if (!m_backend->IsActive())
+    {
+        m_backend->Activate();
+    }
+
+    LoadFromBackend();
+
+    OranDataRepository::Activate();
+}
+
+void
+OranDataRepositoryCache::Deactivate()
+{
+    NS_LOG_FUNCTION(this);
+
+    OranDataRepository::Deactivate();
+
+    if (m_backend != nullptr)
+    {
+        m_backend->Deactivate();
+    }
+
+    m_nodes.clear();
+    m_registeredIds.clear();
+    m_lteUeIds.clear();
+    m_lteEnbIds.clear();
+    m_lteUeByCellInfo.clear();
+}
+
+bool
+OranDataRepositoryCache::IsNodeRegistered(uint64_t e2NodeId)
+{
+    NS_LOG_FUNCTION(this << e2NodeId);
+
+    return GetRegisteredNode(e2NodeId) != nullptr;
+}
+
+uint64_t
+OranDataRepositoryCache::RegisterNode(OranNearRtRic::NodeType type, uint64_t id)
+{
+    NS_LOG_FUNCTION(this << type << id);
+
+    uint64_t e2NodeId = m_backend->RegisterNode(type, id);
+    if (AddRegisteredNode(e2NodeId, Simulator::Now()) != nullptr)
+    {
+        m_nodeRegisteredTrace(e2NodeId);
+    }
+
+    return e2NodeId;
+}
+
+uint64_t
+OranDataRepositoryCache::RegisterNodeLteUe(uint64_t id, uint64_t imsi)
+{
+    NS_LOG_FUNCTION(this << id << imsi);
+
+    uint64_t e2NodeId = m_backend->RegisterNodeLteUe(id, imsi);
+
+    NodeState* node = AddRegisteredNode(e2NodeId, Simulator::Now());
+    if (node != nullptr)
+    {
+        node->SetLteUe();
+        InsertSorted(m_lteUeIds, e2NodeId);
+
+        m_nodeRegisteredTrace(e2NodeId);
+    }
+
+    return e2NodeId;
+}
+
+uint64_t
+OranDataRepositoryCache::RegisterNodeLteEnb(uint64_t id, uint16_t cellId)
+{
+    NS_LOG_FUNCTION(this << id << cellId);
+
+    uint64_t e2NodeId = m_backend->RegisterNodeLteEnb(id, cellId);
+
+    NodeState* node = AddRegisteredNode(e2NodeId, Simulator::Now());
+    if (node != nullptr)
+    {
+        node->SetLteEnb(cellId);
+        InsertSorted(m_lteEnbIds, e2NodeId);
+
+        m_nodeRegisteredTrace(e2NodeId);
+    }
+
+    return e2NodeId;
+}
+
+uint64_t
+OranDataRepositoryCache::DeregisterNode(uint64_t e2NodeId)
+{
+    NS_LOG_FUNCTION(this << e2NodeId);
+
+    uint64_t retVal = m_backend->DeregisterNode(e2NodeId);
+
+    if (m_active)
+    {
+        auto it = m_nodes.find(e2NodeId);
+        if (it != m_nodes.end())
+        {
+            it->second.SetRegistration(false, Simulator::Now());
+        }
+
+        EraseSorted(m_registeredIds, e2NodeId);
+        EraseSorted(m_lteUeIds, e2NodeId);
+        EraseSorted(m_lteEnbIds, e2NodeId);
+
+        if (retVal != 0)
+        {
+            m_nodeDeregisteredTrace(retVal);
+        }
+    }
+
+    return retVal;
+}
+
+void
+OranDataRepositoryCache::SavePosition(uint64_t e2NodeId, Vector pos, Time t)
+{
+    NS_LOG_FUNCTION(this << e2NodeId << pos << t);
+
+    m_backend->SavePosition(e2NodeId, pos, t);
+
+    NodeState* node = GetRegisteredNode(e2NodeId);
+    if (node != nullptr)
+    {
+        node->UpdatePosition(pos, t);
+    }
+}
+
+void
+OranDataRepositoryCache::SaveLteUeCellInfo(uint64_t e2NodeId,
+                                           uint16_t cellId,
+                                           uint16_t rnti,
+                                           Time t)
+{
+    NS_LOG_FUNCTION(this << e2NodeId << (uint32_t)cellId << (uint32_t)rnti << t);
+
+    m_backend->SaveLteUeCellInfo(e2NodeId, cellId, rnti, t);
+
+    NodeState* node = GetRegisteredNode(e2NodeId);
+    if (node != nullptr)
+    {
+        node->UpdateLteUeCellInfo(cellId, rnti, t);
+
+        m_lteUeByCellInfo[(uint32_t(cellId) << 16) | rnti] = e2NodeId;
+    }
+}
+
+void
+OranDataRepositoryCache::SaveAppLoss(uint64_t e2NodeId, double appLoss, Time t)
+{
+    NS_LOG_FUNCTION(this << e2NodeId << appLoss << t);
+
+    m_backend->SaveAppLoss(e2NodeId, appLoss, t);
+
+    NodeState* node = GetRegisteredNode(e2NodeId);
+    if (node != nullptr)
+    {
+        node->UpdateAppLoss(appLoss);
+    }
+}
+
+void
+OranDataRepositoryCache::SaveLteUeRsrpRsrq(uint64_t e2NodeId,
+                                           Time t,
+                                           uint16_t rnti,
+                                           uint16_t cellId,
+                                           double rsrp,
+                                           double rsrq,
+                                           bool isServingCell,
+                                           uint8_t componentCarrierId)
+{
+    NS_LOG_FUNCTION(this << e2NodeId << t << +rnti << +cellId << rsrp << rsrq << isServingCell
+                         << +componentCarrierId);
+
+    m_backend->SaveLteUeRsrpRsrq(e2NodeId,
+                                 t,
+                                 rnti,
+                                 cellId,
+                                 rsrp,
+                                 rsrq,
+                                 isServingCell,
+                                 componentCarrierId);
+
+    NodeState* node = GetRegisteredNode(e2NodeId);
+    if (node != nullptr)
+    {
+        node->UpdateLteUeRsrpRsrq(t, rnti, cellId, rsrp, rsrq, isServingCell, componentCarrierId);
+    }
+}
+
+std::map<Time, Vector>
+OranDataRepositoryCache::GetNodePositions(uint64_t e2NodeId,
+                                          Time fromTime,
+                                          Time toTime,
+                                          uint64_t maxEntries)
+{
+    NS_LOG_FUNCTION(this << e2NodeId << fromTime << toTime << maxEntries);
+
+    std::map<Time, Vector> nodePositions;
+
+    NodeState* node = GetRegisteredNode(e2NodeId);
+    if (node != nullptr)
+    {
+        // The latest position answers the queries for the newest position in
+        // an interval that includes it; the rest need the history
+        if (maxEntries == 1 && node->hasPosition && node->positionTime >= fromTime &&
+            node->positionTime <= toTime)
+        {
+            nodePositions[node->positionTime] = node->position;
+        }
+        else if (node->hasPosition && maxEntries > 0 && fromTime <= toTime)
+        {
+            nodePositions = m_backend->GetNodePositions(e2NodeId, fromTime, toTime, maxEntries);
+        }
+    }
+    return nodePositions;
+}
+
+std::tuple<bool, uint16_t, uint16_t>
+OranDataRepositoryCache::GetLteUeCellInfo(uint64_t e2NodeId)
+{
+    NS_LOG_FUNCTION(this << e2NodeId);
+
+    auto retVal = std::make_tuple(false, 0, 0);
+
+    NodeState* node = GetRegisteredNode(e2NodeId);
+    if (node != nullptr && node->hasCellInfo)
+    {
+        retVal = std::make_tuple(true, node->cellInfoCellId, node->cellInfoRnti);
+    }
+    return retVal;
+}
+
+std::vector<uint64_t>
+OranDataRepositoryCache::GetLteUeE2NodeIds()
+{
+    NS_LOG_FUNCTION(this);
+
+    std::vector<uint64_t> e2NodeIds;
+
+    if (m_active)
+    {
+        e2NodeIds = m_lteUeIds;
+    }
+    return e2NodeIds;
+}
+
+uint64_t
+OranDataRepositoryCache::GetLteUeE2NodeIdFromCellInfo(uint16_t cellId, uint16_t rnti)
+{
+    NS_LOG_FUNCTION(this << cellId << rnti);
+
+    uint64_t id = 0;
+    if (m_active)
+    {
+        uint32_t key = (uint32_t(cellId) << 16) | rnti;
+        auto it = m_lteUeByCellInfo.find(key);
+        if (it != m_lteUeByCellInfo.end())
+        {
+            id = it->second;
+        }
+        else
+        {
+            // The pair may have been reported before the cache was activated
+            id = m_backend->GetLteUeE2NodeIdFromCellInfo(cellId, rnti);
+            if (id != 0)
+            {
+                m_lteUeByCellInfo[key] = id;
+            }
+        }
+    }
+    return id;
+}
+
+std::tuple<bool, uint16_t>
+OranDataRepositoryCache::GetLteEnbCellInfo(uint64_t e2NodeId)
+{
+    NS_LOG_FUNCTION(this << e2NodeId);
+
+    auto retVal = std::make_tuple(false, 0);
+
+    NodeState* node = GetRegisteredNode(e2NodeId);
+    if (node != nullptr && node->isLteEnb)
+    {
+        retVal = std::make_tuple(true, node->cellId);
+    }
+    return retVal;
+}
+
+std::vector<uint64_t>
+OranDataRepositoryCache::GetLteEnbE2NodeIds()
+{
+    NS_LOG_FUNCTION(this);
+
+    std::vector<uint64_t> e2NodeIds;
+
+    if (m_active)
+    {
+        e2NodeIds = m_lteEnbIds;
+    }
+    return e2NodeIds;
+}
+
+std::vector<std::tuple<uint64_t, Time>>
+OranDataRepositoryCache::GetLastRegistrationRequests()
+{
+    NS_LOG_FUNCTION(this);
+
+    std::vector<std::tuple<uint64_t, Time>> requests;
+
+    if (m_active)
+    {
+        requests.reserve(m_registeredIds.size());
+        for (auto e2NodeId : m_registeredIds)
+        {
+            requests.emplace_back(e2NodeId, m_nodes[e2NodeId].lastRequestTime);
+        }
+    }
+    return requests;
+}
+
+double
+OranDataRepositoryCache::GetAppLoss(uint64_t e2NodeId)
+{
+    NS_LOG_FUNCTION(this << e2NodeId);
+
+    double loss = 0;
+
+    NodeState* node = GetRegisteredNode(e2NodeId);
+    if (node != nullptr)
+    {
+        loss = node->appLoss;
+    }
+    return loss;
+}
+
+std::vector<std::tuple<uint16_t, uint16_t, double, double, bool, uint8_t>>
+OranDataRepositoryCache::GetLteUeRsrpRsrq(uint64_t e2NodeId)
+{
+    NS_LOG_FUNCTION(this << e2NodeId);
+
+    std::vector<std::tuple<uint16_t, uint16_t, double, double, bool, uint8_t>> retVal;
+
+    NodeState* node = GetRegisteredNode(e2NodeId);
+    if (node != nullptr)
+    {
+        retVal = node->rsrpRsrq;
+    }
+    return retVal;
+}
+
+OranDataRepository::LteUeSnapshot
+OranDataRepositoryCache::GetLteUeSnapshot()
+{
+    NS_LOG_FUNCTION(this);
+
+    LteUeSnapshot snapshot;
+
+    if (m_active)
+    {
+        for (auto e2NodeId : m_lteUeIds)
+        {
+            const NodeState& node = m_nodes[e2NodeId];
+            if (node.hasCellInfo && node.hasPosition)
+            {
+                snapshot.e2NodeIds.push_back(e2NodeId);
+                snapshot.cellIds.push_back(node.cellInfoCellId);
+                snapshot.rntis.push_back(node.cellInfoRnti);
+                snapshot.positions.push_back(node.position);
+                snapshot.appLosses.push_back(node.appLoss);
+            }
+        }
+    }
+    return snapshot;
+}
+
+OranDataRepository::LteEnbSnapshot
+OranDataRepositoryCache::GetLteEnbSnapshot()
+{
+    NS_LOG_FUNCTION(this);
+
+    LteEnbSnapshot snapshot;
+
+    if (m_active)
+    {
+        for (auto e2NodeId : m_lteEnbIds)
+        {
+            const NodeState& node = m_nodes[e2NodeId];
+            if (node.hasPosition)
+            {
+                snapshot.e2NodeIds.push_back(e2NodeId);
+                snapshot.cellIds.push_back(node.cellId);
+                snapshot.positions.push_back(node.position);
+            }
+        }
+    }
+    return snapshot;
+}
+
+std::tuple<bool, Time, Vector>
+OranDataRepositoryCache::GetLatestNodePosition(uint64_t e2NodeId)
+{
+    NS_LOG_FUNCTION(this << e2NodeId);
+
+    auto retVal = std::make_tuple(false, Time(), Vector());
+
+    NodeState* node = GetRegisteredNode(e2NodeId);
+    if (node != nullptr && node->hasPosition)
+    {
+        retVal = std::make_tuple(true, node->positionTime, node->position);
+    }
+    return retVal;
+}
+
+void
+OranDataRepositoryCache::ForEachNodePosition(uint64_t e2NodeId,
+                                             Time fromTime,
+                                             Time toTime,
+                                             uint64_t maxEntries,
+                                             const NodePositionVisitor& visitor)
+{
+    NS_LOG_FUNCTION(this << e2NodeId << fromTime << toTime << maxEntries);
+
+    NodeState* node = GetRegisteredNode(e2NodeId);
+    if (node != nullptr && node->hasPosition)
+    {
+        if (maxEntries == 1 && node->positionTime >= fromTime && node->positionTime <= toTime)
+        {
+            visitor(node->positionTime, node->position);
+        }
+        else if (maxEntries > 0 && fromTime <= toTime)
+        {
+            m_backend->ForEachNodePosition(e2NodeId, fromTime, toTime, maxEntries, visitor);
+        }
+    }
+}
+
+void
+OranDataRepositoryCache::ForEachLteUeRsrpRsrq(uint64_t e2NodeId,
+                                              const LteUeRsrpRsrqVisitor& visitor)
+{
+    NS_LOG_FUNCTION(this << e2NodeId);
+
+    NodeState* node = GetRegisteredNode(e2NodeId);
+    if (node != nullptr)
+    {
+        for (const auto& measurement : node->rsrpRsrq)
+        {
+            std::apply(visitor, measurement);
+        }
+    }
+}
+
+void
+OranDataRepositoryCache::LogCommandE2Terminator(Ptr<OranCommand> cmd)
+{
+    NS_LOG_FUNCTION(this);
+
+    m_backend->LogCommandE2Terminator(cmd);
+}
+
+void
+OranDataRepositoryCache::LogCommandLm(std::string lm, Ptr<OranCommand> cmd)
+{
+    NS_LOG_FUNCTION(this);
+
+    m_backend->LogCommandLm(lm, cmd);
+}
+
+void
+OranDataRepositoryCache::LogActionLm(std::string lm, std::string logStr)
+{
+    NS_LOG_FUNCTION(this << lm << logStr);
+
+    m_backend->LogActionLm(lm, logStr);
+}
+
+void
+OranDataRepositoryCache::LogActionCmm(std::string cmm, std::string logStr)
+{
+    NS_LOG_FUNCTION(this << cmm << logStr);
+
+    m_backend->LogActionCmm(cmm, logStr);
+}
+
+void
+OranDataRepositoryCache::LogEventLm(const std::string& lm,
+                                    LogEvent event,
+                                    double arg0,
+                                    double arg1,
+                                    double arg2,
+                                    double arg3)
+{
+    NS_LOG_FUNCTION(this << lm << event << arg0 << arg1 << arg2 << arg3);
+
+    m_backend->LogEventLm(lm, event, arg0, arg1, arg2, arg3);
+}
+
+void
+OranDataRepositoryCache::LogEventCmm(const std::string& cmm,
+                                     LogEvent event,
+                                     double arg0,
+                                     double arg1,
+                                     double arg2,
+                                     double arg3)
+{
+    NS_LOG_FUNCTION(this << cmm << event << arg0 << arg1 << arg2 << arg3);
+
+    m_backend->LogEventCmm(cmm, event, arg0, arg1, arg2, arg3);
+}
+
+void
+OranDataRepositoryCache::DoDispose()
+{
+    NS_LOG_FUNCTION(this);
+
+    if (m_backend != nullptr)
+    {
+        m_backend->Dispose();
+        m_backend = nullptr;
+    }
+
+    m_nodes.clear();
+    m_registeredIds.clear();
+    m_lteUeIds.clear();
+    m_lteEnbIds.clear();
+    m_lteUeByCellInfo.clear();
+
+    OranDataRepository::DoDispose();
+}
+
+OranDataRepositoryCache::NodeState*
+OranDataRepositoryCache::GetRegisteredNode(uint64_t e2NodeId)
+{
+    NS_LOG_FUNCTION(this << e2NodeId);
+
+    NodeState* node = nullptr;
+    if (m_active)
+    {
+        auto it = m_nodes.find(e2NodeId);
+        if (it != m_nodes.end() && it->second.registered)
+        {
+            node = &it->second;
+        }
+    }
+    return node;
+}
+
+OranDataRepositoryCache::NodeState*
+OranDataRepositoryCache::AddRegisteredNode(uint64_t e2NodeId, Time t)
+{
+    NS_LOG_FUNCTION(this << e2NodeId << t);
+
+    NodeState* node = nullptr;
+    if (m_active && e2NodeId != 0)
+    {
+        node = &m_nodes[e2NodeId];
+        node->SetRegistration(true, t);
+
+        // A node registered again keeps its type
+        InsertSorted(m_registeredIds, e2NodeId);
+        if (node->isLteUe)
+        {
+            InsertSorted(m_lteUeIds, e2NodeId);
+        }
+        if (node->isLteEnb)
+        {
+            InsertSorted(m_lteEnbIds, e2NodeId);
+        }
+    }
+    return node;
+}
+
+void
+OranDataRepositoryCache::LoadFromBackend()
+{
+    NS_LOG_FUNCTION(this);
+
+    m_nodes.clear();
+    m_registeredIds.clear();
+    m_lteUeIds.clear();
+    m_lteEnbIds.clear();
+    m_lteUeByCellInfo.clear();
+
+    // The times of the cell information and the measurements are not
+    // available, so the loaded values are replaced by any report received
+    // afterwards
+    for (const auto& request : m_backend->GetLastRegistrationRequests())
+    {
+        uint64_t e2NodeId = std::get<0>(request);
+        NodeState& node = m_nodes[e2NodeId];
+        node.SetRegistration(true, std::get<1>(request));
+        InsertSorted(m_registeredIds, e2NodeId);
+
+        std::map<Time, Vector> positions =
+            m_backend->GetNodePositions(e2NodeId, Time::Min(), Time::Max(), 1);
+        if (!positions.empty())
+        {
+            node.UpdatePosition(positions.rbegin()->second, positions.rbegin()->first);
+        }
+    }
+
+    for (auto e2NodeId : m_backend->GetLteUeE2NodeIds())
+    {
+        NodeState& node = m_nodes[e2NodeId];
+        node.SetLteUe();
+        InsertSorted(m_lteUeIds, e2NodeId);
+
+        auto cellInfo = m_backend->GetLteUeCellInfo(e2NodeId);
+        if (std::get<0>(cellInfo))
+        {
+            node.UpdateLteUeCellInfo(std::get<1>(cellInfo), std::get<2>(cellInfo), Time::Min());
+        }
+        node.UpdateAppLoss(m_backend->GetAppLoss(e2NodeId));
+        node.rsrpRsrqTime = Time::Min();
+        node.rsrpRsrq = m_backend->GetLteUeRsrpRsrq(e2NodeId);
+    }
+
+    for (auto e2NodeId : m_backend->GetLteEnbE2NodeIds())
+    {
+        m_nodes[e2NodeId].SetLteEnb(std::get<1>(m_backend->GetLteEnbCellInfo(e2NodeId)));
+        InsertSorted(m_lteEnbIds, e2NodeId);
+    }
+}
+
+void
+OranDataRepositoryCache::InsertSorted(std::vector<uint64_t>& ids, uint64_t e2NodeId)
+{
+    NS_LOG_FUNCTION(e2NodeId);
+
+    // Nodes are usually registered in increasing order of E2 Node ID
+    if (ids.empty() || ids.back() < e2NodeId)
+    {
+        ids.push_back(e2NodeId);
+        return;
+    }
+
+    auto it = std::lower_bound(ids.begin(), ids.end(), e2NodeId);
+    if (*it != e2NodeId)
+    {
+        ids.insert(it, e2NodeId);
+    }
+}
+
+void
+OranDataRepositoryCache::EraseSorted(std::vector<uint64_t>& ids, uint64_t e2NodeId)
+{
+    NS_LOG_FUNCTION(e2NodeId);
+
+    auto it = std::lower_bound(ids.begin(), ids.end(), e2NodeId);
+    if (it != ids.end() && *it == e2NodeId)
+    {
+        ids.erase(it);
+    }
+}
+
+} // namespace ns3
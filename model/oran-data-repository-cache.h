@@ -0,0 +1,226 @@
+/**
+ * NIST-developed software is provided by NIST as a public service. You may
+ * use, copy and distribute copies of the software in any medium, provided that
+ * you keep intact this entire notice. You may improve, modify and create
+ * derivative works of the software or any portion of the software, and you may
+ * copy and distribute such modifications or works. Modified works should carry
+ * a notice stating that you changed the software and should note the date and
+ * nature of any such change. Please explicitly acknowledge the National
+ * Institute of Standards and Technology as the source of the software.
+ *
+ * NIST-developed software is expressly provided "AS IS." NIST MAKES NO
+ * WARRANTY OF ANY KIND, EXPRESS, IMPLIED, IN FACT OR ARISING BY OPERATION OF
+ * LAW, INCLUDING, WITHOUT LIMITATION, THE IMPLIED WARRANTY OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE, NON-INFRINGEMENT AND DATA ACCURACY. NIST
+ * NEITHER REPRESENTS NOR WARRANTS THAT THE OPERATION OF THE SOFTWARE WILL BE
+ * UNINTERRUPTED OR ERROR-FREE, OR THAT ANY DEFECTS WILL BE CORRECTED. NIST
+ * DOES NOT WARRANT OR MAKE ANY REPRESENTATIONS REGARDING THE USE OF THE
+ * SOFTWARE OR THE RESULTS THEREOF, INCLUDING BUT NOT LIMITED TO THE
+ * CORRECTNESS, ACCURACY, RELIABILITY, OR USEFULNESS OF THE SOFTWARE.
+ *
+ * You are solely responsible for determining the appropriateness of using and
+ * distributing the software and you assume all risks associated with its use,
+ * including but not limited to the risks and costs of program errors,
+ * compliance with applicable laws, damage to or loss of data, programs or
+ * equipment, and the unavailability or interruption of operation. This
+ * software is not intended to be used in any situation where a failure could
+ * cause risk of injury or damage to property. The software developed by NIST
+ * employees is not subject to copyright protection within the United States.
+ */
+
+#ifndef ORAN_DATA_REPOSITORY_CACHE_H
+#define ORAN_DATA_REPOSITORY_CACHE_H
+
+#include "oran-data-repository-node-state.h"
+#include "oran-data-repository.h"
+
+#include <map>
+#include <string>
+#include <tuple>
+#include <unordered_map>
+#include <vector>
+
+namespace ns3
+{
+
+/**
+ * @ingroup oran
+ *
+ * A Data Repository that wraps another Data Repository (the "Backend") and
+ * keeps the latest state of each E2 Node in memory.
+ *
+ * Every call of the Data Storage and Logging APIs is forwarded to the
+ * backend, and the registrations and latest reports are also recorded in
+ * hash maps. The queries of the Data Access API that only need the latest
+ * state (registrations, cell information, application loss, RSRP and RSRQ
+ * measurements, the latest position, and the snapshots) are answered from
+ * those maps without querying the backend; the rest, such as the history of
+ * positions, are forwarded to it.
+ *
+ * The state already stored in the backend is loaded when the cache is
+ * activated. The retention policies of the history must be set on the
+ * backend.
+ */
+class OranDataRepositoryCache : public OranDataRepository
+{
+  public:
+    /**
+     * Gets the TypeId of the OranDataRepositoryCache class.
+     *
+     * @return The TypeId.
+     */
+    static TypeId GetTypeId();
+    /**
+     * Creates an instance of the OranDataRepositoryCache class.
+     */
+    OranDataRepositoryCache();
+    /**
+     * The destructor of the OranDataRepositoryCache class.
+     */
+    ~OranDataRepositoryCache() override;
+    /**
+     * Activate the backend and the cache, and load the latest state of the
+     * nodes from the backend.
+     */
+    void Activate() override;
+    /**
+     * Deactivate the cache and the backend, and clear the cached state.
+     */
+    void Deactivate() override;
+
+    /* Data Storage API */
+    bool IsNodeRegistered(uint64_t e2NodeId) override;
+
+    uint64_t RegisterNode(OranNearRtRic::NodeType type, uint64_t id) override;
+    uint64_t RegisterNodeLteUe(uint64_t id, uint64_t imsi) override;
+    uint64_t RegisterNodeLteEnb(uint64_t id, uint16_t cellId) override;
+    uint64_t DeregisterNode(uint64_t e2NodeId) override;
+    void SavePosition(uint64_t e2NodeId, Vector pos, Time t) override;
+    void SaveLteUeCellInfo(uint64_t e2NodeId, uint16_t cellId, uint16_t rnti, Time t) override;
+    void SaveAppLoss(uint64_t e2NodeId, double appLoss, Time t) override;
+    void SaveLteUeRsrpRsrq(uint64_t e2NodeId,
+                           Time t,
+                           uint16_t rnti,
+                           uint16_t cellId,
+                           double rsrp,
+                           double rsrq,
+                           bool isServingCell,
+                           uint8_t componentCarrierId) override;
+
+    std::map<Time, Vector> GetNodePositions(uint64_t e2NodeId,
+                                            Time fromTime,
+                                            Time toTime,
+                                            uint64_t maxEntries = 1) override;
+    std::tuple<bool, uint16_t, uint16_t> GetLteUeCellInfo(uint64_t e2NodeId) override;
+    std::vector<uint64_t> GetLteUeE2NodeIds() override;
+    uint64_t GetLteUeE2NodeIdFromCellInfo(uint16_t cellId, uint16_t rnti) override;
+    std::tuple<bool, uint16_t> GetLteEnbCellInfo(uint64_t e2NodeId) override;
+    std::vector<uint64_t> GetLteEnbE2NodeIds() override;
+    std::vector<std::tuple<uint64_t, Time>> GetLastRegistrationRequests() override;
+    double GetAppLoss(uint64_t e2NodeId) override;
+    std::vector<std::tuple<uint16_t, uint16_t, double, double, bool, uint8_t>> GetLteUeRsrpRsrq(
+        uint64_t e2NodeId) override;
+    LteUeSnapshot GetLteUeSnapshot() override;
+    LteEnbSnapshot GetLteEnbSnapshot() override;
+    std::tuple<bool, Time, Vector> GetLatestNodePosition(uint64_t e2NodeId) override;
+    void ForEachNodePosition(uint64_t e2NodeId,
+                             Time fromTime,
+                             Time toTime,
+                             uint64_t maxEntries,
+                             const NodePositionVisitor& visitor) override;
+    void ForEachLteUeRsrpRsrq(uint64_t e2NodeId, const LteUeRsrpRsrqVisitor& visitor) override;
+
+    void LogCommandE2Terminator(Ptr<OranCommand> cmd) override;
+    void LogCommandLm(std::string lm, Ptr<OranCommand> cmd) override;
+    void LogActionLm(std::string lm, std::string logstr) override;
+    void LogActionCmm(std::string cmm, std::string logstr) override;
+    void LogEventLm(const std::string& lm,
+                    LogEvent event,
+                    double arg0,
+                    double arg1,
+                    double arg2,
+                    double arg3) override;
+    void LogEventCmm(const std::string& cmm,
+                     LogEvent event,
+                     double arg0,
+                     double arg1,
+                     double arg2,
+                     double arg3) override;
+
+  protected:
+    void DoDispose() override;
+
+    /**
+     * The latest state of an E2 Node.
+     */
+    typedef OranDataRepositoryNodeState NodeState;
+
+    /**
+     * Get the state of a registered E2 Node.
+     *
+     * @param e2NodeId The E2 Node ID.
+     *
+     * @return A pointer to the state of the node, or nullptr if the node is not registered.
+     */
+    NodeState* GetRegisteredNode(uint64_t e2NodeId);
+    /**
+     * Record the registration of a node.
+     *
+     * @param e2NodeId The E2 Node ID assigned by the backend, or zero if the
+     *                 registration was not stored.
+     * @param t The time of the registration request.
+     *
+     * @return The state of the node, or nullptr if the registration was not stored.
+     */
+    NodeState* AddRegisteredNode(uint64_t e2NodeId, Time t);
+    /**
+     * Load the latest state of the registered nodes from the backend.
+     */
+    void LoadFromBackend();
+
+  private:
+    /**
+     * Insert an E2 Node ID in a sorted list, if it is not in it.
+     *
+     * @param ids The sorted list.
+     * @param e2NodeId The E2 Node ID.
+     */
+    static void InsertSorted(std::vector<uint64_t>& ids, uint64_t e2NodeId);
+    /**
+     * Remove an E2 Node ID from a sorted list, if it is in it.
+     *
+     * @param ids The sorted list.
+     * @param e2NodeId The E2 Node ID.
+     */
+    static void EraseSorted(std::vector<uint64_t>& ids, uint64_t e2NodeId);
+
+    /**
+     * The Data Repository that stores the data.
+     */
+    Ptr<OranDataRepository> m_backend;
+    /**
+     * The latest state of the E2 Nodes, indexed by E2 Node ID.
+     */
+    std::unordered_map<uint64_t, NodeState> m_nodes;
+    /**
+     * The E2 Node IDs of the registered nodes, sorted.
+     */
+    std::vector<uint64_t> m_registeredIds;
+    /**
+     * The E2 Node IDs of the registered LTE UEs, sorted.
+     */
+    std::vector<uint64_t> m_lteUeIds;
+    /**
+     * The E2 Node IDs of the registered LTE eNBs, sorted.
+     */
+    std::vector<uint64_t> m_lteEnbIds;
+    /**
+     * The E2 Node ID of the LTE UE that last reported each cell ID and RNTI
+     * pair, with the cell ID in the upper bits.
+     */
+    std::unordered_map<uint32_t, uint64_t> m_lteUeByCellInfo;
+}; // class OranDataRepositoryCache
+
+} // namespace ns3
+
+#endif /* ORAN_DATA_REPOSITORY_CACHE_H */
@@ -0,0 +1,928 @@
+/**
+ * NIST-developed software is provided by NIST as a public service. You may
+ * use, copy and distribute copies of the software in any medium, provided that
+ * you keep intact this entire notice. You may improve, modify and create
+ * derivative works of the software or any portion of the software, and you may
+ * copy and distribute such modifications or works. Modified works should carry
+ * a notice stating that you changed the software and should note the date and
+ * nature of any such change. Please explicitly acknowledge the National
+ * Institute of Standards and Technology as the source of the software.
+ *
+ * NIST-developed software is expressly provided "AS IS." NIST MAKES NO
+ * WARRANTY OF ANY KIND, EXPRESS, IMPLIED, IN FACT OR ARISING BY OPERATION OF
+ * LAW, INCLUDING, WITHOUT LIMITATION, THE IMPLIED WARRANTY OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE, NON-INFRINGEMENT AND DATA ACCURACY. NIST
+ * NEITHER REPRESENTS NOR WARRANTS THAT THE OPERATION OF THE SOFTWARE WILL BE
+ * UNINTERRUPTED OR ERROR-FREE, OR THAT ANY DEFECTS WILL BE CORRECTED. NIST
+ * DOES NOT WARRANT OR MAKE ANY REPRESENTATIONS REGARDING THE USE OF THE
+ * SOFTWARE OR THE RESULTS THEREOF, INCLUDING BUT NOT LIMITED TO THE
+ * CORRECTNESS, ACCURACY, RELIABILITY, OR USEFULNESS OF THE SOFTWARE.
+ *
+ * You are solely responsible for determining the appropriateness of using and
+ * distributing the software and you assume all risks associated with its use,
+ * including but not limited to the risks and costs of program errors,
+ * compliance with applicable laws, damage to or loss of data, programs or
+ * equipment, and the unavailability or interruption of operation. This
+ * software is not intended to be used in any situation where a failure could
+ * cause risk of injury or damage to property. The software developed by NIST
+ * employees is not subject to copyright protection within the United States.
+ */
+
+#include "oran-data-repository-memory.h"
+
+#include "oran-data-repository-sqlite.h"
+
+#include "ns3/abort.h"
+#include "ns3/boolean.h"
+#include "ns3/log.h"
+#include "ns3/simulator.h"
+#include "ns3/string.h"
+#include "ns3/uinteger.h"
+
+#include <algorithm>
+#include <cstdio>
+
+namespace ns3
+{
+
+NS_LOG_COMPONENT_DEFINE("OranDataRepositoryMemory");
+
+NS_OBJECT_ENSURE_REGISTERED(OranDataRepositoryMemory);
+
+TypeId
+OranDataRepositoryMemory::GetTypeId()
+{
+    static TypeId tid =
+        TypeId("ns3::OranDataRepositoryMemory")
+            .SetParent<OranDataRepository>()
+            .AddConstructor<OranDataRepositoryMemory>()
+            .AddAttribute("MaxEntriesPerNode",
+                          "The maximum number of entries of each type of report that are kept "
+                          "for each node. When reached, the oldest entry is overwritten.",
+                          UintegerValue(1000),
+                          MakeUintegerAccessor(&OranDataRepositoryMemory::m_maxEntriesPerNode),
+                          MakeUintegerChecker<uint32_t>(1))
+            .AddAttribute("DumpFile",
+                          "The path of the SQLite database to write the stored data to when the "
+                          "repository is deactivated. Empty to disable.",
+                          StringValue(""),
+                          MakeStringAccessor(&OranDataRepositoryMemory::m_dumpPath),
+                          MakeStringChecker());
+
+    return tid;
+}
+
+OranDataRepositoryMemory::OranDataRepositoryMemory()
+    : OranDataRepository(),
+      m_dumpPending(false),
+      m_nextE2NodeId(1)
+{
+    NS_LOG_FUNCTION(this);
+}
+
+OranDataRepositoryMemory::~OranDataRepositoryMemory()
+{
+    NS_LOG_FUNCTION(this);
+}
+
+void
+OranDataRepositoryMemory::Activate()
+{
+    NS_LOG_FUNCTION(this);
+
+    OranDataRepository::Activate();
+
+    m_dumpPending = true;
+}
+
+void
+OranDataRepositoryMemory::Deactivate()
+{
+    NS_LOG_FUNCTION(this);
+
+    if (m_dumpPending && IsLogging())
+    {
+        Dump(m_dumpPath);
+    }
+    m_dumpPending = false;
+
+    OranDataRepository::Deactivate();
+}
+
+bool
+OranDataRepositoryMemory::IsNodeRegistered(uint64_t e2NodeId)
+{
+    NS_LOG_FUNCTION(this << e2NodeId);
+
+    return GetRegisteredNode(e2NodeId) != nullptr;
+}
+
+uint64_t
+OranDataRepositoryMemory::RegisterNode(OranNearRtRic::NodeType type, uint64_t id)
+{
+    NS_LOG_FUNCTION(this << type << id);
+
+    uint64_t e2NodeId = 0;
+
+    if (m_active)
+    {
+        e2NodeId = (id == 0 ? m_nextE2NodeId : id);
+        m_nextE2NodeId = std::max(m_nextE2NodeId, e2NodeId + 1);
+
+        NodeData& node = m_nodes[e2NodeId];
+        node.type = type;
+        node.SetRegistration(true, Simulator::Now());
+
+        if (IsLogging())
+        {
+            m_registrations.emplace_back(e2NodeId, true, Simulator::Now());
+        }
+
+        m_nodeRegisteredTrace(e2NodeId);
+    }
+
+    return e2NodeId;
+}
+
+uint64_t
+OranDataRepositoryMemory::RegisterNodeLteUe(uint64_t id, uint64_t imsi)
+{
+    NS_LOG_FUNCTION(this << id << imsi);
+
+    uint64_t e2NodeId = 0;
+
+    if (m_active)
+    {
+        e2NodeId = RegisterNode(OranNearRtRic::NodeType::LTEUE, id);
+
+        NodeData& node = m_nodes[e2NodeId];
+        node.SetLteUe();
+        node.imsi = imsi;
+    }
+    return e2NodeId;
+}
+
+uint64_t
+OranDataRepositoryMemory::RegisterNodeLteEnb(uint64_t id, uint16_t cellId)
+{
+    NS_LOG_FUNCTION(this << id << cellId);
+
+    uint64_t e2NodeId = 0;
+
+    if (m_active)
+    {
+        e2NodeId = RegisterNode(OranNearRtRic::NodeType::LTEENB, id);
+
+        m_nodes[e2NodeId].SetLteEnb(cellId);
+    }
+    return e2NodeId;
+}
+
+uint64_t
+OranDataRepositoryMemory::DeregisterNode(uint64_t e2NodeId)
+{
+    NS_LOG_FUNCTION(this << e2NodeId);
+
+    uint64_t retVal = 0;
+    if (m_active)
+    {
+        retVal = e2NodeId;
+
+        auto it = m_nodes.find(e2NodeId);
+        if (it != m_nodes.end())
+        {
+            it->second.SetRegistration(false, Simulator::Now());
+        }
+
+        if (IsLogging())
+        {
+            m_registrations.emplace_back(e2NodeId, false, Simulator::Now());
+        }
+
+        m_nodeDeregisteredTrace(e2NodeId);
+    }
+    return retVal;
+}
+
+void
+OranDataRepositoryMemory::SavePosition(uint64_t e2NodeId, Vector pos, Time t)
+{
+    NS_LOG_FUNCTION(this << e2NodeId << pos << t);
+
+    NodeData* node = GetRegisteredNode(e2NodeId);
+    if (node != nullptr)
+    {
+        auto& positions = node->positions;
+        if (positions.Size() > 0 &&
+            t.GetTimeStep() < positions.Get<0>(positions.Size() - 1))
+        {
+            node->positionsSorted = false;
+        }
+        positions.Push(m_maxEntriesPerNode, t.GetTimeStep(), pos.x, pos.y, pos.z);
+
+        node->UpdatePosition(pos, t);
+    }
+}
+
+void
+OranDataRepositoryMemory::SaveLteUeCellInfo(uint64_t e2NodeId,
+                                            uint16_t cellId,
+                                            uint16_t rnti,
+                                            Time t)
+{
+    NS_LOG_FUNCTION(this << e2NodeId << (uint32_t)cellId << (uint32_t)rnti << t);
+
+    NodeData* node = GetRegisteredNode(e2NodeId);
+    if (node != nullptr)
+    {
+        node->cellInfos.Push(m_maxEntriesPerNode, t.GetTimeStep(), cellId, rnti);
+
+        node->UpdateLteUeCellInfo(cellId, rnti, t);
+
+        m_lteUeByCellInfo[std::make_tuple(cellId, rnti)] = e2NodeId;
+    }
+}
+
+void
+OranDataRepositoryMemory::SaveAppLoss(uint64_t e2NodeId, double appLoss, Time t)
+{
+    NS_LOG_FUNCTION(this << e2NodeId << appLoss << t);
+
+    NodeData* node = GetRegisteredNode(e2NodeId);
+    if (node != nullptr)
+    {
+        node->appLosses.Push(m_maxEntriesPerNode, t.GetTimeStep(), appLoss);
+        node->UpdateAppLoss(appLoss);
+    }
+}
+
+void
+OranDataRepositoryMemory::SaveLteUeRsrpRsrq(uint64_t e2NodeId,
+                                            Time t,
+                                            uint16_t rnti,
+                                            uint16_t cellId,
+                                            double rsrp,
+                                            double rsrq,
+                                            bool isServingCell,
+                                            uint8_t componentCarrierId)
+{
+    NS_LOG_FUNCTION(this << e2NodeId << t << +rnti << +cellId << rsrp << rsrq << isServingCell
+                         << +componentCarrierId);
+
+    NodeData* node = GetRegisteredNode(e2NodeId);
+    if (node != nullptr)
+    {
+        node->rsrpRsrqs.Push(m_maxEntriesPerNode,
+                             t.GetTimeStep(),
+                             rnti,
+                             cellId,
+                             rsrp,
+                             rsrq,
+                             isServingCell,
+                             componentCarrierId);
+        node->UpdateLteUeRsrpRsrq(t, rnti, cellId, rsrp, rsrq, isServingCell, componentCarrierId);
+    }
+}
+
+std::map<Time, Vector>
+OranDataRepositoryMemory::GetNodePositions(uint64_t e2NodeId,
+                                           Time fromTime,
+                                           Time toTime,
+                                           uint64_t maxEntries)
+{
+    NS_LOG_FUNCTION(this << e2NodeId << fromTime << toTime << maxEntries);
+
+    std::map<Time, Vector> nodePositions;
+
+    NodeData* node = GetRegisteredNode(e2NodeId);
+    if (node != nullptr)
+    {
+        const auto& positions = node->positions;
+
+        // Collect the matching entries from the newest to the oldest one. If
+        // the positions were reported in order, the search can stop as soon as
+        // enough entries are found or the entries are older than the interval.
+        std::vector<std::size_t> matches;
+        for (std::size_t i = positions.Size(); i > 0; i--)
+        {
+            int64_t t = positions.Get<0>(i - 1);
+            if (node->positionsSorted &&
+                (t < fromTime.GetTimeStep() || matches.size() >= maxEntries))
+            {
+                break;
+            }
+            if (t >= fromTime.GetTimeStep() && t <= toTime.GetTimeStep())
+            {
+                matches.push_back(i - 1);
+            }
+        }
+
+        if (!node->positionsSorted)
+        {
+            std::stable_sort(matches.begin(),
+                             matches.end(),
+                             [&positions](std::size_t a, std::size_t b) {
+                                 return positions.Get<0>(a) > positions.Get<0>(b);
+                             });
+        }
+
+        if (matches.size() > maxEntries)
+        {
+            matches.resize(maxEntries);
+        }
+
+        for (auto i : matches)
+        {
+            nodePositions[Time(positions.Get<0>(i))] =
+                Vector(positions.Get<1>(i), positions.Get<2>(i), positions.Get<3>(i));
+        }
+    }
+    return nodePositions;
+}
+
+std::tuple<bool, uint16_t, uint16_t>
+OranDataRepositoryMemory::GetLteUeCellInfo(uint64_t e2NodeId)
+{
+    NS_LOG_FUNCTION(this << e2NodeId);
+
+    auto retVal = std::make_tuple(false, 0, 0);
+
+    NodeData* node = GetRegisteredNode(e2NodeId);
+    if (node != nullptr && node->hasCellInfo)
+    {
+        retVal = std::make_tuple(true, node->cellInfoCellId, node->cellInfoRnti);
+    }
+    return retVal;
+}
+
+std::vector<uint64_t>
+OranDataRepositoryMemory::GetLteUeE2NodeIds()
+{
+    NS_LOG_FUNCTION(this);
+
+    std::vector<uint64_t> e2NodeIds;
+
+    if (m_active)
+    {
+        for (const auto& entry : m_nodes)
+        {
+            if (entry.second.registered && entry.second.isLteUe)
+            {
+                e2NodeIds.push_back(entry.first);
+            }
+        }
+    }
+    return e2NodeIds;
+}
+
+uint64_t
+OranDataRepositoryMemory::GetLteUeE2NodeIdFromCellInfo(uint16_t cellId, uint16_t rnti)
+{
+    NS_LOG_FUNCTION(this << cellId << rnti);
+
+    uint64_t id = 0;
+    if (m_active)
+    {
+        auto it = m_lteUeByCellInfo.find(std::make_tuple(cellId, rnti));
+        if (it != m_lteUeByCellInfo.end())
+        {
+            id = it->second;
+        }
+    }
+    return id;
+}
+
+std::tuple<bool, uint16_t>
+OranDataRepositoryMemory::GetLteEnbCellInfo(uint64_t e2NodeId)
+{
+    NS_LOG_FUNCTION(this << e2NodeId);
+
+    auto retVal = std::make_tuple(false, 0);
+
+    NodeData* node = GetRegisteredNode(e2NodeId);
+    if (node != nullptr && node->isLteEnb)
+    {
+        retVal = std::make_tuple(true, node->cellId);
+    }
+    return retVal;
+}
+
+std::vector<uint64_t>
+OranDataRepositoryMemory::GetLteEnbE2NodeIds()
+{
+    NS_LOG_FUNCTION(this);
+
+    std::vector<uint64_t> e2NodeIds;
+
+    if (m_active)
+    {
+        for (const auto& entry : m_nodes)
+        {
+            if (entry.second.registered && entry.second.isLteEnb)
+            {
+                e2NodeIds.push_back(entry.first);
+            }
+        }
+    }
+    return e2NodeIds;
+}
+
+std::vector<std::tuple<uint64_t, Time>>
+OranDataRepositoryMemory::GetLastRegistrationRequests()
+{
+    NS_LOG_FUNCTION(this);
+
+    std::vector<std::tuple<uint64_t, Time>> requests;
+
+    if (m_active)
+    {
+        for (const auto& entry : m_nodes)
+        {
+            if (entry.second.registered)
+            {
+                requests.emplace_back(entry.first, entry.second.lastRequestTime);
+            }
+        }
+    }
+    return requests;
+}
+
+double
+OranDataRepositoryMemory::GetAppLoss(uint64_t e2NodeId)
+{
+    NS_LOG_FUNCTION(this << e2NodeId);
+
+    double loss = 0;
+
+    NodeData* node = GetRegisteredNode(e2NodeId);
+    if (node != nullptr)
+    {
+        loss = node->appLoss;
+    }
+    return loss;
+}
+
+std::vector<std::tuple<uint16_t, uint16_t, double, double, bool, uint8_t>>
+OranDataRepositoryMemory::GetLteUeRsrpRsrq(uint64_t e2NodeId)
+{
+    NS_LOG_FUNCTION(this << e2NodeId);
+
+    std::vector<std::tuple<uint16_t, uint16_t, double, double, bool, uint8_t>> retVal;
+
+    NodeData* node = GetRegisteredNode(e2NodeId);
+    if (node != nullptr)
+    {
+        retVal = node->rsrpRsrq;
+    }
+    return retVal;
+}
+
+OranDataRepository::LteUeSnapshot
+OranDataRepositoryMemory::GetLteUeSnapshot()
+{
+    NS_LOG_FUNCTION(this);
+
+    LteUeSnapshot snapshot;
+
+    if (m_active)
+    {
+        for (const auto& entry : m_nodes)
+        {
+            const NodeData& node = entry.second;
+            if (node.registered && node.isLteUe && node.hasCellInfo && node.hasPosition)
+            {
+                snapshot.e2NodeIds.push_back(entry.first);
+                snapshot.cellIds.push_back(node.cellInfoCellId);
+                snapshot.rntis.push_back(node.cellInfoRnti);
+                snapshot.positions.push_back(node.position);
+                snapshot.appLosses.push_back(node.appLoss);
+            }
+        }
+    }
+    return snapshot;
+}
+
+OranDataRepository::LteEnbSnapshot
+OranDataRepositoryMemory::GetLteEnbSnapshot()
+{
+    NS_LOG_FUNCTION(this);
+
+    LteEnbSnapshot snapshot;
+
+    if (m_active)
+    {
+        for (const auto& entry : m_nodes)
+        {
+            const NodeData& node = entry.second;
+            if (node.registered && node.isLteEnb && node.hasPosition)
+            {
+                snapshot.e2NodeIds.push_back(entry.first);
+                snapshot.cellIds.push_back(node.cellId);
+                snapshot.positions.push_back(node.position);
+            }
+        }
+    }
+    return snapshot;
+}
+
+std::tuple<bool, Time, Vector>
+OranDataRepositoryMemory::GetLatestNodePosition(uint64_t e2NodeId)
+{
+    NS_LOG_FUNCTION(this << e2NodeId);
+
+    auto retVal = std::make_tuple(false, Time(), Vector());
+
+    NodeData* node = GetRegisteredNode(e2NodeId);
+    if (node != nullptr && node->hasPosition)
+    {
+        retVal = std::make_tuple(true, node->positionTime, node->position);
+    }
+    return retVal;
+}
+
+void
+OranDataRepositoryMemory::ForEachNodePosition(uint64_t e2NodeId,
+                                              Time fromTime,
+                                              Time toTime,
+                                              uint64_t maxEntries,
+                                              const NodePositionVisitor& visitor)
+{
+    NS_LOG_FUNCTION(this << e2NodeId << fromTime << toTime << maxEntries);
+
+    NodeData* node = GetRegisteredNode(e2NodeId);
+    if (node != nullptr)
+    {
+        if (!node->positionsSorted)
+        {
+            // The matching entries have to be sorted first
+            OranDataRepository::ForEachNodePosition(e2NodeId,
+                                                    fromTime,
+                                                    toTime,
+                                                    maxEntries,
+                                                    visitor);
+            return;
+        }
+
+        const auto& positions = node->positions;
+        uint64_t visited = 0;
+        for (std::size_t i = positions.Size(); i > 0 && visited < maxEntries; i--)
+        {
+            int64_t t = positions.Get<0>(i - 1);
+            if (t < fromTime.GetTimeStep())
+            {
+                break;
+            }
+            if (t <= toTime.GetTimeStep())
+            {
+                visitor(Time(t),
+                        Vector(positions.Get<1>(i - 1),
+                               positions.Get<2>(i - 1),
+                               positions.Get<3>(i - 1)));
+                visited++;
+            }
+        }
+    }
+}
+
+void
+OranDataRepositoryMemory::ForEachLteUeRsrpRsrq(uint64_t e2NodeId,
+                                               const LteUeRsrpRsrqVisitor& visitor)
+{
+    NS_LOG_FUNCTION(this << e2NodeId);
+
+    NodeData* node = GetRegisteredNode(e2NodeId);
+    if (node != nullptr)
+    {
+        for (const auto& measurement : node->rsrpRsrq)
+        {
+            std::apply(visitor, measurement);
+        }
+    }
+}
+
+void
+OranDataRepositoryMemory::LogCommandE2Terminator(Ptr<OranCommand> cmd)
+{
+    NS_LOG_FUNCTION(this);
+
+    if (IsLogging() && IsNodeRegistered(cmd->GetTargetE2NodeId()))
+    {
+        m_e2TerminatorCommands.emplace_back(cmd->GetTargetE2NodeId(),
+                                            Simulator::Now(),
+                                            cmd->ToString());
+    }
+}
+
+void
+OranDataRepositoryMemory::LogCommandLm(std::string lm, Ptr<OranCommand> cmd)
+{
+    NS_LOG_FUNCTION(this);
+
+    if (IsLogging())
+    {
+        m_lmCommands.emplace_back(lm, Simulator::Now(), cmd->ToString());
+    }
+}
+
+void
+OranDataRepositoryMemory::LogActionLm(std::string lm, std::string logStr)
+{
+    NS_LOG_FUNCTION(this << lm << logStr);
+
+    if (IsLogging())
+    {
+        m_lmActions.emplace_back(lm, Simulator::Now(), logStr);
+    }
+}
+
+void
+OranDataRepositoryMemory::LogActionCmm(std::string cmm, std::string logStr)
+{
+    NS_LOG_FUNCTION(this << cmm << logStr);
+
+    if (IsLogging())
+    {
+        m_cmmActions.emplace_back(cmm, Simulator::Now(), logStr);
+    }
+}
+
+void
+OranDataRepositoryMemory::LogEventLm(const std::string& lm,
+                                     LogEvent event,
+                                     double arg0,
+                                     double arg1,
+                                     double arg2,
+                                     double arg3)
+{
+    NS_LOG_FUNCTION(this << lm << event << arg0 << arg1 << arg2 << arg3);
+
+    if (IsLogging())
+    {
+        m_lmEvents.emplace_back(lm,
+                                Simulator::Now(),
+                                event,
+                                std::array<double, 4>{arg0, arg1, arg2, arg3});
+    }
+}
+
+void
+OranDataRepositoryMemory::LogEventCmm(const std::string& cmm,
+                                      LogEvent event,
+                                      double arg0,
+                                      double arg1,
+                                      double arg2,
+                                      double arg3)
+{
+    NS_LOG_FUNCTION(this << cmm << event << arg0 << arg1 << arg2 << arg3);
+
+    if (IsLogging())
+    {
+        m_cmmEvents.emplace_back(cmm,
+                                 Simulator::Now(),
+                                 event,
+                                 std::array<double, 4>{arg0, arg1, arg2, arg3});
+    }
+}
+
+void
+OranDataRepositoryMemory::Dump(const std::string& dbPath)
+{
+    NS_LOG_FUNCTION(this << dbPath);
+
+    // Start from an empty database, instead of adding the data to the one
+    // of a previous dump
+    for (const std::string& suffix : {"", "-wal", "-shm"})
+    {
+        std::remove((dbPath + suffix).c_str());
+    }
+
+    Ptr<OranDataRepositorySqlite> db = CreateObject<OranDataRepositorySqlite>();
+    db->SetAttribute("DatabaseFile", StringValue(dbPath));
+    db->SetAttribute("WriteBatching", BooleanValue(true));
+    db->Activate();
+
+    for (const auto& entry : m_nodes)
+    {
+        const NodeData& node = entry.second;
+
+        db->ImportNode(entry.first, node.type);
+        if (node.isLteUe)
+        {
+            db->ImportNodeLteUe(entry.first, node.imsi);
+        }
+        if (node.isLteEnb)
+        {
+            db->ImportNodeLteEnb(entry.first, node.cellId);
+        }
+    }
+
+    for (const auto& registration : m_registrations)
+    {
+        db->ImportNodeRegistration(std::get<0>(registration),
+                                   std::get<1>(registration),
+                                   std::get<2>(registration));
+    }
+
+    for (const auto& entry : m_nodes)
+    {
+        const NodeData& node = entry.second;
+
+        for (std::size_t i = 0; i < node.positions.Size(); i++)
+        {
+            db->ImportPosition(entry.first,
+                               Vector(node.positions.Get<1>(i),
+                                      node.positions.Get<2>(i),
+                                      node.positions.Get<3>(i)),
+                               Time(node.positions.Get<0>(i)));
+        }
+        for (std::size_t i = 0; i < node.cellInfos.Size(); i++)
+        {
+            db->ImportLteUeCellInfo(entry.first,
+                                    node.cellInfos.Get<1>(i),
+                                    node.cellInfos.Get<2>(i),
+                                    Time(node.cellInfos.Get<0>(i)));
+        }
+        for (std::size_t i = 0; i < node.appLosses.Size(); i++)
+        {
+            db->ImportAppLoss(entry.first,
+                              node.appLosses.Get<1>(i),
+                              Time(node.appLosses.Get<0>(i)));
+        }
+        for (std::size_t i = 0; i < node.rsrpRsrqs.Size(); i++)
+        {
+            db->ImportLteUeRsrpRsrq(entry.first,
+                                    Time(node.rsrpRsrqs.Get<0>(i)),
+                                    node.rsrpRsrqs.Get<1>(i),
+                                    node.rsrpRsrqs.Get<2>(i),
+                                    node.rsrpRsrqs.Get<3>(i),
+                                    node.rsrpRsrqs.Get<4>(i),
+                                    node.rsrpRsrqs.Get<5>(i),
+                                    node.rsrpRsrqs.Get<6>(i));
+        }
+    }
+
+    for (const auto& cmd : m_e2TerminatorCommands)
+    {
+        db->ImportCommandE2Terminator(std::get<0>(cmd), std::get<1>(cmd), std::get<2>(cmd));
+    }
+    for (const auto& cmd : m_lmCommands)
+    {
+        db->ImportCommandLm(std::get<0>(cmd), std::get<1>(cmd), std::get<2>(cmd));
+    }
+    for (const auto& action : m_lmActions)
+    {
+        db->ImportActionLm(std::get<0>(action), std::get<1>(action), std::get<2>(action));
+    }
+    for (const auto& action : m_cmmActions)
+    {
+        db->ImportActionCmm(std::get<0>(action), std::get<1>(action), std::get<2>(action));
+    }
+    for (const auto& event : m_lmEvents)
+    {
+        const auto& args = std::get<3>(event);
+        db->ImportEventLm(std::get<0>(event),
+                          std::get<1>(event),
+                          std::get<2>(event),
+                          args[0],
+                          args[1],
+                          args[2],
+                          args[3]);
+    }
+    for (const auto& event : m_cmmEvents)
+    {
+        const auto& args = std::get<3>(event);
+        db->ImportEventCmm(std::get<0>(event),
+                           std::get<1>(event),
+                           std::get<2>(event),
+                           args[0],
+                           args[1],
+                           args[2],
+                           args[3]);
+    }
+
+    db->Deactivate();
+    db->Dispose();
+}
+
+void
+OranDataRepositoryMemory::DoDispose()
+{
+    NS_LOG_FUNCTION(this);
+
+    if (m_dumpPending && IsLogging())
+    {
+        Dump(m_dumpPath);
+    }
+    m_dumpPending = false;
+    m_active = false;
+
+    m_nodes.clear();
+    m_lteUeByCellInfo.clear();
+    m_registrations.clear();
+    m_pruneCursors.clear();
+    m_e2TerminatorCommands.clear();
+    m_lmCommands.clear();
+    m_lmActions.clear();
+    m_cmmActions.clear();
+    m_lmEvents.clear();
+    m_cmmEvents.clear();
+
+    OranDataRepository::DoDispose();
+}
+
+void
+OranDataRepositoryMemory::DoPruneHistory(HistoryType type,
+                                         Time minTime,
+                                         uint64_t maxRows,
+                                         uint32_t maxDeletes)
+{
+    NS_LOG_FUNCTION(this << type << minTime << maxRows << maxDeletes);
+
+    int64_t minTs = minTime.GetTimeStep();
+    std::size_t budget = maxDeletes;
+
+    if (type == NODE_REGISTRATION)
+    {
+        // Find the requests to remove, from the newest to the oldest, always
+        // keeping the latest request of each node
+        std::vector<bool> remove(m_registrations.size(), false);
+        std::map<uint64_t, uint64_t> kept;
+        for (std::size_t i = m_registrations.size(); i > 0; i--)
+        {
+            uint64_t& count = kept[std::get<0>(m_registrations[i - 1])];
+            if (count > 0 && ((maxRows > 0 && count >= maxRows) ||
+                              std::get<2>(m_registrations[i - 1]).GetTimeStep() < minTs))
+            {
+                remove[i - 1] = true;
+            }
+            else
+            {
+                count++;
+            }
+        }
+
+        // Remove the oldest ones first
+        std::size_t size = 0;
+        for (std::size_t i = 0; i < m_registrations.size(); i++)
+        {
+            if (remove[i] && budget > 0)
+            {
+                budget--;
+            }
+            else
+            {
+                m_registrations[size++] = m_registrations[i];
+            }
+        }
+        m_registrations.resize(size);
+        return;
+    }
+
+    OranDataRepositoryPruneNodes(
+        m_nodes,
+        m_pruneCursors[type],
+        budget,
+        [type, minTs, maxRows](NodeData& node, std::size_t nodeBudget) -> std::size_t {
+            switch (type)
+            {
+            case NODE_LOCATION:
+                return node.positions.Prune(minTs, maxRows, nodeBudget);
+            case LTE_UE_CELL:
+                return node.cellInfos.Prune(minTs, maxRows, nodeBudget);
+            case LTE_UE_RSRP_RSRQ:
+                return node.rsrpRsrqs.Prune(minTs, maxRows, nodeBudget);
+            case NODE_APPLOSS:
+                return node.appLosses.Prune(minTs, maxRows, nodeBudget);
+            default:
+                NS_ABORT_MSG("Unknown type of history " << type);
+            }
+            return 0;
+        });
+}
+
+OranDataRepositoryMemory::NodeData*
+OranDataRepositoryMemory::GetRegisteredNode(uint64_t e2NodeId)
+{
+    NS_LOG_FUNCTION(this << e2NodeId);
+
+    NodeData* node = nullptr;
+    if (m_active)
+    {
+        auto it = m_nodes.find(e2NodeId);
+        if (it != m_nodes.end() && it->second.registered)
+        {
+            node = &it->second;
+        }
+    }
+    return node;
+}
+
+bool
+OranDataRepositoryMemory::IsLogging() const
+{
+    NS_LOG_FUNCTION(this);
+
+    return !m_dumpPath.empty();
+}
+
+} // namespace ns3
@@ -0,0 +1,383 @@
+/**
+ * NIST-developed software is provided by NIST as a public service. You may
+ * use, copy and distribute copies of the software in any medium, provided that
+ * you keep intact this entire notice. You may improve, modify and create
+ * derivative works of the software or any portion of the software, and you may
+ * copy and distribute such modifications or works. Modified works should carry
+ * a notice stating that you changed the software and should note the date and
+ * nature of any such change. Please explicitly acknowledge the National
+ * Institute of Standards and Technology as the source of the software.
+ *
+ * NIST-developed software is expressly provided "AS IS." NIST MAKES NO
+ * WARRANTY OF ANY KIND, EXPRESS, IMPLIED, IN FACT OR ARISING BY OPERATION OF
+ * LAW, INCLUDING, WITHOUT LIMITATION, THE IMPLIED WARRANTY OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE, NON-INFRINGEMENT AND DATA ACCURACY. NIST
+ * NEITHER REPRESENTS NOR WARRANTS THAT THE OPERATION OF THE SOFTWARE WILL BE
+ * UNINTERRUPTED OR ERROR-FREE, OR THAT ANY DEFECTS WILL BE CORRECTED. NIST
+ * DOES NOT WARRANT OR MAKE ANY REPRESENTATIONS REGARDING THE USE OF THE
+ * SOFTWARE OR THE RESULTS THEREOF, INCLUDING BUT NOT LIMITED TO THE
+ * CORRECTNESS, ACCURACY, RELIABILITY, OR USEFULNESS OF THE SOFTWARE.
+ *
+ * You are solely responsible for determining the appropriateness of using and
+ * distributing the software and you assume all risks associated with its use,
+ * including but not limited to the risks and costs of program errors,
+ * compliance with applicable laws, damage to or loss of data, programs or
+ * equipment, and the unavailability or interruption of operation. This
+ * software is not intended to be used in any situation where a failure could
+ * cause risk of injury or damage to property. The software developed by NIST
+ * employees is not subject to copyright protection within the United States.
+ */
+
+#ifndef ORAN_DATA_REPOSITORY_MEMORY_H
+#define ORAN_DATA_REPOSITORY_MEMORY_H
+
+#include "oran-data-repository-node-state.h"
+#include "oran-data-repository.h"
+
+#include <algorithm>
+#include <array>
+#include <map>
+#include <string>
+#include <tuple>
+#include <unordered_map>
+#include <vector>
+
+namespace ns3
+{
+
+/**
+ * @ingroup oran
+ *
+ * A Data Repository implementation that keeps all the data in memory.
+ *
+ * The reports of each E2 Node are stored in per-node ring buffers, with one
+ * vector per column, that hold at most "MaxEntriesPerNode" entries of each
+ * type of report. When a buffer is full, the oldest entry is overwritten.
+ * The latest cell information, application loss, and RSRP/RSRQ measurements
+ * of each node are also kept apart, so that the Data Access API can return
+ * them without searching the buffers.
+ *
+ * No database is used. Optionally, if the "DumpFile" attribute is set, all
+ * the stored data is written to an SQLite database with the schema of
+ * OranDataRepositorySqlite when the repository is deactivated (or disposed
+ * while active). Commands and logs are only kept if the data is going to be
+ * dumped.
+ */
+class OranDataRepositoryMemory : public OranDataRepository
+{
+  public:
+    /**
+     * Gets the TypeId of the OranDataRepositoryMemory class.
+     *
+     * @return The TypeId.
+     */
+    static TypeId GetTypeId();
+    /**
+     * Creates an instance of the OranDataRepositoryMemory class.
+     */
+    OranDataRepositoryMemory();
+    /**
+     * The destructor of the OranDataRepositoryMemory class.
+     */
+    ~OranDataRepositoryMemory() override;
+    /**
+     * Activate the data storage.
+     */
+    void Activate() override;
+    /**
+     * Deactivate the data storage. If a dump file is configured, the stored
+     * data is written to it, once per activation.
+     */
+    void Deactivate() override;
+
+    /* Data Storage API */
+    bool IsNodeRegistered(uint64_t e2NodeId) override;
+
+    uint64_t RegisterNode(OranNearRtRic::NodeType type, uint64_t id) override;
+    uint64_t RegisterNodeLteUe(uint64_t id, uint64_t imsi) override;
+    uint64_t RegisterNodeLteEnb(uint64_t id, uint16_t cellId) override;
+    uint64_t DeregisterNode(uint64_t e2NodeId) override;
+    void SavePosition(uint64_t e2NodeId, Vector pos, Time t) override;
+    void SaveLteUeCellInfo(uint64_t e2NodeId, uint16_t cellId, uint16_t rnti, Time t) override;
+    void SaveAppLoss(uint64_t e2NodeId, double appLoss, Time t) override;
+    void SaveLteUeRsrpRsrq(uint64_t e2NodeId,
+                           Time t,
+                           uint16_t rnti,
+                           uint16_t cellId,
+                           double rsrp,
+                           double rsrq,
+                           bool isServingCell,
+                           uint8_t componentCarrierId) override;
+
+    std::map<Time, Vector> GetNodePositions(uint64_t e2NodeId,
+                                            Time fromTime,
+                                            Time toTime,
+                                            uint64_t maxEntries = 1) override;
+    std::tuple<bool, uint16_t, uint16_t> GetLteUeCellInfo(uint64_t e2NodeId) override;
+    std::vector<uint64_t> GetLteUeE2NodeIds() override;
+    uint64_t GetLteUeE2NodeIdFromCellInfo(uint16_t cellId, uint16_t rnti) override;
+    std::tuple<bool, uint16_t> GetLteEnbCellInfo(uint64_t e2NodeId) override;
+    std::vector<uint64_t> GetLteEnbE2NodeIds() override;
+    std::vector<std::tuple<uint64_t, Time>> GetLastRegistrationRequests() override;
+    double GetAppLoss(uint64_t e2NodeId) override;
+    std::vector<std::tuple<uint16_t, uint16_t, double, double, bool, uint8_t>> GetLteUeRsrpRsrq(
+        uint64_t e2NodeId) override;
+    LteUeSnapshot GetLteUeSnapshot() override;
+    LteEnbSnapshot GetLteEnbSnapshot() override;
+    std::tuple<bool, Time, Vector> GetLatestNodePosition(uint64_t e2NodeId) override;
+    void ForEachNodePosition(uint64_t e2NodeId,
+                             Time fromTime,
+                             Time toTime,
+                             uint64_t maxEntries,
+                             const NodePositionVisitor& visitor) override;
+    void ForEachLteUeRsrpRsrq(uint64_t e2NodeId, const LteUeRsrpRsrqVisitor& visitor) override;
+
+    void LogCommandE2Terminator(Ptr<OranCommand> cmd) override;
+    void LogCommandLm(std::string lm, Ptr<OranCommand> cmd) override;
+    void LogActionLm(std::string lm, std::string logstr) override;
+    void LogActionCmm(std::string cmm, std::string logstr) override;
+    void LogEventLm(const std::string& lm,
+                    LogEvent event,
+                    double arg0,
+                    double arg1,
+                    double arg2,
+                    double arg3) override;
+    void LogEventCmm(const std::string& cmm,
+                     LogEvent event,
+                     double arg0,
+                     double arg1,
+                     double arg2,
+                     double arg3) override;
+
+    /**
+     * Write all the stored data to an SQLite database with the schema used by
+     * OranDataRepositorySqlite. Any existing database at the path is removed
+     * first, so that the database only holds the data of this repository.
+     *
+     * @param dbPath The file path of the database.
+     */
+    void Dump(const std::string& dbPath);
+
+  protected:
+    void DoDispose() override;
+    void DoPruneHistory(HistoryType type,
+                        Time minTime,
+                        uint64_t maxRows,
+                        uint32_t maxDeletes) override;
+
+    /**
+     * A ring buffer with a fixed capacity that stores the entries of a time
+     * series with one vector per column.
+     */
+    template <typename... Ts>
+    class ColumnRing
+    {
+      public:
+        /**
+         * Add an entry, overwriting the oldest one if the buffer is full.
+         *
+         * @param capacity The maximum number of entries in the buffer.
+         * @param values The value of each column.
+         */
+        void Push(uint32_t capacity, const Ts&... values)
+        {
+            if (m_size < capacity)
+            {
+                // The capacity was raised after the buffer wrapped, so move
+                // the oldest entry to the front before growing
+                if (m_head != 0)
+                {
+                    std::size_t head = m_head;
+                    std::apply(
+                        [head](auto&... columns) {
+                            (std::rotate(columns.begin(), columns.begin() + head, columns.end()),
+                             ...);
+                        },
+                        m_columns);
+                    m_head = 0;
+                }
+                std::apply([&values...](auto&... columns) { (columns.push_back(values), ...); },
+                           m_columns);
+                m_size++;
+            }
+            else
+            {
+                std::size_t slot = m_head;
+                std::apply(
+                    [slot, &values...](auto&... columns) { ((columns[slot] = values), ...); },
+                    m_columns);
+                m_head = (m_head + 1) % m_size;
+            }
+        }
+
+        /**
+         * Get the number of entries in the buffer.
+         *
+         * @return The number of entries.
+         */
+        std::size_t Size() const
+        {
+            return m_size;
+        }
+
+        /**
+         * Get the value of a column of an entry.
+         *
+         * @tparam C The index of the column.
+         * @param i The index of the entry, with 0 being the oldest one.
+         *
+         * @return The value.
+         */
+        template <std::size_t C>
+        auto Get(std::size_t i) const
+        {
+            return std::get<C>(m_columns)[(m_head + i) % m_size];
+        }
+
+        /**
+         * Remove the oldest entries that are older than a time, or that
+         * exceed a number of entries, always keeping the newest entry. The
+         * first column must be the time of the entry.
+         *
+         * @param minTime The time step before which entries are removed, or zero for no limit.
+         * @param maxEntries The maximum number of entries, or zero for no limit.
+         * @param maxRemovals The maximum number of entries to remove.
+         *
+         * @return The number of entries removed.
+         */
+        std::size_t Prune(int64_t minTime, uint64_t maxEntries, std::size_t maxRemovals)
+        {
+            if (m_size <= 1)
+            {
+                return 0;
+            }
+
+            std::size_t count = 0;
+            if (maxEntries > 0 && m_size > maxEntries)
+            {
+                count = m_size - maxEntries;
+            }
+            while (minTime > 0 && count < m_size - 1 && Get<0>(count) < minTime)
+            {
+                count++;
+            }
+            count = std::min(count, maxRemovals);
+
+            if (count > 0)
+            {
+                // Move the oldest entry to the front of the columns before
+                // erasing, so that the remaining entries stay in order
+                std::size_t head = m_head;
+                std::apply(
+                    [head, count](auto&... columns) {
+                        ((std::rotate(columns.begin(), columns.begin() + head, columns.end()),
+                          columns.erase(columns.begin(), columns.begin() + count)),
+                         ...);
+                    },
+                    m_columns);
+                m_head = 0;
+                m_size -= count;
+            }
+
+            return count;
+        }
+
+      private:
+        std::tuple<std::vector<Ts>...> m_columns; //!< The columns.
+        std::size_t m_head = 0;                   //!< The slot of the oldest entry.
+        std::size_t m_size = 0;                   //!< The number of entries.
+    };
+
+    /**
+     * The data stored for an E2 Node.
+     */
+    struct NodeData : public OranDataRepositoryNodeState
+    {
+        OranNearRtRic::NodeType type; //!< The node type.
+        uint64_t imsi = 0;            //!< The IMSI of an LTE UE.
+        bool positionsSorted = true;  //!< Flag that indicates if positions arrived in order.
+        ColumnRing<int64_t, double, double, double> positions; //!< Time, x, y and z.
+        ColumnRing<int64_t, uint16_t, uint16_t> cellInfos;      //!< Time, cell ID and RNTI.
+        ColumnRing<int64_t, double> appLosses;                  //!< Time and loss.
+        ColumnRing<int64_t, uint16_t, uint16_t, double, double, bool, uint8_t>
+            rsrpRsrqs; //!< Time, RNTI, cell ID, RSRP, RSRQ, serving flag and carrier ID.
+    };
+
+    /**
+     * Get the data of a registered E2 Node.
+     *
+     * @param e2NodeId The E2 Node ID.
+     *
+     * @return A pointer to the data of the node, or nullptr if the node is not registered.
+     */
+    NodeData* GetRegisteredNode(uint64_t e2NodeId);
+    /**
+     * Check if the Commands and logs should be kept.
+     *
+     * @return True, if a dump file is configured; otherwise, false.
+     */
+    bool IsLogging() const;
+
+  private:
+    /**
+     * The maximum number of entries of each type of report kept for each node.
+     */
+    uint32_t m_maxEntriesPerNode;
+    /**
+     * The path of the database to write the stored data to. Empty to disable.
+     */
+    std::string m_dumpPath;
+    /**
+     * Flag that indicates if the stored data has not been dumped since the
+     * repository was activated.
+     */
+    bool m_dumpPending;
+    /**
+     * The data of the E2 Nodes, indexed by E2 Node ID.
+     */
+    std::map<uint64_t, NodeData> m_nodes;
+    /**
+     * The E2 Node ID to assign to the next node registered without an ID.
+     */
+    uint64_t m_nextE2NodeId;
+    /**
+     * The E2 Node ID of the LTE UE that last reported each cell ID and RNTI pair.
+     */
+    std::map<std::tuple<uint16_t, uint16_t>, uint64_t> m_lteUeByCellInfo;
+    /**
+     * The (de)registration requests: E2 Node ID, registered, and time.
+     */
+    std::vector<std::tuple<uint64_t, bool, Time>> m_registrations;
+    /**
+     * The E2 Node ID of the next node to prune for each type of history.
+     */
+    std::map<HistoryType, uint64_t> m_pruneCursors;
+    /**
+     * The Commands issued by the E2 Terminator: target E2 Node ID, time, and Command.
+     */
+    std::vector<std::tuple<uint64_t, Time, std::string>> m_e2TerminatorCommands;
+    /**
+     * The Commands issued by the LMs: LM name, time, and Command.
+     */
+    std::vector<std::tuple<std::string, Time, std::string>> m_lmCommands;
+    /**
+     * The logged LM actions: LM name, time, and action.
+     */
+    std::vector<std::tuple<std::string, Time, std::string>> m_lmActions;
+    /**
+     * The logged CMM actions: CMM name, time, and action.
+     */
+    std::vector<std::tuple<std::string, Time, std::string>> m_cmmActions;
+    /**
+     * The logged LM events: LM name, time, event code, and arguments.
+     */
+    std::vector<std::tuple<std::string, Time, LogEvent, std::array<double, 4>>> m_lmEvents;
+    /**
+     * The logged CMM events: CMM name, time, event code, and arguments.
+     */
+    std::vector<std::tuple<std::string, Time, LogEvent, std::array<double, 4>>> m_cmmEvents;
+}; // class OranDataRepositoryMemory
+
+} // namespace ns3
+
+#endif /* ORAN_DATA_REPOSITORY_MEMORY_H */
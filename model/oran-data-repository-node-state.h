@@ -0,0 +1,228 @@
+/**
+ * NIST-developed software is provided by NIST as a public service. You may
+ * use, copy and distribute copies of the software in any medium, provided that
+ * you keep intact this entire notice. You may improve, modify and create
+ * derivative works of the software or any portion of the software, and you may
+ * copy and distribute such modifications or works. Modified works should carry
+ * a notice stating that you changed the software and should note the date and
+ * nature of any such change. Please explicitly acknowledge the National
+ * Institute of Standards and Technology as the source of the software.
+ *
+ * NIST-developed software is expressly provided "AS IS." NIST MAKES NO
+ * WARRANTY OF ANY KIND, EXPRESS, IMPLIED, IN FACT OR ARISING BY OPERATION OF
+ * LAW, INCLUDING, WITHOUT LIMITATION, THE IMPLIED WARRANTY OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE, NON-INFRINGEMENT AND DATA ACCURACY. NIST
+ * NEITHER REPRESENTS NOR WARRANTS THAT THE OPERATION OF THE SOFTWARE WILL BE
+ * UNINTERRUPTED OR ERROR-FREE, OR THAT ANY DEFECTS WILL BE CORRECTED. NIST
+ * DOES NOT WARRANT OR MAKE ANY REPRESENTATIONS REGARDING THE USE OF THE
+ * SOFTWARE OR THE RESULTS THEREOF, INCLUDING BUT NOT LIMITED TO THE
+ * CORRECTNESS, ACCURACY, RELIABILITY, OR USEFULNESS OF THE SOFTWARE.
+ *
+ * You are solely responsible for determining the appropriateness of using and
+ * distributing the software and you assume all risks associated with its use,
+ * including but not limited to the risks and costs of program errors,
+ * compliance with applicable laws, damage to or loss of data, programs or
+ * equipment, and the unavailability or interruption of operation. This
+ * software is not intended to be used in any situation where a failure could
+ * cause risk of injury or damage to property. The software developed by NIST
+ * employees is not subject to copyright protection within the United States.
+ */
+
+#ifndef ORAN_DATA_REPOSITORY_NODE_STATE_H
+#define ORAN_DATA_REPOSITORY_NODE_STATE_H
+
+#include "ns3/nstime.h"
+#include "ns3/vector.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <map>
+#include <tuple>
+#include <vector>
+
+namespace ns3
+{
+
+/**
+ * @ingroup oran
+ *
+ * The latest state of an E2 Node, kept in memory by the Data Repositories
+ * that serve the reads of the latest reports without going through the
+ * stored history. The reports are applied in arrival order, and the latest
+ * values are only replaced by reports that are not older than them.
+ */
+struct OranDataRepositoryNodeState
+{
+    bool registered = false;     //!< The registration state.
+    Time lastRequestTime;        //!< The time of the last (de)registration request.
+    bool isLteUe = false;        //!< Flag that indicates if the node is an LTE UE.
+    bool isLteEnb = false;       //!< Flag that indicates if the node is an LTE eNB.
+    uint16_t cellId = 0;         //!< The cell ID of an LTE eNB.
+    bool hasPosition = false;    //!< Flag that indicates if there is a position.
+    Time positionTime;           //!< The time of the latest position.
+    Vector position;             //!< The latest position.
+    bool hasCellInfo = false;    //!< Flag that indicates if there is cell information.
+    Time cellInfoTime;           //!< The time of the latest cell information.
+    uint16_t cellInfoCellId = 0; //!< The cell ID of the latest cell information.
+    uint16_t cellInfoRnti = 0;   //!< The RNTI of the latest cell information.
+    double appLoss = 0;          //!< The latest application loss.
+    Time rsrpRsrqTime;           //!< The time of the latest RSRP and RSRQ measurements.
+    std::vector<std::tuple<uint16_t, uint16_t, double, double, bool, uint8_t>>
+        rsrpRsrq; //!< The latest RSRP and RSRQ measurements.
+
+    /**
+     * Apply a registration or deregistration request. A node that is
+     * registered again keeps its type.
+     *
+     * @param isRegistered The registration state.
+     * @param t The time of the request.
+     */
+    void SetRegistration(bool isRegistered, Time t)
+    {
+        registered = isRegistered;
+        lastRequestTime = t;
+    }
+
+    /**
+     * Mark the node as an LTE UE.
+     */
+    void SetLteUe()
+    {
+        isLteUe = true;
+    }
+
+    /**
+     * Mark the node as an LTE eNB.
+     *
+     * @param enbCellId The cell ID of the eNB.
+     */
+    void SetLteEnb(uint16_t enbCellId)
+    {
+        isLteEnb = true;
+        cellId = enbCellId;
+    }
+
+    /**
+     * Apply a position report.
+     *
+     * @param pos The position.
+     * @param t The time of the report.
+     */
+    void UpdatePosition(Vector pos, Time t)
+    {
+        if (!hasPosition || t >= positionTime)
+        {
+            hasPosition = true;
+            positionTime = t;
+            position = pos;
+        }
+    }
+
+    /**
+     * Apply an LTE cell information report.
+     *
+     * @param ueCellId The cell ID.
+     * @param rnti The RNTI.
+     * @param t The time of the report.
+     */
+    void UpdateLteUeCellInfo(uint16_t ueCellId, uint16_t rnti, Time t)
+    {
+        if (!hasCellInfo || t >= cellInfoTime)
+        {
+            hasCellInfo = true;
+            cellInfoTime = t;
+            cellInfoCellId = ueCellId;
+            cellInfoRnti = rnti;
+        }
+    }
+
+    /**
+     * Apply an application loss report.
+     *
+     * @param loss The application loss.
+     */
+    void UpdateAppLoss(double loss)
+    {
+        appLoss = loss;
+    }
+
+    /**
+     * Apply an RSRP and RSRQ measurement. The measurements with the latest
+     * time are kept, and the ones of the same time are accumulated.
+     *
+     * @param t The time of the measurement.
+     * @param rnti The RNTI of the UE.
+     * @param measCellId The cell ID of the measured cell.
+     * @param rsrp The RSRP.
+     * @param rsrq The RSRQ.
+     * @param isServingCell Flag that indicates if the cell is the serving cell.
+     * @param componentCarrierId The component carrier ID.
+     */
+    void UpdateLteUeRsrpRsrq(Time t,
+                             uint16_t rnti,
+                             uint16_t measCellId,
+                             double rsrp,
+                             double rsrq,
+                             bool isServingCell,
+                             uint8_t componentCarrierId)
+    {
+        if (rsrpRsrq.empty() || t > rsrpRsrqTime)
+        {
+            rsrpRsrq.clear();
+            rsrpRsrqTime = t;
+        }
+        if (t == rsrpRsrqTime)
+        {
+            rsrpRsrq.emplace_back(rnti, measCellId, rsrp, rsrq, isServingCell, componentCarrierId);
+        }
+    }
+};
+
+/**
+ * @ingroup oran
+ *
+ * Prune the history of the nodes of a Data Repository, visiting the nodes
+ * in order of E2 Node ID starting at a cursor, and wrapping around, until
+ * all of them are visited or the budget of deletions is used up. The cursor
+ * is left at the node after the last one visited, so that all the nodes are
+ * pruned even if the budget is used up before the end.
+ *
+ * @param nodes The nodes, indexed by E2 Node ID.
+ * @param cursor The E2 Node ID to start at, updated to the one to start the
+ *               next time at.
+ * @param budget The maximum number of entries to remove.
+ * @param prune The function that prunes the history of a node, given the
+ *              node and the remaining budget, and returns the number of
+ *              entries that it removed.
+ */
+template <typename Node, typename PruneFunction>
+void
+OranDataRepositoryPruneNodes(std::map<uint64_t, Node>& nodes,
+                             uint64_t& cursor,
+                             std::size_t budget,
+                             PruneFunction prune)
+{
+    if (nodes.empty())
+    {
+        return;
+    }
+
+    auto it = nodes.lower_bound(cursor);
+    for (std::size_t visited = 0; visited < nodes.size() && budget > 0; visited++)
+    {
+        if (it == nodes.end())
+        {
+            it = nodes.begin();
+        }
+
+        budget -= prune(it->second, budget);
+
+        it++;
+    }
+
+    cursor = (it == nodes.end() ? 0 : it->first);
+}
+
+} // namespace ns3
+
+#endif /* ORAN_DATA_REPOSITORY_NODE_STATE_H */
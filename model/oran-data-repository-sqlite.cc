@@ -31,9 +31,19 @@
 #include "oran-data-repository-sqlite.h"
 
 #include "ns3/abort.h"
+#include "ns3/boolean.h"
+#include "ns3/double.h"
+#include "ns3/integer.h"
 #include "ns3/log.h"
 #include "ns3/simulator.h"
 #include "ns3/string.h"
+#include "ns3/uinteger.h"
+
+#include <algorithm>
+#include <cctype>
+#include <cmath>
+#include <fstream>
+#include <limits>
 
 namespace ns3
 {
@@ -54,10 +64,113 @@ OranDataRepositorySqlite::GetTypeId()
                           StringValue("oran-repository.db"),
                           MakeStringAccessor(&OranDataRepositorySqlite::m_dbPath),
                           MakeStringChecker())
+            .AddAttribute("CacheStatements",
+                          "Flag that indicates if the statements are compiled once, when the "
+                          "database is opened, instead of every time that they are used. "
+                          "Disabling it is only meant to measure the cost of the compilation, "
+                          "and statements that are not cached are not timed.",
+                          BooleanValue(true),
+                          MakeBooleanAccessor(&OranDataRepositorySqlite::m_cacheStatements),
+                          MakeBooleanChecker())
+            .AddAttribute("SchemaVersion",
+                          "The version of the database schema. Version 1 uses tables with "
+                          "autoincrement row IDs. Version 2 clusters the history tables on "
+                          "(nodeid, simulationtime, seq). Databases with version 1 are migrated "
+                          "when opened with version 2.",
+                          UintegerValue(1),
+                          MakeUintegerAccessor(&OranDataRepositorySqlite::m_schemaVersion),
+                          MakeUintegerChecker<uint32_t>(1, 2))
+            .AddAttribute("WriteBatching",
+                          "Flag that indicates if writes should be grouped into transactions "
+                          "that are committed once the events of the simulation time at which "
+                          "they were started have been processed, when the maximum number of "
+                          "rows is reached, or when the database is closed.",
+                          BooleanValue(false),
+                          MakeBooleanAccessor(&OranDataRepositorySqlite::m_writeBatching),
+                          MakeBooleanChecker())
+            .AddAttribute("WriteBatchMaxRows",
+                          "The maximum number of rows written in a single transaction when "
+                          "write batching is enabled.",
+                          UintegerValue(1000),
+                          MakeUintegerAccessor(&OranDataRepositorySqlite::m_writeBatchMaxRows),
+                          MakeUintegerChecker<uint32_t>(1))
+            .AddAttribute("AsyncWrites",
+                          "Flag that indicates if writes should be performed by a dedicated "
+                          "writer thread. Reads wait for the queued writes to the tables "
+                          "they use to be completed. The \"QueryRc\" and \"QueryLatency\" "
+                          "trace sources are then called from the writer thread.",
+                          BooleanValue(false),
+                          MakeBooleanAccessor(&OranDataRepositorySqlite::m_asyncWrites),
+                          MakeBooleanChecker())
+            .AddAttribute("AsyncQueueCapacity",
+                          "The maximum number of writes queued for the writer thread when "
+                          "asynchronous writes are enabled. Writes block while the queue "
+                          "is full.",
+                          UintegerValue(65536),
+                          MakeUintegerAccessor(&OranDataRepositorySqlite::m_asyncQueueCapacity),
+                          MakeUintegerChecker<uint32_t>(1))
+            .AddAttribute("WalMode",
+                          "Flag that indicates if the database should use write-ahead logging. "
+                          "In this mode, the Data Access API uses a separate read-only "
+                          "connection, unless the database is in memory or temporary.",
+                          BooleanValue(false),
+                          MakeBooleanAccessor(&OranDataRepositorySqlite::m_walMode),
+                          MakeBooleanChecker())
+            .AddAttribute("WalAutoCheckpoint",
+                          "The number of pages in the write-ahead log after which a commit "
+                          "runs a passive checkpoint. Zero disables these checkpoints.",
+                          UintegerValue(1000),
+                          MakeUintegerAccessor(&OranDataRepositorySqlite::m_walAutoCheckpoint),
+                          MakeUintegerChecker<uint32_t>())
+            .AddAttribute("WalCheckpointInterval",
+                          "The simulation time between periodic passive checkpoints of the "
+                          "write-ahead log. Zero disables these checkpoints.",
+                          TimeValue(Seconds(0)),
+                          MakeTimeAccessor(&OranDataRepositorySqlite::m_walCheckpointInterval),
+                          MakeTimeChecker())
+            .AddAttribute("WalSizeLimit",
+                          "The size, in bytes, to which the write-ahead log file is truncated "
+                          "after a checkpoint. A negative value disables the limit.",
+                          IntegerValue(-1),
+                          MakeIntegerAccessor(&OranDataRepositorySqlite::m_walSizeLimit),
+                          MakeIntegerChecker<int64_t>(-1))
+            .AddAttribute("PositionTolerance",
+                          "The maximum distance, in meters, between a location and the track "
+                          "extrapolated from the stored locations of the node for the location "
+                          "to replace the last one instead of being added. Zero stores every "
+                          "location.",
+                          DoubleValue(0),
+                          MakeDoubleAccessor(&OranDataRepositorySqlite::m_positionTolerance),
+                          MakeDoubleChecker<double>(0))
+            .AddAttribute("QueryStats",
+                          "Flag to collect the number of executions and a histogram of the "
+                          "wall-clock latency of each type of prepared statement.",
+                          BooleanValue(false),
+                          MakeBooleanAccessor(&OranDataRepositorySqlite::m_queryStatsEnabled),
+                          MakeBooleanChecker())
+            .AddAttribute("QueryStatsFile",
+                          "The file to which the summary of the execution statistics of the "
+                          "prepared statements is written when the database is closed. Empty "
+                          "disables the summary.",
+                          StringValue(""),
+                          MakeStringAccessor(&OranDataRepositorySqlite::m_queryStatsPath),
+                          MakeStringChecker())
             .AddTraceSource("QueryRc",
                             "Return code for SQL queries",
                             MakeTraceSourceAccessor(&OranDataRepositorySqlite::m_queryRc),
                             "ns3::OranDataRepositorySqlite::QueryTracedCallback")
+            .AddTraceSource("WalSize",
+                            "Number of pages in the write-ahead log after each commit",
+                            MakeTraceSourceAccessor(&OranDataRepositorySqlite::m_walSize),
+                            "ns3::OranDataRepositorySqlite::WalSizeTracedCallback")
+            .AddTraceSource("WalCheckpoint",
+                            "Result of each checkpoint of the write-ahead log",
+                            MakeTraceSourceAccessor(&OranDataRepositorySqlite::m_walCheckpoint),
+                            "ns3::OranDataRepositorySqlite::WalCheckpointTracedCallback")
+            .AddTraceSource("QueryLatency",
+                            "Wall-clock latency of each execution of a prepared statement",
+                            MakeTraceSourceAccessor(&OranDataRepositorySqlite::m_queryLatency),
+                            "ns3::OranDataRepositorySqlite::QueryLatencyTracedCallback")
 
         ;
 
@@ -66,11 +179,21 @@ OranDataRepositorySqlite::GetTypeId()
 
 OranDataRepositorySqlite::OranDataRepositorySqlite()
     : OranDataRepository(),
-      m_db(nullptr)
+      m_db(nullptr),
+      m_readDb(nullptr),
+      m_walActive(false),
+      m_batchOpen(false),
+      m_batchTables(0),
+      m_batchRows(0),
+      m_nextE2NodeId(1),
+      m_nextSeq(1),
+      m_writeQueueHead(0),
+      m_writeQueueTail(0),
+      m_writerStop(false),
+      m_writerSleeping(false),
+      m_flushWaiting(false)
 {
     NS_LOG_FUNCTION(this);
-
-    InitStatements();
 }
 
 OranDataRepositorySqlite::~OranDataRepositorySqlite()
@@ -104,6 +227,15 @@ OranDataRepositorySqlite::Deactivate()
     OranDataRepository::Deactivate();
 }
 
+void
+OranDataRepositorySqlite::FlushWrites()
+{
+    NS_LOG_FUNCTION(this);
+
+    CommitBatch();
+    WaitForWrites();
+}
+
 bool
 OranDataRepositorySqlite::IsNodeRegistered(uint64_t e2NodeId)
 {
@@ -112,19 +244,11 @@ OranDataRepositorySqlite::IsNodeRegistered(uint64_t e2NodeId)
     bool registered = false;
     if (m_active)
     {
-        int rc;
-        sqlite3_stmt* stmt = nullptr;
-
-        sqlite3_prepare_v2(m_db, m_queryStmtsStrings[CHECK_NODE_REGISTERED].c_str(), -1, &stmt, 0);
-        sqlite3_bind_int64(stmt, 1, e2NodeId);
-
-        while ((rc = sqlite3_step(stmt)) == SQLITE_ROW)
+        auto it = m_registeredNodes.find(e2NodeId);
+        if (it != m_registeredNodes.end())
         {
-            registered = sqlite3_column_int(stmt, 0);
+            registered = it->second;
         }
-
-        CheckQueryReturnCode(stmt, rc, FormatBoundArgsList(e2NodeId));
-        sqlite3_finalize(stmt);
     }
     return registered;
 }
@@ -138,56 +262,13 @@ OranDataRepositorySqlite::RegisterNode(OranNearRtRic::NodeType type, uint64_t id
 
     if (m_active)
     {
-        int rc;
-        sqlite3_stmt* stmt = nullptr;
-
-        if (id == 0)
-        {
-            // Insert or update the node information
-            sqlite3_prepare_v2(m_db, m_queryStmtsStrings[INSERT_NODE_ADD].c_str(), -1, &stmt, 0);
-
-            sqlite3_bind_int(stmt, 1, type);
-
-            rc = sqlite3_step(stmt);
-
-            CheckQueryReturnCode(stmt, rc, FormatBoundArgsList(type));
-
-            e2NodeId = sqlite3_last_insert_rowid(m_db);
-        }
-        else
-        {
-            sqlite3_prepare_v2(m_db, m_queryStmtsStrings[INSERT_NODE_UPDATE].c_str(), -1, &stmt, 0);
-
-            sqlite3_bind_int(stmt, 1, id);
-            sqlite3_bind_int(stmt, 2, type);
-
-            rc = sqlite3_step(stmt);
-
-            CheckQueryReturnCode(stmt, rc, FormatBoundArgsList(type));
+        // Allocate a new E2 Node ID if the node does not provide one
+        e2NodeId = (id == 0 ? m_nextE2NodeId : id);
 
-            e2NodeId = sqlite3_last_insert_rowid(m_db);
-        }
-
-        sqlite3_finalize(stmt);
-
-        // Insert the registration information
-        sqlite3_prepare_v2(m_db,
-                           m_queryStmtsStrings[INSERT_NODE_REGISTRATION].c_str(),
-                           -1,
-                           &stmt,
-                           0);
-
-        sqlite3_bind_int64(stmt, 1, e2NodeId);
-        sqlite3_bind_int(stmt, 2, 1);
-        sqlite3_bind_int64(stmt, 3, Simulator::Now().GetTimeStep());
-
-        rc = sqlite3_step(stmt);
-
-        CheckQueryReturnCode(stmt,
-                             rc,
-                             FormatBoundArgsList(e2NodeId, true, Simulator::Now().GetTimeStep()));
+        ImportNode(e2NodeId, type);
+        ImportNodeRegistration(e2NodeId, true, Simulator::Now());
 
-        sqlite3_finalize(stmt);
+        m_nodeRegisteredTrace(e2NodeId);
     }
 
     return e2NodeId;
@@ -201,18 +282,8 @@ OranDataRepositorySqlite::RegisterNodeLteUe(uint64_t id, uint64_t imsi)
 
     if (m_active)
     {
-        int rc;
-        sqlite3_stmt* stmt = nullptr;
         e2NodeId = RegisterNode(OranNearRtRic::NodeType::LTEUE, id);
-
-        sqlite3_prepare_v2(m_db, m_queryStmtsStrings[INSERT_LTE_UE_NODE].c_str(), -1, &stmt, 0);
-
-        sqlite3_bind_int64(stmt, 1, id);
-        sqlite3_bind_int64(stmt, 2, imsi);
-
-        rc = sqlite3_step(stmt);
-        CheckQueryReturnCode(stmt, rc, FormatBoundArgsList(id, imsi));
-        sqlite3_finalize(stmt);
+        ImportNodeLteUe(e2NodeId, imsi);
     }
     return e2NodeId;
 }
@@ -226,18 +297,8 @@ OranDataRepositorySqlite::RegisterNodeLteEnb(uint64_t id, uint16_t cellId)
 
     if (m_active)
     {
-        int rc;
-        sqlite3_stmt* stmt = nullptr;
         e2NodeId = RegisterNode(OranNearRtRic::NodeType::LTEENB, id);
-
-        sqlite3_prepare_v2(m_db, m_queryStmtsStrings[INSERT_LTE_ENB_NODE].c_str(), -1, &stmt, 0);
-
-        sqlite3_bind_int64(stmt, 1, id);
-        sqlite3_bind_int(stmt, 2, cellId);
-
-        rc = sqlite3_step(stmt);
-        CheckQueryReturnCode(stmt, rc, FormatBoundArgsList(id, cellId));
-        sqlite3_finalize(stmt);
+        ImportNodeLteEnb(e2NodeId, cellId);
     }
     return e2NodeId;
 }
@@ -250,26 +311,11 @@ OranDataRepositorySqlite::DeregisterNode(uint64_t e2NodeId)
     uint64_t retVal = 0;
     if (m_active)
     {
-        int rc;
-        sqlite3_stmt* stmt = nullptr;
-
         retVal = e2NodeId;
 
-        sqlite3_prepare_v2(m_db,
-                           m_queryStmtsStrings[INSERT_NODE_REGISTRATION].c_str(),
-                           -1,
-                           &stmt,
-                           0);
-
-        sqlite3_bind_int64(stmt, 1, e2NodeId);
-        sqlite3_bind_int(stmt, 2, false);
-        sqlite3_bind_int64(stmt, 3, Simulator::Now().GetTimeStep());
+        ImportNodeRegistration(e2NodeId, false, Simulator::Now());
 
-        rc = sqlite3_step(stmt);
-        CheckQueryReturnCode(stmt,
-                             rc,
-                             FormatBoundArgsList(e2NodeId, false, Simulator::Now().GetTimeStep()));
-        sqlite3_finalize(stmt);
+        m_nodeDeregisteredTrace(e2NodeId);
     }
     return retVal;
 }
@@ -283,27 +329,7 @@ OranDataRepositorySqlite::SavePosition(uint64_t e2NodeId, Vector pos, Time t)
     {
         if (IsNodeRegistered(e2NodeId))
         {
-            int rc;
-            sqlite3_stmt* stmt = nullptr;
-
-            sqlite3_prepare_v2(m_db,
-                               m_queryStmtsStrings[INSERT_NODE_LOCATION].c_str(),
-                               -1,
-                               &stmt,
-                               0);
-
-            sqlite3_bind_int64(stmt, 1, e2NodeId);
-            sqlite3_bind_double(stmt, 2, pos.x);
-            sqlite3_bind_double(stmt, 3, pos.y);
-            sqlite3_bind_double(stmt, 4, pos.z);
-            sqlite3_bind_int64(stmt, 5, t.GetTimeStep());
-
-            rc = sqlite3_step(stmt);
-            CheckQueryReturnCode(
-                stmt,
-                rc,
-                FormatBoundArgsList(e2NodeId, pos.x, pos.y, pos.z, t.GetTimeStep()));
-            sqlite3_finalize(stmt);
+            ImportPosition(e2NodeId, pos, t);
         }
     }
 }
@@ -320,21 +346,7 @@ OranDataRepositorySqlite::SaveLteUeCellInfo(uint64_t e2NodeId,
     {
         if (IsNodeRegistered(e2NodeId))
         {
-            int rc;
-            sqlite3_stmt* stmt = nullptr;
-
-            sqlite3_prepare_v2(m_db, m_queryStmtsStrings[INSERT_LTE_UE_CELL].c_str(), -1, &stmt, 0);
-
-            sqlite3_bind_int64(stmt, 1, e2NodeId);
-            sqlite3_bind_int(stmt, 2, cellId);
-            sqlite3_bind_int(stmt, 3, rnti);
-            sqlite3_bind_int64(stmt, 4, t.GetTimeStep());
-
-            rc = sqlite3_step(stmt);
-            CheckQueryReturnCode(stmt,
-                                 rc,
-                                 FormatBoundArgsList(e2NodeId, cellId, rnti, t.GetTimeStep()));
-            sqlite3_finalize(stmt);
+            ImportLteUeCellInfo(e2NodeId, cellId, rnti, t);
         }
     }
 }
@@ -348,24 +360,7 @@ OranDataRepositorySqlite::SaveAppLoss(uint64_t e2NodeId, double appLoss, Time t)
     {
         if (IsNodeRegistered(e2NodeId))
         {
-            int rc;
-            std::string query;
-            sqlite3_stmt* stmt = nullptr;
-
-            query = "INSERT INTO nodeapploss (nodeid, loss, simulationtime)"
-                    " VALUES (?, ?, ?)"
-                    ";";
-
-            sqlite3_prepare_v2(m_db, query.c_str(), -1, &stmt, 0);
-
-            sqlite3_bind_int64(stmt, 1, e2NodeId);
-            sqlite3_bind_double(stmt, 2, appLoss);
-            sqlite3_bind_int64(stmt, 3, t.GetTimeStep());
-
-            rc = sqlite3_step(stmt);
-
-            CheckQueryReturnCode(stmt, rc, FormatBoundArgsList(e2NodeId, appLoss, t.GetTimeStep()));
-            sqlite3_finalize(stmt);
+            ImportAppLoss(e2NodeId, appLoss, t);
         }
     }
 }
@@ -387,38 +382,14 @@ OranDataRepositorySqlite::SaveLteUeRsrpRsrq(uint64_t e2NodeId,
     {
         if (IsNodeRegistered(e2NodeId))
         {
-            int rc;
-            std::string query;
-            sqlite3_stmt* stmt = nullptr;
-
-            sqlite3_prepare_v2(m_db,
-                               m_queryStmtsStrings[INSERT_LTE_UE_RSRP_RSRQ].c_str(),
-                               -1,
-                               &stmt,
-                               0);
-
-            sqlite3_bind_int64(stmt, 1, e2NodeId);
-            sqlite3_bind_int64(stmt, 2, t.GetTimeStep());
-            sqlite3_bind_int(stmt, 3, rnti);
-            sqlite3_bind_int(stmt, 4, cellId);
-            sqlite3_bind_double(stmt, 5, rsrp);
-            sqlite3_bind_double(stmt, 6, rsrq);
-            sqlite3_bind_int(stmt, 7, isServing);
-            sqlite3_bind_int(stmt, 8, componentCarrierId);
-
-            rc = sqlite3_step(stmt);
-
-            CheckQueryReturnCode(stmt,
-                                 rc,
-                                 FormatBoundArgsList(e2NodeId,
-                                                     t.GetTimeStep(),
-                                                     rnti,
-                                                     cellId,
-                                                     rsrp,
-                                                     rsrq,
-                                                     isServing,
-                                                     componentCarrierId));
-            sqlite3_finalize(stmt);
+            ImportLteUeRsrpRsrq(e2NodeId,
+                                t,
+                                rnti,
+                                cellId,
+                                rsrp,
+                                rsrq,
+                                isServing,
+                                componentCarrierId);
         }
     }
 }
@@ -438,13 +409,7 @@ OranDataRepositorySqlite::GetNodePositions(uint64_t e2NodeId,
         if (IsNodeRegistered(e2NodeId))
         {
             int rc;
-            sqlite3_stmt* stmt = nullptr;
-
-            sqlite3_prepare_v2(m_db,
-                               m_queryStmtsStrings[GET_NODE_ALL_POSITIONS].c_str(),
-                               -1,
-                               &stmt,
-                               0);
+            sqlite3_stmt* stmt = GetReadStatement(GET_NODE_ALL_POSITIONS);
 
             sqlite3_bind_int64(stmt, 1, e2NodeId);
             sqlite3_bind_int64(stmt, 2, fromTime.GetTimeStep());
@@ -464,16 +429,119 @@ OranDataRepositorySqlite::GetNodePositions(uint64_t e2NodeId,
                 nodePositions[t] = pos;
             }
 
-            CheckQueryReturnCode(
-                stmt,
-                rc,
-                FormatBoundArgsList(e2NodeId, fromTime.GetTimeStep(), toTime.GetTimeStep()));
-            sqlite3_finalize(stmt);
+            CheckQuery(stmt, rc, e2NodeId, fromTime.GetTimeStep(), toTime.GetTimeStep());
+            ResetStatement(stmt);
+
+            // The locations between the stored ones of a compressed history
+            // are rebuilt at the bounds of the requested period
+            if (m_positionTolerance > 0 && maxEntries > 0)
+            {
+                bool found;
+                Vector pos;
+
+                if (nodePositions.empty() || nodePositions.rbegin()->first < toTime)
+                {
+                    std::tie(found, pos) = InterpolatePosition(e2NodeId, toTime);
+                    if (found)
+                    {
+                        nodePositions[toTime] = pos;
+                        if (nodePositions.size() > maxEntries)
+                        {
+                            nodePositions.erase(nodePositions.begin());
+                        }
+                    }
+                }
+
+                if (!nodePositions.empty() && nodePositions.size() < maxEntries &&
+                    nodePositions.begin()->first > fromTime)
+                {
+                    std::tie(found, pos) = InterpolatePosition(e2NodeId, fromTime);
+                    if (found)
+                    {
+                        nodePositions[fromTime] = pos;
+                    }
+                }
+            }
         }
     }
     return nodePositions;
 }
 
+std::tuple<bool, Time, Vector>
+OranDataRepositorySqlite::GetLatestNodePosition(uint64_t e2NodeId)
+{
+    NS_LOG_FUNCTION(this << e2NodeId);
+
+    auto retVal = std::make_tuple(false, Time(), Vector());
+
+    if (m_active)
+    {
+        if (IsNodeRegistered(e2NodeId))
+        {
+            int rc;
+            sqlite3_stmt* stmt = GetReadStatement(GET_NODE_LATEST_POSITION);
+
+            sqlite3_bind_int64(stmt, 1, e2NodeId);
+
+            while ((rc = sqlite3_step(stmt)) == SQLITE_ROW)
+            {
+                retVal = std::make_tuple(true,
+                                         Time(sqlite3_column_int64(stmt, 0)),
+                                         Vector(sqlite3_column_double(stmt, 1),
+                                                sqlite3_column_double(stmt, 2),
+                                                sqlite3_column_double(stmt, 3)));
+            }
+
+            CheckQuery(stmt, rc, e2NodeId);
+            ResetStatement(stmt);
+        }
+    }
+    return retVal;
+}
+
+void
+OranDataRepositorySqlite::ForEachNodePosition(uint64_t e2NodeId,
+                                              Time fromTime,
+                                              Time toTime,
+                                              uint64_t maxEntries,
+                                              const NodePositionVisitor& visitor)
+{
+    NS_LOG_FUNCTION(this << e2NodeId << fromTime << toTime << maxEntries);
+
+    // The positions rebuilt at the bounds of a compressed history are added
+    // by GetNodePositions
+    if (m_positionTolerance > 0)
+    {
+        OranDataRepository::ForEachNodePosition(e2NodeId, fromTime, toTime, maxEntries, visitor);
+        return;
+    }
+
+    if (m_active)
+    {
+        if (IsNodeRegistered(e2NodeId))
+        {
+            int rc;
+            sqlite3_stmt* stmt = GetReadStatement(GET_NODE_ALL_POSITIONS);
+
+            sqlite3_bind_int64(stmt, 1, e2NodeId);
+            sqlite3_bind_int64(stmt, 2, fromTime.GetTimeStep());
+            sqlite3_bind_int64(stmt, 3, toTime.GetTimeStep());
+            sqlite3_bind_int64(stmt, 4, maxEntries);
+
+            while ((rc = sqlite3_step(stmt)) == SQLITE_ROW)
+            {
+                visitor(Time(sqlite3_column_int64(stmt, 0)),
+                        Vector(sqlite3_column_double(stmt, 1),
+                               sqlite3_column_double(stmt, 2),
+                               sqlite3_column_double(stmt, 3)));
+            }
+
+            CheckQuery(stmt, rc, e2NodeId, fromTime.GetTimeStep(), toTime.GetTimeStep());
+            ResetStatement(stmt);
+        }
+    }
+}
+
 std::tuple<bool, uint16_t, uint16_t>
 OranDataRepositorySqlite::GetLteUeCellInfo(uint64_t e2NodeId)
 {
@@ -485,13 +553,8 @@ OranDataRepositorySqlite::GetLteUeCellInfo(uint64_t e2NodeId)
         if (IsNodeRegistered(e2NodeId))
         {
             int rc;
-            sqlite3_stmt* stmt = nullptr;
+            sqlite3_stmt* stmt = GetReadStatement(GET_LTE_UE_CELLINFO);
 
-            sqlite3_prepare_v2(m_db,
-                               m_queryStmtsStrings[GET_LTE_UE_CELLINFO].c_str(),
-                               -1,
-                               &stmt,
-                               0);
             sqlite3_bind_int64(stmt, 1, e2NodeId);
 
             while ((rc = sqlite3_step(stmt)) == SQLITE_ROW)
@@ -501,8 +564,8 @@ OranDataRepositorySqlite::GetLteUeCellInfo(uint64_t e2NodeId)
                 retVal = std::make_tuple(true, cellId, rnti);
             }
 
-            CheckQueryReturnCode(stmt, rc, FormatBoundArgsList(e2NodeId));
-            sqlite3_finalize(stmt);
+            CheckQuery(stmt, rc, e2NodeId);
+            ResetStatement(stmt);
         }
     }
     return retVal;
@@ -518,16 +581,7 @@ OranDataRepositorySqlite::GetLteUeE2NodeIds()
     if (m_active)
     {
         int rc;
-        sqlite3_stmt* stmt = nullptr;
-
-        if (sqlite3_prepare_v2(m_db,
-                               m_queryStmtsStrings[GET_LTE_ALL_UE_E2NODEIDS].c_str(),
-                               -1,
-                               &stmt,
-                               0) != SQLITE_OK)
-        {
-            std::cerr << "SQL Error: " << sqlite3_errmsg(m_db) << std::endl;
-        }
+        sqlite3_stmt* stmt = GetReadStatement(GET_LTE_ALL_UE_E2NODEIDS);
 
         while ((rc = sqlite3_step(stmt)) == SQLITE_ROW)
         {
@@ -535,7 +589,7 @@ OranDataRepositorySqlite::GetLteUeE2NodeIds()
         }
 
         CheckQueryReturnCode(stmt, rc);
-        sqlite3_finalize(stmt);
+        ResetStatement(stmt);
     }
     return e2NodeIds;
 }
@@ -552,16 +606,7 @@ OranDataRepositorySqlite::GetAppLoss(uint64_t e2NodeId)
         if (IsNodeRegistered(e2NodeId))
         {
             int rc;
-            std::string query;
-            sqlite3_stmt* stmt = nullptr;
-
-            query = "SELECT loss"
-                    " FROM nodeapploss"
-                    " WHERE nodeid = ?"
-                    " ORDER BY entryid DESC LIMIT 1"
-                    ";";
-
-            sqlite3_prepare_v2(m_db, query.c_str(), -1, &stmt, 0);
+            sqlite3_stmt* stmt = GetReadStatement(GET_NODE_APPLOSS);
 
             sqlite3_bind_int64(stmt, 1, e2NodeId);
 
@@ -570,8 +615,8 @@ OranDataRepositorySqlite::GetAppLoss(uint64_t e2NodeId)
                 loss = sqlite3_column_double(stmt, 0);
             }
 
-            CheckQueryReturnCode(stmt, rc, FormatBoundArgsList(e2NodeId));
-            sqlite3_finalize(stmt);
+            CheckQuery(stmt, rc, e2NodeId);
+            ResetStatement(stmt);
         }
     }
     return loss;
@@ -586,13 +631,8 @@ OranDataRepositorySqlite::GetLteUeE2NodeIdFromCellInfo(uint16_t cellId, uint16_t
     if (m_active)
     {
         int rc;
-        sqlite3_stmt* stmt = nullptr;
+        sqlite3_stmt* stmt = GetReadStatement(GET_LTE_UE_E2NODEID_FROM_CELLINFO);
 
-        sqlite3_prepare_v2(m_db,
-                           m_queryStmtsStrings[GET_LTE_UE_E2NODEID_FROM_CELLINFO].c_str(),
-                           -1,
-                           &stmt,
-                           0);
         sqlite3_bind_int(stmt, 1, cellId);
         sqlite3_bind_int(stmt, 2, rnti);
 
@@ -601,8 +641,8 @@ OranDataRepositorySqlite::GetLteUeE2NodeIdFromCellInfo(uint16_t cellId, uint16_t
             id = sqlite3_column_int64(stmt, 0);
         }
 
-        CheckQueryReturnCode(stmt, rc, FormatBoundArgsList(cellId, rnti));
-        sqlite3_finalize(stmt);
+        CheckQuery(stmt, rc, cellId, rnti);
+        ResetStatement(stmt);
     }
     return id;
 }
@@ -618,13 +658,8 @@ OranDataRepositorySqlite::GetLteEnbCellInfo(uint64_t e2NodeId)
         if (IsNodeRegistered(e2NodeId))
         {
             int rc;
-            sqlite3_stmt* stmt = nullptr;
+            sqlite3_stmt* stmt = GetReadStatement(GET_LTE_CELLID_FROM_E2NODEID);
 
-            sqlite3_prepare_v2(m_db,
-                               m_queryStmtsStrings[GET_LTE_CELLID_FROM_E2NODEID].c_str(),
-                               -1,
-                               &stmt,
-                               0);
             sqlite3_bind_int64(stmt, 1, e2NodeId);
 
             while ((rc = sqlite3_step(stmt)) == SQLITE_ROW)
@@ -633,8 +668,8 @@ OranDataRepositorySqlite::GetLteEnbCellInfo(uint64_t e2NodeId)
                 retVal = std::make_tuple(true, cellId);
             }
 
-            CheckQueryReturnCode(stmt, rc, FormatBoundArgsList(e2NodeId));
-            sqlite3_finalize(stmt);
+            CheckQuery(stmt, rc, e2NodeId);
+            ResetStatement(stmt);
         }
     }
     return retVal;
@@ -650,13 +685,7 @@ OranDataRepositorySqlite::GetLteEnbE2NodeIds()
     if (m_active)
     {
         int rc;
-        sqlite3_stmt* stmt = nullptr;
-
-        sqlite3_prepare_v2(m_db,
-                           m_queryStmtsStrings[GET_LTE_ALL_ENB_E2NODEIDS].c_str(),
-                           -1,
-                           &stmt,
-                           0);
+        sqlite3_stmt* stmt = GetReadStatement(GET_LTE_ALL_ENB_E2NODEIDS);
 
         while ((rc = sqlite3_step(stmt)) == SQLITE_ROW)
         {
@@ -664,7 +693,7 @@ OranDataRepositorySqlite::GetLteEnbE2NodeIds()
         }
 
         CheckQueryReturnCode(stmt, rc);
-        sqlite3_finalize(stmt);
+        ResetStatement(stmt);
     }
     return e2NodeIds;
 }
@@ -678,13 +707,7 @@ OranDataRepositorySqlite::GetLastRegistrationRequests()
     if (m_active)
     {
         int rc;
-        sqlite3_stmt* stmt = nullptr;
-
-        sqlite3_prepare_v2(m_db,
-                           m_queryStmtsStrings[GET_ALL_LAST_REGISTRATION_TIMES].c_str(),
-                           -1,
-                           &stmt,
-                           0);
+        sqlite3_stmt* stmt = GetReadStatement(GET_ALL_LAST_REGISTRATION_TIMES);
 
         while ((rc = sqlite3_step(stmt)) == SQLITE_ROW)
         {
@@ -695,7 +718,7 @@ OranDataRepositorySqlite::GetLastRegistrationRequests()
         }
 
         CheckQueryReturnCode(stmt, rc);
-        sqlite3_finalize(stmt);
+        ResetStatement(stmt);
     }
 
     return requests;
@@ -713,15 +736,9 @@ OranDataRepositorySqlite::GetLteUeRsrpRsrq(uint64_t e2NodeId)
         if (IsNodeRegistered(e2NodeId))
         {
             int rc;
-            sqlite3_stmt* stmt = nullptr;
+            sqlite3_stmt* stmt = GetReadStatement(GET_LTE_UE_RSRP_RSRQ);
 
-            sqlite3_prepare_v2(m_db,
-                               m_queryStmtsStrings[GET_LTE_UE_RSRP_RSRQ].c_str(),
-                               -1,
-                               &stmt,
-                               0);
             sqlite3_bind_int64(stmt, 1, e2NodeId);
-            sqlite3_bind_int64(stmt, 2, e2NodeId);
 
             while ((rc = sqlite3_step(stmt)) == SQLITE_ROW)
             {
@@ -736,266 +753,2310 @@ OranDataRepositorySqlite::GetLteUeRsrpRsrq(uint64_t e2NodeId)
                     std::make_tuple(rnti, cellId, rsrp, rsrq, isServing, componentCarrierId));
             }
 
-            CheckQueryReturnCode(stmt, rc, FormatBoundArgsList(e2NodeId, e2NodeId));
-            sqlite3_finalize(stmt);
+            CheckQuery(stmt, rc, e2NodeId);
+            ResetStatement(stmt);
         }
     }
     return retVal;
 }
 
 void
-OranDataRepositorySqlite::LogCommandE2Terminator(Ptr<OranCommand> cmd)
+OranDataRepositorySqlite::ForEachLteUeRsrpRsrq(uint64_t e2NodeId,
+                                               const LteUeRsrpRsrqVisitor& visitor)
 {
-    NS_LOG_FUNCTION(this);
+    NS_LOG_FUNCTION(this << e2NodeId);
 
     if (m_active)
     {
-        if (IsNodeRegistered(cmd->GetTargetE2NodeId()))
+        if (IsNodeRegistered(e2NodeId))
         {
             int rc;
-            sqlite3_stmt* stmt = nullptr;
-
-            sqlite3_prepare_v2(m_db,
-                               m_queryStmtsStrings[LOG_E2TERMINATOR_COMMAND].c_str(),
-                               -1,
-                               &stmt,
-                               0);
-
-            sqlite3_bind_int64(stmt, 1, cmd->GetTargetE2NodeId());
-            sqlite3_bind_int64(stmt, 2, Simulator::Now().GetTimeStep());
-            sqlite3_bind_text(stmt, 3, cmd->ToString().c_str(), -1, 0);
-
-            rc = sqlite3_step(stmt);
-            CheckQueryReturnCode(stmt,
-                                 rc,
-                                 FormatBoundArgsList(cmd->GetTargetE2NodeId(),
-                                                     Simulator::Now().GetTimeStep(),
-                                                     cmd->ToString()));
-            sqlite3_finalize(stmt);
+            sqlite3_stmt* stmt = GetReadStatement(GET_LTE_UE_RSRP_RSRQ);
+
+            sqlite3_bind_int64(stmt, 1, e2NodeId);
+
+            while ((rc = sqlite3_step(stmt)) == SQLITE_ROW)
+            {
+                visitor(sqlite3_column_int(stmt, 0),
+                        sqlite3_column_int(stmt, 1),
+                        sqlite3_column_double(stmt, 2),
+                        sqlite3_column_double(stmt, 3),
+                        sqlite3_column_int(stmt, 4),
+                        sqlite3_column_int(stmt, 5));
+            }
+
+            CheckQuery(stmt, rc, e2NodeId);
+            ResetStatement(stmt);
         }
     }
 }
 
-void
-OranDataRepositorySqlite::LogCommandLm(std::string lm, Ptr<OranCommand> cmd)
+OranDataRepository::LteUeSnapshot
+OranDataRepositorySqlite::GetLteUeSnapshot()
 {
     NS_LOG_FUNCTION(this);
 
+    LteUeSnapshot snapshot;
+
     if (m_active)
     {
         int rc;
-        sqlite3_stmt* stmt = nullptr;
+        sqlite3_stmt* stmt = GetReadStatement(GET_LTE_UE_SNAPSHOT);
 
-        sqlite3_prepare_v2(m_db, m_queryStmtsStrings[LOG_LM_COMMAND].c_str(), -1, &stmt, 0);
+        while ((rc = sqlite3_step(stmt)) == SQLITE_ROW)
+        {
+            uint64_t e2NodeId = sqlite3_column_int64(stmt, 0);
 
-        sqlite3_bind_text(stmt, 1, lm.c_str(), -1, 0);
-        sqlite3_bind_int64(stmt, 2, Simulator::Now().GetTimeStep());
-        sqlite3_bind_text(stmt, 3, cmd->ToString().c_str(), -1, 0);
+            // The registration state is kept in memory
+            if (IsNodeRegistered(e2NodeId))
+            {
+                snapshot.e2NodeIds.push_back(e2NodeId);
+                snapshot.cellIds.push_back(sqlite3_column_int(stmt, 1));
+                snapshot.rntis.push_back(sqlite3_column_int(stmt, 2));
+                snapshot.positions.emplace_back(sqlite3_column_double(stmt, 3),
+                                                sqlite3_column_double(stmt, 4),
+                                                sqlite3_column_double(stmt, 5));
+                snapshot.appLosses.push_back(sqlite3_column_double(stmt, 6));
+            }
+        }
 
-        rc = sqlite3_step(stmt);
-        CheckQueryReturnCode(
-            stmt,
-            rc,
-            FormatBoundArgsList(lm, Simulator::Now().GetTimeStep(), cmd->ToString()));
-        sqlite3_finalize(stmt);
+        CheckQueryReturnCode(stmt, rc);
+        ResetStatement(stmt);
     }
+    return snapshot;
 }
 
-void
-OranDataRepositorySqlite::LogActionLm(std::string lm, std::string logStr)
+OranDataRepository::LteEnbSnapshot
+OranDataRepositorySqlite::GetLteEnbSnapshot()
 {
-    NS_LOG_FUNCTION(this << lm << logStr);
+    NS_LOG_FUNCTION(this);
+
+    LteEnbSnapshot snapshot;
 
     if (m_active)
     {
         int rc;
-        sqlite3_stmt* stmt = nullptr;
+        sqlite3_stmt* stmt = GetReadStatement(GET_LTE_ENB_SNAPSHOT);
 
-        sqlite3_prepare_v2(m_db, m_queryStmtsStrings[LOG_LM_ACTION].c_str(), -1, &stmt, 0);
-
-        sqlite3_bind_text(stmt, 1, lm.c_str(), -1, 0);
-        sqlite3_bind_int64(stmt, 2, Simulator::Now().GetTimeStep());
-        sqlite3_bind_text(stmt, 3, logStr.c_str(), -1, 0);
+        while ((rc = sqlite3_step(stmt)) == SQLITE_ROW)
+        {
+            uint64_t e2NodeId = sqlite3_column_int64(stmt, 0);
 
-        rc = sqlite3_step(stmt);
+            // The registration state is kept in memory
+            if (IsNodeRegistered(e2NodeId))
+            {
+                snapshot.e2NodeIds.push_back(e2NodeId);
+                snapshot.cellIds.push_back(sqlite3_column_int(stmt, 1));
+                snapshot.positions.emplace_back(sqlite3_column_double(stmt, 2),
+                                                sqlite3_column_double(stmt, 3),
+                                                sqlite3_column_double(stmt, 4));
+            }
+        }
 
-        CheckQueryReturnCode(stmt,
-                             rc,
-                             FormatBoundArgsList(lm, Simulator::Now().GetTimeStep(), logStr));
-        sqlite3_finalize(stmt);
+        CheckQueryReturnCode(stmt, rc);
+        ResetStatement(stmt);
     }
+    return snapshot;
 }
 
 void
-OranDataRepositorySqlite::LogActionCmm(std::string cmm, std::string logStr)
+OranDataRepositorySqlite::LogCommandE2Terminator(Ptr<OranCommand> cmd)
 {
-    NS_LOG_FUNCTION(this << cmm << logStr);
+    NS_LOG_FUNCTION(this);
 
     if (m_active)
     {
-        int rc;
-        sqlite3_stmt* stmt = nullptr;
-
-        sqlite3_prepare_v2(m_db, m_queryStmtsStrings[LOG_CMM_ACTION].c_str(), -1, &stmt, 0);
-
-        sqlite3_bind_text(stmt, 1, cmm.c_str(), -1, 0);
-        sqlite3_bind_int64(stmt, 2, Simulator::Now().GetTimeStep());
-        sqlite3_bind_text(stmt, 3, logStr.c_str(), -1, 0);
-
-        rc = sqlite3_step(stmt);
-
-        CheckQueryReturnCode(stmt,
-                             rc,
-                             FormatBoundArgsList(cmm, Simulator::Now().GetTimeStep(), logStr));
-        sqlite3_finalize(stmt);
+        if (IsNodeRegistered(cmd->GetTargetE2NodeId()))
+        {
+            ImportCommandE2Terminator(cmd->GetTargetE2NodeId(),
+                                      Simulator::Now(),
+                                      cmd->ToString());
+        }
     }
 }
 
 void
-OranDataRepositorySqlite::CheckQueryReturnCode(sqlite3_stmt* stmt,
-                                               int rc,
-                                               std::string boundParmsStr) const
+OranDataRepositorySqlite::LogCommandLm(std::string lm, Ptr<OranCommand> cmd)
 {
-    NS_LOG_FUNCTION(this << stmt << rc);
-
-    // Get the formated string of the prepared statement
-    std::string stmtStr = sqlite3_sql(stmt);
-
-    // Trace the result of the query
-    m_queryRc(stmtStr, boundParmsStr, rc);
+    NS_LOG_FUNCTION(this);
 
-    if (rc == SQLITE_OK || rc == SQLITE_DONE)
-    {
-        NS_LOG_INFO("Query SUCCESSFUL: \"" << stmtStr << "\"; " << boundParmsStr);
-    }
-    else
+    if (m_active)
     {
-        NS_ABORT_MSG("Query FAILED: \"" << stmtStr << "\"; (" << boundParmsStr << "); RC = " << rc);
+        ImportCommandLm(lm, Simulator::Now(), cmd->ToString());
     }
 }
 
 void
-OranDataRepositorySqlite::CloseDb()
+OranDataRepositorySqlite::LogActionLm(std::string lm, std::string logStr)
 {
-    NS_LOG_FUNCTION(this);
+    NS_LOG_FUNCTION(this << lm << logStr);
 
-    sqlite3_close(m_db);
-    m_db = nullptr;
+    if (m_active)
+    {
+        ImportActionLm(lm, Simulator::Now(), logStr);
+    }
 }
 
 void
-OranDataRepositorySqlite::DoDispose()
+OranDataRepositorySqlite::LogActionCmm(std::string cmm, std::string logStr)
 {
-    NS_LOG_FUNCTION(this);
+    NS_LOG_FUNCTION(this << cmm << logStr);
 
-    if (IsDbOpen())
+    if (m_active)
     {
-        CloseDb();
+        ImportActionCmm(cmm, Simulator::Now(), logStr);
     }
-
-    OranDataRepository::DoDispose();
+}
+
+void
+OranDataRepositorySqlite::LogEventLm(const std::string& lm,
+                                     LogEvent event,
+                                     double arg0,
+                                     double arg1,
+                                     double arg2,
+                                     double arg3)
+{
+    NS_LOG_FUNCTION(this << lm << event << arg0 << arg1 << arg2 << arg3);
+
+    if (m_active)
+    {
+        ImportEventLm(lm, Simulator::Now(), event, arg0, arg1, arg2, arg3);
+    }
+}
+
+void
+OranDataRepositorySqlite::LogEventCmm(const std::string& cmm,
+                                      LogEvent event,
+                                      double arg0,
+                                      double arg1,
+                                      double arg2,
+                                      double arg3)
+{
+    NS_LOG_FUNCTION(this << cmm << event << arg0 << arg1 << arg2 << arg3);
+
+    if (m_active)
+    {
+        ImportEventCmm(cmm, Simulator::Now(), event, arg0, arg1, arg2, arg3);
+    }
+}
+
+void
+OranDataRepositorySqlite::ImportNode(uint64_t e2NodeId, OranNearRtRic::NodeType type)
+{
+    NS_LOG_FUNCTION(this << e2NodeId << type);
+
+    if (m_active)
+    {
+        WriteOp op = {INSERT_NODE_UPDATE};
+        op.AddInteger(e2NodeId);
+        op.AddInteger(type);
+
+        BeginWrite();
+        SubmitWrite(op);
+        EndWrite();
+
+        m_nextE2NodeId = std::max(m_nextE2NodeId, e2NodeId + 1);
+    }
+}
+
+void
+OranDataRepositorySqlite::ImportNodeLteUe(uint64_t e2NodeId, uint64_t imsi)
+{
+    NS_LOG_FUNCTION(this << e2NodeId << imsi);
+
+    if (m_active)
+    {
+        WriteOp op = {INSERT_LTE_UE_NODE};
+        op.AddInteger(e2NodeId);
+        op.AddInteger(imsi);
+
+        BeginWrite();
+        SubmitWrite(op);
+        EndWrite();
+    }
+}
+
+void
+OranDataRepositorySqlite::ImportNodeLteEnb(uint64_t e2NodeId, uint16_t cellId)
+{
+    NS_LOG_FUNCTION(this << e2NodeId << cellId);
+
+    if (m_active)
+    {
+        WriteOp op = {INSERT_LTE_ENB_NODE};
+        op.AddInteger(e2NodeId);
+        op.AddInteger(cellId);
+
+        BeginWrite();
+        SubmitWrite(op);
+        EndWrite();
+    }
+}
+
+void
+OranDataRepositorySqlite::ImportNodeRegistration(uint64_t e2NodeId, bool registered, Time t)
+{
+    NS_LOG_FUNCTION(this << e2NodeId << registered << t);
+
+    if (m_active)
+    {
+        int64_t ts = t.GetTimeStep();
+
+        WriteOp op = {INSERT_NODE_REGISTRATION};
+        op.AddInteger(e2NodeId);
+        op.AddInteger(registered);
+        op.AddInteger(ts);
+
+        BeginWrite();
+        SubmitWrite(op);
+        EndWrite();
+
+        m_registeredNodes[e2NodeId] = registered;
+    }
+}
+
+void
+OranDataRepositorySqlite::ImportPosition(uint64_t e2NodeId, Vector pos, Time t)
+{
+    NS_LOG_FUNCTION(this << e2NodeId << pos << t);
+
+    if (m_active)
+    {
+        int64_t ts = t.GetTimeStep();
+        uint64_t seq = 0;
+        bool insert = true;
+        bool updateTail = false;
+        int64_t tailTs = 0;
+        uint64_t tailSeq = 0;
+        Vector tailPos;
+        int64_t tailNewTs = 0;
+
+        if (m_positionTolerance > 0)
+        {
+            const double infinity = std::numeric_limits<double>::infinity();
+            bool isNew = (m_positionTracks.find(e2NodeId) == m_positionTracks.end());
+            PositionTrack& track = m_positionTracks[e2NodeId];
+
+            if (!isNew && track.active && t > track.lastTime)
+            {
+                // Narrow the velocities of the segment to those that keep the
+                // new location within the tolerance on each axis
+                double axisTolerance = m_positionTolerance / std::sqrt(3.0);
+                double dt = (t - track.startTime).GetSeconds();
+                Vector minVelocity = track.minVelocity;
+                Vector maxVelocity = track.maxVelocity;
+                auto narrow = [axisTolerance, dt](double& minV, double& maxV, double from, double to) {
+                    minV = std::max(minV, (to - from - axisTolerance) / dt);
+                    maxV = std::min(maxV, (to - from + axisTolerance) / dt);
+                    return minV <= maxV;
+                };
+                bool follows = narrow(minVelocity.x, maxVelocity.x, track.startPos.x, pos.x);
+                follows = narrow(minVelocity.y, maxVelocity.y, track.startPos.y, pos.y) && follows;
+                follows = narrow(minVelocity.z, maxVelocity.z, track.startPos.z, pos.z) && follows;
+
+                if (follows && track.hasTail)
+                {
+                    // The new location follows the segment, so it replaces the last one
+                    insert = false;
+                    updateTail = true;
+                    tailPos = pos;
+                    tailNewTs = ts;
+                }
+                else if (!follows)
+                {
+                    // The last location ends the segment, moved to the middle of
+                    // the velocities that kept all its locations within the tolerance
+                    dt = (track.lastTime - track.startTime).GetSeconds();
+                    Vector endPos(
+                        track.startPos.x + (track.minVelocity.x + track.maxVelocity.x) / 2 * dt,
+                        track.startPos.y + (track.minVelocity.y + track.maxVelocity.y) / 2 * dt,
+                        track.startPos.z + (track.minVelocity.z + track.maxVelocity.z) / 2 * dt);
+
+                    updateTail = true;
+                    tailPos = endPos;
+                    tailNewTs = track.lastTime.GetTimeStep();
+
+                    // The new location is the first one of the next segment
+                    dt = (t - track.lastTime).GetSeconds();
+                    track.startTime = track.lastTime;
+                    track.startPos = endPos;
+                    minVelocity = Vector(-infinity, -infinity, -infinity);
+                    maxVelocity = Vector(infinity, infinity, infinity);
+                    narrow(minVelocity.x, maxVelocity.x, endPos.x, pos.x);
+                    narrow(minVelocity.y, maxVelocity.y, endPos.y, pos.y);
+                    narrow(minVelocity.z, maxVelocity.z, endPos.z, pos.z);
+                }
+
+                tailTs = track.lastTime.GetTimeStep();
+                tailSeq = track.lastSeq;
+                track.minVelocity = minVelocity;
+                track.maxVelocity = maxVelocity;
+                track.hasTail = true;
+            }
+            else if (isNew || t > track.lastTime)
+            {
+                // The first location of the node, or the first after the end of the track
+                track.active = true;
+                track.startTime = t;
+                track.startPos = pos;
+                track.minVelocity = Vector(-infinity, -infinity, -infinity);
+                track.maxVelocity = Vector(infinity, infinity, infinity);
+                track.hasTail = false;
+            }
+            else
+            {
+                // Locations that are not newer than the last one end the track
+                track.active = false;
+            }
+
+            if (insert && m_schemaVersion >= 2)
+            {
+                seq = m_nextSeq++;
+            }
+
+            if (isNew || t > track.lastTime)
+            {
+                track.lastTime = t;
+                track.lastSeq = (insert ? seq : tailSeq);
+            }
+        }
+        else if (m_schemaVersion >= 2)
+        {
+            seq = m_nextSeq++;
+        }
+
+        BeginWrite();
+
+        if (updateTail)
+        {
+            WriteOp op = {UPDATE_NODE_LOCATION};
+            op.AddInteger(e2NodeId);
+            op.AddReal(tailPos.x);
+            op.AddReal(tailPos.y);
+            op.AddReal(tailPos.z);
+            op.AddInteger(tailNewTs);
+            op.AddInteger(tailTs);
+
+            if (m_schemaVersion >= 2)
+            {
+                op.AddInteger(tailSeq);
+            }
+
+            SubmitWrite(op);
+        }
+
+        if (insert)
+        {
+            WriteOp op = {INSERT_NODE_LOCATION};
+            op.AddInteger(e2NodeId);
+            op.AddReal(pos.x);
+            op.AddReal(pos.y);
+            op.AddReal(pos.z);
+            op.AddInteger(ts);
+
+            if (m_schemaVersion >= 2)
+            {
+                op.AddInteger(seq);
+            }
+
+            SubmitWrite(op);
+        }
+
+        // Keep the latest position of the node
+        WriteOp op = {INSERT_NODE_LOCATION_LATEST};
+        op.AddInteger(e2NodeId);
+        op.AddReal(pos.x);
+        op.AddReal(pos.y);
+        op.AddReal(pos.z);
+        op.AddInteger(ts);
+
+        SubmitWrite(op);
+        EndWrite();
+    }
+}
+
+void
+OranDataRepositorySqlite::ImportLteUeCellInfo(uint64_t e2NodeId,
+                                              uint16_t cellId,
+                                              uint16_t rnti,
+                                              Time t)
+{
+    NS_LOG_FUNCTION(this << e2NodeId << (uint32_t)cellId << (uint32_t)rnti << t);
+
+    if (m_active)
+    {
+        int64_t ts = t.GetTimeStep();
+        uint64_t seq = (m_schemaVersion >= 2 ? m_nextSeq++ : 0);
+
+        WriteOp op = {INSERT_LTE_UE_CELL};
+        op.AddInteger(e2NodeId);
+        op.AddInteger(cellId);
+        op.AddInteger(rnti);
+        op.AddInteger(ts);
+
+        if (m_schemaVersion >= 2)
+        {
+            op.AddInteger(seq);
+        }
+
+        // Keep the latest cell information of the node
+        WriteOp latestOp = {INSERT_LTE_UE_CELL_LATEST};
+        latestOp.AddInteger(e2NodeId);
+        latestOp.AddInteger(cellId);
+        latestOp.AddInteger(rnti);
+        latestOp.AddInteger(ts);
+
+        BeginWrite();
+        SubmitWrite(op);
+        SubmitWrite(latestOp);
+        EndWrite();
+    }
+}
+
+void
+OranDataRepositorySqlite::ImportAppLoss(uint64_t e2NodeId, double appLoss, Time t)
+{
+    NS_LOG_FUNCTION(this << e2NodeId << appLoss << t);
+
+    if (m_active)
+    {
+        int64_t ts = t.GetTimeStep();
+        uint64_t seq = (m_schemaVersion >= 2 ? m_nextSeq++ : 0);
+
+        WriteOp op = {INSERT_NODE_APPLOSS};
+        op.AddInteger(e2NodeId);
+        op.AddReal(appLoss);
+        op.AddInteger(ts);
+
+        if (m_schemaVersion >= 2)
+        {
+            op.AddInteger(seq);
+        }
+
+        // Keep the latest application loss of the node
+        WriteOp latestOp = {INSERT_NODE_APPLOSS_LATEST};
+        latestOp.AddInteger(e2NodeId);
+        latestOp.AddReal(appLoss);
+        latestOp.AddInteger(ts);
+
+        BeginWrite();
+        SubmitWrite(op);
+        SubmitWrite(latestOp);
+        EndWrite();
+    }
+}
+
+void
+OranDataRepositorySqlite::ImportLteUeRsrpRsrq(uint64_t e2NodeId,
+                                              Time t,
+                                              uint16_t rnti,
+                                              uint16_t cellId,
+                                              double rsrp,
+                                              double rsrq,
+                                              bool isServing,
+                                              uint8_t componentCarrierId)
+{
+    NS_LOG_FUNCTION(this << e2NodeId << t << +rnti << +cellId << rsrp << rsrq << isServing
+                         << +componentCarrierId);
+
+    if (m_active)
+    {
+        int64_t ts = t.GetTimeStep();
+        uint64_t seq = (m_schemaVersion >= 2 ? m_nextSeq++ : 0);
+
+        WriteOp op = {INSERT_LTE_UE_RSRP_RSRQ};
+        op.AddInteger(e2NodeId);
+        op.AddInteger(ts);
+        op.AddInteger(rnti);
+        op.AddInteger(cellId);
+        op.AddReal(rsrp);
+        op.AddReal(rsrq);
+        op.AddInteger(isServing);
+        op.AddInteger(componentCarrierId);
+
+        if (m_schemaVersion >= 2)
+        {
+            op.AddInteger(seq);
+        }
+
+        // Keep the latest measurements of the node, discarding older ones
+        WriteOp deleteOp = {DELETE_LTE_UE_RSRP_RSRQ_LATEST};
+        deleteOp.AddInteger(e2NodeId);
+        deleteOp.AddInteger(ts);
+
+        WriteOp latestOp = {INSERT_LTE_UE_RSRP_RSRQ_LATEST};
+        latestOp.AddInteger(e2NodeId);
+        latestOp.AddInteger(ts);
+        latestOp.AddInteger(rnti);
+        latestOp.AddInteger(cellId);
+        latestOp.AddReal(rsrp);
+        latestOp.AddReal(rsrq);
+        latestOp.AddInteger(isServing);
+        latestOp.AddInteger(componentCarrierId);
+
+        BeginWrite();
+        SubmitWrite(op);
+        SubmitWrite(deleteOp);
+        SubmitWrite(latestOp);
+        EndWrite();
+    }
+}
+
+void
+OranDataRepositorySqlite::ImportCommandE2Terminator(uint64_t targetE2NodeId,
+                                                    Time t,
+                                                    const std::string& cmd)
+{
+    NS_LOG_FUNCTION(this << targetE2NodeId << t << cmd);
+
+    if (m_active)
+    {
+        int64_t ts = t.GetTimeStep();
+
+        WriteOp op = {LOG_E2TERMINATOR_COMMAND};
+        op.AddInteger(targetE2NodeId);
+        op.AddInteger(ts);
+        op.AddText(cmd);
+
+        BeginWrite();
+        SubmitWrite(op);
+        EndWrite();
+    }
+}
+
+void
+OranDataRepositorySqlite::ImportCommandLm(const std::string& lm, Time t, const std::string& cmd)
+{
+    NS_LOG_FUNCTION(this << lm << t << cmd);
+
+    if (m_active)
+    {
+        int64_t ts = t.GetTimeStep();
+
+        WriteOp op = {LOG_LM_COMMAND};
+        op.AddText(lm);
+        op.AddInteger(ts);
+        op.AddText(cmd);
+
+        BeginWrite();
+        SubmitWrite(op);
+        EndWrite();
+    }
+}
+
+void
+OranDataRepositorySqlite::ImportActionLm(const std::string& lm, Time t, const std::string& logStr)
+{
+    NS_LOG_FUNCTION(this << lm << t << logStr);
+
+    if (m_active)
+    {
+        int64_t ts = t.GetTimeStep();
+
+        WriteOp op = {LOG_LM_ACTION};
+        op.AddText(lm);
+        op.AddInteger(ts);
+        op.AddText(logStr);
+
+        BeginWrite();
+        SubmitWrite(op);
+        EndWrite();
+    }
+}
+
+void
+OranDataRepositorySqlite::ImportActionCmm(const std::string& cmm,
+                                          Time t,
+                                          const std::string& logStr)
+{
+    NS_LOG_FUNCTION(this << cmm << t << logStr);
+
+    if (m_active)
+    {
+        int64_t ts = t.GetTimeStep();
+
+        WriteOp op = {LOG_CMM_ACTION};
+        op.AddText(cmm);
+        op.AddInteger(ts);
+        op.AddText(logStr);
+
+        BeginWrite();
+        SubmitWrite(op);
+        EndWrite();
+    }
+}
+
+void
+OranDataRepositorySqlite::ImportEventLm(const std::string& lm,
+                                        Time t,
+                                        LogEvent event,
+                                        double arg0,
+                                        double arg1,
+                                        double arg2,
+                                        double arg3)
+{
+    NS_LOG_FUNCTION(this << lm << t << event << arg0 << arg1 << arg2 << arg3);
+
+    ImportEvent(LOG_LM_EVENT, lm, t, event, arg0, arg1, arg2, arg3);
+}
+
+void
+OranDataRepositorySqlite::ImportEventCmm(const std::string& cmm,
+                                         Time t,
+                                         LogEvent event,
+                                         double arg0,
+                                         double arg1,
+                                         double arg2,
+                                         double arg3)
+{
+    NS_LOG_FUNCTION(this << cmm << t << event << arg0 << arg1 << arg2 << arg3);
+
+    ImportEvent(LOG_CMM_EVENT, cmm, t, event, arg0, arg1, arg2, arg3);
+}
+
+void
+OranDataRepositorySqlite::ImportEvent(StatementType type,
+                                      const std::string& name,
+                                      Time t,
+                                      LogEvent event,
+                                      double arg0,
+                                      double arg1,
+                                      double arg2,
+                                      double arg3)
+{
+    NS_LOG_FUNCTION(this << type << name << t << event << arg0 << arg1 << arg2 << arg3);
+
+    if (m_active)
+    {
+        int64_t ts = t.GetTimeStep();
+
+        BeginWrite();
+        // Only the numeric values are stored; the text is rendered when queried
+        WriteOp op = {type};
+        op.AddInteger(GetLogModuleId(name));
+        op.AddInteger(ts);
+        op.AddInteger(GetLogEventId(event));
+        op.AddReal(arg0);
+        op.AddReal(arg1);
+        op.AddReal(arg2);
+        op.AddReal(arg3);
+
+        SubmitWrite(op);
+        EndWrite();
+    }
+}
+
+void
+OranDataRepositorySqlite::CheckQueryReturnCode(sqlite3_stmt* stmt,
+                                               int rc,
+                                               std::string boundParmsStr) const
+{
+    NS_LOG_FUNCTION(this << stmt << rc);
+
+    // Successful queries are only reported if someone is listening
+    if (!IsQueryTraced(rc))
+    {
+        return;
+    }
+
+    // Get the formated string of the prepared statement
+    std::string stmtStr = sqlite3_sql(stmt);
+
+    // Trace the result of the query
+    m_queryRc(stmtStr, boundParmsStr, rc);
+
+    if (rc == SQLITE_OK || rc == SQLITE_DONE)
+    {
+        NS_LOG_INFO("Query SUCCESSFUL: \"" << stmtStr << "\"; " << boundParmsStr);
+    }
+    else
+    {
+        NS_ABORT_MSG("Query FAILED: \"" << stmtStr << "\"; (" << boundParmsStr << "); RC = " << rc);
+    }
+}
+
+bool
+OranDataRepositorySqlite::IsQueryTraced(int rc) const
+{
+    if (rc != SQLITE_OK && rc != SQLITE_DONE)
+    {
+        return true;
+    }
+
+    if (!m_queryRc.IsEmpty())
+    {
+        return true;
+    }
+
+#ifdef NS3_LOG_ENABLE
+    return g_log.IsEnabled(LOG_INFO);
+#else
+    return false;
+#endif
+}
+
+std::map<std::string, OranDataRepositorySqlite::QueryStats>
+OranDataRepositorySqlite::GetQueryStats() const
+{
+    NS_LOG_FUNCTION(this);
+
+    std::map<std::string, QueryStats> stats;
+
+    std::lock_guard<std::mutex> lock(m_queryStatsMutex);
+    for (uint32_t type = 0; type < m_queryStats.size(); type++)
+    {
+        if (m_queryStats[type].count > 0)
+        {
+            stats[GetStatementName(static_cast<StatementType>(type))] = m_queryStats[type];
+        }
+    }
+
+    return stats;
+}
+
+void
+OranDataRepositorySqlite::PrintQueryStats(std::ostream& os) const
+{
+    NS_LOG_FUNCTION(this);
+
+    // The upper bound, in microseconds, of the bucket that holds a percentile
+    auto getPercentile = [](const QueryStats& stats, double percentile) {
+        uint64_t rank = static_cast<uint64_t>(std::ceil(percentile * stats.count));
+        uint64_t seen = 0;
+        uint32_t bucket = 0;
+        for (; bucket < QUERY_LATENCY_BUCKETS - 1; bucket++)
+        {
+            seen += stats.histogram[bucket];
+            if (seen >= rank)
+            {
+                break;
+            }
+        }
+        double bound = static_cast<double>(2ULL << bucket) / 1000;
+        return std::min(bound, stats.maxTime.GetNanoSeconds() / 1000.0);
+    };
+
+    os << "statement,count,total_us,mean_us,min_us,max_us,p50_us,p99_us" << std::endl;
+    for (const auto& entry : GetQueryStats())
+    {
+        const QueryStats& stats = entry.second;
+        double totalUs = stats.totalTime.GetNanoSeconds() / 1000.0;
+
+        os << entry.first << "," << stats.count << "," << totalUs << ","
+           << totalUs / stats.count << "," << stats.minTime.GetNanoSeconds() / 1000.0 << ","
+           << stats.maxTime.GetNanoSeconds() / 1000.0 << "," << getPercentile(stats, 0.5) << ","
+           << getPercentile(stats, 0.99) << std::endl;
+    }
+}
+
+void
+OranDataRepositorySqlite::CloseDb()
+{
+    NS_LOG_FUNCTION(this);
+
+    FlushWrites();
+    StopWriter();
+    m_walCheckpointEvent.Cancel();
+    CloseReadDb();
+    FinalizeStatements();
+
+    if (m_queryStatsEnabled && !m_queryStatsPath.empty())
+    {
+        std::ofstream statsFile(m_queryStatsPath);
+        NS_ABORT_MSG_IF(!statsFile.is_open(),
+                        "Could not open the query statistics file " << m_queryStatsPath);
+        PrintQueryStats(statsFile);
+    }
+    m_registeredNodes.clear();
+    m_positionTracks.clear();
+    m_logModuleIds.clear();
+    m_logEventIds.clear();
+    m_logEventDbIds.clear();
+
+    sqlite3_close(m_db);
+    m_db = nullptr;
+}
+
+void
+OranDataRepositorySqlite::DoDispose()
+{
+    NS_LOG_FUNCTION(this);
+
+    if (IsDbOpen())
+    {
+        CloseDb();
+    }
+
+    OranDataRepository::DoDispose();
+}
+
+void
+OranDataRepositorySqlite::DoPruneHistory(HistoryType type,
+                                         Time minTime,
+                                         uint64_t maxRows,
+                                         uint32_t maxDeletes)
+{
+    NS_LOG_FUNCTION(this << type << minTime << maxRows << maxDeletes);
+
+    if (!IsDbOpen() || m_registeredNodes.empty())
+    {
+        return;
+    }
+
+    StatementType ageStmt;
+    StatementType countStmt;
+    switch (type)
+    {
+    case NODE_LOCATION:
+        ageStmt = PRUNE_NODE_LOCATION_AGE;
+        countStmt = PRUNE_NODE_LOCATION_COUNT;
+        break;
+    case LTE_UE_CELL:
+        ageStmt = PRUNE_LTE_UE_CELL_AGE;
+        countStmt = PRUNE_LTE_UE_CELL_COUNT;
+        break;
+    case LTE_UE_RSRP_RSRQ:
+        ageStmt = PRUNE_LTE_UE_RSRP_RSRQ_AGE;
+        countStmt = PRUNE_LTE_UE_RSRP_RSRQ_COUNT;
+        break;
+    case NODE_APPLOSS:
+        ageStmt = PRUNE_NODE_APPLOSS_AGE;
+        countStmt = PRUNE_NODE_APPLOSS_COUNT;
+        break;
+    case NODE_REGISTRATION:
+        ageStmt = PRUNE_NODE_REGISTRATION_AGE;
+        countStmt = PRUNE_NODE_REGISTRATION_COUNT;
+        break;
+    default:
+        NS_ABORT_MSG("Unknown type of history " << type);
+    }
+
+    std::vector<uint64_t> nodes;
+    nodes.reserve(m_registeredNodes.size());
+    for (const auto& node : m_registeredNodes)
+    {
+        nodes.push_back(node.first);
+    }
+    std::sort(nodes.begin(), nodes.end());
+
+    int64_t minTs = minTime.GetTimeStep();
+
+    // The deletes are run on this thread, as the number of rows deleted by
+    // each one is needed for the next, once the queued writes are executed
+    BeginWrite();
+    WaitForWrites();
+
+    // Visit the nodes starting after the last one pruned, so that all the
+    // nodes are pruned even if the budget is used up before the end
+    uint64_t& cursor = m_pruneCursors[type];
+    uint64_t budget = maxDeletes;
+    uint64_t visited = 0;
+
+    while (visited < nodes.size() && budget > 0)
+    {
+        uint64_t e2NodeId = nodes[(cursor + visited) % nodes.size()];
+        visited++;
+
+        if (minTs > 0)
+        {
+            sqlite3_stmt* stmt = GetStatement(ageStmt);
+
+            sqlite3_bind_int64(stmt, 1, e2NodeId);
+            sqlite3_bind_int64(stmt, 2, minTs);
+            sqlite3_bind_int64(stmt, 3, budget);
+
+            int rc = sqlite3_step(stmt);
+            CheckQuery(stmt, rc, e2NodeId, minTs, budget);
+            ResetStatement(stmt);
+
+            budget -= std::min<uint64_t>(budget, sqlite3_changes(m_db));
+        }
+
+        if (maxRows > 0 && budget > 0)
+        {
+            sqlite3_stmt* stmt = GetStatement(countStmt);
+
+            sqlite3_bind_int64(stmt, 1, e2NodeId);
+            sqlite3_bind_int64(stmt, 2, maxRows);
+            sqlite3_bind_int64(stmt, 3, budget);
+
+            int rc = sqlite3_step(stmt);
+            CheckQuery(stmt, rc, e2NodeId, maxRows, budget);
+            ResetStatement(stmt);
+
+            budget -= std::min<uint64_t>(budget, sqlite3_changes(m_db));
+        }
+    }
+
+    cursor = (cursor + visited) % nodes.size();
+
+    // The deletes are not submitted as writes, so the tables are marked as
+    // written by the open batch here, for the reads on the read-only
+    // connection to commit it first
+    if (m_batchOpen)
+    {
+        m_batchTables |= m_statementTables[ageStmt] | m_statementTables[countStmt];
+    }
+
+    EndWrite();
+}
+
+bool
+OranDataRepositorySqlite::IsDbOpen() const
+{
+    NS_LOG_FUNCTION(this);
+
+    return m_db != nullptr;
+}
+
+void
+OranDataRepositorySqlite::OpenDb()
+{
+    NS_LOG_FUNCTION(this);
+
+    // Check for special file names and print a warning if we find them
+    if (m_dbPath == ":memory:")
+    {
+        NS_LOG_WARN("Using in-memory DB for the ORAN Storage. DB will not be saved to disk.");
+        std::cerr
+            << "WARNING: Using in-memory DB for the ORAN Storage. DB will not be saved to disk."
+            << std::endl;
+    }
+    else
+    {
+        // Check for DB names that are URIs. We do not support those
+        if (m_dbPath.find(":") != std::string::npos)
+        {
+            NS_ABORT_MSG("File name for the ORAN Storage DB ("
+                         << m_dbPath << ") is an URI. URI-named DBs are not supported");
+        }
+    }
+
+    if (m_dbPath.empty())
+    {
+        NS_LOG_WARN("Using a randomly named temporary file as DB for the ORAN Storage. DB will not "
+                    "be available after simulation ends.");
+        std::cerr << "WARNING: Using a randomly named temporary file as DB for the ORAN Storage. "
+                     "DB will not be available after simulation ends."
+                  << std::endl;
+    }
+
+    // Reads may use the connection while the writer thread executes writes
+    // to other tables, so the connection is serialized if it is shared
+    int flags = SQLITE_OPEN_READWRITE | SQLITE_OPEN_CREATE;
+    if (m_asyncWrites)
+    {
+        flags |= SQLITE_OPEN_FULLMUTEX;
+    }
+
+    int error = sqlite3_open_v2(m_dbPath.c_str(), &m_db, flags, nullptr);
+    if (error != 0)
+    {
+        NS_ABORT_MSG("Could not open database: " << sqlite3_errmsg(m_db));
+    }
+    else
+    {
+        NS_LOG_INFO("Oran repository \"" << m_dbPath << "\" connected to successfully!");
+        ;
+    }
+
+    m_walActive = ConfigureJournal();
+
+    InitStatements();
+    InitStatementTables();
+    InitDb();
+    PrepareStatements();
+    OpenReadDb();
+    LoadRegistrations();
+    LoadLogModules();
+    LoadLogEvents();
+
+    if (m_schemaVersion >= 2)
+    {
+        LoadSequence();
+    }
+
+    if (m_walActive && m_walCheckpointInterval.IsStrictlyPositive())
+    {
+        m_walCheckpointEvent =
+            Simulator::Schedule(m_walCheckpointInterval,
+                                &OranDataRepositorySqlite::DoPeriodicCheckpoint,
+                                this);
+    }
+
+    if (m_asyncWrites)
+    {
+        StartWriter();
+    }
+}
+
+sqlite3_stmt*
+OranDataRepositorySqlite::GetStatement(StatementType type) const
+{
+    NS_LOG_FUNCTION(this << type);
+
+    if (!m_cacheStatements)
+    {
+        return CompileStatement(m_db, type);
+    }
+
+    auto it = m_queryStmts.find(type);
+
+    NS_ABORT_MSG_IF(it == m_queryStmts.end(),
+                    "Attempting to use a statement that has not been prepared (" << type << ")");
+
+    StartStatementTiming(it->second);
+
+    return it->second;
+}
+
+sqlite3_stmt*
+OranDataRepositorySqlite::GetReadStatement(StatementType type)
+{
+    NS_LOG_FUNCTION(this << type);
+
+    if (m_readDb == nullptr)
+    {
+        WaitForWrites(type);
+        return GetStatement(type);
+    }
+
+    // The read-only connection only sees the committed writes
+    if (m_batchTables & m_statementTables[type])
+    {
+        CommitBatch();
+    }
+    WaitForWrites(type);
+
+    if (!m_cacheStatements)
+    {
+        return CompileStatement(m_readDb, type);
+    }
+
+    auto it = m_readStmts.find(type);
+
+    NS_ABORT_MSG_IF(it == m_readStmts.end(),
+                    "Attempting to read with a statement that has not been prepared (" << type
+                                                                                       << ")");
+
+    StartStatementTiming(it->second);
+
+    return it->second;
+}
+
+void
+OranDataRepositorySqlite::ResetStatement(sqlite3_stmt* stmt) const
+{
+    NS_LOG_FUNCTION(this << stmt);
+
+    // The return code of the reset, or of the finalization of a statement
+    // that is not cached, repeats the one from the last step, which has
+    // already been checked, so it is ignored here.
+    if (!m_cacheStatements)
+    {
+        sqlite3_finalize(stmt);
+        return;
+    }
+
+    sqlite3_reset(stmt);
+    sqlite3_clear_bindings(stmt);
+
+    StopStatementTiming(stmt);
+}
+
+sqlite3_stmt*
+OranDataRepositorySqlite::CompileStatement(sqlite3* db, StatementType type) const
+{
+    NS_LOG_FUNCTION(this << db << type);
+
+    auto it = m_queryStmtsStrings.find(type);
+
+    NS_ABORT_MSG_IF(it == m_queryStmtsStrings.end(),
+                    "Attempting to use a statement that has not been defined (" << type << ")");
+
+    sqlite3_stmt* stmt = nullptr;
+    if (sqlite3_prepare_v2(db, it->second.c_str(), -1, &stmt, nullptr) != SQLITE_OK)
+    {
+        NS_ABORT_MSG("Could not prepare statement \"" << it->second
+                                                       << "\": " << sqlite3_errmsg(db));
+    }
+
+    return stmt;
+}
+
+void
+OranDataRepositorySqlite::AddStatementTiming(StatementType type, sqlite3_stmt* stmt)
+{
+    NS_LOG_FUNCTION(this << type << stmt);
+
+    StatementTiming timing;
+    timing.type = type;
+    m_stmtTimings[stmt] = timing;
+}
+
+void
+OranDataRepositorySqlite::StartStatementTiming(sqlite3_stmt* stmt) const
+{
+    NS_LOG_FUNCTION(this << stmt);
+
+    if (!m_queryStatsEnabled && m_queryLatency.IsEmpty())
+    {
+        return;
+    }
+
+    auto it = m_stmtTimings.find(stmt);
+    if (it != m_stmtTimings.end())
+    {
+        it->second.started = true;
+        it->second.start = std::chrono::steady_clock::now();
+    }
+}
+
+void
+OranDataRepositorySqlite::StopStatementTiming(sqlite3_stmt* stmt) const
+{
+    NS_LOG_FUNCTION(this << stmt);
+
+    if (!m_queryStatsEnabled && m_queryLatency.IsEmpty())
+    {
+        return;
+    }
+
+    auto it = m_stmtTimings.find(stmt);
+    if (it == m_stmtTimings.end() || !it->second.started)
+    {
+        return;
+    }
+
+    it->second.started = false;
+    uint64_t ns = std::chrono::duration_cast<std::chrono::nanoseconds>(
+                      std::chrono::steady_clock::now() - it->second.start)
+                      .count();
+    Time latency = NanoSeconds(ns);
+
+    if (m_queryStatsEnabled)
+    {
+        uint32_t bucket = 0;
+        while (bucket < QUERY_LATENCY_BUCKETS - 1 && (ns >> (bucket + 1)) > 0)
+        {
+            bucket++;
+        }
+
+        std::lock_guard<std::mutex> lock(m_queryStatsMutex);
+        if (m_queryStats.size() <= it->second.type)
+        {
+            m_queryStats.resize(NUM_STATEMENT_TYPES);
+        }
+
+        QueryStats& stats = m_queryStats[it->second.type];
+        if (stats.count == 0 || latency < stats.minTime)
+        {
+            stats.minTime = latency;
+        }
+        if (latency > stats.maxTime)
+        {
+            stats.maxTime = latency;
+        }
+        stats.count++;
+        stats.totalTime += latency;
+        stats.histogram[bucket]++;
+    }
+
+    if (!m_queryLatency.IsEmpty())
+    {
+        m_queryLatency(GetStatementName(it->second.type), latency);
+    }
+}
+
+const std::string&
+OranDataRepositorySqlite::GetStatementName(StatementType type)
+{
+    // The names are built once, so that tracing does not build a string per
+    // execution
+    static const std::string names[] = {"BEGIN_TRANSACTION",
+                                        "COMMIT_TRANSACTION",
+                                        "DELETE_LTE_UE_RSRP_RSRQ_LATEST",
+                                        "GET_ALL_LAST_REGISTRATION_TIMES",
+                                        "GET_ALL_REGISTRATIONS",
+                                        "GET_LOG_EVENTS",
+                                        "GET_LOG_MODULES",
+                                        "GET_LTE_ALL_ENB_E2NODEIDS",
+                                        "GET_LTE_ALL_UE_E2NODEIDS",
+                                        "GET_LTE_CELLID_FROM_E2NODEID",
+                                        "GET_LTE_ENB_SNAPSHOT",
+                                        "GET_LTE_UE_CELLINFO",
+                                        "GET_LTE_UE_E2NODEID_FROM_CELLINFO",
+                                        "GET_LTE_UE_RSRP_RSRQ",
+                                        "GET_LTE_UE_SNAPSHOT",
+                                        "GET_MAX_E2NODEID",
+                                        "GET_MAX_SEQ",
+                                        "GET_NODE_ALL_POSITIONS",
+                                        "GET_NODE_APPLOSS",
+                                        "GET_NODE_LATEST_POSITION",
+                                        "GET_NODE_POSITION_AFTER",
+                                        "GET_NODE_POSITION_BEFORE",
+                                        "INSERT_LOG_EVENT",
+                                        "INSERT_LOG_MODULE",
+                                        "INSERT_LTE_ENB_NODE",
+                                        "INSERT_LTE_UE_CELL",
+                                        "INSERT_LTE_UE_CELL_LATEST",
+                                        "INSERT_LTE_UE_NODE",
+                                        "INSERT_NODE_APPLOSS",
+                                        "INSERT_NODE_APPLOSS_LATEST",
+                                        "INSERT_NODE_UPDATE",
+                                        "INSERT_NODE_LOCATION",
+                                        "INSERT_NODE_LOCATION_LATEST",
+                                        "INSERT_NODE_REGISTRATION",
+                                        "INSERT_LTE_UE_RSRP_RSRQ",
+                                        "INSERT_LTE_UE_RSRP_RSRQ_LATEST",
+                                        "LOG_CMM_ACTION",
+                                        "LOG_CMM_EVENT",
+                                        "LOG_E2TERMINATOR_COMMAND",
+                                        "LOG_LM_ACTION",
+                                        "LOG_LM_COMMAND",
+                                        "LOG_LM_EVENT",
+                                        "PRUNE_LTE_UE_CELL_AGE",
+                                        "PRUNE_LTE_UE_CELL_COUNT",
+                                        "PRUNE_LTE_UE_RSRP_RSRQ_AGE",
+                                        "PRUNE_LTE_UE_RSRP_RSRQ_COUNT",
+                                        "PRUNE_NODE_APPLOSS_AGE",
+                                        "PRUNE_NODE_APPLOSS_COUNT",
+                                        "PRUNE_NODE_LOCATION_AGE",
+                                        "PRUNE_NODE_LOCATION_COUNT",
+                                        "PRUNE_NODE_REGISTRATION_AGE",
+                                        "PRUNE_NODE_REGISTRATION_COUNT",
+                                        "UPDATE_NODE_LOCATION"};
+    static_assert(sizeof(names) / sizeof(names[0]) == NUM_STATEMENT_TYPES,
+                  "Missing names of statement types");
+
+    return names[type];
+}
+
+void
+OranDataRepositorySqlite::BeginWrite()
+{
+    NS_LOG_FUNCTION(this);
+
+    if (m_batchOpen && (!m_writeBatching || m_batchTime != Simulator::Now()))
+    {
+        CommitBatch();
+    }
+
+    if (m_writeBatching && !m_batchOpen)
+    {
+        WriteOp op = {BEGIN_TRANSACTION};
+        SubmitWrite(op);
+
+        m_batchOpen = true;
+        m_batchRows = 0;
+        m_batchTime = Simulator::Now();
+
+        // Commit once the events of the current time have been processed,
+        // so that the batch is not left open until the next write
+        m_batchCommitEvent =
+            Simulator::ScheduleNow(&OranDataRepositorySqlite::CommitBatch, this);
+    }
+}
+
+void
+OranDataRepositorySqlite::EndWrite()
+{
+    NS_LOG_FUNCTION(this);
+
+    if (m_batchOpen)
+    {
+        m_batchRows++;
+
+        if (m_batchRows >= m_writeBatchMaxRows)
+        {
+            CommitBatch();
+        }
+    }
+}
+
+void
+OranDataRepositorySqlite::CommitBatch()
+{
+    NS_LOG_FUNCTION(this);
+
+    if (m_batchOpen)
+    {
+        WriteOp op = {COMMIT_TRANSACTION};
+        SubmitWrite(op);
+
+        NS_LOG_INFO("Committed write batch with " << m_batchRows << " rows started at "
+                                                  << m_batchTime.As(Time::S));
+
+        m_batchOpen = false;
+        m_batchTables = 0;
+        m_batchRows = 0;
+        m_batchCommitEvent.Cancel();
+    }
+}
+
+void
+OranDataRepositorySqlite::WriteOp::AddInteger(int64_t value)
+{
+    NS_ASSERT_MSG(numValues < MAX_WRITE_VALUES, "Too many values bound to a write");
+
+    values[numValues].kind = WriteValue::INTEGER;
+    values[numValues].integer = value;
+    numValues++;
+}
+
+void
+OranDataRepositorySqlite::WriteOp::AddReal(double value)
+{
+    NS_ASSERT_MSG(numValues < MAX_WRITE_VALUES, "Too many values bound to a write");
+
+    values[numValues].kind = WriteValue::REAL;
+    values[numValues].real = value;
+    numValues++;
+}
+
+void
+OranDataRepositorySqlite::WriteOp::AddText(const std::string& value)
+{
+    NS_ASSERT_MSG(numValues < MAX_WRITE_VALUES, "Too many values bound to a write");
+
+    values[numValues].kind = WriteValue::TEXT;
+    values[numValues].text = &value;
+    numValues++;
+}
+
+void
+OranDataRepositorySqlite::SubmitWrite(const WriteOp& op)
+{
+    NS_LOG_FUNCTION(this << op.type);
+
+    if (m_batchOpen && !op.checkpoint)
+    {
+        m_batchTables |= m_statementTables[op.type];
+    }
+
+    if (!m_writerThread.joinable())
+    {
+        ExecuteWrite(op);
+        return;
+    }
+
+    uint64_t tail = m_writeQueueTail.load(std::memory_order_relaxed);
+
+    // Block until the writer thread frees a slot if the queue is full
+    if (tail - m_writeQueueHead.load(std::memory_order_acquire) >= m_writeQueue.size())
+    {
+        WaitForQueue(tail - m_writeQueue.size() + 1);
+    }
+
+    // The strings are copied to the storage of the slot, which keeps its
+    // capacity, so that no memory is allocated once the queue is warmed up
+    uint64_t slot = tail % m_writeQueue.size();
+    WriteOp& queued = m_writeQueue[slot];
+    uint8_t numTexts = 0;
+
+    queued = op;
+    for (uint8_t i = 0; i < queued.numValues; i++)
+    {
+        if (queued.values[i].kind == WriteValue::TEXT)
+        {
+            NS_ASSERT_MSG(numTexts < MAX_WRITE_TEXTS, "Too many strings bound to a write");
+
+            std::string& text = m_writeQueueText[slot * MAX_WRITE_TEXTS + numTexts++];
+            text = *queued.values[i].text;
+            queued.values[i].text = &text;
+        }
+    }
+
+    m_writeQueueTail.store(tail + 1);
+
+    // Record the last write to the tables, so that reads only wait for the
+    // writes to the tables they use
+    uint64_t tables = (op.checkpoint ? 0 : m_statementTables[op.type]);
+    for (uint32_t table = 0; tables != 0; table++, tables >>= 1)
+    {
+        if (tables & 1)
+        {
+            m_tableWrites[table] = tail + 1;
+        }
+    }
+
+    if (m_writerSleeping.load())
+    {
+        std::lock_guard<std::mutex> lock(m_writerMutex);
+        m_writerCv.notify_one();
+    }
+}
+
+void
+OranDataRepositorySqlite::ExecuteWrite(const WriteOp& op)
+{
+    NS_LOG_FUNCTION(this << op.type);
+
+    if (op.checkpoint)
+    {
+        CheckpointWal();
+        return;
+    }
+
+    sqlite3_stmt* stmt = GetStatement(op.type);
+
+    // The strings are valid until the statement is reset
+    for (uint8_t i = 0; i < op.numValues; i++)
+    {
+        const WriteValue& value = op.values[i];
+
+        switch (value.kind)
+        {
+        case WriteValue::INTEGER:
+            sqlite3_bind_int64(stmt, i + 1, value.integer);
+            break;
+        case WriteValue::REAL:
+            sqlite3_bind_double(stmt, i + 1, value.real);
+            break;
+        case WriteValue::TEXT:
+            sqlite3_bind_text(stmt, i + 1, value.text->c_str(), -1, SQLITE_STATIC);
+            break;
+        }
+    }
+
+    int rc = sqlite3_step(stmt);
+
+    if (IsQueryTraced(rc))
+    {
+        std::stringstream ss;
+        for (uint8_t i = 0; i < op.numValues; i++)
+        {
+            const WriteValue& value = op.values[i];
+
+            ss << (i > 0 ? ", " : "");
+            switch (value.kind)
+            {
+            case WriteValue::INTEGER:
+                ss << value.integer;
+                break;
+            case WriteValue::REAL:
+                ss << value.real;
+                break;
+            case WriteValue::TEXT:
+                ss << *value.text;
+                break;
+            }
+        }
+
+        CheckQueryReturnCode(stmt, rc, ss.str());
+    }
+    else
+    {
+        CheckQueryReturnCode(stmt, rc);
+    }
+
+    ResetStatement(stmt);
+}
+
+void
+OranDataRepositorySqlite::WaitForWrites()
+{
+    NS_LOG_FUNCTION(this);
+
+    WaitForQueue(m_writeQueueTail.load(std::memory_order_relaxed));
+}
+
+void
+OranDataRepositorySqlite::WaitForWrites(StatementType type)
+{
+    NS_LOG_FUNCTION(this << type);
+
+    if (!m_writerThread.joinable())
+    {
+        return;
+    }
+
+    uint64_t count = 0;
+    uint64_t tables = m_statementTables[type];
+    for (uint32_t table = 0; tables != 0; table++, tables >>= 1)
+    {
+        if (tables & 1)
+        {
+            count = std::max(count, m_tableWrites[table]);
+        }
+    }
+
+    WaitForQueue(count);
+}
+
+void
+OranDataRepositorySqlite::WaitForQueue(uint64_t count)
+{
+    NS_LOG_FUNCTION(this << count);
+
+    if (m_writerThread.joinable() && m_writeQueueHead.load() < count)
+    {
+        std::unique_lock<std::mutex> lock(m_writerMutex);
+        m_flushWaiting.store(true);
+        m_flushCv.wait(lock, [this, count]() { return m_writeQueueHead.load() >= count; });
+        m_flushWaiting.store(false);
+    }
+}
+
+void
+OranDataRepositorySqlite::StartWriter()
+{
+    NS_LOG_FUNCTION(this);
+
+    m_writeQueue.assign(m_asyncQueueCapacity, WriteOp());
+    m_writeQueueText.assign(m_asyncQueueCapacity * MAX_WRITE_TEXTS, std::string());
+    m_tableWrites.assign(std::numeric_limits<uint64_t>::digits, 0);
+    m_writeQueueHead.store(0);
+    m_writeQueueTail.store(0);
+    m_writerStop.store(false);
+    m_writerSleeping.store(false);
+    m_flushWaiting.store(false);
+
+    m_writerThread = std::thread(&OranDataRepositorySqlite::RunWriter, this);
+}
+
+void
+OranDataRepositorySqlite::StopWriter()
+{
+    NS_LOG_FUNCTION(this);
+
+    if (m_writerThread.joinable())
+    {
+        {
+            std::lock_guard<std::mutex> lock(m_writerMutex);
+            m_writerStop.store(true);
+            m_writerCv.notify_one();
+        }
+
+        m_writerThread.join();
+        m_writeQueue.clear();
+        m_writeQueueText.clear();
+    }
+}
+
+void
+OranDataRepositorySqlite::RunWriter()
+{
+    NS_LOG_FUNCTION(this);
+
+    uint64_t head = m_writeQueueHead.load(std::memory_order_relaxed);
+
+    while (true)
+    {
+        if (head != m_writeQueueTail.load(std::memory_order_acquire))
+        {
+            ExecuteWrite(m_writeQueue[head % m_writeQueue.size()]);
+
+            m_writeQueueHead.store(++head);
+
+            if (m_flushWaiting.load())
+            {
+                std::lock_guard<std::mutex> lock(m_writerMutex);
+                m_flushCv.notify_all();
+            }
+        }
+        else
+        {
+            std::unique_lock<std::mutex> lock(m_writerMutex);
+            m_writerSleeping.store(true);
+            m_writerCv.wait(lock, [this, head]() {
+                return m_writeQueueTail.load() != head || m_writerStop.load();
+            });
+            m_writerSleeping.store(false);
+
+            if (m_writeQueueTail.load() == head && m_writerStop.load())
+            {
+                break;
+            }
+        }
+    }
+}
+
+std::map<OranDataRepositorySqlite::StatementType,
+         std::pair<std::string, std::vector<std::string>>>
+OranDataRepositorySqlite::ExplainQueryPlans()
+{
+    NS_LOG_FUNCTION(this);
+
+    NS_ABORT_MSG_IF(m_db == nullptr, "Attempting to explain query plans with a closed database");
+
+    WaitForWrites();
+
+    std::map<StatementType, std::pair<std::string, std::vector<std::string>>> plans;
+
+    for (const auto& entry : m_queryStmtsStrings)
+    {
+        int rc;
+        sqlite3_stmt* stmt = nullptr;
+        std::string query = "EXPLAIN QUERY PLAN " + entry.second;
+        std::vector<std::string> steps;
+
+        if (sqlite3_prepare_v2(m_db, query.c_str(), -1, &stmt, nullptr) != SQLITE_OK)
+        {
+            NS_ABORT_MSG("Could not prepare statement \"" << query
+                                                           << "\": " << sqlite3_errmsg(m_db));
+        }
+
+        // The fourth column has the description of each step
+        while ((rc = sqlite3_step(stmt)) == SQLITE_ROW)
+        {
+            steps.push_back(reinterpret_cast<const char*>(sqlite3_column_text(stmt, 3)));
+        }
+        CheckQueryReturnCode(stmt, rc);
+        sqlite3_finalize(stmt);
+
+        plans[entry.first] = std::make_pair(entry.second, steps);
+    }
+
+    return plans;
+}
+
+void
+OranDataRepositorySqlite::InitDb()
+{
+    NS_LOG_FUNCTION(this);
+
+    uint32_t dbSchemaVersion = GetDbSchemaVersion();
+
+    NS_ABORT_MSG_IF(dbSchemaVersion > m_schemaVersion,
+                    "The ORAN Storage DB (" << m_dbPath << ") uses schema version "
+                                            << dbSchemaVersion << ", and version "
+                                            << m_schemaVersion << " was requested. Downgrading "
+                                            << "the schema is not supported");
+
+    if (dbSchemaVersion == 1 && m_schemaVersion == 2)
+    {
+        MigrateSchemaToV2();
+    }
+
+    // E2 Node Table
+    RunCreateStatement(m_createStmtsStrings[TABLE_NODE]);
+    RunCreateStatement(m_createStmtsStrings[INDEX_NODE]);
+
+    // E2 Node Registration
+    RunCreateStatement(m_createStmtsStrings[TABLE_NODE_REGISTRATION]);
+    RunCreateStatement(m_createStmtsStrings[INDEX_NODE_REGISTRATION]);
+
+    // E2 Node Location
+    RunCreateStatement(m_createStmtsStrings[TABLE_NODE_LOCATION]);
+    if (m_schemaVersion < 2)
+    {
+        RunCreateStatement(m_createStmtsStrings[INDEX_NODE_LOCATION]);
+    }
+
+    // LTE eNB
+    RunCreateStatement(m_createStmtsStrings[TABLE_LTE_ENB]);
+    RunCreateStatement(m_createStmtsStrings[INDEX_LTE_ENB_NODEID]);
+    RunCreateStatement(m_createStmtsStrings[INDEX_LTE_ENB_CELLID]);
+
+    // LTE UE
+    RunCreateStatement(m_createStmtsStrings[TABLE_LTE_UE]);
+    RunCreateStatement(m_createStmtsStrings[INDEX_LTE_UE_NODEID]);
+    RunCreateStatement(m_createStmtsStrings[INDEX_LTE_UE_IMSI]);
+
+    // LTE UE Cell Information
+    RunCreateStatement(m_createStmtsStrings[TABLE_LTE_UE_CELL]);
+    RunCreateStatement(m_createStmtsStrings[TABLE_LTE_UE_RSRP_RSRQ]);
+    if (m_schemaVersion < 2)
+    {
+        RunCreateStatement(m_createStmtsStrings[INDEX_LTE_UE_CELL_NODEID]);
+        RunCreateStatement(m_createStmtsStrings[INDEX_LTE_UE_RSRP_RSRQ_NODEID]);
+    }
+    RunCreateStatement(m_createStmtsStrings[INDEX_LTE_UE_CELL_CELLID]);
+
+    RunCreateStatement(m_createStmtsStrings[TABLE_APPLOSS_COMMAND]);
+    if (m_schemaVersion < 2)
+    {
+        RunCreateStatement(m_createStmtsStrings[INDEX_NODE_APPLOSS_NODEID]);
+    }
+
+    // Latest values
+    RunCreateStatement(m_createStmtsStrings[TABLE_LTE_UE_CELL_LATEST]);
+    RunCreateStatement(m_createStmtsStrings[TABLE_LTE_UE_RSRP_RSRQ_LATEST]);
+    RunCreateStatement(m_createStmtsStrings[INDEX_LTE_UE_RSRP_RSRQ_LATEST_NODEID]);
+    RunCreateStatement(m_createStmtsStrings[TABLE_NODE_APPLOSS_LATEST]);
+    RunCreateStatement(m_createStmtsStrings[TABLE_NODE_LOCATION_LATEST]);
+    RunCreateStatement(m_createStmtsStrings[BACKFILL_LTE_UE_CELL_LATEST]);
+    RunCreateStatement(m_createStmtsStrings[BACKFILL_LTE_UE_RSRP_RSRQ_LATEST]);
+    RunCreateStatement(m_createStmtsStrings[BACKFILL_NODE_APPLOSS_LATEST]);
+    RunCreateStatement(m_createStmtsStrings[BACKFILL_NODE_LOCATION_LATEST]);
+
+    // E2 Terminator Commands
+    RunCreateStatement(m_createStmtsStrings[TABLE_TERMINATOR_COMMAND]);
+
+    // LM Commands
+    RunCreateStatement(m_createStmtsStrings[TABLE_LM_COMMAND]);
+
+    // LM Actions (Internal Log)
+    RunCreateStatement(m_createStmtsStrings[TABLE_LM_ACTION]);
+
+    // CMM Actions (Internal Log)
+    RunCreateStatement(m_createStmtsStrings[TABLE_CMM_ACTION]);
+
+    // LM and CMM Events (Structured Internal Log)
+    RunCreateStatement(m_createStmtsStrings[TABLE_LOG_MODULE]);
+    RunCreateStatement(m_createStmtsStrings[TABLE_LOG_EVENT]);
+    RunCreateStatement(m_createStmtsStrings[TABLE_LM_EVENT]);
+    RunCreateStatement(m_createStmtsStrings[TABLE_CMM_EVENT]);
+    RunCreateStatement(m_createStmtsStrings[VIEW_LM_EVENT_TEXT]);
+    RunCreateStatement(m_createStmtsStrings[VIEW_CMM_EVENT_TEXT]);
+    RunCreateStatement(m_createStmtsStrings[VIEW_LM_LOG]);
+    RunCreateStatement(m_createStmtsStrings[VIEW_CMM_LOG]);
+
+    // Stamp the schema version
+    RunCreateStatement("PRAGMA user_version = " + std::to_string(m_schemaVersion) + ";");
+}
+
+void
+OranDataRepositorySqlite::PrepareStatements()
+{
+    NS_LOG_FUNCTION(this);
+
+    for (const auto& entry : m_queryStmtsStrings)
+    {
+        sqlite3_stmt* stmt = nullptr;
+
+        if (sqlite3_prepare_v2(m_db, entry.second.c_str(), -1, &stmt, nullptr) != SQLITE_OK)
+        {
+            NS_ABORT_MSG("Could not prepare statement \"" << entry.second
+                                                           << "\": " << sqlite3_errmsg(m_db));
+        }
+
+        m_queryStmts[entry.first] = stmt;
+        AddStatementTiming(entry.first, stmt);
+    }
+}
+
+void
+OranDataRepositorySqlite::InitStatementTables()
+{
+    NS_LOG_FUNCTION(this);
+
+    // Split the SQL of a statement into its words
+    auto getWords = [](const std::string& sql) {
+        std::vector<std::string> words;
+        std::string word;
+        for (char c : sql)
+        {
+            if (std::isalnum(static_cast<unsigned char>(c)) || c == '_')
+            {
+                word += c;
+            }
+            else if (!word.empty())
+            {
+                words.push_back(word);
+                word.clear();
+            }
+        }
+        if (!word.empty())
+        {
+            words.push_back(word);
+        }
+        return words;
+    };
+
+    // Map the name of each table to its bit, and the name of each view to
+    // the bits of the tables that it reads. The name follows "CREATE TABLE
+    // IF NOT EXISTS" or "CREATE VIEW IF NOT EXISTS".
+    static_assert(VIEW_LM_LOG < std::numeric_limits<uint64_t>::digits,
+                  "Too many tables to be represented by a mask");
+
+    std::map<std::string, uint64_t> tables;
+    for (int type = TABLE_CMM_ACTION; type <= VIEW_LM_LOG; type++)
+    {
+        std::vector<std::string> words =
+            getWords(m_createStmtsStrings[static_cast<CreateStatementType>(type)]);
+        uint64_t mask = 0;
+
+        if (type < VIEW_CMM_EVENT_TEXT)
+        {
+            mask = (uint64_t(1) << type);
+        }
+        else
+        {
+            for (const auto& word : words)
+            {
+                auto it = tables.find(word);
+                mask |= (it != tables.end() ? it->second : 0);
+            }
+        }
+
+        tables[words.at(5)] = mask;
+    }
+
+    m_statementTables.clear();
+    for (const auto& entry : m_queryStmtsStrings)
+    {
+        uint64_t mask = 0;
+        for (const auto& word : getWords(entry.second))
+        {
+            auto it = tables.find(word);
+            mask |= (it != tables.end() ? it->second : 0);
+        }
+
+        m_statementTables[entry.first] = mask;
+    }
+
+    // The end of a transaction makes all its writes visible to the reads
+    m_statementTables[BEGIN_TRANSACTION] = std::numeric_limits<uint64_t>::max();
+    m_statementTables[COMMIT_TRANSACTION] = std::numeric_limits<uint64_t>::max();
+}
+
+void
+OranDataRepositorySqlite::FinalizeStatements()
+{
+    NS_LOG_FUNCTION(this);
+
+    for (auto& entry : m_queryStmts)
+    {
+        m_stmtTimings.erase(entry.second);
+        sqlite3_finalize(entry.second);
+    }
+
+    m_queryStmts.clear();
+}
+
+void
+OranDataRepositorySqlite::LoadRegistrations()
+{
+    NS_LOG_FUNCTION(this);
+
+    int rc;
+    sqlite3_stmt* stmt = GetStatement(GET_ALL_REGISTRATIONS);
+
+    // Requests are returned in order, so the last one of each node sets its state
+    m_registeredNodes.clear();
+    while ((rc = sqlite3_step(stmt)) == SQLITE_ROW)
+    {
+        m_registeredNodes[sqlite3_column_int64(stmt, 0)] = sqlite3_column_int(stmt, 1);
+    }
+
+    CheckQueryReturnCode(stmt, rc);
+    ResetStatement(stmt);
+
+    stmt = GetStatement(GET_MAX_E2NODEID);
+
+    m_nextE2NodeId = 1;
+    while ((rc = sqlite3_step(stmt)) == SQLITE_ROW)
+    {
+        m_nextE2NodeId = sqlite3_column_int64(stmt, 0) + 1;
+    }
+
+    CheckQueryReturnCode(stmt, rc);
+    ResetStatement(stmt);
+}
+
+void
+OranDataRepositorySqlite::LoadLogModules()
+{
+    NS_LOG_FUNCTION(this);
+
+    int rc;
+    sqlite3_stmt* stmt = GetStatement(GET_LOG_MODULES);
+
+    m_logModuleIds.clear();
+    while ((rc = sqlite3_step(stmt)) == SQLITE_ROW)
+    {
+        m_logModuleIds[reinterpret_cast<const char*>(sqlite3_column_text(stmt, 1))] =
+            sqlite3_column_int(stmt, 0);
+    }
+
+    CheckQueryReturnCode(stmt, rc);
+    ResetStatement(stmt);
+}
+
+void
+OranDataRepositorySqlite::LoadLogEvents()
+{
+    NS_LOG_FUNCTION(this);
+
+    int rc;
+    sqlite3_stmt* stmt = GetStatement(GET_LOG_EVENTS);
+
+    m_logEventIds.clear();
+    m_logEventDbIds.clear();
+    while ((rc = sqlite3_step(stmt)) == SQLITE_ROW)
+    {
+        m_logEventIds[{reinterpret_cast<const char*>(sqlite3_column_text(stmt, 1)),
+                       reinterpret_cast<const char*>(sqlite3_column_text(stmt, 2))}] =
+            sqlite3_column_int(stmt, 0);
+    }
+
+    CheckQueryReturnCode(stmt, rc);
+    ResetStatement(stmt);
+}
+
+uint32_t
+OranDataRepositorySqlite::GetLogEventId(LogEvent event)
+{
+    NS_LOG_FUNCTION(this << event);
+
+    if (event < m_logEventDbIds.size() && m_logEventDbIds[event] != 0)
+    {
+        return m_logEventDbIds[event];
+    }
+
+    const auto& formats = GetLogEventFormats();
+    auto format = formats.find(event);
+    NS_ABORT_MSG_IF(format == formats.end(), "Unknown log event " << event);
+
+    // IDs are assigned sequentially, and never removed while the DB is open
+    auto it = m_logEventIds.find({format->second.module, format->second.format});
+    if (it == m_logEventIds.end())
+    {
+        uint32_t eventId = m_logEventIds.size() + 1;
+        it = m_logEventIds.insert({{format->second.module, format->second.format}, eventId}).first;
+
+        // The registered formats outlive the write
+        WriteOp op = {INSERT_LOG_EVENT};
+        op.AddInteger(eventId);
+        op.AddText(format->second.module);
+        op.AddText(format->second.format);
+
+        SubmitWrite(op);
+    }
+
+    if (event >= m_logEventDbIds.size())
+    {
+        m_logEventDbIds.resize(event + 1, 0);
+    }
+    m_logEventDbIds[event] = it->second;
+
+    return it->second;
+}
+
+uint32_t
+OranDataRepositorySqlite::GetLogModuleId(const std::string& name)
+{
+    NS_LOG_FUNCTION(this << name);
+
+    auto it = m_logModuleIds.find(name);
+    if (it != m_logModuleIds.end())
+    {
+        return it->second;
+    }
+
+    // IDs are assigned sequentially, and never removed while the DB is open
+    uint32_t moduleId = m_logModuleIds.size() + 1;
+    m_logModuleIds[name] = moduleId;
+
+    WriteOp op = {INSERT_LOG_MODULE};
+    op.AddInteger(moduleId);
+    op.AddText(name);
+
+    SubmitWrite(op);
+
+    return moduleId;
+}
+
+std::tuple<bool, Vector>
+OranDataRepositorySqlite::InterpolatePosition(uint64_t e2NodeId, Time t)
+{
+    NS_LOG_FUNCTION(this << e2NodeId << t);
+
+    int rc;
+    bool found = true;
+    Time times[2];
+    Vector positions[2];
+    StatementType types[2] = {GET_NODE_POSITION_BEFORE, GET_NODE_POSITION_AFTER};
+
+    for (int i = 0; i < 2; i++)
+    {
+        sqlite3_stmt* stmt = GetReadStatement(types[i]);
+
+        sqlite3_bind_int64(stmt, 1, e2NodeId);
+        sqlite3_bind_int64(stmt, 2, t.GetTimeStep());
+
+        rc = sqlite3_step(stmt);
+        if (rc == SQLITE_ROW)
+        {
+            times[i] = Time(sqlite3_column_int64(stmt, 0));
+            positions[i] = Vector(sqlite3_column_double(stmt, 1),
+                                  sqlite3_column_double(stmt, 2),
+                                  sqlite3_column_double(stmt, 3));
+        }
+        else
+        {
+            CheckQuery(stmt, rc, e2NodeId, t.GetTimeStep());
+            found = false;
+        }
+        ResetStatement(stmt);
+    }
+
+    if (!found)
+    {
+        return std::make_tuple(false, Vector());
+    }
+
+    double fraction = (t - times[0]).GetSeconds() / (times[1] - times[0]).GetSeconds();
+    return std::make_tuple(true,
+                           Vector(positions[0].x + (positions[1].x - positions[0].x) * fraction,
+                                  positions[0].y + (positions[1].y - positions[0].y) * fraction,
+                                  positions[0].z + (positions[1].z - positions[0].z) * fraction));
+}
+
+void
+OranDataRepositorySqlite::LoadSequence()
+{
+    NS_LOG_FUNCTION(this);
+
+    int rc;
+    sqlite3_stmt* stmt = GetStatement(GET_MAX_SEQ);
+
+    m_nextSeq = 1;
+    while ((rc = sqlite3_step(stmt)) == SQLITE_ROW)
+    {
+        m_nextSeq = sqlite3_column_int64(stmt, 0) + 1;
+    }
+
+    CheckQueryReturnCode(stmt, rc);
+    ResetStatement(stmt);
 }
 
 bool
-OranDataRepositorySqlite::IsDbOpen() const
+OranDataRepositorySqlite::ConfigureJournal()
 {
     NS_LOG_FUNCTION(this);
 
-    return m_db != nullptr;
+    if (!m_walMode)
+    {
+        return false;
+    }
+
+    int rc;
+    sqlite3_stmt* stmt;
+    std::string journalMode;
+
+    sqlite3_prepare_v2(m_db, "PRAGMA journal_mode = WAL;", -1, &stmt, nullptr);
+    while ((rc = sqlite3_step(stmt)) == SQLITE_ROW)
+    {
+        journalMode = reinterpret_cast<const char*>(sqlite3_column_text(stmt, 0));
+    }
+    CheckQueryReturnCode(stmt, rc);
+    sqlite3_finalize(stmt);
+
+    if (journalMode != "wal")
+    {
+        NS_LOG_WARN("The ORAN Storage DB (" << m_dbPath << ") does not support write-ahead "
+                                            << "logging. Using journal mode " << journalMode);
+        return false;
+    }
+
+    // With write-ahead logging, the database cannot be corrupted if commits
+    // are not synced, so only the checkpoints are synced
+    sqlite3_prepare_v2(m_db, "PRAGMA synchronous = NORMAL;", -1, &stmt, nullptr);
+    rc = sqlite3_step(stmt);
+    CheckQueryReturnCode(stmt, rc);
+    sqlite3_finalize(stmt);
+
+    std::string sizeLimit = "PRAGMA journal_size_limit = " + std::to_string(m_walSizeLimit) + ";";
+    sqlite3_prepare_v2(m_db, sizeLimit.c_str(), -1, &stmt, nullptr);
+    while ((rc = sqlite3_step(stmt)) == SQLITE_ROW)
+    {
+    }
+    CheckQuery(stmt, rc, m_walSizeLimit);
+    sqlite3_finalize(stmt);
+
+    // This replaces the automatic checkpoints of SQLite, which are run by
+    // WalHook instead
+    sqlite3_wal_hook(m_db, &OranDataRepositorySqlite::WalHook, this);
+
+    return true;
 }
 
 void
-OranDataRepositorySqlite::OpenDb()
+OranDataRepositorySqlite::OpenReadDb()
 {
     NS_LOG_FUNCTION(this);
 
-    // Check for special file names and print a warning if we find them
-    if (m_dbPath == ":memory:")
+    // In-memory and temporary databases are private to their connection
+    if (!m_walActive || m_dbPath == ":memory:" || m_dbPath.empty())
     {
-        NS_LOG_WARN("Using in-memory DB for the ORAN Storage. DB will not be saved to disk.");
-        std::cerr
-            << "WARNING: Using in-memory DB for the ORAN Storage. DB will not be saved to disk."
-            << std::endl;
+        return;
     }
-    else
+
+    if (sqlite3_open_v2(m_dbPath.c_str(), &m_readDb, SQLITE_OPEN_READONLY, nullptr) != SQLITE_OK)
     {
-        // Check for DB names that are URIs. We do not support those
-        if (m_dbPath.find(":") != std::string::npos)
+        NS_ABORT_MSG("Could not open read-only database connection: " << sqlite3_errmsg(m_readDb));
+    }
+
+    // Only the queries of the Data Access API are run on this connection
+    static const StatementType readTypes[] = {GET_ALL_LAST_REGISTRATION_TIMES,
+                                              GET_LTE_ALL_ENB_E2NODEIDS,
+                                              GET_LTE_ALL_UE_E2NODEIDS,
+                                              GET_LTE_CELLID_FROM_E2NODEID,
+                                              GET_LTE_ENB_SNAPSHOT,
+                                              GET_LTE_UE_CELLINFO,
+                                              GET_LTE_UE_E2NODEID_FROM_CELLINFO,
+                                              GET_LTE_UE_RSRP_RSRQ,
+                                              GET_LTE_UE_SNAPSHOT,
+                                              GET_NODE_ALL_POSITIONS,
+                                              GET_NODE_APPLOSS,
+                                              GET_NODE_LATEST_POSITION,
+                                              GET_NODE_POSITION_AFTER,
+                                              GET_NODE_POSITION_BEFORE};
+
+    for (StatementType type : readTypes)
+    {
+        const std::string& sql = m_queryStmtsStrings.at(type);
+        sqlite3_stmt* stmt = nullptr;
+
+        if (sqlite3_prepare_v2(m_readDb, sql.c_str(), -1, &stmt, nullptr) != SQLITE_OK)
         {
-            NS_ABORT_MSG("File name for the ORAN Storage DB ("
-                         << m_dbPath << ") is an URI. URI-named DBs are not supported");
+            NS_ABORT_MSG("Could not prepare statement \"" << sql
+                                                          << "\": " << sqlite3_errmsg(m_readDb));
         }
+
+        m_readStmts[type] = stmt;
+        AddStatementTiming(type, stmt);
     }
+}
 
-    if (m_dbPath.empty())
+void
+OranDataRepositorySqlite::CloseReadDb()
+{
+    NS_LOG_FUNCTION(this);
+
+    for (auto& entry : m_readStmts)
     {
-        NS_LOG_WARN("Using a randomly named temporary file as DB for the ORAN Storage. DB will not "
-                    "be available after simulation ends.");
-        std::cerr << "WARNING: Using a randomly named temporary file as DB for the ORAN Storage. "
-                     "DB will not be available after simulation ends."
-                  << std::endl;
+        m_stmtTimings.erase(entry.second);
+        sqlite3_finalize(entry.second);
     }
+    m_readStmts.clear();
 
-    int error = sqlite3_open(m_dbPath.c_str(), &m_db);
-    if (error != 0)
+    if (m_readDb != nullptr)
     {
-        NS_ABORT_MSG("Could not open database: " << sqlite3_errmsg(m_db));
+        sqlite3_close(m_readDb);
+        m_readDb = nullptr;
     }
-    else
+}
+
+int
+OranDataRepositorySqlite::WalHook(void* repository, sqlite3* db, const char* dbName, int walPages)
+{
+    NS_LOG_FUNCTION(repository << db << dbName << walPages);
+
+    auto repo = static_cast<OranDataRepositorySqlite*>(repository);
+
+    repo->m_walSize(walPages);
+
+    if (repo->m_walAutoCheckpoint > 0 &&
+        static_cast<uint32_t>(walPages) >= repo->m_walAutoCheckpoint)
     {
-        NS_LOG_INFO("Oran repository \"" << m_dbPath << "\" connected to successfully!");
-        ;
+        repo->CheckpointWal();
     }
 
-    InitDb();
+    return SQLITE_OK;
 }
 
 void
-OranDataRepositorySqlite::InitDb()
+OranDataRepositorySqlite::CheckpointWal()
 {
     NS_LOG_FUNCTION(this);
 
-    // E2 Node Table
-    RunCreateStatement(m_createStmtsStrings[TABLE_NODE]);
-    RunCreateStatement(m_createStmtsStrings[INDEX_NODE]);
+    int walPages = 0;
+    int checkpointedPages = 0;
+    int rc = sqlite3_wal_checkpoint_v2(m_db,
+                                       nullptr,
+                                       SQLITE_CHECKPOINT_PASSIVE,
+                                       &walPages,
+                                       &checkpointedPages);
 
-    // E2 Node Registration
-    RunCreateStatement(m_createStmtsStrings[TABLE_NODE_REGISTRATION]);
-    RunCreateStatement(m_createStmtsStrings[INDEX_NODE_REGISTRATION]);
+    // A busy checkpoint is retried by the next one
+    NS_ABORT_MSG_IF(rc != SQLITE_OK && rc != SQLITE_BUSY,
+                    "Checkpoint of the write-ahead log FAILED: " << sqlite3_errmsg(m_db));
 
-    // E2 Node Location
-    RunCreateStatement(m_createStmtsStrings[TABLE_NODE_LOCATION]);
-    RunCreateStatement(m_createStmtsStrings[INDEX_NODE_LOCATION]);
+    NS_LOG_INFO("Checkpointed " << checkpointedPages << " of " << walPages
+                                << " pages of the write-ahead log");
 
-    // LTE eNB
-    RunCreateStatement(m_createStmtsStrings[TABLE_LTE_ENB]);
-    RunCreateStatement(m_createStmtsStrings[INDEX_LTE_ENB_NODEID]);
-    RunCreateStatement(m_createStmtsStrings[INDEX_LTE_ENB_CELLID]);
+    m_walCheckpoint(walPages, checkpointedPages);
+}
 
-    // LTE UE
-    RunCreateStatement(m_createStmtsStrings[TABLE_LTE_UE]);
-    RunCreateStatement(m_createStmtsStrings[INDEX_LTE_UE_NODEID]);
-    RunCreateStatement(m_createStmtsStrings[INDEX_LTE_UE_IMSI]);
+void
+OranDataRepositorySqlite::DoPeriodicCheckpoint()
+{
+    NS_LOG_FUNCTION(this);
 
-    // LTE UE Cell Information
-    RunCreateStatement(m_createStmtsStrings[TABLE_LTE_UE_CELL]);
-    RunCreateStatement(m_createStmtsStrings[TABLE_LTE_UE_RSRP_RSRQ]);
-    RunCreateStatement(m_createStmtsStrings[INDEX_LTE_UE_CELL_NODEID]);
-    RunCreateStatement(m_createStmtsStrings[INDEX_LTE_UE_CELL_CELLID]);
+    // A checkpoint cannot include the writes of an open transaction
+    CommitBatch();
 
-    RunCreateStatement(m_createStmtsStrings[TABLE_APPLOSS_COMMAND]);
+    WriteOp op;
+    op.checkpoint = true;
 
-    // E2 Terminator Commands
-    RunCreateStatement(m_createStmtsStrings[TABLE_TERMINATOR_COMMAND]);
+    SubmitWrite(op);
 
-    // LM Commands
-    RunCreateStatement(m_createStmtsStrings[TABLE_LM_COMMAND]);
+    m_walCheckpointEvent = Simulator::Schedule(m_walCheckpointInterval,
+                                               &OranDataRepositorySqlite::DoPeriodicCheckpoint,
+                                               this);
+}
 
-    // LM Actions (Internal Log)
-    RunCreateStatement(m_createStmtsStrings[TABLE_LM_ACTION]);
+uint32_t
+OranDataRepositorySqlite::GetDbSchemaVersion()
+{
+    NS_LOG_FUNCTION(this);
 
-    // CMM Actions (Internal Log)
-    RunCreateStatement(m_createStmtsStrings[TABLE_CMM_ACTION]);
+    int rc;
+    sqlite3_stmt* stmt;
+    uint32_t version = 0;
+
+    sqlite3_prepare_v2(m_db, "PRAGMA user_version;", -1, &stmt, nullptr);
+    while ((rc = sqlite3_step(stmt)) == SQLITE_ROW)
+    {
+        version = sqlite3_column_int(stmt, 0);
+    }
+    CheckQueryReturnCode(stmt, rc);
+    sqlite3_finalize(stmt);
+
+    if (version == 0)
+    {
+        // Databases created before the version was stamped use version 1
+        sqlite3_prepare_v2(m_db,
+                           "SELECT 1 FROM sqlite_master WHERE type = 'table' AND name = 'node';",
+                           -1,
+                           &stmt,
+                           nullptr);
+        while ((rc = sqlite3_step(stmt)) == SQLITE_ROW)
+        {
+            version = 1;
+        }
+        CheckQueryReturnCode(stmt, rc);
+        sqlite3_finalize(stmt);
+    }
+
+    return version;
+}
+
+void
+OranDataRepositorySqlite::MigrateSchemaToV2()
+{
+    NS_LOG_FUNCTION(this);
+
+    NS_LOG_INFO("Migrating the ORAN Storage DB (" << m_dbPath << ") to schema version 2");
+
+    // Table, CREATE statement for version 2, and columns to copy
+    std::vector<std::tuple<std::string, CreateStatementType, std::string>> tables = {
+        {"nodelocation", TABLE_NODE_LOCATION, "nodeid, x, y, z, simulationtime"},
+        {"lteuecell", TABLE_LTE_UE_CELL, "nodeid, cellid, rnti, simulationtime"},
+        {"lteuersrprsrq",
+         TABLE_LTE_UE_RSRP_RSRQ,
+         "nodeid, simulationtime, rnti, cellid, rsrp, rsrq, serving, ccid"},
+        {"nodeapploss", TABLE_APPLOSS_COMMAND, "nodeid, loss, simulationtime"}};
+
+    // The row IDs of version 1 are used as sequence numbers, so that the
+    // order of the entries is preserved
+    RunCreateStatement("BEGIN TRANSACTION;");
+    for (const auto& table : tables)
+    {
+        const std::string& name = std::get<0>(table);
+        const std::string& columns = std::get<2>(table);
+
+        RunCreateStatement("ALTER TABLE " + name + " RENAME TO " + name + "_v1;");
+        RunCreateStatement(m_createStmtsStrings[std::get<1>(table)]);
+        RunCreateStatement("INSERT INTO " + name + " (" + columns + ", seq) SELECT " + columns +
+                           ", entryid FROM " + name + "_v1;");
+        RunCreateStatement("DROP TABLE " + name + "_v1;");
+    }
+    RunCreateStatement("COMMIT TRANSACTION;");
 }
 
 void
@@ -1004,17 +3065,59 @@ OranDataRepositorySqlite::InitStatements()
     NS_LOG_FUNCTION(this);
 
     // Initialize the create statements
+    // Fill the tables with the latest values from the history tables, only
+    // if they are empty (i.e., they were just added to an existing database)
+    m_createStmtsStrings[BACKFILL_LTE_UE_CELL_LATEST] =
+        "INSERT OR IGNORE INTO lteuecell_latest "
+        "(nodeid, cellid, rnti, simulationtime) "
+        "SELECT nodeid, cellid, rnti, simulationtime "
+        "FROM lteuecell AS lc "
+        "WHERE entryid = (SELECT entryid FROM lteuecell "
+        "WHERE nodeid = lc.nodeid "
+        "ORDER BY simulationtime DESC, entryid DESC LIMIT 1) "
+        "AND NOT EXISTS (SELECT 1 FROM lteuecell_latest);";
+
+    m_createStmtsStrings[BACKFILL_LTE_UE_RSRP_RSRQ_LATEST] =
+        "INSERT INTO lteuersrprsrq_latest "
+        "(nodeid, simulationtime, rnti, cellid, rsrp, rsrq, serving, ccid) "
+        "SELECT nodeid, simulationtime, rnti, cellid, rsrp, rsrq, serving, ccid "
+        "FROM lteuersrprsrq AS rr "
+        "WHERE simulationtime = (SELECT MAX(simulationtime) FROM lteuersrprsrq "
+        "WHERE nodeid = rr.nodeid) "
+        "AND NOT EXISTS (SELECT 1 FROM lteuersrprsrq_latest) "
+        "ORDER BY entryid;";
+
+    m_createStmtsStrings[BACKFILL_NODE_APPLOSS_LATEST] =
+        "INSERT OR IGNORE INTO nodeapploss_latest "
+        "(nodeid, loss, simulationtime) "
+        "SELECT nodeid, loss, simulationtime "
+        "FROM nodeapploss "
+        "WHERE entryid IN (SELECT MAX(entryid) FROM nodeapploss GROUP BY nodeid) "
+        "AND NOT EXISTS (SELECT 1 FROM nodeapploss_latest);";
+
+    m_createStmtsStrings[BACKFILL_NODE_LOCATION_LATEST] =
+        "INSERT OR IGNORE INTO nodelocation_latest "
+        "(nodeid, x, y, z, simulationtime) "
+        "SELECT nodeid, x, y, z, simulationtime "
+        "FROM nodelocation AS nl "
+        "WHERE entryid = (SELECT entryid FROM nodelocation "
+        "WHERE nodeid = nl.nodeid "
+        "ORDER BY simulationtime DESC, entryid DESC LIMIT 1) "
+        "AND NOT EXISTS (SELECT 1 FROM nodelocation_latest);";
+
     m_createStmtsStrings[INDEX_LTE_ENB_CELLID] = "CREATE INDEX IF NOT EXISTS "
                                                  "idx_lteenb_cellid ON lteenb(cellid);";
 
     m_createStmtsStrings[INDEX_LTE_ENB_NODEID] = "CREATE INDEX IF NOT EXISTS "
                                                  "idx_lteenb_nodeid ON lteenb(nodeid);";
 
-    m_createStmtsStrings[INDEX_LTE_UE_CELL_CELLID] = "CREATE INDEX IF NOT EXISTS "
-                                                     "idx_lteuecell_cellid ON lteuecell(cellid);";
+    m_createStmtsStrings[INDEX_LTE_UE_CELL_CELLID] =
+        "CREATE INDEX IF NOT EXISTS "
+        "idx_lteuecell_cellid_rnti ON lteuecell(cellid, rnti);";
 
-    m_createStmtsStrings[INDEX_LTE_UE_CELL_NODEID] = "CREATE INDEX IF NOT EXISTS "
-                                                     "idx_lteuecell_nodeid ON lteuecell(nodeid);";
+    m_createStmtsStrings[INDEX_LTE_UE_CELL_NODEID] =
+        "CREATE INDEX IF NOT EXISTS "
+        "idx_lteuecell_nodeid_time ON lteuecell(nodeid, simulationtime);";
 
     m_createStmtsStrings[INDEX_LTE_UE_IMSI] = "CREATE INDEX IF NOT EXISTS "
                                               "idx_lteue_imsi ON lteue(imsi);";
@@ -1022,15 +3125,28 @@ OranDataRepositorySqlite::InitStatements()
     m_createStmtsStrings[INDEX_LTE_UE_NODEID] = "CREATE INDEX IF NOT EXISTS "
                                                 "idx_lteue_nodeid ON lteue(nodeid);";
 
+    m_createStmtsStrings[INDEX_LTE_UE_RSRP_RSRQ_LATEST_NODEID] =
+        "CREATE INDEX IF NOT EXISTS "
+        "idx_lteuersrprsrq_latest_nodeid ON lteuersrprsrq_latest(nodeid);";
+
+    m_createStmtsStrings[INDEX_LTE_UE_RSRP_RSRQ_NODEID] =
+        "CREATE INDEX IF NOT EXISTS "
+        "idx_lteuersrprsrq_nodeid_time ON lteuersrprsrq(nodeid, simulationtime);";
+
     m_createStmtsStrings[INDEX_NODE] = "CREATE INDEX IF NOT EXISTS "
                                        "idx_node_nodeid ON node (nodeid);";
 
-    m_createStmtsStrings[INDEX_NODE_LOCATION] = "CREATE INDEX IF NOT EXISTS "
-                                                "idx_nodelocation_nodeid ON nodelocation(nodeid);";
+    m_createStmtsStrings[INDEX_NODE_LOCATION] =
+        "CREATE INDEX IF NOT EXISTS "
+        "idx_nodelocation_nodeid_time ON nodelocation(nodeid, simulationtime);";
+
+    m_createStmtsStrings[INDEX_NODE_APPLOSS_NODEID] =
+        "CREATE INDEX IF NOT EXISTS "
+        "idx_nodeapploss_nodeid_time ON nodeapploss(nodeid, simulationtime);";
 
     m_createStmtsStrings[INDEX_NODE_REGISTRATION] =
         "CREATE INDEX IF NOT EXISTS "
-        "idx_noderegistration_nodeid ON noderegistration(nodeid);";
+        "idx_noderegistration_nodeid_time ON noderegistration(nodeid, simulationtime);";
 
     m_createStmtsStrings[TABLE_CMM_ACTION] =
         "CREATE TABLE IF NOT EXISTS cmmaction ("
@@ -1046,6 +3162,85 @@ OranDataRepositorySqlite::InitStatements()
         "simulationtime INTEGER                           NOT NULL, "
         "description    TEXT                              NOT NULL);";
 
+    m_createStmtsStrings[TABLE_CMM_EVENT] =
+        "CREATE TABLE IF NOT EXISTS cmmevent ("
+        "entryid        INTEGER PRIMARY KEY AUTOINCREMENT NOT NULL, "
+        "moduleid       INTEGER                           NOT NULL, "
+        "simulationtime INTEGER                           NOT NULL, "
+        "eventid        INTEGER                           NOT NULL, "
+        "arg0           REAL                              NOT NULL, "
+        "arg1           REAL                              NOT NULL, "
+        "arg2           REAL                              NOT NULL, "
+        "arg3           REAL                              NOT NULL, "
+        "FOREIGN KEY(moduleid) REFERENCES logmodule(moduleid), "
+        "FOREIGN KEY(eventid) REFERENCES logevent(eventid));";
+
+    m_createStmtsStrings[TABLE_LM_EVENT] =
+        "CREATE TABLE IF NOT EXISTS lmevent ("
+        "entryid        INTEGER PRIMARY KEY AUTOINCREMENT NOT NULL, "
+        "moduleid       INTEGER                           NOT NULL, "
+        "simulationtime INTEGER                           NOT NULL, "
+        "eventid        INTEGER                           NOT NULL, "
+        "arg0           REAL                              NOT NULL, "
+        "arg1           REAL                              NOT NULL, "
+        "arg2           REAL                              NOT NULL, "
+        "arg3           REAL                              NOT NULL, "
+        "FOREIGN KEY(moduleid) REFERENCES logmodule(moduleid), "
+        "FOREIGN KEY(eventid) REFERENCES logevent(eventid));";
+
+    m_createStmtsStrings[TABLE_LOG_EVENT] = "CREATE TABLE IF NOT EXISTS logevent ("
+                                            "eventid INTEGER PRIMARY KEY NOT NULL, "
+                                            "module  TEXT                NOT NULL, "
+                                            "format  TEXT                NOT NULL, "
+                                            "UNIQUE(module, format));";
+
+    m_createStmtsStrings[TABLE_LOG_MODULE] = "CREATE TABLE IF NOT EXISTS logmodule ("
+                                             "moduleid INTEGER PRIMARY KEY NOT NULL, "
+                                             "name     TEXT UNIQUE         NOT NULL);";
+
+    // The text of the events is only rendered when they are queried
+    m_createStmtsStrings[VIEW_CMM_EVENT_TEXT] =
+        "CREATE VIEW IF NOT EXISTS cmmeventtext AS "
+        "SELECT e.entryid, m.name AS cmmname, e.simulationtime, "
+        "printf(d.format, e.arg0, e.arg1, e.arg2, e.arg3) AS description "
+        "FROM cmmevent AS e "
+        "JOIN logmodule AS m ON m.moduleid = e.moduleid "
+        "JOIN logevent AS d ON d.eventid = e.eventid;";
+
+    m_createStmtsStrings[VIEW_LM_EVENT_TEXT] =
+        "CREATE VIEW IF NOT EXISTS lmeventtext AS "
+        "SELECT e.entryid, m.name AS lmname, e.simulationtime, "
+        "printf(d.format, e.arg0, e.arg1, e.arg2, e.arg3) AS description "
+        "FROM lmevent AS e "
+        "JOIN logmodule AS m ON m.moduleid = e.moduleid "
+        "JOIN logevent AS d ON d.eventid = e.eventid;";
+
+    // The free-form and the structured logs, with the text of the events
+    // prefixed by the time and the name of the module like the free-form logs
+    std::string timeSteps = std::to_string(Seconds(1).GetTimeStep()) + ".0";
+
+    m_createStmtsStrings[VIEW_CMM_LOG] =
+        "CREATE VIEW IF NOT EXISTS cmmlog AS "
+        "SELECT cmmname, simulationtime, description FROM cmmaction "
+        "UNION ALL "
+        "SELECT cmmname, simulationtime, "
+        "printf('%f -- %s -- ', simulationtime / " +
+        timeSteps +
+        ", cmmname) || description "
+        "FROM cmmeventtext "
+        "ORDER BY simulationtime;";
+
+    m_createStmtsStrings[VIEW_LM_LOG] =
+        "CREATE VIEW IF NOT EXISTS lmlog AS "
+        "SELECT lmname, simulationtime, description FROM lmaction "
+        "UNION ALL "
+        "SELECT lmname, simulationtime, "
+        "printf('%f -- %s -- ', simulationtime / " +
+        timeSteps +
+        ", lmname) || description "
+        "FROM lmeventtext "
+        "ORDER BY simulationtime;";
+
     m_createStmtsStrings[TABLE_LM_COMMAND] =
         "CREATE TABLE IF NOT EXISTS lmcommand ("
         "entryid        INTEGER PRIMARY KEY AUTOINCREMENT NOT NULL, "
@@ -1073,6 +3268,14 @@ OranDataRepositorySqlite::InitStatements()
         "FOREIGN KEY(cellid) REFERENCES lteenb(cellid), "
         "FOREIGN KEY(nodeid) REFERENCES lteue(nodeid));";
 
+    m_createStmtsStrings[TABLE_LTE_UE_CELL_LATEST] =
+        "CREATE TABLE IF NOT EXISTS lteuecell_latest ("
+        "nodeid         INTEGER PRIMARY KEY NOT NULL, "
+        "cellid         INTEGER             NOT NULL, "
+        "rnti           INTEGER             NOT NULL, "
+        "simulationtime INTEGER             NOT NULL, "
+        "FOREIGN KEY(nodeid) REFERENCES lteue(nodeid));";
+
     m_createStmtsStrings[TABLE_LTE_UE_RSRP_RSRQ] =
         "CREATE TABLE IF NOT EXISTS lteuersrprsrq ("
         "entryid        INTEGER PRIMARY KEY AUTOINCREMENT NOT NULL, "
@@ -1087,6 +3290,19 @@ OranDataRepositorySqlite::InitStatements()
         "FOREIGN KEY(cellid) REFERENCES lteenb(cellid), "
         "FOREIGN KEY(nodeid) REFERENCES lteue(nodeid));";
 
+    m_createStmtsStrings[TABLE_LTE_UE_RSRP_RSRQ_LATEST] =
+        "CREATE TABLE IF NOT EXISTS lteuersrprsrq_latest ("
+        "entryid        INTEGER PRIMARY KEY NOT NULL, "
+        "nodeid         INTEGER             NOT NULL, "
+        "simulationtime INTEGER             NOT NULL, "
+        "rnti           INTEGER             NOT NULL, "
+        "cellid         INTEGER             NOT NULL, "
+        "rsrp           REAL                NOT NULL, "
+        "rsrq           REAL                NOT NULL, "
+        "serving        BOOLEAN             NOT NULL, "
+        "ccid           BOOLEAN             NOT NULL, "
+        "FOREIGN KEY(nodeid) REFERENCES lteue(nodeid));";
+
     m_createStmtsStrings[TABLE_NODE] =
         "CREATE TABLE IF NOT EXISTS node ("
         "nodeid         INTEGER PRIMARY KEY AUTOINCREMENT NOT NULL, "
@@ -1102,6 +3318,15 @@ OranDataRepositorySqlite::InitStatements()
         "simulationtime INTEGER                           NOT NULL, "
         "FOREIGN KEY(nodeid) REFERENCES node(nodeid));";
 
+    m_createStmtsStrings[TABLE_NODE_LOCATION_LATEST] =
+        "CREATE TABLE IF NOT EXISTS nodelocation_latest ("
+        "nodeid         INTEGER PRIMARY KEY NOT NULL, "
+        "x              REAL                NOT NULL, "
+        "y              REAL                NOT NULL, "
+        "z              REAL                NOT NULL, "
+        "simulationtime INTEGER             NOT NULL, "
+        "FOREIGN KEY(nodeid) REFERENCES node(nodeid));";
+
     m_createStmtsStrings[TABLE_NODE_REGISTRATION] =
         "CREATE TABLE IF NOT EXISTS noderegistration ("
         "entryid        INTEGER PRIMARY KEY AUTOINCREMENT NOT NULL, "
@@ -1126,12 +3351,21 @@ OranDataRepositorySqlite::InitStatements()
         "simulationtime INTEGER                           NOT NULL, "
         "FOREIGN KEY(nodeid) REFERENCES node(nodeid)              );";
 
+    m_createStmtsStrings[TABLE_NODE_APPLOSS_LATEST] =
+        "CREATE TABLE IF NOT EXISTS nodeapploss_latest ("
+        "nodeid         INTEGER PRIMARY KEY NOT NULL, "
+        "loss           REAL                NOT NULL, "
+        "simulationtime INTEGER             NOT NULL, "
+        "FOREIGN KEY(nodeid) REFERENCES node(nodeid));";
+
     // Query Statements
-    m_queryStmtsStrings[CHECK_NODE_REGISTERED] = "SELECT registered "
-                                                 "FROM noderegistration "
-                                                 "WHERE nodeid = ? "
-                                                 "ORDER BY simulationtime DESC, entryid DESC "
-                                                 "LIMIT 1;";
+    m_queryStmtsStrings[BEGIN_TRANSACTION] = "BEGIN TRANSACTION;";
+
+    m_queryStmtsStrings[COMMIT_TRANSACTION] = "COMMIT TRANSACTION;";
+
+    m_queryStmtsStrings[DELETE_LTE_UE_RSRP_RSRQ_LATEST] =
+        "DELETE FROM lteuersrprsrq_latest "
+        "WHERE nodeid = ? AND simulationtime < ?;";
 
     m_queryStmtsStrings[GET_ALL_LAST_REGISTRATION_TIMES] = "SELECT nodeid, MAX(simulationtime) "
                                                            "FROM noderegistration "
@@ -1139,6 +3373,14 @@ OranDataRepositorySqlite::InitStatements()
                                                            "HAVING registered = 1 "
                                                            "ORDER BY nodeid;";
 
+    m_queryStmtsStrings[GET_ALL_REGISTRATIONS] = "SELECT nodeid, registered "
+                                                 "FROM noderegistration "
+                                                 "ORDER BY simulationtime ASC, entryid ASC;";
+
+    m_queryStmtsStrings[GET_LOG_EVENTS] = "SELECT eventid, module, format FROM logevent;";
+
+    m_queryStmtsStrings[GET_LOG_MODULES] = "SELECT moduleid, name FROM logmodule;";
+
     m_queryStmtsStrings[GET_LTE_ALL_ENB_E2NODEIDS] =
         "SELECT nr.nodeid, MAX(nr.simulationtime) "
         "FROM noderegistration AS nr "
@@ -1158,11 +3400,15 @@ OranDataRepositorySqlite::InitStatements()
                                                         "FROM lteenb "
                                                         "WHERE nodeid = ?;";
 
+    m_queryStmtsStrings[GET_LTE_ENB_SNAPSHOT] = "SELECT enb.nodeid, enb.cellid, nl.x, nl.y, nl.z "
+                                                "FROM lteenb AS enb "
+                                                "INNER JOIN nodelocation_latest AS nl "
+                                                "ON nl.nodeid = enb.nodeid "
+                                                "ORDER BY enb.nodeid;";
+
     m_queryStmtsStrings[GET_LTE_UE_CELLINFO] = "SELECT cellid, rnti "
-                                               "FROM lteuecell "
-                                               "WHERE nodeid = ? "
-                                               "ORDER BY simulationtime DESC, entryid DESC "
-                                               "LIMIT 1;";
+                                               "FROM lteuecell_latest "
+                                               "WHERE nodeid = ?;";
 
     m_queryStmtsStrings[GET_LTE_UE_E2NODEID_FROM_CELLINFO] = "SELECT nodeid "
                                                              "FROM lteuecell "
@@ -1175,15 +3421,47 @@ OranDataRepositorySqlite::InitStatements()
         "WHERE nodeid = ? AND simulationtime >= ? AND simulationtime <= ? "
         "ORDER BY simulationtime DESC, entryid DESC LIMIT ? ;";
 
+    m_queryStmtsStrings[GET_NODE_APPLOSS] = "SELECT loss "
+                                            "FROM nodeapploss_latest "
+                                            "WHERE nodeid = ?;";
+
+    m_queryStmtsStrings[GET_NODE_LATEST_POSITION] = "SELECT simulationtime, x, y, z "
+                                                    "FROM nodelocation_latest "
+                                                    "WHERE nodeid = ?;";
+
+    m_queryStmtsStrings[GET_NODE_POSITION_AFTER] =
+        "SELECT simulationtime, x, y, z "
+        "FROM nodelocation "
+        "WHERE nodeid = ? AND simulationtime > ? "
+        "ORDER BY simulationtime ASC, entryid ASC LIMIT 1;";
+
+    m_queryStmtsStrings[GET_NODE_POSITION_BEFORE] =
+        "SELECT simulationtime, x, y, z "
+        "FROM nodelocation "
+        "WHERE nodeid = ? AND simulationtime <= ? "
+        "ORDER BY simulationtime DESC, entryid DESC LIMIT 1;";
+
     m_queryStmtsStrings[GET_LTE_UE_RSRP_RSRQ] = "SELECT rnti, cellid, rsrp, rsrq, serving, ccid "
-                                                "FROM lteuersrprsrq "
-                                                "WHERE nodeid = ? "
-                                                "AND simulationtime IN ("
-                                                "SELECT simulationtime "
-                                                "FROM lteuersrprsrq "
+                                                "FROM lteuersrprsrq_latest "
                                                 "WHERE nodeid = ? "
-                                                "ORDER BY simulationtime DESC LIMIT 1"
-                                                ");";
+                                                "ORDER BY entryid;";
+
+    m_queryStmtsStrings[GET_LTE_UE_SNAPSHOT] =
+        "SELECT ue.nodeid, lc.cellid, lc.rnti, nl.x, nl.y, nl.z, IFNULL(al.loss, 0) "
+        "FROM lteue AS ue "
+        "INNER JOIN lteuecell_latest AS lc ON lc.nodeid = ue.nodeid "
+        "INNER JOIN nodelocation_latest AS nl ON nl.nodeid = ue.nodeid "
+        "LEFT JOIN nodeapploss_latest AS al ON al.nodeid = ue.nodeid "
+        "ORDER BY ue.nodeid;";
+
+    m_queryStmtsStrings[GET_MAX_E2NODEID] = "SELECT IFNULL(MAX(nodeid), 0) "
+                                            "FROM node;";
+
+    m_queryStmtsStrings[INSERT_LOG_EVENT] = "INSERT OR IGNORE INTO logevent "
+                                            "(eventid, module, format) VALUES (?, ?, ?);";
+
+    m_queryStmtsStrings[INSERT_LOG_MODULE] = "INSERT OR IGNORE INTO logmodule "
+                                             "(moduleid, name) VALUES (?, ?);";
 
     m_queryStmtsStrings[INSERT_LTE_ENB_NODE] = "INSERT OR REPLACE INTO lteenb "
                                                "(nodeid, cellid) VALUES (?, ?);";
@@ -1192,11 +3470,24 @@ OranDataRepositorySqlite::InitStatements()
         "INSERT INTO lteuecell "
         "(nodeid, cellid, rnti, simulationtime) VALUES (?, ?, ?, ?);";
 
+    // Only replace the latest cell information if it is not newer than the new one
+    m_queryStmtsStrings[INSERT_LTE_UE_CELL_LATEST] =
+        "INSERT OR REPLACE INTO lteuecell_latest "
+        "(nodeid, cellid, rnti, simulationtime) "
+        "SELECT ?1, ?2, ?3, ?4 "
+        "WHERE NOT EXISTS (SELECT 1 FROM lteuecell_latest "
+        "WHERE nodeid = ?1 AND simulationtime > ?4);";
+
     m_queryStmtsStrings[INSERT_LTE_UE_NODE] = "INSERT OR REPLACE INTO lteue "
                                               "(nodeid, imsi) VALUES (?, ?);";
 
-    m_queryStmtsStrings[INSERT_NODE_ADD] = "INSERT INTO node "
-                                           "(nodetype) VALUES (?);";
+    m_queryStmtsStrings[INSERT_NODE_APPLOSS] =
+        "INSERT INTO nodeapploss "
+        "(nodeid, loss, simulationtime) VALUES (?, ?, ?);";
+
+    m_queryStmtsStrings[INSERT_NODE_APPLOSS_LATEST] =
+        "INSERT OR REPLACE INTO nodeapploss_latest "
+        "(nodeid, loss, simulationtime) VALUES (?, ?, ?);";
 
     m_queryStmtsStrings[INSERT_NODE_UPDATE] = "INSERT OR REPLACE INTO node "
                                               "(nodeid, nodetype) VALUES (?, ?);";
@@ -1205,6 +3496,14 @@ OranDataRepositorySqlite::InitStatements()
         "INSERT INTO nodelocation "
         "(nodeid, x, y, z, simulationtime) VALUES (?, ?, ?, ?, ?);";
 
+    // Only replace the latest position if it is not newer than the new one
+    m_queryStmtsStrings[INSERT_NODE_LOCATION_LATEST] =
+        "INSERT OR REPLACE INTO nodelocation_latest "
+        "(nodeid, x, y, z, simulationtime) "
+        "SELECT ?1, ?2, ?3, ?4, ?5 "
+        "WHERE NOT EXISTS (SELECT 1 FROM nodelocation_latest "
+        "WHERE nodeid = ?1 AND simulationtime > ?5);";
+
     m_queryStmtsStrings[INSERT_NODE_REGISTRATION] =
         "INSERT INTO noderegistration "
         "(nodeid, registered, simulationtime) VALUES (?, ?, ?);";
@@ -1214,10 +3513,23 @@ OranDataRepositorySqlite::InitStatements()
         "(nodeid, simulationtime, rnti, cellid, rsrp, rsrq, serving, ccid) VALUES (?, ?, ?, ?, ?, "
         "?, ?, ?);";
 
+    // Only add the measurements if there are no newer ones
+    m_queryStmtsStrings[INSERT_LTE_UE_RSRP_RSRQ_LATEST] =
+        "INSERT INTO lteuersrprsrq_latest "
+        "(nodeid, simulationtime, rnti, cellid, rsrp, rsrq, serving, ccid) "
+        "SELECT ?1, ?2, ?3, ?4, ?5, ?6, ?7, ?8 "
+        "WHERE NOT EXISTS (SELECT 1 FROM lteuersrprsrq_latest "
+        "WHERE nodeid = ?1 AND simulationtime > ?2);";
+
     m_queryStmtsStrings[LOG_CMM_ACTION] =
         "INSERT INTO cmmaction "
         "(cmmname, simulationtime, description) VALUES (?, ?, ?);";
 
+    m_queryStmtsStrings[LOG_CMM_EVENT] =
+        "INSERT INTO cmmevent "
+        "(moduleid, simulationtime, eventid, arg0, arg1, arg2, arg3) "
+        "VALUES (?, ?, ?, ?, ?, ?, ?);";
+
     m_queryStmtsStrings[LOG_E2TERMINATOR_COMMAND] =
         "INSERT INTO terminatorcommand "
         "(targetid, simulationtime, cmdname) VALUES (?, ?, ?);";
@@ -1227,6 +3539,284 @@ OranDataRepositorySqlite::InitStatements()
 
     m_queryStmtsStrings[LOG_LM_COMMAND] = "INSERT INTO lmcommand "
                                           "(lmname, simulationtime, cmdname) VALUES (?, ?, ?);";
+
+    m_queryStmtsStrings[LOG_LM_EVENT] =
+        "INSERT INTO lmevent "
+        "(moduleid, simulationtime, eventid, arg0, arg1, arg2, arg3) "
+        "VALUES (?, ?, ?, ?, ?, ?, ?);";
+
+    // Remove the entries of a node older than a time, always keeping the latest one
+    m_queryStmtsStrings[PRUNE_LTE_UE_CELL_AGE] =
+        "DELETE FROM lteuecell "
+        "WHERE entryid IN (SELECT entryid FROM lteuecell "
+        "WHERE nodeid = ?1 AND simulationtime < "
+        "MIN(?2, (SELECT MAX(simulationtime) FROM lteuecell WHERE nodeid = ?1)) "
+        "ORDER BY simulationtime LIMIT ?3);";
+
+    // Remove the entries of a node beyond the newest given number
+    m_queryStmtsStrings[PRUNE_LTE_UE_CELL_COUNT] =
+        "DELETE FROM lteuecell "
+        "WHERE entryid IN (SELECT entryid FROM lteuecell "
+        "WHERE nodeid = ?1 "
+        "ORDER BY simulationtime DESC, entryid DESC LIMIT ?3 OFFSET ?2);";
+
+    m_queryStmtsStrings[PRUNE_LTE_UE_RSRP_RSRQ_AGE] =
+        "DELETE FROM lteuersrprsrq "
+        "WHERE entryid IN (SELECT entryid FROM lteuersrprsrq "
+        "WHERE nodeid = ?1 AND simulationtime < "
+        "MIN(?2, (SELECT MAX(simulationtime) FROM lteuersrprsrq WHERE nodeid = ?1)) "
+        "ORDER BY simulationtime LIMIT ?3);";
+
+    m_queryStmtsStrings[PRUNE_LTE_UE_RSRP_RSRQ_COUNT] =
+        "DELETE FROM lteuersrprsrq "
+        "WHERE entryid IN (SELECT entryid FROM lteuersrprsrq "
+        "WHERE nodeid = ?1 "
+        "ORDER BY simulationtime DESC, entryid DESC LIMIT ?3 OFFSET ?2);";
+
+    m_queryStmtsStrings[PRUNE_NODE_APPLOSS_AGE] =
+        "DELETE FROM nodeapploss "
+        "WHERE entryid IN (SELECT entryid FROM nodeapploss "
+        "WHERE nodeid = ?1 AND simulationtime < "
+        "MIN(?2, (SELECT MAX(simulationtime) FROM nodeapploss WHERE nodeid = ?1)) "
+        "ORDER BY simulationtime LIMIT ?3);";
+
+    m_queryStmtsStrings[PRUNE_NODE_APPLOSS_COUNT] =
+        "DELETE FROM nodeapploss "
+        "WHERE entryid IN (SELECT entryid FROM nodeapploss "
+        "WHERE nodeid = ?1 "
+        "ORDER BY simulationtime DESC, entryid DESC LIMIT ?3 OFFSET ?2);";
+
+    m_queryStmtsStrings[PRUNE_NODE_LOCATION_AGE] =
+        "DELETE FROM nodelocation "
+        "WHERE entryid IN (SELECT entryid FROM nodelocation "
+        "WHERE nodeid = ?1 AND simulationtime < "
+        "MIN(?2, (SELECT MAX(simulationtime) FROM nodelocation WHERE nodeid = ?1)) "
+        "ORDER BY simulationtime LIMIT ?3);";
+
+    m_queryStmtsStrings[PRUNE_NODE_LOCATION_COUNT] =
+        "DELETE FROM nodelocation "
+        "WHERE entryid IN (SELECT entryid FROM nodelocation "
+        "WHERE nodeid = ?1 "
+        "ORDER BY simulationtime DESC, entryid DESC LIMIT ?3 OFFSET ?2);";
+
+    m_queryStmtsStrings[PRUNE_NODE_REGISTRATION_AGE] =
+        "DELETE FROM noderegistration "
+        "WHERE entryid IN (SELECT entryid FROM noderegistration "
+        "WHERE nodeid = ?1 AND simulationtime < "
+        "MIN(?2, (SELECT MAX(simulationtime) FROM noderegistration WHERE nodeid = ?1)) "
+        "ORDER BY simulationtime LIMIT ?3);";
+
+    m_queryStmtsStrings[PRUNE_NODE_REGISTRATION_COUNT] =
+        "DELETE FROM noderegistration "
+        "WHERE entryid IN (SELECT entryid FROM noderegistration "
+        "WHERE nodeid = ?1 "
+        "ORDER BY simulationtime DESC, entryid DESC LIMIT ?3 OFFSET ?2);";
+
+    // Move the last location of a node, which is the newest one with its time
+    m_queryStmtsStrings[UPDATE_NODE_LOCATION] =
+        "UPDATE nodelocation "
+        "SET x = ?2, y = ?3, z = ?4, simulationtime = ?5 "
+        "WHERE entryid = (SELECT MAX(entryid) FROM nodelocation "
+        "WHERE nodeid = ?1 AND simulationtime = ?6);";
+
+    if (m_schemaVersion >= 2)
+    {
+        // Schema version 2: the history tables have no row IDs, and are
+        // clustered on (nodeid, simulationtime, seq), where seq is a sequence
+        // number that preserves the insertion order
+        m_createStmtsStrings[BACKFILL_LTE_UE_CELL_LATEST] =
+            "INSERT OR IGNORE INTO lteuecell_latest "
+            "(nodeid, cellid, rnti, simulationtime) "
+            "SELECT nodeid, cellid, rnti, simulationtime "
+            "FROM lteuecell AS lc "
+            "WHERE seq = (SELECT seq FROM lteuecell "
+            "WHERE nodeid = lc.nodeid "
+            "ORDER BY simulationtime DESC, seq DESC LIMIT 1) "
+            "AND NOT EXISTS (SELECT 1 FROM lteuecell_latest);";
+
+        m_createStmtsStrings[BACKFILL_LTE_UE_RSRP_RSRQ_LATEST] =
+            "INSERT INTO lteuersrprsrq_latest "
+            "(nodeid, simulationtime, rnti, cellid, rsrp, rsrq, serving, ccid) "
+            "SELECT nodeid, simulationtime, rnti, cellid, rsrp, rsrq, serving, ccid "
+            "FROM lteuersrprsrq AS rr "
+            "WHERE simulationtime = (SELECT MAX(simulationtime) FROM lteuersrprsrq "
+            "WHERE nodeid = rr.nodeid) "
+            "AND NOT EXISTS (SELECT 1 FROM lteuersrprsrq_latest) "
+            "ORDER BY seq;";
+
+        m_createStmtsStrings[BACKFILL_NODE_APPLOSS_LATEST] =
+            "INSERT OR IGNORE INTO nodeapploss_latest "
+            "(nodeid, loss, simulationtime) "
+            "SELECT nodeid, loss, simulationtime "
+            "FROM nodeapploss "
+            "WHERE seq IN (SELECT MAX(seq) FROM nodeapploss GROUP BY nodeid) "
+            "AND NOT EXISTS (SELECT 1 FROM nodeapploss_latest);";
+
+        m_createStmtsStrings[BACKFILL_NODE_LOCATION_LATEST] =
+            "INSERT OR IGNORE INTO nodelocation_latest "
+            "(nodeid, x, y, z, simulationtime) "
+            "SELECT nodeid, x, y, z, simulationtime "
+            "FROM nodelocation AS nl "
+            "WHERE seq = (SELECT seq FROM nodelocation "
+            "WHERE nodeid = nl.nodeid "
+            "ORDER BY simulationtime DESC, seq DESC LIMIT 1) "
+            "AND NOT EXISTS (SELECT 1 FROM nodelocation_latest);";
+
+        m_createStmtsStrings[INDEX_LTE_UE_CELL_CELLID] =
+            "CREATE INDEX IF NOT EXISTS "
+            "idx_lteuecell_cellid_rnti ON lteuecell(cellid, rnti, seq);";
+
+        m_createStmtsStrings[TABLE_LTE_UE_CELL] =
+            "CREATE TABLE IF NOT EXISTS lteuecell ("
+            "nodeid         INTEGER NOT NULL, "
+            "simulationtime INTEGER NOT NULL, "
+            "seq            INTEGER NOT NULL, "
+            "cellid         INTEGER NOT NULL, "
+            "rnti           INTEGER NOT NULL, "
+            "PRIMARY KEY(nodeid, simulationtime, seq), "
+            "FOREIGN KEY(cellid) REFERENCES lteenb(cellid), "
+            "FOREIGN KEY(nodeid) REFERENCES lteue(nodeid)) WITHOUT ROWID;";
+
+        m_createStmtsStrings[TABLE_LTE_UE_RSRP_RSRQ] =
+            "CREATE TABLE IF NOT EXISTS lteuersrprsrq ("
+            "nodeid         INTEGER NOT NULL, "
+            "simulationtime INTEGER NOT NULL, "
+            "seq            INTEGER NOT NULL, "
+            "rnti           INTEGER NOT NULL, "
+            "cellid         INTEGER NOT NULL, "
+            "rsrp           REAL    NOT NULL, "
+            "rsrq           REAL    NOT NULL, "
+            "serving        BOOLEAN NOT NULL, "
+            "ccid           BOOLEAN NOT NULL, "
+            "PRIMARY KEY(nodeid, simulationtime, seq), "
+            "FOREIGN KEY(cellid) REFERENCES lteenb(cellid), "
+            "FOREIGN KEY(nodeid) REFERENCES lteue(nodeid)) WITHOUT ROWID;";
+
+        m_createStmtsStrings[TABLE_NODE_LOCATION] =
+            "CREATE TABLE IF NOT EXISTS nodelocation ("
+            "nodeid         INTEGER NOT NULL, "
+            "simulationtime INTEGER NOT NULL, "
+            "seq            INTEGER NOT NULL, "
+            "x              REAL    NOT NULL, "
+            "y              REAL    NOT NULL, "
+            "z              REAL    NOT NULL, "
+            "PRIMARY KEY(nodeid, simulationtime, seq), "
+            "FOREIGN KEY(nodeid) REFERENCES node(nodeid)) WITHOUT ROWID;";
+
+        m_createStmtsStrings[TABLE_APPLOSS_COMMAND] =
+            "CREATE TABLE IF NOT EXISTS nodeapploss ("
+            "nodeid         INTEGER NOT NULL, "
+            "simulationtime INTEGER NOT NULL, "
+            "seq            INTEGER NOT NULL, "
+            "loss           REAL    NOT NULL, "
+            "PRIMARY KEY(nodeid, simulationtime, seq), "
+            "FOREIGN KEY(nodeid) REFERENCES node(nodeid)) WITHOUT ROWID;";
+
+        m_queryStmtsStrings[PRUNE_LTE_UE_CELL_AGE] =
+            "DELETE FROM lteuecell "
+            "WHERE (nodeid, simulationtime, seq) IN (SELECT nodeid, simulationtime, seq "
+            "FROM lteuecell WHERE nodeid = ?1 AND simulationtime < "
+            "MIN(?2, (SELECT MAX(simulationtime) FROM lteuecell WHERE nodeid = ?1)) "
+            "ORDER BY simulationtime LIMIT ?3);";
+
+        m_queryStmtsStrings[PRUNE_LTE_UE_CELL_COUNT] =
+            "DELETE FROM lteuecell "
+            "WHERE (nodeid, simulationtime, seq) IN (SELECT nodeid, simulationtime, seq "
+            "FROM lteuecell WHERE nodeid = ?1 "
+            "ORDER BY simulationtime DESC, seq DESC LIMIT ?3 OFFSET ?2);";
+
+        m_queryStmtsStrings[PRUNE_LTE_UE_RSRP_RSRQ_AGE] =
+            "DELETE FROM lteuersrprsrq "
+            "WHERE (nodeid, simulationtime, seq) IN (SELECT nodeid, simulationtime, seq "
+            "FROM lteuersrprsrq WHERE nodeid = ?1 AND simulationtime < "
+            "MIN(?2, (SELECT MAX(simulationtime) FROM lteuersrprsrq WHERE nodeid = ?1)) "
+            "ORDER BY simulationtime LIMIT ?3);";
+
+        m_queryStmtsStrings[PRUNE_LTE_UE_RSRP_RSRQ_COUNT] =
+            "DELETE FROM lteuersrprsrq "
+            "WHERE (nodeid, simulationtime, seq) IN (SELECT nodeid, simulationtime, seq "
+            "FROM lteuersrprsrq WHERE nodeid = ?1 "
+            "ORDER BY simulationtime DESC, seq DESC LIMIT ?3 OFFSET ?2);";
+
+        m_queryStmtsStrings[PRUNE_NODE_APPLOSS_AGE] =
+            "DELETE FROM nodeapploss "
+            "WHERE (nodeid, simulationtime, seq) IN (SELECT nodeid, simulationtime, seq "
+            "FROM nodeapploss WHERE nodeid = ?1 AND simulationtime < "
+            "MIN(?2, (SELECT MAX(simulationtime) FROM nodeapploss WHERE nodeid = ?1)) "
+            "ORDER BY simulationtime LIMIT ?3);";
+
+        m_queryStmtsStrings[PRUNE_NODE_APPLOSS_COUNT] =
+            "DELETE FROM nodeapploss "
+            "WHERE (nodeid, simulationtime, seq) IN (SELECT nodeid, simulationtime, seq "
+            "FROM nodeapploss WHERE nodeid = ?1 "
+            "ORDER BY simulationtime DESC, seq DESC LIMIT ?3 OFFSET ?2);";
+
+        m_queryStmtsStrings[PRUNE_NODE_LOCATION_AGE] =
+            "DELETE FROM nodelocation "
+            "WHERE (nodeid, simulationtime, seq) IN (SELECT nodeid, simulationtime, seq "
+            "FROM nodelocation WHERE nodeid = ?1 AND simulationtime < "
+            "MIN(?2, (SELECT MAX(simulationtime) FROM nodelocation WHERE nodeid = ?1)) "
+            "ORDER BY simulationtime LIMIT ?3);";
+
+        m_queryStmtsStrings[PRUNE_NODE_LOCATION_COUNT] =
+            "DELETE FROM nodelocation "
+            "WHERE (nodeid, simulationtime, seq) IN (SELECT nodeid, simulationtime, seq "
+            "FROM nodelocation WHERE nodeid = ?1 "
+            "ORDER BY simulationtime DESC, seq DESC LIMIT ?3 OFFSET ?2);";
+
+        m_queryStmtsStrings[GET_LTE_UE_E2NODEID_FROM_CELLINFO] = "SELECT nodeid "
+                                                                 "FROM lteuecell "
+                                                                 "WHERE cellid = ? AND rnti = ? "
+                                                                 "ORDER BY seq DESC LIMIT 1;";
+
+        m_queryStmtsStrings[GET_MAX_SEQ] = "SELECT MAX(maxseq) FROM ("
+                                           "SELECT IFNULL(MAX(seq), 0) AS maxseq "
+                                           "FROM nodelocation UNION ALL "
+                                           "SELECT IFNULL(MAX(seq), 0) FROM lteuecell UNION ALL "
+                                           "SELECT IFNULL(MAX(seq), 0) FROM lteuersrprsrq "
+                                           "UNION ALL "
+                                           "SELECT IFNULL(MAX(seq), 0) FROM nodeapploss);";
+
+        m_queryStmtsStrings[GET_NODE_ALL_POSITIONS] =
+            "SELECT simulationtime, x, y, z "
+            "FROM nodelocation "
+            "WHERE nodeid = ? AND simulationtime >= ? AND simulationtime <= ? "
+            "ORDER BY simulationtime DESC, seq DESC LIMIT ? ;";
+
+        m_queryStmtsStrings[GET_NODE_POSITION_AFTER] =
+            "SELECT simulationtime, x, y, z "
+            "FROM nodelocation "
+            "WHERE nodeid = ? AND simulationtime > ? "
+            "ORDER BY simulationtime ASC, seq ASC LIMIT 1;";
+
+        m_queryStmtsStrings[UPDATE_NODE_LOCATION] =
+            "UPDATE nodelocation "
+            "SET x = ?2, y = ?3, z = ?4, simulationtime = ?5 "
+            "WHERE nodeid = ?1 AND simulationtime = ?6 AND seq = ?7;";
+
+        m_queryStmtsStrings[GET_NODE_POSITION_BEFORE] =
+            "SELECT simulationtime, x, y, z "
+            "FROM nodelocation "
+            "WHERE nodeid = ? AND simulationtime <= ? "
+            "ORDER BY simulationtime DESC, seq DESC LIMIT 1;";
+
+        m_queryStmtsStrings[INSERT_LTE_UE_CELL] =
+            "INSERT INTO lteuecell "
+            "(nodeid, cellid, rnti, simulationtime, seq) VALUES (?, ?, ?, ?, ?);";
+
+        m_queryStmtsStrings[INSERT_NODE_APPLOSS] =
+            "INSERT INTO nodeapploss "
+            "(nodeid, loss, simulationtime, seq) VALUES (?, ?, ?, ?);";
+
+        m_queryStmtsStrings[INSERT_NODE_LOCATION] =
+            "INSERT INTO nodelocation "
+            "(nodeid, x, y, z, simulationtime, seq) VALUES (?, ?, ?, ?, ?, ?);";
+
+        m_queryStmtsStrings[INSERT_LTE_UE_RSRP_RSRQ] =
+            "INSERT INTO lteuersrprsrq "
+            "(nodeid, simulationtime, rnti, cellid, rsrp, rsrq, serving, ccid, seq) "
+            "VALUES (?, ?, ?, ?, ?, ?, ?, ?, ?);";
+    }
 }
 
 void
@@ -33,10 +33,20 @@
 
 #include "oran-data-repository.h"
 
+#include "ns3/event-id.h"
 #include "ns3/traced-callback.h"
 
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <map>
+#include <mutex>
 #include <sqlite3.h>
 #include <sstream>
+#include <thread>
+#include <unordered_map>
+#include <vector>
 
 namespace ns3
 {
@@ -51,9 +61,12 @@ namespace ns3
  * database. This class does not provide methods for deleting existing database
  * files; if this is required, the user must take care of that in the scenario.
  *
- * The methods defined in the OranDataRepository API build SQL prepared
- * statements to access the database, validating the return code after each
- * database query.
+ * The methods defined in the OranDataRepository API access the database
+ * through a cache of SQL prepared statements, validating the return code
+ * after each database query. The statements are compiled once, when the
+ * database is opened, reset and rebound on every call, and finalized when
+ * the database is closed. Statements are only compiled and finalized on
+ * every call if the "CacheStatements" attribute is disabled.
  */
 class OranDataRepositorySqlite : public OranDataRepository
 {
@@ -82,6 +95,13 @@ class OranDataRepositorySqlite : public OranDataRepository
      * this method will call CloseDb.
      */
     void Deactivate() override;
+    /**
+     * Commit the open write batch, if any, and wait until all the queued
+     * writes have been executed. The commit only has an effect if write
+     * batching is enabled, and the wait only if asynchronous writes are
+     * enabled.
+     */
+    void FlushWrites();
 
     /* Data Storage API */
     bool IsNodeRegistered(uint64_t e2NodeId) override;
@@ -115,11 +135,214 @@ class OranDataRepositorySqlite : public OranDataRepository
     double GetAppLoss(uint64_t e2NodeId) override;
     std::vector<std::tuple<uint16_t, uint16_t, double, double, bool, uint8_t>> GetLteUeRsrpRsrq(
         uint64_t e2NodeId) override;
+    LteUeSnapshot GetLteUeSnapshot() override;
+    LteEnbSnapshot GetLteEnbSnapshot() override;
+    std::tuple<bool, Time, Vector> GetLatestNodePosition(uint64_t e2NodeId) override;
+    void ForEachNodePosition(uint64_t e2NodeId,
+                             Time fromTime,
+                             Time toTime,
+                             uint64_t maxEntries,
+                             const NodePositionVisitor& visitor) override;
+    void ForEachLteUeRsrpRsrq(uint64_t e2NodeId, const LteUeRsrpRsrqVisitor& visitor) override;
 
     void LogCommandE2Terminator(Ptr<OranCommand> cmd) override;
     void LogCommandLm(std::string lm, Ptr<OranCommand> cmd) override;
     void LogActionLm(std::string lm, std::string logstr) override;
     void LogActionCmm(std::string cmm, std::string logstr) override;
+    void LogEventLm(const std::string& lm,
+                    LogEvent event,
+                    double arg0,
+                    double arg1,
+                    double arg2,
+                    double arg3) override;
+    void LogEventCmm(const std::string& cmm,
+                     LogEvent event,
+                     double arg0,
+                     double arg1,
+                     double arg2,
+                     double arg3) override;
+
+    /* Import API */
+    /**
+     * Store an E2 Node, without registering it.
+     *
+     * @param e2NodeId The E2 Node ID.
+     * @param type The Node Type.
+     */
+    void ImportNode(uint64_t e2NodeId, OranNearRtRic::NodeType type);
+    /**
+     * Store the IMSI of an LTE UE E2 Node.
+     *
+     * @param e2NodeId The E2 Node ID.
+     * @param imsi The IMSI of the LTE UE.
+     */
+    void ImportNodeLteUe(uint64_t e2NodeId, uint64_t imsi);
+    /**
+     * Store the cell ID of an LTE eNB E2 Node.
+     *
+     * @param e2NodeId The E2 Node ID.
+     * @param cellId The cell ID of the LTE eNB.
+     */
+    void ImportNodeLteEnb(uint64_t e2NodeId, uint16_t cellId);
+    /**
+     * Store a registration or deregistration request of an E2 Node.
+     *
+     * @param e2NodeId The E2 Node ID.
+     * @param registered True for a registration; false for a deregistration.
+     * @param t The time of the request.
+     */
+    void ImportNodeRegistration(uint64_t e2NodeId, bool registered, Time t);
+    /**
+     * Store the position of a node at a given time.
+     *
+     * @param e2NodeId The E2 Node ID of the node.
+     * @param pos The position.
+     * @param t The time at which this position was reported for the node.
+     */
+    void ImportPosition(uint64_t e2NodeId, Vector pos, Time t);
+    /**
+     * Store the UE's connected cell information at the given time.
+     *
+     * @param e2NodeId The E2 Node ID of the node.
+     * @param cellId The cell ID of the connected cell.
+     * @param rnti The RNTI assigned to the UE by the cell.
+     * @param t The time at which this cell information was reported by the node.
+     */
+    void ImportLteUeCellInfo(uint64_t e2NodeId, uint16_t cellId, uint16_t rnti, Time t);
+    /**
+     * Store the UE's application packet loss.
+     *
+     * @param e2NodeId The E2 Node ID of the node.
+     * @param appLoss The application packet loss.
+     * @param t The time at which the loss was reported by the node.
+     */
+    void ImportAppLoss(uint64_t e2NodeId, double appLoss, Time t);
+    /**
+     * Store the UE's RSRP and RSRQ.
+     *
+     * @param e2NodeId The E2 Node ID of the node.
+     * @param t The time at which the values were reported by the node.
+     * @param rnti The RNTI assigned to the UE by the cell.
+     * @param cellId The cell ID of the cell.
+     * @param rsrp The RSRP value.
+     * @param rsrq The RSRQ value.
+     * @param isServingCell A flag that indicates if this is the serving cell.
+     * @param componentCarrierId The component carrier ID.
+     */
+    void ImportLteUeRsrpRsrq(uint64_t e2NodeId,
+                             Time t,
+                             uint16_t rnti,
+                             uint16_t cellId,
+                             double rsrp,
+                             double rsrq,
+                             bool isServingCell,
+                             uint8_t componentCarrierId);
+    /**
+     * Store a Command issued by the E2 Terminator.
+     *
+     * @param targetE2NodeId The E2 Node ID of the target of the Command.
+     * @param t The time at which the Command was issued.
+     * @param cmd The string representation of the Command.
+     */
+    void ImportCommandE2Terminator(uint64_t targetE2NodeId, Time t, const std::string& cmd);
+    /**
+     * Store a Command issued by a Logic Module.
+     *
+     * @param lm The Logic Module's name.
+     * @param t The time at which the Command was issued.
+     * @param cmd The string representation of the Command.
+     */
+    void ImportCommandLm(const std::string& lm, Time t, const std::string& cmd);
+    /**
+     * Store a Logic Module action.
+     *
+     * @param lm The Logic Module's name.
+     * @param t The time of the action.
+     * @param logStr The string with the action.
+     */
+    void ImportActionLm(const std::string& lm, Time t, const std::string& logStr);
+    /**
+     * Store a Conflict Mitigation Module action.
+     *
+     * @param cmm The Conflict Mitigation Module's name.
+     * @param t The time of the action.
+     * @param logStr The string with the action.
+     */
+    void ImportActionCmm(const std::string& cmm, Time t, const std::string& logStr);
+    /**
+     * Store a structured Logic Module event.
+     *
+     * @param lm The Logic Module's name.
+     * @param t The time of the event.
+     * @param event The event code.
+     * @param arg0 The first argument of the event.
+     * @param arg1 The second argument of the event.
+     * @param arg2 The third argument of the event.
+     * @param arg3 The fourth argument of the event.
+     */
+    void ImportEventLm(const std::string& lm,
+                       Time t,
+                       LogEvent event,
+                       double arg0,
+                       double arg1,
+                       double arg2,
+                       double arg3);
+    /**
+     * Store a structured Conflict Mitigation Module event.
+     *
+     * @param cmm The Conflict Mitigation Module's name.
+     * @param t The time of the event.
+     * @param event The event code.
+     * @param arg0 The first argument of the event.
+     * @param arg1 The second argument of the event.
+     * @param arg2 The third argument of the event.
+     * @param arg3 The fourth argument of the event.
+     */
+    void ImportEventCmm(const std::string& cmm,
+                        Time t,
+                        LogEvent event,
+                        double arg0,
+                        double arg1,
+                        double arg2,
+                        double arg3);
+
+    /**
+     * The number of buckets of the latency histograms of the statements.
+     */
+    static const uint32_t QUERY_LATENCY_BUCKETS = 32;
+    /**
+     * The execution statistics of a prepared statement. Bucket i of the
+     * histogram counts the executions that took from 2^i to 2^(i+1) - 1
+     * nanoseconds of wall-clock time (the first bucket includes 0 ns, and the
+     * last one every longer execution).
+     */
+    struct QueryStats
+    {
+        uint64_t count = 0; //!< The number of executions.
+        Time totalTime;     //!< The total wall-clock time of the executions.
+        Time minTime;       //!< The wall-clock time of the fastest execution.
+        Time maxTime;       //!< The wall-clock time of the slowest execution.
+        std::array<uint64_t, QUERY_LATENCY_BUCKETS> histogram{}; //!< The latency histogram.
+    };
+
+    /**
+     * Get the execution statistics collected for the prepared statements
+     * since the object was created, if the "QueryStats" attribute is enabled.
+     * Only the statements that have been executed are included.
+     *
+     * @return A map with the statistics, indexed by the name of the statement.
+     */
+    std::map<std::string, QueryStats> GetQueryStats() const;
+    /**
+     * Print a summary of the execution statistics of the prepared statements,
+     * one line per statement in CSV format, with the number of executions,
+     * and the total, mean, minimum, maximum, median, and 99th percentile
+     * wall-clock times (in microseconds). The percentiles are the upper
+     * bounds of the histogram buckets that hold them.
+     *
+     * @param os The output stream.
+     */
+    void PrintQueryStats(std::ostream& os) const;
 
     /**
      * TracedCallback signature for SQL Queries. Traces the queries and the result code
@@ -130,6 +353,26 @@ class OranDataRepositorySqlite : public OranDataRepository
      * @param [in] rc The return code
      */
     typedef void (*QueryRcTracedCallback)(std::string query, std::string args, int rc);
+    /**
+     * TracedCallback signature for the size of the write-ahead log after a commit.
+     *
+     * @param [in] walPages The number of pages in the write-ahead log.
+     */
+    typedef void (*WalSizeTracedCallback)(int walPages);
+    /**
+     * TracedCallback signature for the checkpoints of the write-ahead log.
+     *
+     * @param [in] walPages The number of pages in the write-ahead log.
+     * @param [in] checkpointedPages The number of pages written back to the database.
+     */
+    typedef void (*WalCheckpointTracedCallback)(int walPages, int checkpointedPages);
+    /**
+     * TracedCallback signature for the wall-clock latency of a prepared statement.
+     *
+     * @param [in] statement The name of the statement.
+     * @param [in] latency The wall-clock time from getting the statement to resetting it.
+     */
+    typedef void (*QueryLatencyTracedCallback)(const std::string& statement, Time latency);
 
   protected:
     /**
@@ -138,27 +381,60 @@ class OranDataRepositorySqlite : public OranDataRepository
      */
     enum StatementType
     {
-        CHECK_NODE_REGISTERED = 0,         //!< Query if a node is registered
+        BEGIN_TRANSACTION = 0,             //!< Begin a write batch transaction
+        COMMIT_TRANSACTION,                //!< Commit a write batch transaction
+        DELETE_LTE_UE_RSRP_RSRQ_LATEST,    //!< Remove outdated latest UE RSRP and RSRQ
         GET_ALL_LAST_REGISTRATION_TIMES,   //!< Get node registation times
+        GET_ALL_REGISTRATIONS,             //!< Get all the node registration requests
+        GET_LOG_EVENTS,                    //!< Get the formats of the logged events
+        GET_LOG_MODULES,                   //!< Get the names of the logging modules
         GET_LTE_ALL_ENB_E2NODEIDS,         //!< Get all LTE eNB E2 IDs
         GET_LTE_ALL_UE_E2NODEIDS,          //!< Get all LTE UE E2 IDs
         GET_LTE_CELLID_FROM_E2NODEID,      //!< Get the cell ID of an LTE eNB from its E2 Node ID
+        GET_LTE_ENB_SNAPSHOT,              //!< Get the cell ID and position of all LTE eNBs
         GET_LTE_UE_CELLINFO,               //!< Get the cell information associated with LTE UE
         GET_LTE_UE_E2NODEID_FROM_CELLINFO, //!< Get the E2 ID of a UE from the cell information
         GET_LTE_UE_RSRP_RSRQ,              //!< Get the UE RSRP and RSRQ measurements
+        GET_LTE_UE_SNAPSHOT,               //!< Get the latest information of all LTE UEs
+        GET_MAX_E2NODEID,                  //!< Get the largest E2 Node ID in use
+        GET_MAX_SEQ,                       //!< Get the largest sequence number in use (v2)
         GET_NODE_ALL_POSITIONS,            //!< The location of all nodes E2 nodes
+        GET_NODE_APPLOSS,                  //!< Get the last application loss of an E2 node
+        GET_NODE_LATEST_POSITION,          //!< Get the latest location of an E2 node
+        GET_NODE_POSITION_AFTER,           //!< Get the first location of a node after a time
+        GET_NODE_POSITION_BEFORE,          //!< Get the last location of a node up to a time
+        INSERT_LOG_EVENT,                  //!< Add the format of a logged event
+        INSERT_LOG_MODULE,                 //!< Add the name of a logging module
         INSERT_LTE_ENB_NODE,               //!< Add an LTE eNB E2 node
         INSERT_LTE_UE_CELL,                //!< Add LTE UE cell information for an E2 node
+        INSERT_LTE_UE_CELL_LATEST,         //!< Update the latest LTE UE cell information
         INSERT_LTE_UE_NODE,                //!< Add an LTE UE E2 node
-        INSERT_NODE_ADD,                   //!< Add an E2 node
+        INSERT_NODE_APPLOSS,               //!< Add an E2 node's application loss
+        INSERT_NODE_APPLOSS_LATEST,        //!< Update an E2 node's latest application loss
         INSERT_NODE_UPDATE,                //!< Update an E2 node's information
         INSERT_NODE_LOCATION,              //!< Add an E2 node's location
+        INSERT_NODE_LOCATION_LATEST,       //!< Update an E2 node's latest location
         INSERT_NODE_REGISTRATION,          //!< Add an E2 node registration request
         INSERT_LTE_UE_RSRP_RSRQ,           //!< Add LTE UE RSRP and RSRQ
+        INSERT_LTE_UE_RSRP_RSRQ_LATEST,    //!< Add latest LTE UE RSRP and RSRQ
         LOG_CMM_ACTION,                    //!< Log a CM module action
+        LOG_CMM_EVENT,                     //!< Log a structured CM module event
         LOG_E2TERMINATOR_COMMAND,          //!< Log an E2 terminator command from the RIC
         LOG_LM_ACTION,                     //!< Log an LM action
-        LOG_LM_COMMAND                     //!< Log an LM command
+        LOG_LM_COMMAND,                    //!< Log an LM command
+        LOG_LM_EVENT,                      //!< Log a structured LM event
+        PRUNE_LTE_UE_CELL_AGE,             //!< Remove old LTE UE cell information of an E2 node
+        PRUNE_LTE_UE_CELL_COUNT,           //!< Remove excess LTE UE cell information of an E2 node
+        PRUNE_LTE_UE_RSRP_RSRQ_AGE,        //!< Remove old LTE UE RSRP and RSRQ of an E2 node
+        PRUNE_LTE_UE_RSRP_RSRQ_COUNT,      //!< Remove excess LTE UE RSRP and RSRQ of an E2 node
+        PRUNE_NODE_APPLOSS_AGE,            //!< Remove old application loss of an E2 node
+        PRUNE_NODE_APPLOSS_COUNT,          //!< Remove excess application loss of an E2 node
+        PRUNE_NODE_LOCATION_AGE,           //!< Remove old locations of an E2 node
+        PRUNE_NODE_LOCATION_COUNT,         //!< Remove excess locations of an E2 node
+        PRUNE_NODE_REGISTRATION_AGE,       //!< Remove old registration requests of an E2 node
+        PRUNE_NODE_REGISTRATION_COUNT,     //!< Remove excess registration requests of an E2 node
+        UPDATE_NODE_LOCATION,              //!< Move the last location of an E2 node
+        NUM_STATEMENT_TYPES                //!< The number of types of statements
     };
 
     /**
@@ -167,29 +443,54 @@ class OranDataRepositorySqlite : public OranDataRepository
      */
     enum CreateStatementType
     {
-        INDEX_LTE_ENB_CELLID = 0, //!< Index for the table with LTE eNB based on Cell IDs
-        INDEX_LTE_ENB_NODEID,     //!< Index for the table with LTE eNB based on E2 Node IDs
-        INDEX_LTE_UE_CELL_CELLID, //!< Index for the table with LTE UE Cell Information based on
-                                  //!< Cell IDs
-        INDEX_LTE_UE_CELL_NODEID, //!< Index for the table with LTE UE Cell Information based on E2
-                                  //!< Node IDs
-        INDEX_LTE_UE_IMSI,        //!< Index for the table with LTE UE based on IMSI
-        INDEX_LTE_UE_NODEID,      //!< Index for the table with LTE UE based on E2 Node ID
-        INDEX_NODE,               //!< Index for the table with E2 Node Information
-        INDEX_NODE_LOCATION,      //!< Index for the table with Node Locations
-        INDEX_NODE_REGISTRATION,  //!< Index for the table with Node Registrations
-        TABLE_CMM_ACTION,         //!< Table with logs of CMM actions
-        TABLE_LM_ACTION,          //!< Table with logs of LM actions
-        TABLE_LM_COMMAND,         //!< Table with logs of LM commamds
-        TABLE_LTE_ENB,            //!< Table with LTE eNB information
-        TABLE_LTE_UE,             //!< Table with LTE UE information
-        TABLE_LTE_UE_CELL,        //!< Table with LTE UE Cell Information
-        TABLE_LTE_UE_RSRP_RSRQ,   //!< Table with LTE UE RSRP and RSRQ Information
-        TABLE_NODE,               //!< Table with E2 Node Information
-        TABLE_NODE_LOCATION,      //!< Table with Node Locations
-        TABLE_NODE_REGISTRATION,  //!< Table with Node Registrations
-        TABLE_TERMINATOR_COMMAND, //!< Table with logs of E2 Terminator Commands
-        TABLE_APPLOSS_COMMAND     //!< Table with logs of application loss Commands
+        BACKFILL_LTE_UE_CELL_LATEST = 0,      //!< Fill the latest LTE UE Cell Information
+        BACKFILL_LTE_UE_RSRP_RSRQ_LATEST,     //!< Fill the latest LTE UE RSRP and RSRQ
+        BACKFILL_NODE_APPLOSS_LATEST,         //!< Fill the latest application loss
+        BACKFILL_NODE_LOCATION_LATEST,        //!< Fill the latest Node Locations
+        INDEX_LTE_ENB_CELLID,                 //!< Index for the table with LTE eNB based on Cell
+                                              //!< IDs
+        INDEX_LTE_ENB_NODEID,                 //!< Index for the table with LTE eNB based on E2 Node
+                                              //!< IDs
+        INDEX_LTE_UE_CELL_CELLID,             //!< Index for the table with LTE UE Cell Information
+                                              //!< based on Cell IDs
+        INDEX_LTE_UE_CELL_NODEID,             //!< Index for the table with LTE UE Cell Information
+                                              //!< based on E2 Node IDs
+        INDEX_LTE_UE_IMSI,                    //!< Index for the table with LTE UE based on IMSI
+        INDEX_LTE_UE_NODEID,                  //!< Index for the table with LTE UE based on E2 Node
+                                              //!< ID
+        INDEX_LTE_UE_RSRP_RSRQ_LATEST_NODEID, //!< Index for the table with the latest LTE UE RSRP
+                                              //!< and RSRQ based on E2 Node IDs
+        INDEX_LTE_UE_RSRP_RSRQ_NODEID,        //!< Index for the table with LTE UE RSRP and RSRQ
+                                              //!< based on E2 Node IDs
+        INDEX_NODE_APPLOSS_NODEID,            //!< Index for the table with application loss
+                                              //!< based on E2 Node IDs
+        INDEX_NODE,                           //!< Index for the table with E2 Node Information
+        INDEX_NODE_LOCATION,                  //!< Index for the table with Node Locations
+        INDEX_NODE_REGISTRATION,              //!< Index for the table with Node Registrations
+        TABLE_CMM_ACTION,                     //!< Table with logs of CMM actions
+        TABLE_CMM_EVENT,                      //!< Table with structured logs of CMM events
+        TABLE_LM_ACTION,                      //!< Table with logs of LM actions
+        TABLE_LM_COMMAND,                     //!< Table with logs of LM commamds
+        TABLE_LM_EVENT,                       //!< Table with structured logs of LM events
+        TABLE_LOG_EVENT,                      //!< Table with the formats of the logged events
+        TABLE_LOG_MODULE,                     //!< Table with the names of the logging modules
+        TABLE_LTE_ENB,                        //!< Table with LTE eNB information
+        TABLE_LTE_UE,                         //!< Table with LTE UE information
+        TABLE_LTE_UE_CELL,                    //!< Table with LTE UE Cell Information
+        TABLE_LTE_UE_CELL_LATEST,             //!< Table with the latest LTE UE Cell Information
+        TABLE_LTE_UE_RSRP_RSRQ,               //!< Table with LTE UE RSRP and RSRQ Information
+        TABLE_LTE_UE_RSRP_RSRQ_LATEST,        //!< Table with the latest LTE UE RSRP and RSRQ
+        TABLE_NODE,                           //!< Table with E2 Node Information
+        TABLE_NODE_APPLOSS_LATEST,            //!< Table with the latest application loss
+        TABLE_NODE_LOCATION,                  //!< Table with Node Locations
+        TABLE_NODE_LOCATION_LATEST,           //!< Table with the latest Node Locations
+        TABLE_NODE_REGISTRATION,              //!< Table with Node Registrations
+        TABLE_TERMINATOR_COMMAND,             //!< Table with logs of E2 Terminator Commands
+        TABLE_APPLOSS_COMMAND,                //!< Table with logs of application loss Commands
+        VIEW_CMM_EVENT_TEXT,                  //!< View with the text of the CMM events
+        VIEW_LM_EVENT_TEXT,                   //!< View with the text of the LM events
+        VIEW_CMM_LOG,                         //!< View with the text of all the CMM logs
+        VIEW_LM_LOG                           //!< View with the text of all the LM logs
     };
 
     /**
@@ -203,6 +504,38 @@ class OranDataRepositorySqlite : public OranDataRepository
     virtual void CheckQueryReturnCode(sqlite3_stmt* stmt,
                                       int rc,
                                       std::string boundParmsStr = "") const;
+    /**
+     * Checks that a query was executed successfully, like CheckQueryReturnCode.
+     * The bound arguments are only formatted if they are used, that is, if
+     * the query failed, the "QueryRc" trace source is connected, or the logs
+     * of the queries are enabled.
+     *
+     * @param stmt The query that was executed.
+     * @param rc The return code.
+     * @param args The bound arguments.
+     */
+    template <typename... BoundArgs>
+    void CheckQuery(sqlite3_stmt* stmt, int rc, const BoundArgs&... args) const
+    {
+        if (IsQueryTraced(rc))
+        {
+            CheckQueryReturnCode(stmt, rc, FormatBoundArgsList(args...));
+        }
+        else
+        {
+            CheckQueryReturnCode(stmt, rc);
+        }
+    }
+    /**
+     * Indicates if the details of a query are used when its return code is
+     * checked.
+     *
+     * @param rc The return code.
+     *
+     * @return True, if the query failed, the "QueryRc" trace source is
+     *         connected, or the logs of the queries are enabled; otherwise, false.
+     */
+    bool IsQueryTraced(int rc) const;
 
     /**
      * Converts the bound arguments of a prepared statement into a formatted string.
@@ -243,6 +576,10 @@ class OranDataRepositorySqlite : public OranDataRepository
     virtual void CloseDb();
 
     void DoDispose() override;
+    void DoPruneHistory(HistoryType type,
+                        Time minTime,
+                        uint64_t maxRows,
+                        uint32_t maxDeletes) override;
     /**
      * Indicates if the database connection has been established.
      *
@@ -251,39 +588,660 @@ class OranDataRepositorySqlite : public OranDataRepository
     virtual bool IsDbOpen() const;
     /**
      * Opens the database file stores the handler. This method
-     * calls InitDb to ensure that the required tables and indexes are available.
+     * calls InitDb to ensure that the required tables and indexes are available,
+     * and then compiles all the prepared statements.
      */
     virtual void OpenDb();
+    /**
+     * Gets the compiled prepared statement of the given type, ready to have
+     * its parameters bound.
+     *
+     * @param type The type of statement.
+     *
+     * @return The prepared statement.
+     */
+    sqlite3_stmt* GetStatement(StatementType type) const;
+    /**
+     * Gets the compiled prepared statement of the given type for a read of
+     * the Data Access API, after the writes issued before it are visible to
+     * it. This is the statement of the read-only connection, if it is open.
+     * That connection only sees committed writes, so the open write batch is
+     * committed first if it wrote to the tables read by the statement.
+     * Otherwise, the read shares the connection of the writes, and sees the
+     * rows of the open batch without committing it.
+     *
+     * @param type The type of statement.
+     *
+     * @return The prepared statement.
+     */
+    sqlite3_stmt* GetReadStatement(StatementType type);
+    /**
+     * Resets a prepared statement and clears its bindings, so that it can be
+     * reused by the next call. Statements that are not cached are finalized.
+     *
+     * @param stmt The prepared statement.
+     */
+    void ResetStatement(sqlite3_stmt* stmt) const;
+    /**
+     * Compiles a statement for a single use, when statements are not cached.
+     *
+     * @param db The connection for which the statement is compiled.
+     * @param type The type of statement.
+     *
+     * @return The prepared statement.
+     */
+    sqlite3_stmt* CompileStatement(sqlite3* db, StatementType type) const;
+    /**
+     * The maximum number of values bound to a statement that is written.
+     */
+    static const uint8_t MAX_WRITE_VALUES = 9;
+    /**
+     * The maximum number of text values bound to a statement that is written.
+     */
+    static const uint8_t MAX_WRITE_TEXTS = 2;
+    /**
+     * A value bound to a statement that is written.
+     */
+    struct WriteValue
+    {
+        /**
+         * The types of values.
+         */
+        enum Kind : uint8_t
+        {
+            INTEGER, //!< A 64-bit integer.
+            REAL,    //!< A floating point number.
+            TEXT     //!< A string.
+        };
+
+        Kind kind; //!< The type of the value.
+
+        union {
+            int64_t integer;         //!< The value, if it is an integer.
+            double real;             //!< The value, if it is a floating point number.
+            const std::string* text; //!< The value, if it is a string.
+        };
+    };
+
+    /**
+     * A write of the database, that is, the execution of a statement with
+     * the values bound to it. Writes are plain records, so that they are
+     * queued for the writer thread without allocating memory; the strings
+     * are copied to storage owned by the slot of the queue.
+     */
+    struct WriteOp
+    {
+        StatementType type = BEGIN_TRANSACTION;   //!< The statement that is executed.
+        bool checkpoint = false;                  //!< Flag that indicates if the write-ahead log
+                                                  //!< is checkpointed instead.
+        uint8_t numValues = 0;                    //!< The number of values bound to the statement.
+        WriteValue values[MAX_WRITE_VALUES] = {}; //!< The values bound to the statement.
+
+        /**
+         * Bind an integer to the next parameter of the statement.
+         *
+         * @param value The value.
+         */
+        void AddInteger(int64_t value);
+        /**
+         * Bind a floating point number to the next parameter of the statement.
+         *
+         * @param value The value.
+         */
+        void AddReal(double value);
+        /**
+         * Bind a string to the next parameter of the statement. The string
+         * must be valid until the write is submitted.
+         *
+         * @param value The value.
+         */
+        void AddText(const std::string& value);
+    };
+
+    /**
+     * Prepare the database for a write. If write batching is enabled, this
+     * commits the open batch if the simulation time has advanced since it
+     * was started, and begins a new batch if none is open, scheduling its
+     * commit after the events of the current simulation time.
+     */
+    void BeginWrite();
+    /**
+     * Account for a completed write. If write batching is enabled, this
+     * commits the open batch once it holds the maximum number of rows.
+     */
+    void EndWrite();
+    /**
+     * Execute a write. If asynchronous writes are enabled, the write is
+     * queued for the writer thread, blocking until a slot is free if the
+     * queue is full; otherwise, it is executed immediately.
+     *
+     * @param op The write.
+     */
+    void SubmitWrite(const WriteOp& op);
+    /**
+     * Execute a write on the database, checking the result of the statement.
+     *
+     * @param op The write.
+     */
+    void ExecuteWrite(const WriteOp& op);
+    /**
+     * Wait until the writer thread has executed all the queued writes. This
+     * has no effect if asynchronous writes are not enabled.
+     */
+    void WaitForWrites();
+    /**
+     * Wait until the writer thread has executed the queued writes to the
+     * tables read by a statement, so that the writes queued for other tables
+     * do not delay the read. This has no effect if asynchronous writes are
+     * not enabled.
+     *
+     * @param type The type of statement that reads the tables.
+     */
+    void WaitForWrites(StatementType type);
+    /**
+     * Wait until the writer thread has executed the given number of writes.
+     *
+     * @param count The number of writes.
+     */
+    void WaitForQueue(uint64_t count);
+    /**
+     * Get the query plan of every prepared statement, as reported by
+     * "EXPLAIN QUERY PLAN". This allows tests to check that the statements
+     * are answered with the indexes of the schema. The database must be open.
+     *
+     * @return A map with the SQL of each statement and the details of the
+     *         steps of its query plan, indexed by statement type.
+     */
+    std::map<StatementType, std::pair<std::string, std::vector<std::string>>> ExplainQueryPlans();
     /**
      * Used to report the return code of SQL queries.
      */
     TracedCallback<std::string, std::string, int> m_queryRc;
+    /**
+     * Used to report the size of the write-ahead log after each commit.
+     */
+    TracedCallback<int> m_walSize;
+    /**
+     * Used to report the result of the checkpoints of the write-ahead log.
+     */
+    TracedCallback<int, int> m_walCheckpoint;
+    /**
+     * Used to report the wall-clock latency of each execution of a prepared statement.
+     */
+    TracedCallback<const std::string&, Time> m_queryLatency;
 
   private:
     /**
      * Ready the database schema. This method creates the required tables and indexes.
      * If the schema already exists, no change is made, allowing for reusing existing
      * database files and extending databases created with previous simulations.
+     *
+     * The latest position, cell information, application loss, and RSRP/RSRQ
+     * measurements of each node are also kept in tables with the "_latest"
+     * suffix, updated on every insert, so that their lookups, and the
+     * snapshots of all the LTE UEs and eNBs, do not depend on the length of
+     * the history.
      */
     void InitDb();
 
     /**
-     * Initialize the maps with the prepared statements' strings
+     * Initialize the maps with the prepared statements' strings, for the
+     * configured schema version.
      */
     void InitStatements();
+    /**
+     * Find the tables that each statement reads or writes, from the names of
+     * the tables and views of the schema in its SQL. The transaction
+     * statements are marked as using every table.
+     */
+    void InitStatementTables();
+    /**
+     * Enable write-ahead logging in the open database, if configured.
+     *
+     * @return True, if the database uses write-ahead logging; otherwise, false.
+     */
+    bool ConfigureJournal();
+    /**
+     * Open the read-only connection used by the Data Access API and compile
+     * its statements, if write-ahead logging is in use and the database is
+     * stored in a file.
+     */
+    void OpenReadDb();
+    /**
+     * Finalize the statements of the read-only connection and close it.
+     */
+    void CloseReadDb();
+    /**
+     * The callback invoked by SQLite after each commit in write-ahead logging
+     * mode. It reports the size of the log, and checkpoints it once it reaches
+     * the configured size.
+     *
+     * @param repository The Data Repository.
+     * @param db The database connection.
+     * @param dbName The name of the database.
+     * @param walPages The number of pages in the write-ahead log.
+     *
+     * @return SQLITE_OK.
+     */
+    static int WalHook(void* repository, sqlite3* db, const char* dbName, int walPages);
+    /**
+     * Run a passive checkpoint of the write-ahead log.
+     */
+    void CheckpointWal();
+    /**
+     * Commit the open write batch, checkpoint the write-ahead log, and
+     * schedule the next periodic checkpoint.
+     */
+    void DoPeriodicCheckpoint();
+    /**
+     * Get the schema version of the open database.
+     *
+     * @return The schema version, or 0 if the database is empty.
+     */
+    uint32_t GetDbSchemaVersion();
+    /**
+     * Migrate the history tables of a database with schema version 1 to
+     * version 2.
+     */
+    void MigrateSchemaToV2();
+    /**
+     * Load the next sequence number to use from the database.
+     */
+    void LoadSequence();
+    /**
+     * Compile all the statements in the map of statements' strings. The
+     * statements are reused (reset and with their bindings cleared) by every
+     * call, and finalized when the database is closed.
+     */
+    void PrepareStatements();
+    /**
+     * Finalize all the compiled prepared statements.
+     */
+    void FinalizeStatements();
+    /**
+     * Load the registration state of the E2 Nodes, and the next E2 Node ID to
+     * assign, from the database.
+     */
+    void LoadRegistrations();
+    /**
+     * Load the IDs assigned to the names of the logging modules from the
+     * database.
+     */
+    void LoadLogModules();
+    /**
+     * Load the IDs assigned to the formats of the logged events from the
+     * database.
+     */
+    void LoadLogEvents();
+    /**
+     * Get the ID assigned to the name of a logging module, storing the name
+     * if it has not been seen before.
+     *
+     * @param name The name of the LM or CMM.
+     *
+     * @return The ID of the logging module.
+     */
+    uint32_t GetLogModuleId(const std::string& name);
+    /**
+     * Get the ID that the database assigns to the format of an event,
+     * storing the format if it has not been seen before. The IDs of the
+     * database are independent of the ones registered in this process, so
+     * that the events of different programs can be stored in the same
+     * database.
+     *
+     * @param event The event code.
+     *
+     * @return The ID of the event in the database.
+     */
+    uint32_t GetLogEventId(LogEvent event);
+    /**
+     * Store a structured event of an LM or a CMM.
+     *
+     * @param type The statement to store the event with.
+     * @param name The name of the LM or CMM.
+     * @param t The time of the event.
+     * @param event The event code.
+     * @param arg0 The first argument of the event.
+     * @param arg1 The second argument of the event.
+     * @param arg2 The third argument of the event.
+     * @param arg3 The fourth argument of the event.
+     */
+    void ImportEvent(StatementType type,
+                     const std::string& name,
+                     Time t,
+                     LogEvent event,
+                     double arg0,
+                     double arg1,
+                     double arg2,
+                     double arg3);
+    /**
+     * Get the location of a node at a time, interpolated linearly between the
+     * last location stored up to that time and the first one stored after it.
+     *
+     * @param e2NodeId The E2 Node ID.
+     * @param t The time.
+     *
+     * @return A tuple with a flag that indicates if there are stored locations
+     *         on both sides of the time, and the interpolated location.
+     */
+    std::tuple<bool, Vector> InterpolatePosition(uint64_t e2NodeId, Time t);
+    /**
+     * Commit the open write batch, if any, without waiting for the queued
+     * writes to be executed.
+     */
+    void CommitBatch();
+    /**
+     * Start the writer thread.
+     */
+    void StartWriter();
+    /**
+     * Stop the writer thread, once it has executed all the queued writes,
+     * and wait for it to finish.
+     */
+    void StopWriter();
+    /**
+     * The loop of the writer thread, which executes the queued writes in
+     * order until the thread is stopped.
+     */
+    void RunWriter();
+    /**
+     * Register a compiled prepared statement for the execution statistics.
+     *
+     * @param type The type of statement.
+     * @param stmt The prepared statement.
+     */
+    void AddStatementTiming(StatementType type, sqlite3_stmt* stmt);
+    /**
+     * Record the start of an execution of a prepared statement, if the
+     * execution statistics are enabled or the "QueryLatency" trace source
+     * is connected.
+     *
+     * @param stmt The prepared statement.
+     */
+    void StartStatementTiming(sqlite3_stmt* stmt) const;
+    /**
+     * Record the end of an execution of a prepared statement, if its start
+     * was recorded, in the execution statistics and the "QueryLatency" trace
+     * source.
+     *
+     * @param stmt The prepared statement.
+     */
+    void StopStatementTiming(sqlite3_stmt* stmt) const;
+    /**
+     * Get the name of a type of statement.
+     *
+     * @param type The type of statement.
+     *
+     * @return The name of the enumerator, which is valid until the program ends.
+     */
+    static const std::string& GetStatementName(StatementType type);
 
     /**
      * The database.
      */
     sqlite3* m_db;
+    /**
+     * The read-only connection to the database used by the Data Access API.
+     */
+    sqlite3* m_readDb;
     /**
      * The file path of the database.
      */
     std::string m_dbPath;
+    /**
+     * The version of the database schema, which is stamped in the database
+     * (PRAGMA user_version). In version 1, the history tables (nodelocation,
+     * lteuecell, lteuersrprsrq, and nodeapploss) use autoincrement row IDs and
+     * are indexed by node. In version 2, these tables have no row IDs and are
+     * clustered on (nodeid, simulationtime, seq), where seq preserves the
+     * insertion order, so that range and latest-value queries are
+     * index-ordered scans.
+     */
+    uint32_t m_schemaVersion;
+    /**
+     * Flag that indicates if the database should use write-ahead logging.
+     * The mode is stored in the database file, so it is kept when the
+     * database is opened again without it. In this mode, commits are not
+     * synced to disk.
+     */
+    bool m_walMode;
+    /**
+     * Flag that indicates if the open database uses write-ahead logging.
+     */
+    bool m_walActive;
+    /**
+     * The number of pages in the write-ahead log after which it is checkpointed.
+     */
+    uint32_t m_walAutoCheckpoint;
+    /**
+     * The time between periodic checkpoints of the write-ahead log.
+     */
+    Time m_walCheckpointInterval;
+    /**
+     * The size to which the write-ahead log is truncated after a checkpoint.
+     */
+    int64_t m_walSizeLimit;
+    /**
+     * The event of the next periodic checkpoint of the write-ahead log.
+     */
+    EventId m_walCheckpointEvent;
+    /**
+     * Flag that indicates if writes are grouped into transactions.
+     */
+    bool m_writeBatching;
+    /**
+     * The maximum number of rows written in a single batch.
+     */
+    uint32_t m_writeBatchMaxRows;
+    /**
+     * Flag that indicates if a write batch transaction is open.
+     */
+    bool m_batchOpen;
+    /**
+     * The tables written by the open batch, as a mask like the ones of
+     * m_statementTables.
+     */
+    uint64_t m_batchTables;
+    /**
+     * The event that commits the open write batch at the end of the
+     * simulation time at which it was started.
+     */
+    EventId m_batchCommitEvent;
+    /**
+     * The number of rows written in the open batch.
+     */
+    uint32_t m_batchRows;
+    /**
+     * The simulation time at which the open batch was started.
+     */
+    Time m_batchTime;
+    /**
+     * The registration state of the E2 Nodes, indexed by E2 Node ID. It is
+     * loaded when the database is opened and updated by every registration,
+     * so that IsNodeRegistered does not query the database. The IDs of the
+     * nodes registered without one are also allocated from it.
+     */
+    std::unordered_map<uint64_t, bool> m_registeredNodes;
+    /**
+     * The E2 Node ID to assign to the next node registered without an ID.
+     */
+    uint64_t m_nextE2NodeId;
+    /**
+     * The IDs assigned to the names of the logging modules.
+     */
+    std::unordered_map<std::string, uint32_t> m_logModuleIds;
+    /**
+     * The IDs assigned to the formats of the logged events, indexed by the
+     * name of the module and the format.
+     */
+    std::map<std::pair<std::string, std::string>, uint32_t> m_logEventIds;
+    /**
+     * The database ID of each event code registered in this process, or zero
+     * if the event has not been stored yet.
+     */
+    std::vector<uint32_t> m_logEventDbIds;
+    /**
+     * The sequence number of the next entry in the history tables (schema version 2).
+     */
+    uint64_t m_nextSeq;
+    /**
+     * The position of the next E2 Node to prune in the list of nodes of each
+     * type of history.
+     */
+    std::map<HistoryType, uint64_t> m_pruneCursors;
+    /**
+     * The track of the locations stored for an E2 Node when the location
+     * history is compressed. The stored locations form a track of linear
+     * segments. While a segment is open, each new location narrows the range
+     * of velocities (on each axis) that keep every location since its start
+     * within the tolerance, and replaces the last stored location instead of
+     * being added. When a new location leaves no such velocity, the last
+     * stored location is moved to the end of the segment extrapolated with
+     * the middle of the range, and the new location starts the next segment.
+     * Locations that are not newer than the last one stored are added as is,
+     * and end the track.
+     */
+    struct PositionTrack
+    {
+        bool active = false;  //!< Flag that indicates if new locations may extend the track.
+        Time startTime;       //!< The time of the location that starts the segment.
+        Vector startPos;      //!< The location that starts the segment.
+        Vector minVelocity;   //!< The minimum velocity of the segment on each axis (m/s).
+        Vector maxVelocity;   //!< The maximum velocity of the segment on each axis (m/s).
+        bool hasTail = false; //!< Flag that indicates if the newest location can be moved.
+        Time lastTime;        //!< The time of the newest location stored for the node.
+        uint64_t lastSeq = 0; //!< The sequence number of the newest location (version 2).
+    };
+
+    /**
+     * The maximum distance, in meters, between a location and the track
+     * extrapolated from the stored ones for it to replace the last one.
+     */
+    double m_positionTolerance;
+    /**
+     * The tracks of the stored locations, indexed by E2 Node ID.
+     */
+    std::unordered_map<uint64_t, PositionTrack> m_positionTracks;
+    /**
+     * Flag that indicates if writes are performed by a writer thread, in the
+     * same order and with the same transaction boundaries as without it. The
+     * state kept in memory (registrations, E2 Node IDs, and sequence numbers)
+     * is still updated by the simulator thread.
+     */
+    bool m_asyncWrites;
+    /**
+     * The maximum number of writes queued for the writer thread.
+     */
+    uint32_t m_asyncQueueCapacity;
+    /**
+     * The ring buffer with the writes queued for the writer thread.
+     */
+    std::vector<WriteOp> m_writeQueue;
+    /**
+     * The storage of the strings of the queued writes, with MAX_WRITE_TEXTS
+     * strings for each slot of the queue.
+     */
+    std::vector<std::string> m_writeQueueText;
+    /**
+     * The tables used by each statement, as a mask with the bits of the
+     * TABLE_* and VIEW_* types of CREATE statements.
+     */
+    std::map<StatementType, uint64_t> m_statementTables;
+    /**
+     * The number of queued writes, when the last write to each table was
+     * queued, indexed by the type of the CREATE statement of the table.
+     */
+    std::vector<uint64_t> m_tableWrites;
+    /**
+     * The number of writes executed by the writer thread.
+     */
+    std::atomic<uint64_t> m_writeQueueHead;
+    /**
+     * The number of writes queued by the simulator thread.
+     */
+    std::atomic<uint64_t> m_writeQueueTail;
+    /**
+     * Flag that requests the writer thread to stop.
+     */
+    std::atomic<bool> m_writerStop;
+    /**
+     * Flag that indicates that the writer thread is waiting for writes.
+     */
+    std::atomic<bool> m_writerSleeping;
+    /**
+     * Flag that indicates that the simulator thread is waiting for the writes,
+     * or for a free slot of the queue.
+     */
+    std::atomic<bool> m_flushWaiting;
+    /**
+     * The mutex used to sleep and wake up the writer and simulator threads.
+     */
+    std::mutex m_writerMutex;
+    /**
+     * The condition used to wake up the writer thread.
+     */
+    std::condition_variable m_writerCv;
+    /**
+     * The condition used to wake up the simulator thread waiting for the
+     * writes, or for a free slot of the queue.
+     */
+    std::condition_variable m_flushCv;
+    /**
+     * The writer thread.
+     */
+    std::thread m_writerThread;
+    /**
+     * Flag that indicates if the execution statistics of the statements are collected.
+     */
+    bool m_queryStatsEnabled;
+    /**
+     * The file to which the summary of the execution statistics is written
+     * when the database is closed.
+     */
+    std::string m_queryStatsPath;
+    /**
+     * The type of a compiled prepared statement and the start of its
+     * current execution.
+     */
+    struct StatementTiming
+    {
+        StatementType type;                          //!< The type of statement.
+        bool started = false;                        //!< Flag that indicates an execution.
+        std::chrono::steady_clock::time_point start; //!< The start of the execution.
+    };
+
+    /**
+     * The timing of the compiled prepared statements of both connections,
+     * indexed by statement. Entries are only added and removed while the
+     * writer thread is stopped, and each statement is only used by one
+     * thread at a time.
+     */
+    mutable std::unordered_map<sqlite3_stmt*, StatementTiming> m_stmtTimings;
+    /**
+     * The execution statistics of the statements, indexed by statement type.
+     */
+    mutable std::vector<QueryStats> m_queryStats;
+    /**
+     * The mutex that protects the execution statistics, which are also
+     * updated by the writer thread.
+     */
+    mutable std::mutex m_queryStatsMutex;
     /**
      * Map with the prepared statements' strings
      */
     std::map<StatementType, std::string> m_queryStmtsStrings;
+    /**
+     * Flag that indicates if the statements are compiled once and reused.
+     */
+    bool m_cacheStatements;
+    /**
+     * Map with the compiled prepared statements
+     */
+    std::map<StatementType, sqlite3_stmt*> m_queryStmts;
+    /**
+     * Map with the compiled prepared statements of the read-only connection
+     */
+    std::map<StatementType, sqlite3_stmt*> m_readStmts;
     /**
      * Map with the table creation prepared statements' strings
      */
@@ -30,7 +30,13 @@
 
 #include "oran-data-repository.h"
 
+#include "ns3/abort.h"
 #include "ns3/log.h"
+#include "ns3/simulator.h"
+#include "ns3/uinteger.h"
+
+#include <cstdio>
+#include <limits>
 
 namespace ns3
 {
@@ -42,7 +48,28 @@ NS_OBJECT_ENSURE_REGISTERED(OranDataRepository);
 TypeId
 OranDataRepository::GetTypeId()
 {
-    static TypeId tid = TypeId("ns3::OranDataRepository").SetParent<Object>();
+    static TypeId tid =
+        TypeId("ns3::OranDataRepository")
+            .SetParent<Object>()
+            .AddAttribute("PruneInterval",
+                          "The time between two enforcements of the retention policies.",
+                          TimeValue(Seconds(1)),
+                          MakeTimeAccessor(&OranDataRepository::m_pruneInterval),
+                          MakeTimeChecker(Time(1)))
+            .AddAttribute("PruneChunkRows",
+                          "The maximum number of entries of each type of history deleted by "
+                          "each enforcement of the retention policies.",
+                          UintegerValue(1000),
+                          MakeUintegerAccessor(&OranDataRepository::m_pruneChunkRows),
+                          MakeUintegerChecker<uint32_t>(1))
+            .AddTraceSource("NodeRegistered",
+                            "An E2 Node was registered, or renewed its registration",
+                            MakeTraceSourceAccessor(&OranDataRepository::m_nodeRegisteredTrace),
+                            "ns3::OranDataRepository::E2NodeIdTracedCallback")
+            .AddTraceSource("NodeDeregistered",
+                            "An E2 Node was deregistered",
+                            MakeTraceSourceAccessor(&OranDataRepository::m_nodeDeregisteredTrace),
+                            "ns3::OranDataRepository::E2NodeIdTracedCallback");
 
     return tid;
 }
@@ -65,6 +92,11 @@ OranDataRepository::Activate()
     NS_LOG_FUNCTION(this);
 
     m_active = true;
+
+    if (!m_retentionPolicies.empty() && !m_pruneEvent.IsPending())
+    {
+        m_pruneEvent = Simulator::Schedule(m_pruneInterval, &OranDataRepository::PruneHistory, this);
+    }
 }
 
 void
@@ -72,6 +104,8 @@ OranDataRepository::Deactivate()
 {
     NS_LOG_FUNCTION(this);
 
+    m_pruneEvent.Cancel();
+
     m_active = false;
 }
 
@@ -83,11 +117,320 @@ OranDataRepository::IsActive() const
     return m_active;
 }
 
+void
+OranDataRepository::SetRetentionPolicy(HistoryType type, Time maxAge, uint64_t maxRows)
+{
+    NS_LOG_FUNCTION(this << type << maxAge << maxRows);
+
+    if (maxAge.IsZero() && maxRows == 0)
+    {
+        m_retentionPolicies.erase(type);
+        return;
+    }
+
+    m_retentionPolicies[type] = {maxAge, maxRows};
+
+    if (m_active && !m_pruneEvent.IsPending())
+    {
+        m_pruneEvent = Simulator::Schedule(m_pruneInterval, &OranDataRepository::PruneHistory, this);
+    }
+}
+
+OranDataRepository::LteUeSnapshot
+OranDataRepository::GetLteUeSnapshot()
+{
+    NS_LOG_FUNCTION(this);
+
+    LteUeSnapshot snapshot;
+
+    for (auto e2NodeId : GetLteUeE2NodeIds())
+    {
+        bool found;
+        uint16_t cellId;
+        uint16_t rnti;
+
+        std::tie(found, cellId, rnti) = GetLteUeCellInfo(e2NodeId);
+        if (found)
+        {
+            bool hasPosition;
+            Time positionTime;
+            Vector position;
+
+            std::tie(hasPosition, positionTime, position) = GetLatestNodePosition(e2NodeId);
+            if (hasPosition)
+            {
+                snapshot.e2NodeIds.push_back(e2NodeId);
+                snapshot.cellIds.push_back(cellId);
+                snapshot.rntis.push_back(rnti);
+                snapshot.positions.push_back(position);
+                snapshot.appLosses.push_back(GetAppLoss(e2NodeId));
+            }
+        }
+    }
+
+    return snapshot;
+}
+
+OranDataRepository::LteEnbSnapshot
+OranDataRepository::GetLteEnbSnapshot()
+{
+    NS_LOG_FUNCTION(this);
+
+    LteEnbSnapshot snapshot;
+
+    for (auto e2NodeId : GetLteEnbE2NodeIds())
+    {
+        bool found;
+        uint16_t cellId;
+
+        std::tie(found, cellId) = GetLteEnbCellInfo(e2NodeId);
+        if (found)
+        {
+            bool hasPosition;
+            Time positionTime;
+            Vector position;
+
+            std::tie(hasPosition, positionTime, position) = GetLatestNodePosition(e2NodeId);
+            if (hasPosition)
+            {
+                snapshot.e2NodeIds.push_back(e2NodeId);
+                snapshot.cellIds.push_back(cellId);
+                snapshot.positions.push_back(position);
+            }
+        }
+    }
+
+    return snapshot;
+}
+
+std::tuple<bool, Time, Vector>
+OranDataRepository::GetLatestNodePosition(uint64_t e2NodeId)
+{
+    NS_LOG_FUNCTION(this << e2NodeId);
+
+    auto retVal = std::make_tuple(false, Time(), Vector());
+
+    std::map<Time, Vector> positions = GetNodePositions(e2NodeId, Seconds(0), Simulator::Now());
+    if (!positions.empty())
+    {
+        retVal = std::make_tuple(true, positions.rbegin()->first, positions.rbegin()->second);
+    }
+    return retVal;
+}
+
+void
+OranDataRepository::ForEachNodePosition(uint64_t e2NodeId,
+                                        Time fromTime,
+                                        Time toTime,
+                                        uint64_t maxEntries,
+                                        const NodePositionVisitor& visitor)
+{
+    NS_LOG_FUNCTION(this << e2NodeId << fromTime << toTime << maxEntries);
+
+    std::map<Time, Vector> positions = GetNodePositions(e2NodeId, fromTime, toTime, maxEntries);
+    for (auto it = positions.rbegin(); it != positions.rend(); it++)
+    {
+        visitor(it->first, it->second);
+    }
+}
+
+void
+OranDataRepository::ForEachLteUeRsrpRsrq(uint64_t e2NodeId, const LteUeRsrpRsrqVisitor& visitor)
+{
+    NS_LOG_FUNCTION(this << e2NodeId);
+
+    for (const auto& measurement : GetLteUeRsrpRsrq(e2NodeId))
+    {
+        std::apply(visitor, measurement);
+    }
+}
+
+void
+OranDataRepository::DoPruneHistory(HistoryType type,
+                                   Time minTime,
+                                   uint64_t maxRows,
+                                   uint32_t maxDeletes)
+{
+    NS_LOG_FUNCTION(this << type << minTime << maxRows << maxDeletes);
+}
+
+void
+OranDataRepository::PruneHistory()
+{
+    NS_LOG_FUNCTION(this);
+
+    if (!m_active || m_retentionPolicies.empty())
+    {
+        return;
+    }
+
+    for (const auto& entry : m_retentionPolicies)
+    {
+        // Without a maximum age, no entry is older than the minimum time
+        Time minTime = Seconds(0);
+        if (entry.second.maxAge.IsStrictlyPositive() && Simulator::Now() > entry.second.maxAge)
+        {
+            minTime = Simulator::Now() - entry.second.maxAge;
+        }
+
+        if (minTime.IsStrictlyPositive() || entry.second.maxRows > 0)
+        {
+            DoPruneHistory(entry.first, minTime, entry.second.maxRows, m_pruneChunkRows);
+        }
+    }
+
+    m_pruneEvent = Simulator::Schedule(m_pruneInterval, &OranDataRepository::PruneHistory, this);
+}
+
+void
+OranDataRepository::LogEventLm(const std::string& lm,
+                               LogEvent event,
+                               double arg0,
+                               double arg1,
+                               double arg2,
+                               double arg3)
+{
+    NS_LOG_FUNCTION(this << lm << event << arg0 << arg1 << arg2 << arg3);
+
+    LogActionLm(lm,
+                std::to_string(Simulator::Now().GetSeconds()) + " -- " + lm + " -- " +
+                    FormatLogEvent(event, arg0, arg1, arg2, arg3));
+}
+
+void
+OranDataRepository::LogEventCmm(const std::string& cmm,
+                                LogEvent event,
+                                double arg0,
+                                double arg1,
+                                double arg2,
+                                double arg3)
+{
+    NS_LOG_FUNCTION(this << cmm << event << arg0 << arg1 << arg2 << arg3);
+
+    LogActionCmm(cmm,
+                 std::to_string(Simulator::Now().GetSeconds()) + " -- " + cmm + " -- " +
+                     FormatLogEvent(event, arg0, arg1, arg2, arg3));
+}
+
+namespace
+{
+
+/**
+ * Get the registered formats of the events, and the ID of each one of them
+ * indexed by module name and format. They are kept in a function, so that
+ * the modules can register their events from static initializers.
+ *
+ * @return The formats and the IDs of the events.
+ */
+std::pair<std::map<OranDataRepository::LogEvent, OranDataRepository::LogEventFormat>,
+          std::map<std::pair<std::string, std::string>, OranDataRepository::LogEvent>>&
+GetLogEventRegistry()
+{
+    static std::pair<
+        std::map<OranDataRepository::LogEvent, OranDataRepository::LogEventFormat>,
+        std::map<std::pair<std::string, std::string>, OranDataRepository::LogEvent>>
+        registry = {{{OranDataRepository::LOG_NO_ACTION, {"", "No action taken"}}},
+                    {{{"", "No action taken"}, OranDataRepository::LOG_NO_ACTION}}};
+
+    return registry;
+}
+
+} // namespace
+
+OranDataRepository::LogEvent
+OranDataRepository::RegisterLogEvent(const std::string& module, const std::string& format)
+{
+    auto& registry = GetLogEventRegistry();
+
+    auto it = registry.second.find({module, format});
+    if (it != registry.second.end())
+    {
+        return it->second;
+    }
+
+    NS_ABORT_MSG_IF(registry.first.rbegin()->first == std::numeric_limits<LogEvent>::max(),
+                    "Too many log events registered");
+
+    LogEvent event = registry.first.rbegin()->first + 1;
+    registry.first[event] = {module, format};
+    registry.second[{module, format}] = event;
+
+    return event;
+}
+
+const std::map<OranDataRepository::LogEvent, OranDataRepository::LogEventFormat>&
+OranDataRepository::GetLogEventFormats()
+{
+    return GetLogEventRegistry().first;
+}
+
+std::string
+OranDataRepository::FormatLogEvent(LogEvent event,
+                                   double arg0,
+                                   double arg1,
+                                   double arg2,
+                                   double arg3)
+{
+    NS_LOG_FUNCTION(event << arg0 << arg1 << arg2 << arg3);
+
+    auto it = GetLogEventFormats().find(event);
+    NS_ABORT_MSG_IF(it == GetLogEventFormats().end(), "Unknown log event " << event);
+
+    // Render the conversions one at a time, so that each argument is passed
+    // with the type that its conversion expects
+    const std::string& format = it->second.format;
+    const double args[] = {arg0, arg1, arg2, arg3};
+    std::size_t nextArg = 0;
+    std::string text;
+    char buffer[64];
+
+    for (std::size_t i = 0; i < format.size(); i++)
+    {
+        if (format[i] != '%')
+        {
+            text += format[i];
+            continue;
+        }
+
+        std::size_t end = format.find_first_of("%dif", i + 1);
+        NS_ABORT_MSG_IF(end == std::string::npos, "Invalid format of log event " << event);
+        std::string spec = format.substr(i, end - i);
+
+        if (format[end] == '%')
+        {
+            text += '%';
+        }
+        else
+        {
+            NS_ABORT_MSG_IF(nextArg >= 4, "Too many conversions in log event " << event);
+            double arg = args[nextArg++];
+            if (format[end] == 'f')
+            {
+                std::snprintf(buffer, sizeof(buffer), (spec + "f").c_str(), arg);
+            }
+            else
+            {
+                std::snprintf(buffer,
+                              sizeof(buffer),
+                              (spec + "lld").c_str(),
+                              static_cast<long long>(arg));
+            }
+            text += buffer;
+        }
+        i = end;
+    }
+
+    return text;
+}
+
 void
 OranDataRepository::DoDispose()
 {
     NS_LOG_FUNCTION(this);
 
+    m_pruneEvent.Cancel();
+    m_retentionPolicies.clear();
+
     Object::DoDispose();
 }
 
@@ -35,12 +35,17 @@
 #include "oran-near-rt-ric.h"
 #include "oran-report.h"
 
+#include "ns3/event-id.h"
 #include "ns3/nstime.h"
 #include "ns3/object.h"
+#include "ns3/traced-callback.h"
 #include "ns3/vector.h"
 
+#include <functional>
 #include <map>
+#include <string>
 #include <tuple>
+#include <vector>
 
 namespace ns3
 {
@@ -56,10 +61,100 @@ namespace ns3
  * When the Data Repository is deactivated all the requests to store data will
  * be ignored, and all queries for stored data will return empty sets.
  *
+ * The history of the reports and registrations can be bounded with a
+ * retention policy for each type of history (see SetRetentionPolicy). While
+ * the Data Repository is active, the policies are enforced every
+ * "PruneInterval", deleting at most "PruneChunkRows" entries of each type of
+ * history at a time, so that the pruning is spread over the simulation. The
+ * latest information of each node (the latest position, cell information,
+ * application loss, RSRP and RSRQ measurements, and registration request) is
+ * never deleted.
+ *
  */
 class OranDataRepository : public Object
 {
   public:
+    /**
+     * The types of history that can be bounded with a retention policy.
+     */
+    enum HistoryType
+    {
+        NODE_LOCATION = 0, //!< The positions of the nodes
+        LTE_UE_CELL,       //!< The cell information of the LTE UEs
+        LTE_UE_RSRP_RSRQ,  //!< The RSRP and RSRQ measurements of the LTE UEs
+        NODE_APPLOSS,      //!< The application loss of the nodes
+        NODE_REGISTRATION  //!< The registration requests of the nodes
+    };
+
+    /**
+     * The ID of an event that the Logic Modules and Conflict Mitigation
+     * Modules can log with up to four numeric arguments instead of free-form
+     * text. The modules register the format of each of their events (see
+     * RegisterLogEvent), and the text of an event is rendered from its format
+     * and its arguments only when it is needed.
+     */
+    typedef uint16_t LogEvent;
+
+    /**
+     * The event that any module can log when it takes no action.
+     */
+    static constexpr LogEvent LOG_NO_ACTION = 1;
+
+    /**
+     * The format of a registered event.
+     */
+    struct LogEventFormat
+    {
+        std::string module; //!< The name of the module that registered the event.
+        std::string format; //!< The format of the text of the event.
+    };
+
+    /**
+     * The latest information of the registered LTE UEs that have reported
+     * both their cell information and their position, stored as a structure
+     * of arrays. The entries with the same index belong to the same UE, and
+     * the UEs are sorted by E2 Node ID.
+     */
+    struct LteUeSnapshot
+    {
+        std::vector<uint64_t> e2NodeIds; //!< The E2 Node IDs.
+        std::vector<uint16_t> cellIds;   //!< The cell IDs of the serving cells.
+        std::vector<uint16_t> rntis;     //!< The RNTIs assigned by the serving cells.
+        std::vector<Vector> positions;   //!< The latest positions.
+        std::vector<double> appLosses;   //!< The latest application losses (0 if unknown).
+    };
+
+    /**
+     * The information of the registered LTE eNBs that have reported their
+     * position, stored as a structure of arrays. The entries with the same
+     * index belong to the same eNB, and the eNBs are sorted by E2 Node ID.
+     */
+    struct LteEnbSnapshot
+    {
+        std::vector<uint64_t> e2NodeIds; //!< The E2 Node IDs.
+        std::vector<uint16_t> cellIds;   //!< The cell IDs.
+        std::vector<Vector> positions;   //!< The latest positions.
+    };
+
+    /**
+     * Callback invoked by ForEachNodePosition with the time of a position
+     * and the position.
+     */
+    typedef std::function<void(Time, const Vector&)> NodePositionVisitor;
+    /**
+     * Callback invoked by ForEachLteUeRsrpRsrq with the RNTI, cell ID, RSRP,
+     * RSRQ, serving cell flag, and component carrier ID of a measurement.
+     */
+    typedef std::function<void(uint16_t, uint16_t, double, double, bool, uint8_t)>
+        LteUeRsrpRsrqVisitor;
+    /**
+     * TracedCallback signature for the registration and deregistration of
+     * E2 Nodes.
+     *
+     * @param [in] e2NodeId The E2 Node ID of the node.
+     */
+    typedef void (*E2NodeIdTracedCallback)(uint64_t e2NodeId);
+
     /**
      * Gets the TypeId of the OranDataRepository class.
      *
@@ -88,6 +183,17 @@ class OranDataRepository : public Object
      * @return True, if the data storage is active; otherwise, false.
      */
     virtual bool IsActive() const;
+    /**
+     * Set the retention policy of a type of history. Entries older than the
+     * maximum age, and the entries of each node beyond the newest maximum
+     * number of rows, are deleted incrementally while the Data Repository is
+     * active. Setting both limits to zero removes the policy.
+     *
+     * @param type The type of history.
+     * @param maxAge The maximum age of the entries, or zero for no limit.
+     * @param maxRows The maximum number of entries of each node, or zero for no limit.
+     */
+    void SetRetentionPolicy(HistoryType type, Time maxAge, uint64_t maxRows);
 
     /* Data Storage API */
     /**
@@ -272,6 +378,59 @@ class OranDataRepository : public Object
      */
     virtual std::vector<std::tuple<uint16_t, uint16_t, double, double, bool, uint8_t>>
     GetLteUeRsrpRsrq(uint64_t e2NodeId) = 0;
+    /**
+     * Gets the latest cell information, position, and application loss of
+     * all the registered LTE UEs. This default implementation queries each
+     * UE separately; backends should override it to fetch the whole snapshot
+     * at once.
+     *
+     * @return The snapshot of the LTE UEs.
+     */
+    virtual LteUeSnapshot GetLteUeSnapshot();
+    /**
+     * Gets the cell ID and latest position of all the registered LTE eNBs.
+     * This default implementation queries each eNB separately; backends
+     * should override it to fetch the whole snapshot at once.
+     *
+     * @return The snapshot of the LTE eNBs.
+     */
+    virtual LteEnbSnapshot GetLteEnbSnapshot();
+    /**
+     * Gets the latest position of a node, without building a collection.
+     * This default implementation uses GetNodePositions.
+     *
+     * @param e2NodeId The E2 Node ID of the node.
+     *
+     * @return A tuple with a boolean indicating if a position was found, the
+     * time of the position, and the position.
+     */
+    virtual std::tuple<bool, Time, Vector> GetLatestNodePosition(uint64_t e2NodeId);
+    /**
+     * Visits the recorded positions of a node between two times, from the
+     * newest to the oldest one, without building a collection. This default
+     * implementation uses GetNodePositions. The visitor must not use the
+     * Data Repository.
+     *
+     * @param e2NodeId The E2 Node ID of the node.
+     * @param fromTime Starting time of the interval to visit.
+     * @param toTime End time of the interval to visit.
+     * @param maxEntries Maximum number of entries to visit.
+     * @param visitor The callback invoked for each position.
+     */
+    virtual void ForEachNodePosition(uint64_t e2NodeId,
+                                     Time fromTime,
+                                     Time toTime,
+                                     uint64_t maxEntries,
+                                     const NodePositionVisitor& visitor);
+    /**
+     * Visits the last reported RSRP and RSRQ values of a UE without building
+     * a collection. This default implementation uses GetLteUeRsrpRsrq. The
+     * visitor must not use the Data Repository.
+     *
+     * @param e2NodeId The E2 Node ID.
+     * @param visitor The callback invoked for each measurement.
+     */
+    virtual void ForEachLteUeRsrpRsrq(uint64_t e2NodeId, const LteUeRsrpRsrqVisitor& visitor);
 
     /* Logging API */
     /**
@@ -301,17 +460,147 @@ class OranDataRepository : public Object
      * @param logstr An string with the action to be logged.
      */
     virtual void LogActionCmm(std::string cmm, std::string logstr) = 0;
+    /**
+     * Log a Logic Module event. This default implementation renders the
+     * event and logs it as an action (see LogActionLm).
+     *
+     * @param lm The Logic Module name.
+     * @param event The event.
+     * @param arg0 The first argument of the event.
+     * @param arg1 The second argument of the event.
+     * @param arg2 The third argument of the event.
+     * @param arg3 The fourth argument of the event.
+     */
+    virtual void LogEventLm(const std::string& lm,
+                            LogEvent event,
+                            double arg0,
+                            double arg1,
+                            double arg2,
+                            double arg3);
+    /**
+     * Log a Conflict Mitigation Module event. This default implementation
+     * renders the event and logs it as an action (see LogActionCmm).
+     *
+     * @param cmm The Conflict Mitigation Module name.
+     * @param event The event.
+     * @param arg0 The first argument of the event.
+     * @param arg1 The second argument of the event.
+     * @param arg2 The third argument of the event.
+     * @param arg3 The fourth argument of the event.
+     */
+    virtual void LogEventCmm(const std::string& cmm,
+                             LogEvent event,
+                             double arg0,
+                             double arg1,
+                             double arg2,
+                             double arg3);
+
+    /**
+     * Register the format of the text of an event of a module. The formats
+     * are printf formats that use "%d" for integer arguments and "%f" for
+     * real ones, so that they can also be rendered with the printf function
+     * of SQLite. Registering the same format again for the same module
+     * returns the ID that it already has. The modules usually register their
+     * events in the static initializers of their source files.
+     *
+     * @param module The name of the module, such as the name of its TypeId.
+     * @param format The format of the text of the event.
+     *
+     * @return The ID of the event.
+     */
+    static LogEvent RegisterLogEvent(const std::string& module, const std::string& format);
+    /**
+     * Get the format of each registered event. The IDs of the events are
+     * assigned in order of registration, starting after LOG_NO_ACTION, whose
+     * module name is empty, so they may differ between programs.
+     *
+     * @return The format of each event, indexed by event ID.
+     */
+    static const std::map<LogEvent, LogEventFormat>& GetLogEventFormats();
+    /**
+     * Render the text of an event.
+     *
+     * @param event The event.
+     * @param arg0 The first argument of the event.
+     * @param arg1 The second argument of the event.
+     * @param arg2 The third argument of the event.
+     * @param arg3 The fourth argument of the event.
+     *
+     * @return The text of the event.
+     */
+    static std::string FormatLogEvent(LogEvent event,
+                                      double arg0,
+                                      double arg1,
+                                      double arg2,
+                                      double arg3);
 
   protected:
     /**
      * Disposes of the object.
      */
     void DoDispose() override;
+    /**
+     * Delete the oldest entries of a type of history that are outside of its
+     * retention policy, up to a maximum number of entries. Backends that keep
+     * a history should override this method; this default implementation
+     * does nothing.
+     *
+     * @param type The type of history.
+     * @param minTime The time before which entries are deleted, or zero for no limit.
+     * @param maxRows The maximum number of entries of each node, or zero for no limit.
+     * @param maxDeletes The maximum number of entries to delete.
+     */
+    virtual void DoPruneHistory(HistoryType type,
+                                Time minTime,
+                                uint64_t maxRows,
+                                uint32_t maxDeletes);
 
     /**
      * Flag to keep track of the active status.
      */
     bool m_active;
+    /**
+     * The trace fired when an E2 Node is registered, or renews its
+     * registration. Implementations must fire it from the Register* methods.
+     */
+    TracedCallback<uint64_t> m_nodeRegisteredTrace;
+    /**
+     * The trace fired when an E2 Node is deregistered. Implementations must
+     * fire it from DeregisterNode.
+     */
+    TracedCallback<uint64_t> m_nodeDeregisteredTrace;
+
+  private:
+    /**
+     * The retention policy of a type of history.
+     */
+    struct RetentionPolicy
+    {
+        Time maxAge;      //!< The maximum age of the entries, or zero for no limit.
+        uint64_t maxRows; //!< The maximum number of entries of each node, or zero for no limit.
+    };
+
+    /**
+     * Enforce the retention policies and schedule the next pruning.
+     */
+    void PruneHistory();
+
+    /**
+     * The retention policies, indexed by type of history.
+     */
+    std::map<HistoryType, RetentionPolicy> m_retentionPolicies;
+    /**
+     * The time between two enforcements of the retention policies.
+     */
+    Time m_pruneInterval;
+    /**
+     * The maximum number of entries of each type of history deleted at a time.
+     */
+    uint32_t m_pruneChunkRows;
+    /**
+     * The event of the next enforcement of the retention policies.
+     */
+    EventId m_pruneEvent;
 }; // class OranDataRepository
 
 } // namespace ns3
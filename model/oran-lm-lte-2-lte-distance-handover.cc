@@ -34,11 +34,15 @@
 #include "oran-data-repository.h"
 
 #include "ns3/abort.h"
+#include "ns3/boolean.h"
 #include "ns3/log.h"
-#include "ns3/simulator.h"
 #include "ns3/uinteger.h"
 
+#include <algorithm>
 #include <cfloat>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
 
 namespace ns3
 {
@@ -47,18 +51,56 @@ NS_LOG_COMPONENT_DEFINE("OranLmLte2LteDistanceHandover");
 
 NS_OBJECT_ENSURE_REGISTERED(OranLmLte2LteDistanceHandover);
 
+namespace
+{
+
+/**
+ * The event that logs the distance from a UE to a cell.
+ */
+const OranDataRepository::LogEvent LOG_DISTANCE_TO_CELL =
+    OranDataRepository::RegisterLogEvent(
+        "ns3::OranLmLte2LteDistanceHandover",
+        "Distance from UE with RNTI %d in CellID %d to eNB with CellID %d is %f");
+
+/**
+ * The event that logs that a cell is the closest one so far.
+ */
+const OranDataRepository::LogEvent LOG_SHORTEST_DISTANCE =
+    OranDataRepository::RegisterLogEvent("ns3::OranLmLte2LteDistanceHandover",
+                                         "Distance to eNB with CellID %d is shortest so far");
+
+/**
+ * The event that logs that a handover is issued to the closest cell.
+ */
+const OranDataRepository::LogEvent LOG_DISTANCE_HANDOVER =
+    OranDataRepository::RegisterLogEvent(
+        "ns3::OranLmLte2LteDistanceHandover",
+        "Closest eNB (CellID %d) is different than the currently attached eNB (CellID %d). "
+        "Issuing handover command.");
+
+} // namespace
+
 TypeId
 OranLmLte2LteDistanceHandover::GetTypeId()
 {
     static TypeId tid = TypeId("ns3::OranLmLte2LteDistanceHandover")
                             .SetParent<OranLm>()
-                            .AddConstructor<OranLmLte2LteDistanceHandover>();
+                            .AddConstructor<OranLmLte2LteDistanceHandover>()
+                            .AddAttribute("Incremental",
+                                          "Flag to indicate if the closest eNB is only found "
+                                          "again for the UEs that changed since the previous "
+                                          "LM query cycle.",
+                                          BooleanValue(true),
+                                          MakeBooleanAccessor(
+                                              &OranLmLte2LteDistanceHandover::m_incremental),
+                                          MakeBooleanChecker());
 
     return tid;
 }
 
 OranLmLte2LteDistanceHandover::OranLmLte2LteDistanceHandover()
-    : OranLm()
+    : OranLm(),
+      m_evaluationsVerbose(false)
 {
     NS_LOG_FUNCTION(this);
 
@@ -70,6 +112,50 @@ OranLmLte2LteDistanceHandover::~OranLmLte2LteDistanceHandover()
     NS_LOG_FUNCTION(this);
 }
 
+void
+OranLmLte2LteDistanceHandover::ReadData()
+{
+    NS_LOG_FUNCTION(this);
+
+    NS_ABORT_MSG_IF(m_nearRtRic == nullptr,
+                    "Attempting to run LM (" + m_name + ") with NULL Near-RT RIC");
+
+    m_evaluated.clear();
+
+    // The distances are only kept in the evaluations when verbose, so they
+    // cannot be reused if the flag changed since they were made.
+    bool incremental = m_incremental && IsIncrementalRun() && m_evaluationsVerbose == m_verbose;
+    if (incremental && GetChangedE2NodeIds().empty())
+    {
+        // Nothing changed since the previous run, so its evaluations are
+        // still valid.
+        NS_LOG_LOGIC("\"" << m_name << "\" reusing the evaluation of all the UEs");
+        return;
+    }
+
+    Ptr<OranDataRepository> data = m_nearRtRic->Data();
+    std::vector<UeInfo> ueInfos = GetUeInfos(data);
+    std::vector<EnbInfo> enbInfos = GetEnbInfos(data);
+    m_evaluations = GetEvaluations(ueInfos, enbInfos, incremental);
+    m_evaluationsVerbose = m_verbose;
+    m_ueInfos = std::move(ueInfos);
+    m_enbInfos = std::move(enbInfos);
+}
+
+void
+OranLmLte2LteDistanceHandover::Evaluate()
+{
+    NS_LOG_FUNCTION(this);
+
+    // The UEs are evaluated in parallel if the Near-RT RIC has worker threads.
+    ParallelFor(m_evaluated.size(), [this](std::size_t begin, std::size_t end) {
+        for (std::size_t i = begin; i < end; i++)
+        {
+            m_evaluations[m_evaluated[i]] = EvaluateUe(m_ueInfos[m_evaluated[i]], m_enbInfos);
+        }
+    });
+}
+
 std::vector<Ptr<OranCommand>>
 OranLmLte2LteDistanceHandover::Run()
 {
@@ -79,13 +165,7 @@ OranLmLte2LteDistanceHandover::Run()
 
     if (m_active)
     {
-        NS_ABORT_MSG_IF(m_nearRtRic == nullptr,
-                        "Attempting to run LM (" + m_name + ") with NULL Near-RT RIC");
-
-        Ptr<OranDataRepository> data = m_nearRtRic->Data();
-        std::vector<UeInfo> ueInfos = GetUeInfos(data);
-        std::vector<EnbInfo> enbInfos = GetEnbInfos(data);
-        commands = GetHandoverCommands(data, ueInfos, enbInfos);
+        commands = GetHandoverCommands(m_ueInfos, m_evaluations);
     }
 
     // Return the commands.
@@ -97,155 +177,189 @@ OranLmLte2LteDistanceHandover::GetUeInfos(Ptr<OranDataRepository> data) const
 {
     NS_LOG_FUNCTION(this << data);
 
-    std::vector<UeInfo> ueInfos;
-    for (auto ueId : data->GetLteUeE2NodeIds())
+    // Get the cell information and location of all the UEs at once
+    OranDataRepository::LteUeSnapshot snapshot = data->GetLteUeSnapshot();
+
+    std::vector<UeInfo> ueInfos(snapshot.e2NodeIds.size());
+    for (std::size_t i = 0; i < ueInfos.size(); i++)
+    {
+        UeInfo& ueInfo = ueInfos[i];
+        ueInfo.nodeId = snapshot.e2NodeIds[i];
+        ueInfo.cellId = snapshot.cellIds[i];
+        ueInfo.rnti = snapshot.rntis[i];
+        ueInfo.position = snapshot.positions[i];
+    }
+    return ueInfos;
+}
+
+std::vector<OranLmLte2LteDistanceHandover::EnbInfo>
+OranLmLte2LteDistanceHandover::GetEnbInfos(Ptr<OranDataRepository> data) const
+{
+    NS_LOG_FUNCTION(this << data);
+
+    // Get the cell ID and location of all the eNBs at once
+    OranDataRepository::LteEnbSnapshot snapshot = data->GetLteEnbSnapshot();
+
+    std::vector<EnbInfo> enbInfos(snapshot.e2NodeIds.size());
+    for (std::size_t i = 0; i < enbInfos.size(); i++)
+    {
+        EnbInfo& enbInfo = enbInfos[i];
+        enbInfo.nodeId = snapshot.e2NodeIds[i];
+        enbInfo.cellId = snapshot.cellIds[i];
+        enbInfo.position = snapshot.positions[i];
+    }
+    return enbInfos;
+}
+
+OranLmLte2LteDistanceHandover::Evaluation
+OranLmLte2LteDistanceHandover::EvaluateUe(
+    const OranLmLte2LteDistanceHandover::UeInfo& ueInfo,
+    const std::vector<OranLmLte2LteDistanceHandover::EnbInfo>& enbInfos) const
+{
+    Evaluation evaluation;
+    double min = DBL_MAX; // The minimum distance recorded.
+    evaluation.newCellId = ueInfo.cellId;
+    if (m_verbose)
     {
-        UeInfo ueInfo;
-        ueInfo.nodeId = ueId;
-        // Get the current cell ID and RNTI of the UE and record it.
-        bool found;
-        std::tie(found, ueInfo.cellId, ueInfo.rnti) = data->GetLteUeCellInfo(ueInfo.nodeId);
-        if (found)
+        evaluation.distances.reserve(enbInfos.size());
+    }
+
+    // Compare the location of each active eNB with the location of the UE
+    // and see if that UE is currently being served by the closet cell.
+    for (const auto& enbInfo : enbInfos)
+    {
+        // Calculate the distance between the UE and eNB.
+        double dist = std::sqrt(std::pow(ueInfo.position.x - enbInfo.position.x, 2) +
+                                std::pow(ueInfo.position.y - enbInfo.position.y, 2) +
+                                std::pow(ueInfo.position.z - enbInfo.position.z, 2));
+
+        // Check if the distance is shorter than the current minimum
+        bool isMin = dist < min;
+        if (isMin)
         {
-            // Get the latest location of the UE.
-            std::map<Time, Vector> nodePositions =
-                data->GetNodePositions(ueInfo.nodeId, Seconds(0), Simulator::Now());
+            // Record the new minimum
+            min = dist;
+            // Record the ID of the cell that produced the new minimum.
+            evaluation.newCellId = enbInfo.cellId;
+        }
 
-            if (!nodePositions.empty())
-            {
-                // We found both the cell and location informtaion for this UE
-                // so record it for a later analysis.
-                ueInfo.position = nodePositions.rbegin()->second;
-                ueInfos.push_back(ueInfo);
-            }
-            else
-            {
-                NS_LOG_INFO("Could not find LTE UE location for E2 Node ID = " << ueInfo.nodeId);
-            }
+        if (m_verbose)
+        {
+            evaluation.distances.emplace_back(enbInfo.cellId, dist, isMin);
         }
-        else
+
+        // Check if this cell is the currently serving this UE.
+        if (ueInfo.cellId == enbInfo.cellId)
         {
-            NS_LOG_INFO("Could not find LTE UE cell info for E2 Node ID = " << ueInfo.nodeId);
+            // It is, so indicate record the ID of the cell that is
+            // currently serving the UE.
+            evaluation.oldCellNodeId = enbInfo.nodeId;
         }
     }
-    return ueInfos;
+
+    return evaluation;
 }
 
-std::vector<OranLmLte2LteDistanceHandover::EnbInfo>
-OranLmLte2LteDistanceHandover::GetEnbInfos(Ptr<OranDataRepository> data) const
+std::vector<OranLmLte2LteDistanceHandover::Evaluation>
+OranLmLte2LteDistanceHandover::GetEvaluations(
+    const std::vector<OranLmLte2LteDistanceHandover::UeInfo>& ueInfos,
+    const std::vector<OranLmLte2LteDistanceHandover::EnbInfo>& enbInfos,
+    bool incremental)
 {
-    NS_LOG_FUNCTION(this << data);
+    NS_LOG_FUNCTION(this << incremental);
+
+    const std::unordered_set<uint64_t>& changedE2NodeIds = GetChangedE2NodeIds();
 
-    std::vector<EnbInfo> enbInfos;
-    for (auto enbId : data->GetLteEnbE2NodeIds())
+    // The evaluations of the previous run can only be reused if none of the
+    // eNBs that were or are active changed.
+    auto isChanged = [&changedE2NodeIds](const EnbInfo& enbInfo) {
+        return changedE2NodeIds.find(enbInfo.nodeId) != changedE2NodeIds.end();
+    };
+    if (std::any_of(m_enbInfos.begin(), m_enbInfos.end(), isChanged) ||
+        std::any_of(enbInfos.begin(), enbInfos.end(), isChanged))
     {
-        EnbInfo enbInfo;
-        enbInfo.nodeId = enbId;
-        // Get the cell ID of this eNB and record it.
-        bool found;
-        std::tie(found, enbInfo.cellId) = data->GetLteEnbCellInfo(enbInfo.nodeId);
-        if (found)
+        incremental = false;
+    }
+
+    // Index the evaluations of the previous run by the node ID of their UE
+    std::unordered_map<uint64_t, std::size_t> previous;
+    if (incremental)
+    {
+        previous.reserve(m_ueInfos.size());
+        for (std::size_t i = 0; i < m_ueInfos.size(); i++)
         {
-            // Get all known locations of the eNB.
-            std::map<Time, Vector> nodePositions =
-                data->GetNodePositions(enbInfo.nodeId, Seconds(0), Simulator::Now());
+            previous.emplace(m_ueInfos[i].nodeId, i);
+        }
+    }
 
-            if (!nodePositions.empty())
-            {
-                // We found both the cell and location information for this
-                // eNB so record it for a later analysis.
-                enbInfo.position = nodePositions.rbegin()->second;
-                enbInfos.push_back(enbInfo);
-            }
-            else
-            {
-                NS_LOG_INFO("Could not find LTE eNB location for E2 Node ID = " << enbInfo.nodeId);
-            }
+    std::vector<Evaluation> evaluations(ueInfos.size());
+    for (std::size_t i = 0; i < ueInfos.size(); i++)
+    {
+        uint64_t nodeId = ueInfos[i].nodeId;
+        auto it = previous.find(nodeId);
+        if (it != previous.end() && changedE2NodeIds.find(nodeId) == changedE2NodeIds.end())
+        {
+            evaluations[i] = std::move(m_evaluations[it->second]);
         }
         else
         {
-            NS_LOG_INFO("Could not find LTE eNB cell info for E2 Node ID = " << enbInfo.nodeId);
+            m_evaluated.push_back(i);
         }
     }
-    return enbInfos;
+
+    NS_LOG_LOGIC("\"" << m_name << "\" evaluating " << m_evaluated.size() << " of "
+                      << ueInfos.size() << " UEs");
+
+    return evaluations;
 }
 
 std::vector<Ptr<OranCommand>>
 OranLmLte2LteDistanceHandover::GetHandoverCommands(
-    Ptr<OranDataRepository> data,
-    std::vector<OranLmLte2LteDistanceHandover::UeInfo> ueInfos,
-    std::vector<OranLmLte2LteDistanceHandover::EnbInfo> enbInfos) const
+    const std::vector<OranLmLte2LteDistanceHandover::UeInfo>& ueInfos,
+    const std::vector<OranLmLte2LteDistanceHandover::Evaluation>& evaluations) const
 {
-    NS_LOG_FUNCTION(this << data);
+    NS_LOG_FUNCTION(this);
 
     std::vector<Ptr<OranCommand>> commands;
 
-    // Compare the location of each active eNB with the location of each active
-    // UE and see if that UE is currently being served by the closet cell. If
-    // there is a closer eNB to the UE then the currently serving cell then
-    // issue a handover command.
-    for (auto ueInfo : ueInfos)
+    // Log the evaluation of each UE, in order, and if there is a closer eNB
+    // to the UE than the currently serving cell then issue a handover command.
+    for (std::size_t i = 0; i < ueInfos.size(); i++)
     {
-        double min = DBL_MAX;               // The minimum distance recorded.
-        uint64_t oldCellNodeId;             // The ID of the cell currently serving the UE.
-        uint16_t newCellId = ueInfo.cellId; // The ID of the closest cell.
-        for (const auto& enbInfo : enbInfos)
+        const UeInfo& ueInfo = ueInfos[i];
+        const Evaluation& evaluation = evaluations[i];
+        for (const auto& [cellId, dist, isMin] : evaluation.distances)
         {
-            // Calculate the distance between the UE and eNB.
-            double dist = std::sqrt(std::pow(ueInfo.position.x - enbInfo.position.x, 2) +
-                                    std::pow(ueInfo.position.y - enbInfo.position.y, 2) +
-                                    std::pow(ueInfo.position.z - enbInfo.position.z, 2));
-
-            LogLogicToRepository("Distance from UE with RNTI " + std::to_string(ueInfo.rnti) +
-                                 " in CellID " + std::to_string(ueInfo.cellId) +
-                                 " to eNB with CellID " + std::to_string(enbInfo.cellId) + " is " +
-                                 std::to_string(dist));
-
-            // Check if the distance is shorter than the current minimum
-            if (dist < min)
+            LogLogicToRepository(LOG_DISTANCE_TO_CELL, ueInfo.rnti, ueInfo.cellId, cellId, dist);
+            if (isMin)
             {
-                // Record the new minimum
-                min = dist;
-                // Record the ID of the cell that produced the new minimum.
-                newCellId = enbInfo.cellId;
-
-                LogLogicToRepository("Distance to eNB with CellID " +
-                                     std::to_string(enbInfo.cellId) + " is shortest so far");
-            }
-
-            // Check if this cell is the currently serving this UE.
-            if (ueInfo.cellId == enbInfo.cellId)
-            {
-                // It is, so indicate record the ID of the cell that is
-                // currently serving the UE.
-                oldCellNodeId = enbInfo.nodeId;
+                LogLogicToRepository(LOG_SHORTEST_DISTANCE, cellId);
             }
         }
 
         // Check if the ID of the closest cell is different from ID of the cell
         // that is currently serving the UE
-        if (newCellId != ueInfo.cellId)
+        if (evaluation.newCellId != ueInfo.cellId)
         {
             // It is, so issue a handover command.
             Ptr<OranCommandLte2LteHandover> handoverCommand =
                 CreateObject<OranCommandLte2LteHandover>();
             // Send the command to the cell currently serving the UE.
-            handoverCommand->SetAttribute("TargetE2NodeId", UintegerValue(oldCellNodeId));
+            handoverCommand->SetAttribute("TargetE2NodeId",
+                                          UintegerValue(evaluation.oldCellNodeId));
             // Use the RNTI that the current cell is using to identify the UE.
             handoverCommand->SetAttribute("TargetRnti", UintegerValue(ueInfo.rnti));
             // Give the current cell the ID of the new cell to handover to.
-            handoverCommand->SetAttribute("TargetCellId", UintegerValue(newCellId));
+            handoverCommand->SetAttribute("TargetCellId", UintegerValue(evaluation.newCellId));
             // Log the command to the storage
-            data->LogCommandLm(m_name, handoverCommand);
+            LogCommandToRepository(handoverCommand);
             // Add the command to send.
             commands.push_back(handoverCommand);
 
-            LogLogicToRepository("Closest eNB (CellID " + std::to_string(newCellId) + ")" +
-                                 " is different than the currently attached eNB" + " (CellID " +
-                                 std::to_string(ueInfo.cellId) + ")." +
-                                 " Issuing handover command.");
+            LogLogicToRepository(LOG_DISTANCE_HANDOVER, evaluation.newCellId, ueInfo.cellId);
         }
     }
+
     return commands;
 }
 
@@ -36,6 +36,9 @@
 
 #include "ns3/vector.h"
 
+#include <tuple>
+#include <vector>
+
 namespace ns3
 {
 
@@ -69,6 +72,20 @@ class OranLmLte2LteDistanceHandover : public OranLm
         Vector position; //!< The physical position.
     };
 
+    /**
+     * The evaluation of the distance from a UE to the eNBs.
+     */
+    struct Evaluation
+    {
+        uint64_t oldCellNodeId{0}; //!< The node ID of the cell serving the UE.
+        uint16_t newCellId{0};     //!< The ID of the closest cell.
+        /**
+         * The cell ID, the distance, and whether it was the shortest distance
+         * so far, for each eNB. It is only filled in if the LM is verbose.
+         */
+        std::vector<std::tuple<uint16_t, double, bool>> distances;
+    };
+
   public:
     /**
      * Gets the TypeId of the OranLmLte2LteDistanceHandover class.
@@ -85,9 +102,19 @@ class OranLmLte2LteDistanceHandover : public OranLm
      */
     ~OranLmLte2LteDistanceHandover() override;
     /**
-     * Runs the logic specific for this Logic Module. This will retrieve the
-     * location of all LTE UEs and eNBs, find the closest eNB for each UE, and if
-     * this eNB is not the serving eNB, a handover Command is generated.
+     * Retrieves the location of all LTE UEs and eNBs. If the run is
+     * incremental, the UEs that did not change since the previous run reuse
+     * their evaluation, unless an eNB changed, and the data is not even
+     * retrieved if nothing changed.
+     */
+    void ReadData() override;
+    /**
+     * Finds the closest eNB for each UE that does not reuse its evaluation.
+     */
+    void Evaluate() override;
+    /**
+     * Runs the logic specific for this Logic Module. For each UE, if the
+     * closest eNB is not the serving eNB, a handover Command is generated.
      *
      * @return A vector with the handover commands generated by this Logic Module.
      */
@@ -113,19 +140,68 @@ class OranLmLte2LteDistanceHandover : public OranLm
     std::vector<OranLmLte2LteDistanceHandover::EnbInfo> GetEnbInfos(
         Ptr<OranDataRepository> data) const;
     /**
-     * Method with the logic to get the distance between UEs and eNBs
-     * and generate Handover Commands if needed.
+     * Method with the logic to get the distance between a UE and the eNBs.
+     *
+     * @param ueInfo The UE information.
+     * @param enbInfos A vector with the eNB information.
+     *
+     * @return The evaluation of the UE.
+     */
+    OranLmLte2LteDistanceHandover::Evaluation EvaluateUe(
+        const OranLmLte2LteDistanceHandover::UeInfo& ueInfo,
+        const std::vector<OranLmLte2LteDistanceHandover::EnbInfo>& enbInfos) const;
+    /**
+     * Method to reuse the evaluations of the previous run for the UEs that did
+     * not change, if the run is incremental and none of the eNBs changed. The
+     * indexes of the other UEs are stored to be evaluated.
      *
-     * @param data The data repository.
      * @param ueInfos A vector with the UE information.
      * @param enbInfos A vector with the eNB information.
+     * @param incremental Flag to indicate if the run is incremental.
+     *
+     * @return A vector with the evaluation of each UE, if reused.
+     */
+    std::vector<OranLmLte2LteDistanceHandover::Evaluation> GetEvaluations(
+        const std::vector<OranLmLte2LteDistanceHandover::UeInfo>& ueInfos,
+        const std::vector<OranLmLte2LteDistanceHandover::EnbInfo>& enbInfos,
+        bool incremental);
+    /**
+     * Method to log the evaluation of the UEs and generate Handover Commands
+     * if needed.
+     *
+     * @param ueInfos A vector with the UE information.
+     * @param evaluations A vector with the evaluation of each UE.
      *
      * @return A vector with the handover commands generated.
      */
     std::vector<Ptr<OranCommand>> GetHandoverCommands(
-        Ptr<OranDataRepository> data,
-        std::vector<OranLmLte2LteDistanceHandover::UeInfo> ueInfos,
-        std::vector<OranLmLte2LteDistanceHandover::EnbInfo> enbInfos) const;
+        const std::vector<OranLmLte2LteDistanceHandover::UeInfo>& ueInfos,
+        const std::vector<OranLmLte2LteDistanceHandover::Evaluation>& evaluations) const;
+
+    /**
+     * Flag to indicate if the UEs that did not change are not evaluated again.
+     */
+    bool m_incremental;
+    /**
+     * The verbose flag of the LM when the evaluations of the last run were made.
+     */
+    bool m_evaluationsVerbose;
+    /**
+     * The UE information of the last run.
+     */
+    std::vector<UeInfo> m_ueInfos;
+    /**
+     * The eNB information of the last run.
+     */
+    std::vector<EnbInfo> m_enbInfos;
+    /**
+     * The evaluation of each UE in the last run.
+     */
+    std::vector<Evaluation> m_evaluations;
+    /**
+     * The indexes of the UEs to evaluate in the current run.
+     */
+    std::vector<std::size_t> m_evaluated;
 }; // class OranLmLte2lteDistanceHandover
 
 } // namespace ns3
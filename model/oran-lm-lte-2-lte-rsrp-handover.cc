@@ -35,10 +35,10 @@
 
 #include "ns3/abort.h"
 #include "ns3/log.h"
-#include "ns3/simulator.h"
 #include "ns3/uinteger.h"
 
 #include <cfloat>
+#include <vector>
 
 namespace ns3
 {
@@ -47,6 +47,35 @@ NS_LOG_COMPONENT_DEFINE("OranLmLte2LteRsrpHandover");
 
 NS_OBJECT_ENSURE_REGISTERED(OranLmLte2LteRsrpHandover);
 
+namespace
+{
+
+/**
+ * The event that logs the RSRP from a UE to a cell.
+ */
+const OranDataRepository::LogEvent LOG_RSRP_TO_CELL =
+    OranDataRepository::RegisterLogEvent(
+        "ns3::OranLmLte2LteRsrpHandover",
+        "RSRP from UE with RNTI %d in CellID %d to eNB with CellID %d is %f");
+
+/**
+ * The event that logs that a cell has the largest RSRP so far.
+ */
+const OranDataRepository::LogEvent LOG_LARGEST_RSRP =
+    OranDataRepository::RegisterLogEvent("ns3::OranLmLte2LteRsrpHandover",
+                                         "RSRP to eNB with CellID %d is largest so far");
+
+/**
+ * The event that logs that a handover is issued to the cell with the largest RSRP.
+ */
+const OranDataRepository::LogEvent LOG_RSRP_HANDOVER =
+    OranDataRepository::RegisterLogEvent(
+        "ns3::OranLmLte2LteRsrpHandover",
+        "eNB (CellID %d) is different than the currently attached eNB (CellID %d). "
+        "Issuing handover command.");
+
+} // namespace
+
 TypeId
 OranLmLte2LteRsrpHandover::GetTypeId(void)
 {
@@ -70,6 +99,58 @@ OranLmLte2LteRsrpHandover::~OranLmLte2LteRsrpHandover(void)
     NS_LOG_FUNCTION(this);
 }
 
+void
+OranLmLte2LteRsrpHandover::ReadData(void)
+{
+    NS_LOG_FUNCTION(this);
+
+    NS_ABORT_MSG_IF(m_nearRtRic == nullptr,
+                    "Attempting to run LM (" + m_name + ") with NULL Near-RT RIC");
+
+    Ptr<OranDataRepository> data = m_nearRtRic->Data();
+    m_ueInfos = GetUeInfos(data);
+    m_enbInfos = GetEnbInfos(data);
+    m_measurements.clear();
+    m_evaluations.clear();
+
+    // The measurements are only needed after they are read to evaluate the
+    // UEs in parallel, or to log them.
+    if (m_verbose || m_nearRtRic->GetLmThreadPool() != nullptr)
+    {
+        m_measurements = GetMeasurements(data, m_ueInfos);
+    }
+    else
+    {
+        m_evaluations = GetEvaluations(data, m_ueInfos, m_enbInfos);
+    }
+}
+
+void
+OranLmLte2LteRsrpHandover::Evaluate(void)
+{
+    NS_LOG_FUNCTION(this);
+
+    if (m_measurements.size() != m_ueInfos.size())
+    {
+        // The UEs were evaluated while their measurements were read.
+        return;
+    }
+
+    // The UEs are evaluated in parallel if the Near-RT RIC has worker threads.
+    m_evaluations.assign(m_ueInfos.size(), Evaluation());
+    ParallelFor(m_ueInfos.size(), [this](std::size_t begin, std::size_t end) {
+        for (std::size_t i = begin; i < end; i++)
+        {
+            Evaluation& evaluation = m_evaluations[i];
+            evaluation = StartEvaluation(m_ueInfos[i], m_enbInfos);
+            for (const auto& [rnti, cellId, rsrp] : m_measurements[i])
+            {
+                EvaluateMeasurement(evaluation, cellId, rsrp);
+            }
+        }
+    });
+}
+
 std::vector<Ptr<OranCommand>>
 OranLmLte2LteRsrpHandover::Run(void)
 {
@@ -79,13 +160,7 @@ OranLmLte2LteRsrpHandover::Run(void)
 
     if (m_active)
     {
-        NS_ABORT_MSG_IF(m_nearRtRic == nullptr,
-                        "Attempting to run LM (" + m_name + ") with NULL Near-RT RIC");
-
-        Ptr<OranDataRepository> data = m_nearRtRic->Data();
-        std::vector<UeInfo> ueInfos = GetUeInfos(data);
-        std::vector<EnbInfo> enbInfos = GetEnbInfos(data);
-        commands = GetHandoverCommands(data, ueInfos, enbInfos);
+        commands = GetHandoverCommands(m_ueInfos, m_measurements, m_evaluations);
     }
 
     // Return the commands.
@@ -97,36 +172,17 @@ OranLmLte2LteRsrpHandover::GetUeInfos(Ptr<OranDataRepository> data) const
 {
     NS_LOG_FUNCTION(this << data);
 
-    std::vector<UeInfo> ueInfos;
-    for (auto ueId : data->GetLteUeE2NodeIds())
-    {
-        UeInfo ueInfo;
-        ueInfo.nodeId = ueId;
-        // Get the current cell ID and RNTI of the UE and record it.
-        bool found;
-        std::tie(found, ueInfo.cellId, ueInfo.rnti) = data->GetLteUeCellInfo(ueInfo.nodeId);
-        if (found)
-        {
-            // Get the latest location of the UE.
-            std::map<Time, Vector> nodePositions =
-                data->GetNodePositions(ueInfo.nodeId, Seconds(0), Simulator::Now());
+    // Get the cell information and location of all the UEs at once
+    OranDataRepository::LteUeSnapshot snapshot = data->GetLteUeSnapshot();
 
-            if (!nodePositions.empty())
-            {
-                // We found both the cell and location informtaion for this UE
-                // so record it for a later analysis.
-                ueInfo.position = nodePositions.rbegin()->second;
-                ueInfos.push_back(ueInfo);
-            }
-            else
-            {
-                NS_LOG_INFO("Could not find LTE UE location for E2 Node ID = " << ueInfo.nodeId);
-            }
-        }
-        else
-        {
-            NS_LOG_INFO("Could not find LTE UE cell info for E2 Node ID = " << ueInfo.nodeId);
-        }
+    std::vector<UeInfo> ueInfos(snapshot.e2NodeIds.size());
+    for (std::size_t i = 0; i < ueInfos.size(); i++)
+    {
+        UeInfo& ueInfo = ueInfos[i];
+        ueInfo.nodeId = snapshot.e2NodeIds[i];
+        ueInfo.cellId = snapshot.cellIds[i];
+        ueInfo.rnti = snapshot.rntis[i];
+        ueInfo.position = snapshot.positions[i];
     }
     return ueInfos;
 }
@@ -136,121 +192,157 @@ OranLmLte2LteRsrpHandover::GetEnbInfos(Ptr<OranDataRepository> data) const
 {
     NS_LOG_FUNCTION(this << data);
 
-    std::vector<EnbInfo> enbInfos;
-    for (auto enbId : data->GetLteEnbE2NodeIds())
+    // Get the cell ID and location of all the eNBs at once
+    OranDataRepository::LteEnbSnapshot snapshot = data->GetLteEnbSnapshot();
+
+    std::vector<EnbInfo> enbInfos(snapshot.e2NodeIds.size());
+    for (std::size_t i = 0; i < enbInfos.size(); i++)
     {
-        EnbInfo enbInfo;
-        enbInfo.nodeId = enbId;
-        // Get the cell ID of this eNB and record it.
-        bool found;
-        std::tie(found, enbInfo.cellId) = data->GetLteEnbCellInfo(enbInfo.nodeId);
-        if (found)
-        {
-            // Get all known locations of the eNB.
-            std::map<Time, Vector> nodePositions =
-                data->GetNodePositions(enbInfo.nodeId, Seconds(0), Simulator::Now());
+        EnbInfo& enbInfo = enbInfos[i];
+        enbInfo.nodeId = snapshot.e2NodeIds[i];
+        enbInfo.cellId = snapshot.cellIds[i];
+        enbInfo.position = snapshot.positions[i];
+    }
+    return enbInfos;
+}
 
-            if (!nodePositions.empty())
-            {
-                // We found both the cell and location information for this
-                // eNB so record it for a later analysis.
-                enbInfo.position = nodePositions.rbegin()->second;
-                enbInfos.push_back(enbInfo);
-            }
-            else
-            {
-                NS_LOG_INFO("Could not find LTE eNB location for E2 Node ID = " << enbInfo.nodeId);
-            }
-        }
-        else
+std::vector<std::vector<OranLmLte2LteRsrpHandover::Measurement>>
+OranLmLte2LteRsrpHandover::GetMeasurements(
+    Ptr<OranDataRepository> data,
+    const std::vector<OranLmLte2LteRsrpHandover::UeInfo>& ueInfos) const
+{
+    NS_LOG_FUNCTION(this << data);
+
+    // Get the RNTI, cell ID, and RSRP of the measurements of each UE.
+    std::vector<std::vector<Measurement>> measurements(ueInfos.size());
+    for (std::size_t i = 0; i < ueInfos.size(); i++)
+    {
+        std::vector<Measurement>& ueMeasurements = measurements[i];
+        data->ForEachLteUeRsrpRsrq(ueInfos[i].nodeId,
+                                   [&ueMeasurements](uint16_t rnti,
+                                                     uint16_t cellId,
+                                                     double rsrp,
+                                                     double,
+                                                     bool,
+                                                     uint8_t) {
+                                       ueMeasurements.emplace_back(rnti, cellId, rsrp);
+                                   });
+    }
+    return measurements;
+}
+
+std::vector<OranLmLte2LteRsrpHandover::Evaluation>
+OranLmLte2LteRsrpHandover::GetEvaluations(
+    Ptr<OranDataRepository> data,
+    const std::vector<OranLmLte2LteRsrpHandover::UeInfo>& ueInfos,
+    const std::vector<OranLmLte2LteRsrpHandover::EnbInfo>& enbInfos) const
+{
+    NS_LOG_FUNCTION(this << data);
+
+    std::vector<Evaluation> evaluations(ueInfos.size());
+    for (std::size_t i = 0; i < ueInfos.size(); i++)
+    {
+        Evaluation& evaluation = evaluations[i];
+        evaluation = StartEvaluation(ueInfos[i], enbInfos);
+        data->ForEachLteUeRsrpRsrq(
+            ueInfos[i].nodeId,
+            [&evaluation](uint16_t, uint16_t cellId, double rsrp, double, bool, uint8_t) {
+                EvaluateMeasurement(evaluation, cellId, rsrp);
+            });
+    }
+    return evaluations;
+}
+
+OranLmLte2LteRsrpHandover::Evaluation
+OranLmLte2LteRsrpHandover::StartEvaluation(
+    const OranLmLte2LteRsrpHandover::UeInfo& ueInfo,
+    const std::vector<OranLmLte2LteRsrpHandover::EnbInfo>& enbInfos) const
+{
+    Evaluation evaluation;
+    evaluation.newCellId = ueInfo.cellId;
+    for (const auto& enbInfo : enbInfos)
+    {
+        // Check if this cell is the currently serving this UE.
+        if (ueInfo.cellId == enbInfo.cellId)
         {
-            NS_LOG_INFO("Could not find LTE eNB cell info for E2 Node ID = " << enbInfo.nodeId);
+            // It is, so indicate record the ID of the cell that is
+            // currently serving the UE.
+            evaluation.oldCellNodeId = enbInfo.nodeId;
         }
     }
-    return enbInfos;
+
+    return evaluation;
+}
+
+void
+OranLmLte2LteRsrpHandover::EvaluateMeasurement(OranLmLte2LteRsrpHandover::Evaluation& evaluation,
+                                               uint16_t cellId,
+                                               double rsrp)
+{
+    // Check if the RSRP is greater than the current maximum
+    if (rsrp > evaluation.maxRsrp)
+    {
+        // Record the new maximum
+        evaluation.maxRsrp = rsrp;
+        // Record the ID of the cell that produced the new maximum.
+        evaluation.newCellId = cellId;
+    }
 }
 
 std::vector<Ptr<OranCommand>>
 OranLmLte2LteRsrpHandover::GetHandoverCommands(
-    Ptr<OranDataRepository> data,
-    std::vector<OranLmLte2LteRsrpHandover::UeInfo> ueInfos,
-    std::vector<OranLmLte2LteRsrpHandover::EnbInfo> enbInfos) const
+    const std::vector<OranLmLte2LteRsrpHandover::UeInfo>& ueInfos,
+    const std::vector<std::vector<OranLmLte2LteRsrpHandover::Measurement>>& measurements,
+    const std::vector<OranLmLte2LteRsrpHandover::Evaluation>& evaluations) const
 {
-    NS_LOG_FUNCTION(this << data);
+    NS_LOG_FUNCTION(this);
 
     std::vector<Ptr<OranCommand>> commands;
 
-    // Compare the location of each active eNB with the location of each active
-    // UE and see if that UE is currently being served by the closet cell. If
-    // there is a closer eNB to the UE then the currently serving cell then
-    // issue a handover command.
-    for (auto ueInfo : ueInfos)
+    // Log the measurements of each UE, in order, and if there is a cell with a
+    // larger RSRP than the currently serving cell then issue a handover command.
+    for (std::size_t i = 0; i < ueInfos.size(); i++)
     {
-        double max = -DBL_MAX;              // The maximum RSRP recorded.
-        uint64_t oldCellNodeId;             // The ID of the cell currently serving the UE.
-        uint16_t newCellId = ueInfo.cellId; // The ID of the closest cell.
-        auto rsrpMeasurements = data->GetLteUeRsrpRsrq(ueInfo.nodeId);
-        for (auto rsrpMeasurement : rsrpMeasurements)
+        const UeInfo& ueInfo = ueInfos[i];
+        const Evaluation& evaluation = evaluations[i];
+        if (m_verbose)
         {
-            uint16_t rnti;
-            uint16_t cellId;
-            double rsrp;
-            double rsrq;
-            bool isServingCell;
-            uint16_t componentCarrierId;
-            std::tie(rnti, cellId, rsrp, rsrq, isServingCell, componentCarrierId) = rsrpMeasurement;
-            LogLogicToRepository("RSRP from UE with RNTI " + std::to_string(rnti) + " in CellID " +
-                                 std::to_string(ueInfo.cellId) + " to eNB with CellID " +
-                                 std::to_string(cellId) + " is " + std::to_string(rsrp));
-
-            // Check if the RSRP is greater than the current maximum
-            if (rsrp > max)
+            double loggedMax = -DBL_MAX;
+            for (const auto& [rnti, cellId, rsrp] : measurements[i])
             {
-                // Record the new maximum
-                max = rsrp;
-                // Record the ID of the cell that produced the new maximum.
-                newCellId = cellId;
+                LogLogicToRepository(LOG_RSRP_TO_CELL, rnti, ueInfo.cellId, cellId, rsrp);
 
-                LogLogicToRepository("RSRP to eNB with CellID " + std::to_string(cellId) +
-                                     " is largest so far");
-            }
-        }
-
-        for (const auto& enbInfo : enbInfos)
-        {
-            // Check if this cell is the currently serving this UE.
-            if (ueInfo.cellId == enbInfo.cellId)
-            {
-                // It is, so indicate record the ID of the cell that is
-                // currently serving the UE.
-                oldCellNodeId = enbInfo.nodeId;
+                if (rsrp > loggedMax)
+                {
+                    loggedMax = rsrp;
+                    LogLogicToRepository(LOG_LARGEST_RSRP, cellId);
+                }
             }
         }
 
         // Check if the ID of the closest cell is different from ID of the cell
         // that is currently serving the UE
-        if (newCellId != ueInfo.cellId)
+        if (evaluation.newCellId != ueInfo.cellId)
         {
             // It is, so issue a handover command.
             Ptr<OranCommandLte2LteHandover> handoverCommand =
                 CreateObject<OranCommandLte2LteHandover>();
             // Send the command to the cell currently serving the UE.
-            handoverCommand->SetAttribute("TargetE2NodeId", UintegerValue(oldCellNodeId));
+            handoverCommand->SetAttribute("TargetE2NodeId",
+                                          UintegerValue(evaluation.oldCellNodeId));
             // Use the RNTI that the current cell is using to identify the UE.
             handoverCommand->SetAttribute("TargetRnti", UintegerValue(ueInfo.rnti));
             // Give the current cell the ID of the new cell to handover to.
-            handoverCommand->SetAttribute("TargetCellId", UintegerValue(newCellId));
+            handoverCommand->SetAttribute("TargetCellId", UintegerValue(evaluation.newCellId));
             // Log the command to the storage
-            data->LogCommandLm(m_name, handoverCommand);
+            LogCommandToRepository(handoverCommand);
             // Add the command to send.
             commands.push_back(handoverCommand);
 
-            LogLogicToRepository("eNB (CellID " + std::to_string(newCellId) + ")" +
-                                 " is different than the currently attached eNB" + " (CellID " +
-                                 std::to_string(ueInfo.cellId) + ")." +
-                                 " Issuing handover command.");
+            LogLogicToRepository(LOG_RSRP_HANDOVER, evaluation.newCellId, ueInfo.cellId);
         }
     }
+
     return commands;
 }
 
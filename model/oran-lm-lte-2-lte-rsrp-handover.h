@@ -36,6 +36,10 @@
 
 #include "ns3/vector.h"
 
+#include <cfloat>
+#include <tuple>
+#include <vector>
+
 namespace ns3
 {
 
@@ -69,6 +73,21 @@ class OranLmLte2LteRsrpHandover : public OranLm
         Vector position; //!< The physical position.
     };
 
+    /**
+     * A measurement of a UE: the RNTI, the cell ID, and the RSRP.
+     */
+    using Measurement = std::tuple<uint16_t, uint16_t, double>;
+
+    /**
+     * The evaluation of the RSRP measured by a UE.
+     */
+    struct Evaluation
+    {
+        uint64_t oldCellNodeId{0}; //!< The node ID of the cell serving the UE.
+        uint16_t newCellId{0};     //!< The ID of the cell with the largest RSRP.
+        double maxRsrp{-DBL_MAX};  //!< The largest RSRP measured so far.
+    };
+
   public:
     /**
      * Gets the TypeId of the OranLmLte2LteRsrpHandover class.
@@ -85,9 +104,21 @@ class OranLmLte2LteRsrpHandover : public OranLm
      */
     ~OranLmLte2LteRsrpHandover(void) override;
     /**
-     * Runs the logic specific for this Logic Module. This will retrieve the
-     * location of all LTE UEs and eNBs, find the closest eNB for each UE, and if
-     * this eNB is not the serving eNB, a handover Command is generated.
+     * Retrieves the information of all LTE UEs and eNBs, and the RSRP
+     * measurements of each UE. The measurements are only kept if the UEs are
+     * evaluated in parallel, or if the LM is verbose; otherwise, each UE is
+     * evaluated while its measurements are read.
+     */
+    void ReadData(void) override;
+    /**
+     * Finds the cell with the largest RSRP for each UE, unless the UEs were
+     * evaluated while their measurements were read.
+     */
+    void Evaluate(void) override;
+    /**
+     * Runs the logic specific for this Logic Module. For each UE, if the cell
+     * with the largest RSRP is not the serving cell, a handover Command is
+     * generated.
      *
      * @return A vector with the handover commands generated by this Logic Module.
      */
@@ -111,19 +142,83 @@ class OranLmLte2LteRsrpHandover : public OranLm
      */
     std::vector<OranLmLte2LteRsrpHandover::EnbInfo> GetEnbInfos(Ptr<OranDataRepository> data) const;
     /**
-     * Method with the logic to get the distance between UEs and eNBs
-     * and generate Handover Commands if needed.
+     * Method to get the RSRP measurements of the UEs from the repository.
      *
      * @param data The data repository.
      * @param ueInfos A vector with the UE information.
+     *
+     * @return A vector with the measurements of each UE.
+     */
+    std::vector<std::vector<OranLmLte2LteRsrpHandover::Measurement>> GetMeasurements(
+        Ptr<OranDataRepository> data,
+        const std::vector<OranLmLte2LteRsrpHandover::UeInfo>& ueInfos) const;
+    /**
+     * Method to evaluate the UEs while their RSRP measurements are read from
+     * the repository, without keeping the measurements.
+     *
+     * @param data The data repository.
+     * @param ueInfos A vector with the UE information.
+     * @param enbInfos A vector with the eNB information.
+     *
+     * @return A vector with the evaluation of each UE.
+     */
+    std::vector<OranLmLte2LteRsrpHandover::Evaluation> GetEvaluations(
+        Ptr<OranDataRepository> data,
+        const std::vector<OranLmLte2LteRsrpHandover::UeInfo>& ueInfos,
+        const std::vector<OranLmLte2LteRsrpHandover::EnbInfo>& enbInfos) const;
+    /**
+     * Method to start the evaluation of a UE with the cell currently serving it.
+     *
+     * @param ueInfo The UE information.
      * @param enbInfos A vector with the eNB information.
      *
+     * @return The evaluation of the UE, before any measurement.
+     */
+    OranLmLte2LteRsrpHandover::Evaluation StartEvaluation(
+        const OranLmLte2LteRsrpHandover::UeInfo& ueInfo,
+        const std::vector<OranLmLte2LteRsrpHandover::EnbInfo>& enbInfos) const;
+    /**
+     * Method with the logic to keep the cell with the largest RSRP measured
+     * by a UE.
+     *
+     * @param evaluation The evaluation of the UE.
+     * @param cellId The cell ID of the measurement.
+     * @param rsrp The RSRP of the measurement.
+     */
+    static void EvaluateMeasurement(OranLmLte2LteRsrpHandover::Evaluation& evaluation,
+                                    uint16_t cellId,
+                                    double rsrp);
+    /**
+     * Method to log the measurements of the UEs and generate Handover
+     * Commands if needed.
+     *
+     * @param ueInfos A vector with the UE information.
+     * @param measurements A vector with the measurements of each UE.
+     * @param evaluations A vector with the evaluation of each UE.
+     *
      * @return A vector with the handover commands generated.
      */
     std::vector<Ptr<OranCommand>> GetHandoverCommands(
-        Ptr<OranDataRepository> data,
-        std::vector<OranLmLte2LteRsrpHandover::UeInfo> ueInfos,
-        std::vector<OranLmLte2LteRsrpHandover::EnbInfo> enbInfos) const;
+        const std::vector<OranLmLte2LteRsrpHandover::UeInfo>& ueInfos,
+        const std::vector<std::vector<OranLmLte2LteRsrpHandover::Measurement>>& measurements,
+        const std::vector<OranLmLte2LteRsrpHandover::Evaluation>& evaluations) const;
+
+    /**
+     * The UE information of the current run.
+     */
+    std::vector<UeInfo> m_ueInfos;
+    /**
+     * The eNB information of the current run.
+     */
+    std::vector<EnbInfo> m_enbInfos;
+    /**
+     * The measurements of each UE in the current run, if they are kept.
+     */
+    std::vector<std::vector<Measurement>> m_measurements;
+    /**
+     * The evaluation of each UE in the current run.
+     */
+    std::vector<Evaluation> m_evaluations;
 }; // class OranLmLte2LteRsrpHandover
 
 } // namespace ns3
@@ -34,7 +34,6 @@
 
 #include "ns3/abort.h"
 #include "ns3/log.h"
-#include "ns3/simulator.h"
 #include "ns3/string.h"
 #include "ns3/uinteger.h"
 
@@ -46,6 +45,25 @@ namespace ns3
 NS_LOG_COMPONENT_DEFINE("OranLmLte2LteTorchHandover");
 NS_OBJECT_ENSURE_REGISTERED(OranLmLte2LteTorchHandover);
 
+namespace
+{
+
+/**
+ * The event that logs the configuration chosen by the model.
+ */
+const OranDataRepository::LogEvent LOG_ML_CONFIGURATION =
+    OranDataRepository::RegisterLogEvent("ns3::OranLmLte2LteTorchHandover",
+                                         "ML Chooses configuration %d");
+
+/**
+ * The event that logs that a UE is moved to a cell.
+ */
+const OranDataRepository::LogEvent LOG_ML_MOVE_UE =
+    OranDataRepository::RegisterLogEvent("ns3::OranLmLte2LteTorchHandover",
+                                         "Moving UE %d to Cell ID %d");
+
+} // namespace
+
 TypeId
 OranLmLte2LteTorchHandover::GetTypeId()
 {
@@ -74,6 +92,28 @@ OranLmLte2LteTorchHandover::~OranLmLte2LteTorchHandover()
     NS_LOG_FUNCTION(this);
 }
 
+void
+OranLmLte2LteTorchHandover::ReadData()
+{
+    NS_LOG_FUNCTION(this);
+
+    NS_ABORT_MSG_IF(m_nearRtRic == nullptr,
+                    "Attempting to run LM (" + m_name + ") with NULL Near-RT RIC");
+
+    Ptr<OranDataRepository> data = m_nearRtRic->Data();
+    m_ueInfos = GetUeInfos(data);
+    m_enbInfos = GetEnbInfos(data);
+}
+
+void
+OranLmLte2LteTorchHandover::Evaluate()
+{
+    NS_LOG_FUNCTION(this);
+
+    m_inputs = GetInputs(m_ueInfos, m_enbInfos);
+    m_configuration = GetConfiguration(m_inputs);
+}
+
 std::vector<Ptr<OranCommand>>
 OranLmLte2LteTorchHandover::Run()
 {
@@ -83,13 +123,17 @@ OranLmLte2LteTorchHandover::Run()
 
     if (m_active)
     {
-        NS_ABORT_MSG_IF(m_nearRtRic == nullptr,
-                        "Attempting to run LM (" + m_name + ") with NULL Near-RT RIC");
+        LogLogicToRepository([this]() {
+            std::string msg = "ML input tensor: (";
+            for (const auto& input : m_inputs)
+            {
+                msg += std::to_string(input) + ", ";
+            }
+            return msg + ")";
+        });
+        LogLogicToRepository(LOG_ML_CONFIGURATION, m_configuration);
 
-        Ptr<OranDataRepository> data = m_nearRtRic->Data();
-        std::vector<UeInfo> ueInfos = GetUeInfos(data);
-        std::vector<EnbInfo> enbInfos = GetEnbInfos(data);
-        commands = GetHandoverCommands(data, ueInfos, enbInfos);
+        commands = GetHandoverCommands(m_ueInfos, m_configuration);
     }
 
     return commands;
@@ -121,32 +165,18 @@ OranLmLte2LteTorchHandover::GetUeInfos(Ptr<OranDataRepository> data) const
 {
     NS_LOG_FUNCTION(this << data);
 
-    std::vector<UeInfo> ueInfos;
-    for (const auto ueId : data->GetLteUeE2NodeIds())
+    // Get the cell information and location of all the UEs at once
+    OranDataRepository::LteUeSnapshot snapshot = data->GetLteUeSnapshot();
+
+    std::vector<UeInfo> ueInfos(snapshot.e2NodeIds.size());
+    for (std::size_t i = 0; i < ueInfos.size(); i++)
     {
-        UeInfo ueInfo;
-        ueInfo.nodeId = ueId;
-        bool found;
-        std::tie(found, ueInfo.cellId, ueInfo.rnti) = data->GetLteUeCellInfo(ueInfo.nodeId);
-        if (found)
-        {
-            std::map<Time, Vector> nodePositions =
-                data->GetNodePositions(ueInfo.nodeId, Seconds(0), Simulator::Now());
-            if (!nodePositions.empty())
-            {
-                ueInfo.position = nodePositions.rbegin()->second;
-                ueInfo.loss = data->GetAppLoss(ueInfo.nodeId);
-                ueInfos.push_back(ueInfo);
-            }
-            else
-            {
-                NS_LOG_INFO("Could not find LTE UE location for E2 Node ID = " << ueInfo.nodeId);
-            }
-        }
-        else
-        {
-            NS_LOG_INFO("Could not find LTE UE cell info for E2 Node ID = " << ueInfo.nodeId);
-        }
+        UeInfo& ueInfo = ueInfos[i];
+        ueInfo.nodeId = snapshot.e2NodeIds[i];
+        ueInfo.cellId = snapshot.cellIds[i];
+        ueInfo.rnti = snapshot.rntis[i];
+        ueInfo.loss = snapshot.appLosses[i];
+        ueInfo.position = snapshot.positions[i];
     }
     return ueInfos;
 }
@@ -156,45 +186,26 @@ OranLmLte2LteTorchHandover::GetEnbInfos(Ptr<OranDataRepository> data) const
 {
     NS_LOG_FUNCTION(this << data);
 
-    std::vector<EnbInfo> enbInfos;
-    for (const auto enbId : data->GetLteEnbE2NodeIds())
-    {
-        EnbInfo enbInfo;
-        enbInfo.nodeId = enbId;
-        bool found;
-        std::tie(found, enbInfo.cellId) = data->GetLteEnbCellInfo(enbInfo.nodeId);
-        if (found)
-        {
-            std::map<Time, Vector> nodePositions =
-                data->GetNodePositions(enbInfo.nodeId, Seconds(0), Simulator::Now());
+    // Get the cell ID and location of all the eNBs at once
+    OranDataRepository::LteEnbSnapshot snapshot = data->GetLteEnbSnapshot();
 
-            if (!nodePositions.empty())
-            {
-                enbInfo.position = nodePositions.rbegin()->second;
-                enbInfos.push_back(enbInfo);
-            }
-            else
-            {
-                NS_LOG_INFO("Could not find LTE eNB location for E2 Node ID = " << enbInfo.nodeId);
-            }
-        }
-        else
-        {
-            NS_LOG_INFO("Could not find LTE eNB cell info for E2 Node ID = " << enbInfo.nodeId);
-        }
+    std::vector<EnbInfo> enbInfos(snapshot.e2NodeIds.size());
+    for (std::size_t i = 0; i < enbInfos.size(); i++)
+    {
+        EnbInfo& enbInfo = enbInfos[i];
+        enbInfo.nodeId = snapshot.e2NodeIds[i];
+        enbInfo.cellId = snapshot.cellIds[i];
+        enbInfo.position = snapshot.positions[i];
     }
     return enbInfos;
 }
 
-std::vector<Ptr<OranCommand>>
-OranLmLte2LteTorchHandover::GetHandoverCommands(
-    Ptr<OranDataRepository> data,
-    std::vector<OranLmLte2LteTorchHandover::UeInfo> ueInfos,
-    std::vector<OranLmLte2LteTorchHandover::EnbInfo> enbInfos)
+std::vector<float>
+OranLmLte2LteTorchHandover::GetInputs(
+    const std::vector<OranLmLte2LteTorchHandover::UeInfo>& ueInfos,
+    const std::vector<OranLmLte2LteTorchHandover::EnbInfo>& enbInfos) const
 {
-    NS_LOG_FUNCTION(this << data);
-
-    std::vector<Ptr<OranCommand>> commands;
+    NS_LOG_FUNCTION(this);
 
     std::map<uint16_t, float> distanceEnb1;
     std::map<uint16_t, float> distanceEnb2;
@@ -218,7 +229,7 @@ OranLmLte2LteTorchHandover::GetHandoverCommands(
         loss[ueInfo.nodeId] = ueInfo.loss;
     }
 
-    std::vector<float> inputv = {distanceEnb1[1],
+    std::vector<float> inputs = {distanceEnb1[1],
                                  distanceEnb2[1],
                                  loss[1],
                                  distanceEnb1[2],
@@ -231,20 +242,31 @@ OranLmLte2LteTorchHandover::GetHandoverCommands(
                                  distanceEnb2[4],
                                  loss[4]};
 
-    LogLogicToRepository("ML input tensor: (" + std::to_string(inputv.at(0)) + ", " +
-                         std::to_string(inputv.at(1)) + ", " + std::to_string(inputv.at(2)) + ", " +
-                         std::to_string(inputv.at(3)) + ", " + std::to_string(inputv.at(4)) + ", " +
-                         std::to_string(inputv.at(5)) + ", " + std::to_string(inputv.at(6)) + ", " +
-                         std::to_string(inputv.at(7)) + ", " + std::to_string(inputv.at(8)) + ", " +
-                         std::to_string(inputv.at(9)) + ", " + std::to_string(inputv.at(10)) +
-                         ", " + std::to_string(inputv.at(11)) + ", " + ")");
+    return inputs;
+}
+
+int
+OranLmLte2LteTorchHandover::GetConfiguration(std::vector<float>& inputv)
+{
+    NS_LOG_FUNCTION(this);
 
     std::vector<torch::jit::IValue> inputs;
     inputs.push_back(torch::from_blob(inputv.data(), {1, 12}).to(torch::kFloat32));
     at::Tensor output = torch::softmax(m_model.forward(inputs).toTensor(), 1);
 
     int configuration = output.argmax(1).item().toInt();
-    LogLogicToRepository("ML Chooses configuration " + std::to_string(configuration));
+
+    return configuration;
+}
+
+std::vector<Ptr<OranCommand>>
+OranLmLte2LteTorchHandover::GetHandoverCommands(
+    const std::vector<OranLmLte2LteTorchHandover::UeInfo>& ueInfos,
+    int configuration) const
+{
+    NS_LOG_FUNCTION(this << configuration);
+
+    std::vector<Ptr<OranCommand>> commands;
 
     for (const auto ueInfo : ueInfos)
     {
@@ -258,10 +280,10 @@ OranLmLte2LteTorchHandover::GetHandoverCommands(
                 handoverCommand->SetAttribute("TargetE2NodeId", UintegerValue(5));
                 handoverCommand->SetAttribute("TargetRnti", UintegerValue(ueInfo.rnti));
                 handoverCommand->SetAttribute("TargetCellId", UintegerValue(2));
-                data->LogCommandLm(m_name, handoverCommand);
+                LogCommandToRepository(handoverCommand);
                 commands.push_back(handoverCommand);
 
-                LogLogicToRepository("Moving UE 2 to Cell ID 2");
+                LogLogicToRepository(LOG_ML_MOVE_UE, 2, 2);
             }
             else
             {
@@ -273,10 +295,10 @@ OranLmLte2LteTorchHandover::GetHandoverCommands(
                     handoverCommand->SetAttribute("TargetE2NodeId", UintegerValue(6));
                     handoverCommand->SetAttribute("TargetRnti", UintegerValue(ueInfo.rnti));
                     handoverCommand->SetAttribute("TargetCellId", UintegerValue(1));
-                    data->LogCommandLm(m_name, handoverCommand);
+                    LogCommandToRepository(handoverCommand);
                     commands.push_back(handoverCommand);
 
-                    LogLogicToRepository("Moving UE 2 to Cell ID 1");
+                    LogLogicToRepository(LOG_ML_MOVE_UE, 2, 1);
                 }
             }
         }
@@ -292,10 +314,10 @@ OranLmLte2LteTorchHandover::GetHandoverCommands(
                     handoverCommand->SetAttribute("TargetE2NodeId", UintegerValue(5));
                     handoverCommand->SetAttribute("TargetRnti", UintegerValue(ueInfo.rnti));
                     handoverCommand->SetAttribute("TargetCellId", UintegerValue(2));
-                    data->LogCommandLm(m_name, handoverCommand);
+                    LogCommandToRepository(handoverCommand);
                     commands.push_back(handoverCommand);
 
-                    LogLogicToRepository("Moving UE 3 to Cell ID 2");
+                    LogLogicToRepository(LOG_ML_MOVE_UE, 3, 2);
                 }
                 else
                 {
@@ -307,10 +329,10 @@ OranLmLte2LteTorchHandover::GetHandoverCommands(
                         handoverCommand->SetAttribute("TargetE2NodeId", UintegerValue(6));
                         handoverCommand->SetAttribute("TargetRnti", UintegerValue(ueInfo.rnti));
                         handoverCommand->SetAttribute("TargetCellId", UintegerValue(1));
-                        data->LogCommandLm(m_name, handoverCommand);
+                        LogCommandToRepository(handoverCommand);
                         commands.push_back(handoverCommand);
 
-                        LogLogicToRepository("Moving UE 3 to Cell ID 1");
+                        LogLogicToRepository(LOG_ML_MOVE_UE, 3, 1);
                     }
                 }
             }
@@ -89,11 +89,18 @@ class OranLmLte2LteTorchHandover : public OranLm
      */
     ~OranLmLte2LteTorchHandover() override;
     /**
-     * Runs the logic specific for this Logic Module. This will retrieve the
-     * location of all LTE UEs and eNBs and the application loss for all UEs,
-     * calculate the distance between all eNBs for each UE, pass these as
-     * inputs to the PyTorch ML model, and then generate zero or more handover
-     * Commands based on the ML model output that is generated.
+     * Retrieves the location of all LTE UEs and eNBs and the application loss
+     * for all UEs.
+     */
+    void ReadData() override;
+    /**
+     * Calculates the distance between all eNBs for each UE, and passes these
+     * as inputs to the PyTorch ML model.
+     */
+    void Evaluate() override;
+    /**
+     * Runs the logic specific for this Logic Module. This will generate zero
+     * or more handover Commands based on the ML model output that is generated.
      *
      * @return A vector with the handover commands generated by this Logic Module.
      */
@@ -129,19 +136,52 @@ class OranLmLte2LteTorchHandover : public OranLm
     std::vector<OranLmLte2LteTorchHandover::EnbInfo> GetEnbInfos(
         Ptr<OranDataRepository> data) const;
     /**
-     * Method with the logic to generate Handover Commands if needed.
+     * Method to calculate the inputs of the ML model.
      *
-     * @param data The data repository.
      * @param ueInfos A vector with the UE information.
      * @param enbInfos A vector with the eNB information.
      *
+     * @return The inputs of the ML model.
+     */
+    std::vector<float> GetInputs(
+        const std::vector<OranLmLte2LteTorchHandover::UeInfo>& ueInfos,
+        const std::vector<OranLmLte2LteTorchHandover::EnbInfo>& enbInfos) const;
+    /**
+     * Method to get the configuration chosen by the ML model.
+     *
+     * @param inputv The inputs of the ML model.
+     *
+     * @return The configuration.
+     */
+    int GetConfiguration(std::vector<float>& inputv);
+    /**
+     * Method with the logic to generate Handover Commands if needed.
+     *
+     * @param ueInfos A vector with the UE information.
+     * @param configuration The configuration chosen by the ML model.
+     *
      * @return A vector with the handover commands generated.
      */
     std::vector<Ptr<OranCommand>> GetHandoverCommands(
-        Ptr<OranDataRepository> data,
-        std::vector<OranLmLte2LteTorchHandover::UeInfo> ueInfos,
-        std::vector<OranLmLte2LteTorchHandover::EnbInfo> enbInfos);
+        const std::vector<OranLmLte2LteTorchHandover::UeInfo>& ueInfos,
+        int configuration) const;
 
+    /**
+     * The UE information of the current run.
+     */
+    std::vector<UeInfo> m_ueInfos;
+    /**
+     * The eNB information of the current run.
+     */
+    std::vector<EnbInfo> m_enbInfos;
+    /**
+     * The inputs of the ML model in the current run.
+     */
+    std::vector<float> m_inputs;
+    /**
+     * The configuration chosen by the ML model in the current run.
+     */
+    int m_configuration{0};
 }; // class OranLmLte2LteTorchHandover
 
 } // namespace ns3
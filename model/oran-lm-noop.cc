@@ -78,7 +78,7 @@ OranLmNoop::Run()
     NS_ABORT_MSG_IF(m_nearRtRic == nullptr,
                     "Attempting to run LM (" + m_name + ") with NULL Near-RT RIC");
 
-    LogLogicToRepository("No action taken");
+    LogLogicToRepository(OranDataRepository::LOG_NO_ACTION);
     return {};
 }
 
@@ -30,8 +30,10 @@
 
 #include "oran-lm.h"
 
+#include "oran-command.h"
 #include "oran-data-repository.h"
 #include "oran-near-rt-ric.h"
+#include "oran-thread-pool.h"
 
 #include "ns3/abort.h"
 #include "ns3/boolean.h"
@@ -40,6 +42,7 @@
 #include "ns3/simulator.h"
 #include "ns3/string.h"
 
+#include <algorithm>
 #include <string>
 
 namespace ns3
@@ -141,9 +144,22 @@ OranLm::Run(Time cycle)
 {
     NS_LOG_FUNCTION(this << cycle);
 
+    if (PrepareRun(cycle))
+    {
+        ExecuteRun();
+    }
+    CompleteRun();
+}
+
+bool
+OranLm::PrepareRun(Time cycle)
+{
+    NS_LOG_FUNCTION(this << cycle);
+
     if (m_active)
     {
-        NS_ABORT_MSG_IF(IsRunning(), "Attempting to run LM that is already running");
+        NS_ABORT_MSG_IF(IsRunning() || m_runPrepared,
+                        "Attempting to run LM that is already running");
 
         NS_LOG_LOGIC("\"" << m_name << "\" Logic Module starting to run");
 
@@ -152,9 +168,37 @@ OranLm::Run(Time cycle)
         delay = delay < 0.0 ? 0.0 : delay;
 
         m_cycle = cycle;
-        m_commands = Run();
+        m_runDelay = Seconds(delay);
+        m_runQueryCount = m_nearRtRic == nullptr ? 0 : m_nearRtRic->GetLmQueryCount();
+        m_runPrepared = true;
+
+        ReadData();
+    }
+
+    return m_runPrepared;
+}
+
+void
+OranLm::ExecuteRun()
+{
+    NS_LOG_FUNCTION(this);
+
+    NS_ABORT_MSG_IF(!m_runPrepared, "Attempting to execute LM run that has not been prepared");
+
+    Evaluate();
+}
+
+void
+OranLm::CompleteRun()
+{
+    NS_LOG_FUNCTION(this);
 
-        m_finishRunEvent = Simulator::Schedule(Seconds(delay), &OranLm::FinishRun, this);
+    if (m_runPrepared)
+    {
+        m_commands = Run();
+        m_lastRunQueryCount = m_runQueryCount;
+        m_runPrepared = false;
+        m_finishRunEvent = Simulator::Schedule(m_runDelay, &OranLm::FinishRun, this);
     }
 }
 
@@ -167,22 +211,23 @@ OranLm::CancelRun()
     {
         m_finishRunEvent.Cancel();
 
-        std::string msg = "Run canceld for cycle " + std::to_string(m_cycle.GetTimeStep()) +
-                          " with " + std::to_string(m_commands.size()) + " command(s) lost";
-
         if (!m_commands.empty())
         {
-            msg += " {";
+            LogLogicToRepository([this]() {
+                std::string msg = "Run canceld for cycle " +
+                                  std::to_string(m_cycle.GetTimeStep()) + " with " +
+                                  std::to_string(m_commands.size()) + " command(s) lost {";
 
-            for (auto command : m_commands)
-            {
-                msg += command->ToString() + ",";
-            }
+                for (auto command : m_commands)
+                {
+                    msg += command->ToString() + ",";
+                }
 
-            msg.pop_back();
-            msg += "}";
+                msg.pop_back();
+                msg += "}";
 
-            LogLogicToRepository(msg);
+                return msg;
+            });
         }
 
         m_commands.clear();
@@ -210,6 +255,16 @@ OranLm::DoDispose()
     Object::DoDispose();
 }
 
+void
+OranLm::LogCommandToRepository(Ptr<OranCommand> cmd) const
+{
+    NS_LOG_FUNCTION(this << cmd);
+
+    NS_ABORT_MSG_IF(m_nearRtRic == nullptr, "Attempting to log LM command with NULL Near-RT RIC");
+
+    m_nearRtRic->Data()->LogCommandLm(m_name, cmd);
+}
+
 void
 OranLm::LogLogicToRepository(const std::string& msg) const
 {
@@ -225,6 +280,77 @@ OranLm::LogLogicToRepository(const std::string& msg) const
     }
 }
 
+void
+OranLm::LogLogicToRepository(OranDataRepository::LogEvent event,
+                             double arg0,
+                             double arg1,
+                             double arg2,
+                             double arg3) const
+{
+    NS_LOG_FUNCTION(this << event << arg0 << arg1 << arg2 << arg3);
+
+    NS_ABORT_MSG_IF(m_nearRtRic == nullptr, "Attempting to log LM logic with NULL Near-RT RIC");
+
+    if (m_verbose)
+    {
+        m_nearRtRic->Data()->LogEventLm(m_name, event, arg0, arg1, arg2, arg3);
+    }
+}
+
+void
+OranLm::ParallelFor(std::size_t count,
+                    const std::function<void(std::size_t, std::size_t)>& body) const
+{
+    NS_LOG_FUNCTION(this << count);
+
+    NS_ABORT_MSG_IF(m_nearRtRic == nullptr, "Attempting to run LM logic with NULL Near-RT RIC");
+
+    OranThreadPool* pool = m_nearRtRic->GetLmThreadPool();
+
+    if (pool == nullptr || count < 2)
+    {
+        body(0, count);
+        return;
+    }
+
+    // A few chunks per thread, so that the threads that finish early take
+    // over the chunks left by the others
+    std::size_t chunkSize = std::max<std::size_t>(1, count / (4 * (pool->GetNThreads() + 1)));
+
+    pool->ParallelFor(count, chunkSize, body);
+}
+
+const std::unordered_set<uint64_t>&
+OranLm::GetChangedE2NodeIds() const
+{
+    NS_LOG_FUNCTION(this);
+
+    NS_ABORT_MSG_IF(m_nearRtRic == nullptr,
+                    "Attempting to get changed E2 Nodes with NULL Near-RT RIC");
+
+    return m_nearRtRic->GetChangedE2NodeIds();
+}
+
+bool
+OranLm::IsIncrementalRun() const
+{
+    NS_LOG_FUNCTION(this);
+
+    return m_lastRunQueryCount > 0 && m_lastRunQueryCount + 1 == m_runQueryCount;
+}
+
+void
+OranLm::ReadData()
+{
+    NS_LOG_FUNCTION(this);
+}
+
+void
+OranLm::Evaluate()
+{
+    NS_LOG_FUNCTION(this);
+}
+
 void
 OranLm::FinishRun()
 {
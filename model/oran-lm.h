@@ -31,12 +31,17 @@
 #ifndef ORAN_LM_H
 #define ORAN_LM_H
 
+#include "oran-data-repository.h"
+
 #include "ns3/event-id.h"
 #include "ns3/nstime.h"
 #include "ns3/object.h"
 #include "ns3/random-variable-stream.h"
 
+#include <functional>
 #include <string_view>
+#include <type_traits>
+#include <unordered_set>
 #include <vector>
 
 namespace ns3
@@ -53,6 +58,15 @@ class OranCommand;
  * deactivation, getters and setters, and logging logic traces to the Data Repository.
  *
  * This class cannot be instantiated as it lacks implementation of the Run method.
+ *
+ * A run has three phases. PrepareRun reads the data of the run from the
+ * Data Repository with ReadData, on the simulator thread. ExecuteRun evaluates
+ * that data with Evaluate, and may be called on a worker thread by a Near-RT
+ * RIC that runs its Logic Modules in parallel. CompleteRun generates the
+ * commands with the Run method, on the simulator thread, so that the commands
+ * and the logs to the Data Repository are the same as in a serial run.
+ * Logic Modules can also split the evaluation of their UEs among the worker
+ * threads of the Near-RT RIC with ParallelFor.
  */
 class OranLm : public Object
 {
@@ -106,6 +120,27 @@ class OranLm : public Object
      * @param cycle The cycle to run for.
      */
     void Run(Time cycle);
+    /**
+     * Prepare a run of this Logic Module and read its data. This is the first
+     * phase of a run, and must be called on the simulator thread.
+     *
+     * @param cycle The cycle to run for.
+     *
+     * @return True, if the Logic Module is active and must be executed;
+     *         otherwise, false.
+     */
+    bool PrepareRun(Time cycle);
+    /**
+     * Evaluate the data of the prepared run. This is the second phase of a
+     * run, and may be called on a worker thread.
+     */
+    void ExecuteRun();
+    /**
+     * Generate the commands of the prepared run, if any, and schedule the end
+     * of the run. This is the last phase of a run, and must be called on the
+     * simulator thread.
+     */
+    void CompleteRun();
     /**
      * Cancels the current run.
      */
@@ -122,18 +157,105 @@ class OranLm : public Object
      * Dispose of the object.
      */
     void DoDispose() override;
+    /**
+     * Log a command to the Data Repository.
+     *
+     * @param cmd The command to log to the Data Repository.
+     */
+    void LogCommandToRepository(Ptr<OranCommand> cmd) const;
     /**
      * Log a string to the Data Repository
      *
      * @param msg The string to log to the Data Repository
      */
     void LogLogicToRepository(const std::string& msg) const;
+    /**
+     * Log a string to the Data Repository, building it only if the LM is
+     * verbose. This avoids the cost of formatting the message when it would
+     * be discarded, e.g.:
+     *
+     * @code
+     * LogLogicToRepository([&]() { return "Value: " + std::to_string(value); });
+     * @endcode
+     *
+     * @param buildMsg The callable that returns the string to log.
+     */
+    template <typename MsgBuilder,
+              typename = std::enable_if_t<std::is_invocable_r_v<std::string, MsgBuilder>>>
+    void LogLogicToRepository(MsgBuilder&& buildMsg) const
+    {
+        if (m_verbose)
+        {
+            LogLogicToRepository(std::string(buildMsg()));
+        }
+    }
+    /**
+     * Log an event to the Data Repository. The event is stored with its
+     * arguments, and its text is only rendered when it is queried.
+     *
+     * @param event The event.
+     * @param arg0 The first argument of the event.
+     * @param arg1 The second argument of the event.
+     * @param arg2 The third argument of the event.
+     * @param arg3 The fourth argument of the event.
+     */
+    void LogLogicToRepository(OranDataRepository::LogEvent event,
+                              double arg0 = 0,
+                              double arg1 = 0,
+                              double arg2 = 0,
+                              double arg3 = 0) const;
+    /**
+     * Run a function over the range of indexes [0, count), such as the UEs
+     * to evaluate, split into chunks that are run in parallel by the worker
+     * threads of the Near-RT RIC, if it has any; otherwise, the function is
+     * run on the whole range by the calling thread. The function must follow
+     * the same rules as Evaluate.
+     *
+     * @param count The number of indexes.
+     * @param body The function, called with the first index of a chunk and
+     *             the index after its last one.
+     */
+    void ParallelFor(std::size_t count,
+                     const std::function<void(std::size_t, std::size_t)>& body) const;
+    /**
+     * Get the IDs of the E2 Nodes that sent a report, registered, or were
+     * deregistered since the previous LM query cycle of the Near-RT RIC.
+     *
+     * @return The IDs of the E2 Nodes that changed.
+     */
+    const std::unordered_set<uint64_t>& GetChangedE2NodeIds() const;
+    /**
+     * Check if this Logic Module also ran in the previous LM query cycle, so
+     * that the E2 Nodes given by GetChangedE2NodeIds are the only ones whose
+     * data may have changed since its previous run, and the results of the
+     * other nodes can be reused.
+     *
+     * @return True, if only the changed nodes must be evaluated again;
+     *         otherwise, false.
+     */
+    bool IsIncrementalRun() const;
     /**
      * Finish running the logic module.
      */
     virtual void FinishRun();
     /**
-     * Generates the commands to provide to the Near-RT RIC.
+     * Read the data used by a run from the Data Repository. This is called
+     * on the simulator thread when the run is prepared, and does nothing by
+     * default.
+     */
+    virtual void ReadData();
+    /**
+     * Evaluate the data read by ReadData. This may be called on a worker
+     * thread, in parallel with other Logic Modules, so it must only use the
+     * state of this Logic Module: it must not use the Data Repository, log,
+     * nor create, copy or destroy the Ptr of ns-3 objects shared with the
+     * simulation. It does nothing by default.
+     */
+    virtual void Evaluate();
+    /**
+     * Generates the commands to provide to the Near-RT RIC from the
+     * evaluation of the data read by ReadData. This is called on the
+     * simulator thread when the run is completed.
      *
      * @return The generated commands.
      */
@@ -174,6 +296,22 @@ class OranLm : public Object
      * Commands that were generated.
      */
     std::vector<Ptr<OranCommand>> m_commands;
+    /**
+     * The delay to finish the prepared run.
+     */
+    Time m_runDelay;
+    /**
+     * The LM query cycle of the Near-RT RIC for the prepared run.
+     */
+    uint64_t m_runQueryCount{0};
+    /**
+     * The LM query cycle of the Near-RT RIC for the last completed run.
+     */
+    uint64_t m_lastRunQueryCount{0};
+    /**
+     * Flag that indicates that a run has been prepared and not completed.
+     */
+    bool m_runPrepared{false};
 }; // class OranLm
 
 } // namespace ns3
@@ -36,10 +36,6 @@
 #include "oran-e2-node-terminator-lte-ue.h"
 #include "oran-e2-node-terminator.h"
 #include "oran-near-rt-ric.h"
-#include "oran-report-apploss.h"
-#include "oran-report-location.h"
-#include "oran-report-lte-ue-cell-info.h"
-#include "oran-report-lte-ue-rsrp-rsrq.h"
 #include "oran-report.h"
 
 #include "ns3/abort.h"
@@ -195,43 +191,8 @@ OranNearRtRicE2Terminator::ReceiveReport(Ptr<OranReport> report)
             m_data == nullptr,
             "Attempting to use a null data repository in the Near-RT RIC E2 Terminator");
 
-        if (report->GetInstanceTypeId() == TypeId::LookupByName("ns3::OranReportLocation"))
-        {
-            Ptr<OranReportLocation> posRpt = report->GetObject<OranReportLocation>();
-            m_data->SavePosition(posRpt->GetReporterE2NodeId(),
-                                 posRpt->GetLocation(),
-                                 posRpt->GetTime());
-        }
-        else if (report->GetInstanceTypeId() ==
-                 TypeId::LookupByName("ns3::OranReportLteUeCellInfo"))
-        {
-            Ptr<OranReportLteUeCellInfo> lteUeCellInfoRpt =
-                report->GetObject<OranReportLteUeCellInfo>();
-            m_data->SaveLteUeCellInfo(lteUeCellInfoRpt->GetReporterE2NodeId(),
-                                      lteUeCellInfoRpt->GetCellId(),
-                                      lteUeCellInfoRpt->GetRnti(),
-                                      lteUeCellInfoRpt->GetTime());
-        }
-        else if (report->GetInstanceTypeId() == TypeId::LookupByName("ns3::OranReportAppLoss"))
-        {
-            Ptr<OranReportAppLoss> appLossRpt = report->GetObject<OranReportAppLoss>();
-            m_data->SaveAppLoss(appLossRpt->GetReporterE2NodeId(),
-                                appLossRpt->GetLoss(),
-                                appLossRpt->GetTime());
-        }
-        else if (report->GetInstanceTypeId() ==
-                 TypeId::LookupByName("ns3::OranReportLteUeRsrpRsrq"))
-        {
-            Ptr<OranReportLteUeRsrpRsrq> rsrpRsrqRpt = report->GetObject<OranReportLteUeRsrpRsrq>();
-            m_data->SaveLteUeRsrpRsrq(rsrpRsrqRpt->GetReporterE2NodeId(),
-                                      rsrpRsrqRpt->GetTime(),
-                                      rsrpRsrqRpt->GetRnti(),
-                                      rsrpRsrqRpt->GetCellId(),
-                                      rsrpRsrqRpt->GetRsrp(),
-                                      rsrpRsrqRpt->GetRsrq(),
-                                      rsrpRsrqRpt->GetIsServingCell(),
-                                      rsrpRsrqRpt->GetComponentCarrierId());
-        }
+        // Each type of report stores itself with the appropriate method
+        report->StoreIn(m_data);
 
         m_nearRtRic->NotifyReportReceived(report);
     }
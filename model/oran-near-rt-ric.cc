@@ -36,6 +36,7 @@
 #include "oran-lm.h"
 #include "oran-near-rt-ric-e2terminator.h"
 #include "oran-query-trigger.h"
+#include "oran-thread-pool.h"
 
 #include "ns3/abort.h"
 #include "ns3/enum.h"
@@ -43,7 +44,9 @@
 #include "ns3/pointer.h"
 #include "ns3/simulator.h"
 #include "ns3/string.h"
+#include "ns3/uinteger.h"
 
+#include <algorithm>
 #include <vector>
 
 namespace ns3
@@ -97,6 +100,12 @@ OranNearRtRic::GetTypeId()
                 EnumValue(OranNearRtRic::DROP),
                 MakeEnumAccessor<LateCommandPolicy>(&OranNearRtRic::m_lmQueryLateCommandPolicy),
                 MakeEnumChecker(OranNearRtRic::DROP, "DROP", OranNearRtRic::SAVE, "SAVE"))
+            .AddAttribute("LmThreads",
+                          "The number of worker threads used to run the Logic Modules of a query "
+                          "cycle in parallel. A value of \"0\" runs them one after another.",
+                          UintegerValue(0),
+                          MakeUintegerAccessor(&OranNearRtRic::m_lmThreads),
+                          MakeUintegerChecker<uint32_t>())
             .AddAttribute("E2NodeInactivityThreshold",
                           "The amount of time from a node's last registration request before "
                           "becoming inactive.",
@@ -119,7 +128,8 @@ OranNearRtRic::OranNearRtRic()
       m_active(false),
       m_lmQueryEvent(EventId()),
       m_e2NodeInactivityEvent(EventId()),
-      m_lmQueryCycle(Seconds(0))
+      m_lmQueryCycle(Seconds(0)),
+      m_lmQueryCount(0)
 {
     NS_LOG_FUNCTION(this);
 }
@@ -150,8 +160,16 @@ OranNearRtRic::Activate()
         m_active = true;
         // Activate the E2 Terminator
         m_e2Terminator->Activate();
-        // Activate the data repository
+        // Activate the data repository, and follow the registrations of the
+        // E2 Nodes, whoever makes them
         m_data->Activate();
+        m_data->TraceConnectWithoutContext(
+            "NodeRegistered",
+            MakeCallback(&OranNearRtRic::NotifyNodeRegistered, this));
+        m_data->TraceConnectWithoutContext(
+            "NodeDeregistered",
+            MakeCallback(&OranNearRtRic::NotifyNodeDeregistered, this));
+        LoadE2NodeRegistry();
         // Activate the default and additional Logic Modules
         m_defaultLm->Activate();
         for (auto entry : m_additionalLms)
@@ -185,6 +203,12 @@ OranNearRtRic::Deactivate()
         // Deactivate the E2 Terminator
         m_e2Terminator->Deactivate();
         // Deactivate the data repository
+        m_data->TraceDisconnectWithoutContext(
+            "NodeRegistered",
+            MakeCallback(&OranNearRtRic::NotifyNodeRegistered, this));
+        m_data->TraceDisconnectWithoutContext(
+            "NodeDeregistered",
+            MakeCallback(&OranNearRtRic::NotifyNodeDeregistered, this));
         m_data->Deactivate();
         // Deactivate the default and additional Logic Modules
         m_defaultLm->Deactivate();
@@ -216,6 +240,12 @@ OranNearRtRic::Start()
     NS_ABORT_MSG_IF(m_lmQueryEvent.IsPending(), "Near-RT RIC has already been started");
     NS_ABORT_MSG_IF(m_e2NodeInactivityEvent.IsPending(), "Near-RT RIC has already been started");
 
+    // The changes made while the RIC was stopped were not tracked, so a
+    // cycle is skipped to let the LMs know that they must evaluate all the
+    // nodes in their next run.
+    m_lmQueryCount++;
+    m_changedE2NodeIds.clear();
+
     m_lmQueryEvent = Simulator::Schedule(m_lmQueryInterval, &OranNearRtRic::QueryLms, this);
     m_e2NodeInactivityEvent = Simulator::Schedule(Seconds(m_e2NodeInactivityIntervalRv->GetValue()),
                                                   &OranNearRtRic::CheckForInactivity,
@@ -374,6 +404,30 @@ OranNearRtRic::Data() const
     return m_data;
 }
 
+OranThreadPool*
+OranNearRtRic::GetLmThreadPool() const
+{
+    NS_LOG_FUNCTION(this);
+
+    return m_lmThreads > 0 ? m_lmThreadPool.get() : nullptr;
+}
+
+uint64_t
+OranNearRtRic::GetLmQueryCount() const
+{
+    NS_LOG_FUNCTION(this);
+
+    return m_lmQueryCount;
+}
+
+const std::unordered_set<uint64_t>&
+OranNearRtRic::GetChangedE2NodeIds() const
+{
+    NS_LOG_FUNCTION(this);
+
+    return m_lmQueryChangedE2NodeIds;
+}
+
 Ptr<OranCmm>
 OranNearRtRic::GetCmm() const
 {
@@ -467,6 +521,8 @@ OranNearRtRic::NotifyReportReceived(Ptr<OranReport> report)
 
     NS_LOG_LOGIC("Near-RT RIC received a report");
 
+    m_changedE2NodeIds.insert(report->GetReporterE2NodeId());
+
     bool queryLms = false;
 
     for (auto qtrigger : m_queryTriggers)
@@ -498,6 +554,16 @@ OranNearRtRic::DoDispose()
 {
     NS_LOG_FUNCTION(this);
 
+    if (m_active && m_data != nullptr)
+    {
+        m_data->TraceDisconnectWithoutContext(
+            "NodeRegistered",
+            MakeCallback(&OranNearRtRic::NotifyNodeRegistered, this));
+        m_data->TraceDisconnectWithoutContext(
+            "NodeDeregistered",
+            MakeCallback(&OranNearRtRic::NotifyNodeDeregistered, this));
+    }
+
     m_e2Terminator = nullptr;
     m_data = nullptr;
     m_defaultLm = nullptr;
@@ -511,6 +577,11 @@ OranNearRtRic::DoDispose()
     m_cmm = nullptr;
 
     m_lmQueryCommands.clear();
+    m_lmThreadPool.reset();
+    m_changedE2NodeIds.clear();
+    m_lmQueryChangedE2NodeIds.clear();
+    m_e2NodeLastRegistration.clear();
+    m_e2NodeRegistrationHeap = decltype(m_e2NodeRegistrationHeap)();
 
     Object::DoDispose();
 }
@@ -542,6 +613,12 @@ OranNearRtRic::QueryLms()
         // in active.
         CheckForInactivity();
 
+        // Take the nodes that changed since the previous cycle, including the
+        // ones that were just deregistered, for this cycle.
+        m_lmQueryCount++;
+        m_lmQueryChangedE2NodeIds.swap(m_changedE2NodeIds);
+        m_changedE2NodeIds.clear();
+
         if (m_lmQueryMaxWaitTime > Seconds(0))
         {
             m_processLmQueryCommandsEvent =
@@ -550,32 +627,58 @@ OranNearRtRic::QueryLms()
                                     this);
         }
 
-        // Check if LM is still running.
-        if (m_defaultLm->IsRunning())
+        // The default LM runs first, followed by all the additional LMs.
+        std::vector<Ptr<OranLm>> lms = {m_defaultLm};
+        for (const auto& lm : m_additionalLms)
         {
-            // Cancel the current process.
-            m_defaultLm->CancelRun();
-            NS_LOG_WARN("Near-RT RIC canceled run for \""
-                        << m_defaultLm->GetName()
-                        << "\" because it had not finished running by next query cycle");
+            lms.push_back(lm.second);
         }
 
-        // Signal default LM to run
-        m_defaultLm->Run(m_lmQueryCycle);
+        bool parallel = m_lmThreads > 0;
+        std::vector<std::function<void()>> lmRuns;
 
-        // Signal all additional LMs to run.
-        for (auto lm : m_additionalLms)
+        if (parallel &&
+            (m_lmThreadPool == nullptr || m_lmThreadPool->GetNThreads() != m_lmThreads))
+        {
+            m_lmThreadPool = std::make_unique<OranThreadPool>(m_lmThreads);
+        }
+
+        for (const auto& lm : lms)
         {
             // Check if LM is still running.
-            if (lm.second->IsRunning())
+            if (lm->IsRunning())
             {
                 // Cancel the current process.
-                lm.second->CancelRun();
+                lm->CancelRun();
                 NS_LOG_WARN("Near-RT RIC canceled run for \""
-                            << lm.second->GetName()
+                            << lm->GetName()
                             << "\" because it had not finished running by next query cycle");
             }
-            lm.second->Run(m_lmQueryCycle);
+
+            // Signal LM to run, reading its data in order.
+            if (lm->PrepareRun(m_lmQueryCycle))
+            {
+                lmRuns.push_back([lm]() { lm->ExecuteRun(); });
+            }
+        }
+
+        // Only the evaluations of the LMs run in parallel, so the commands
+        // and logs are generated in the same order as in a serial run.
+        if (parallel)
+        {
+            m_lmThreadPool->Run(lmRuns);
+        }
+        else
+        {
+            for (const auto& lmRun : lmRuns)
+            {
+                lmRun();
+            }
+        }
+
+        for (const auto& lm : lms)
+        {
+            lm->CompleteRun();
         }
 
         m_lmQueryEvent = Simulator::Schedule(m_lmQueryInterval, &OranNearRtRic::QueryLms, this);
@@ -598,27 +701,36 @@ OranNearRtRic::CheckForInactivity()
 
         NS_LOG_LOGIC("Near-RT RIC checking for E2 Node inactivity");
 
-        std::vector<std::tuple<uint64_t, Time>> lastRegistrations =
-            m_data->GetLastRegistrationRequests();
-
-        for (auto lastreg : lastRegistrations)
+        // Only the registration requests older than the threshold are visited
+        Time now = Simulator::Now();
+        std::vector<uint64_t> inactiveE2NodeIds;
+        while (!m_e2NodeRegistrationHeap.empty() &&
+               now - m_e2NodeRegistrationHeap.top().first > m_e2NodeInactivityThreshold)
         {
-            uint64_t e2NodeId;
             Time registrationTime;
+            uint64_t e2NodeId;
 
-            std::tie(e2NodeId, registrationTime) = lastreg;
-
-            Time inactivityPeriod = Simulator::Now() - registrationTime;
+            std::tie(registrationTime, e2NodeId) = m_e2NodeRegistrationHeap.top();
+            m_e2NodeRegistrationHeap.pop();
 
-            if (inactivityPeriod > m_e2NodeInactivityThreshold)
+            auto it = m_e2NodeLastRegistration.find(e2NodeId);
+            if (it != m_e2NodeLastRegistration.end() && it->second == registrationTime)
             {
                 NS_LOG_LOGIC("Near-RT RIC deactivating E2 Node with ID "
                              << e2NodeId << " that has not registered in "
-                             << inactivityPeriod.GetSeconds() << " s");
-                m_e2Terminator->ReceiveDeregistrationRequest(e2NodeId);
+                             << (now - registrationTime).GetSeconds() << " s");
+                m_e2NodeLastRegistration.erase(it);
+                inactiveE2NodeIds.push_back(e2NodeId);
             }
         }
 
+        // Deregister the nodes in order of E2 Node ID
+        std::sort(inactiveE2NodeIds.begin(), inactiveE2NodeIds.end());
+        for (auto e2NodeId : inactiveE2NodeIds)
+        {
+            m_e2Terminator->ReceiveDeregistrationRequest(e2NodeId);
+        }
+
         if (m_e2NodeInactivityEvent.IsPending())
         {
             m_e2NodeInactivityEvent.Cancel();
@@ -631,6 +743,55 @@ OranNearRtRic::CheckForInactivity()
     }
 }
 
+void
+OranNearRtRic::NotifyNodeRegistered(uint64_t e2NodeId)
+{
+    NS_LOG_FUNCTION(this << e2NodeId);
+
+    Time now = Simulator::Now();
+
+    auto inserted = m_e2NodeLastRegistration.emplace(e2NodeId, now);
+    if (inserted.second)
+    {
+        m_changedE2NodeIds.insert(e2NodeId);
+    }
+    else
+    {
+        inserted.first->second = now;
+    }
+    m_e2NodeRegistrationHeap.emplace(now, e2NodeId);
+}
+
+void
+OranNearRtRic::NotifyNodeDeregistered(uint64_t e2NodeId)
+{
+    NS_LOG_FUNCTION(this << e2NodeId);
+
+    // The entries of the node in the heap become stale
+    m_e2NodeLastRegistration.erase(e2NodeId);
+    m_changedE2NodeIds.insert(e2NodeId);
+}
+
+void
+OranNearRtRic::LoadE2NodeRegistry()
+{
+    NS_LOG_FUNCTION(this);
+
+    m_e2NodeLastRegistration.clear();
+    m_e2NodeRegistrationHeap = decltype(m_e2NodeRegistrationHeap)();
+
+    for (const auto& lastReg : m_data->GetLastRegistrationRequests())
+    {
+        uint64_t e2NodeId;
+        Time registrationTime;
+
+        std::tie(e2NodeId, registrationTime) = lastReg;
+
+        m_e2NodeLastRegistration[e2NodeId] = registrationTime;
+        m_e2NodeRegistrationHeap.emplace(registrationTime, e2NodeId);
+    }
+}
+
 void
 OranNearRtRic::ProcessLmQueryCommands()
 {
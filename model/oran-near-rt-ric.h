@@ -36,7 +36,14 @@
 #include "ns3/object.h"
 #include "ns3/random-variable-stream.h"
 
+#include <functional>
 #include <map>
+#include <memory>
+#include <queue>
+#include <unordered_map>
+#include <unordered_set>
+#include <utility>
+#include <vector>
 
 namespace ns3
 {
@@ -48,6 +55,7 @@ class OranDataRepository;
 class OranNearRtRicE2Terminator;
 class OranQueryTrigger;
 class OranReport;
+class OranThreadPool;
 
 /**
  * @defgroup oran O-RAN architecture
@@ -77,6 +85,13 @@ class OranReport;
  * Similarly, an instance of the Conflict Mitigation Module must always be present.
  *
  * Additional Logic Modules can be added and removed during the simulation.
+ *
+ * The Logic Modules are run one after another by default. With the
+ * "LmThreads" attribute, the evaluations of a query cycle are instead run in
+ * parallel by a pool of worker threads, while the simulator thread waits.
+ * The Logic Modules read their data from the Data Repository before, and
+ * generate their commands and logs after, in their order on the simulator
+ * thread, so they produce the same commands and logs as in a serial run.
  */
 class OranNearRtRic : public Object
 {
@@ -231,6 +246,29 @@ class OranNearRtRic : public Object
      * @return A pointer to the Data Repository instance.
      */
     Ptr<OranDataRepository> Data() const;
+    /**
+     * Get the pool of worker threads used to run the Logic Modules in
+     * parallel, which they can also use to parallelize their own logic.
+     *
+     * @return The pool, or nullptr if the Logic Modules are run one after another.
+     */
+    OranThreadPool* GetLmThreadPool() const;
+    /**
+     * Get the number of LM query cycles that have started, which identifies
+     * the current cycle.
+     *
+     * @return The number of LM query cycles.
+     */
+    uint64_t GetLmQueryCount() const;
+    /**
+     * Get the IDs of the E2 Nodes that sent a report, registered, or were
+     * deregistered between the start of the previous LM query cycle and the
+     * start of the current one, so that the Logic Modules can skip the nodes
+     * whose data has not changed.
+     *
+     * @return The IDs of the E2 Nodes that changed.
+     */
+    const std::unordered_set<uint64_t>& GetChangedE2NodeIds() const;
     /**
      * Get the Conflict Mitigation Module.
      *
@@ -276,6 +314,28 @@ class OranNearRtRic : public Object
      * Function that checks for node inactivity.
      */
     void CheckForInactivity();
+    /**
+     * Trace sink for the registrations of the Data Repository. The inactivity
+     * deadline of the node is extended, and, if the node was not registered,
+     * it is marked as changed for the next LM query cycle.
+     *
+     * @param e2NodeId The E2 Node ID of the node.
+     */
+    void NotifyNodeRegistered(uint64_t e2NodeId);
+    /**
+     * Trace sink for the deregistrations of the Data Repository. The node is
+     * no longer checked for inactivity, and it is marked as changed for the
+     * next LM query cycle.
+     *
+     * @param e2NodeId The E2 Node ID of the node.
+     */
+    void NotifyNodeDeregistered(uint64_t e2NodeId);
+    /**
+     * Load the last registration request of every registered E2 Node from the
+     * Data Repository into the in-memory registry used to check for
+     * inactivity.
+     */
+    void LoadE2NodeRegistry();
     /**
      * Processes the commands received for this LM query cycle.
      */
@@ -326,10 +386,39 @@ class OranNearRtRic : public Object
      * The random variable used to periodically schedule checks for node inactivity.
      */
     Ptr<RandomVariableStream> m_e2NodeInactivityIntervalRv;
+    /**
+     * The time of the last registration request of each registered E2 Node,
+     * indexed by E2 Node ID.
+     */
+    std::unordered_map<uint64_t, Time> m_e2NodeLastRegistration;
+    /**
+     * Min-heap with the registration requests, ordered by time, so that the
+     * nodes whose inactivity threshold expired are found without visiting
+     * the rest. Entries older than the last registration request of their
+     * node are stale, and are discarded when they reach the top.
+     */
+    std::priority_queue<std::pair<Time, uint64_t>,
+                        std::vector<std::pair<Time, uint64_t>>,
+                        std::greater<std::pair<Time, uint64_t>>>
+        m_e2NodeRegistrationHeap;
     /**
      * The current LM query cycle.
      */
     Time m_lmQueryCycle;
+    /**
+     * The number of LM query cycles that have started.
+     */
+    uint64_t m_lmQueryCount;
+    /**
+     * The IDs of the E2 Nodes that changed since the start of the current LM
+     * query cycle.
+     */
+    std::unordered_set<uint64_t> m_changedE2NodeIds;
+    /**
+     * The IDs of the E2 Nodes that changed between the start of the previous
+     * LM query cycle and the start of the current one.
+     */
+    std::unordered_set<uint64_t> m_lmQueryChangedE2NodeIds;
     /**
      * The maximum amount of time to wait for a Logic Module to finish running.
      */
@@ -350,6 +439,14 @@ class OranNearRtRic : public Object
      * The vector of LM query triggers, indexed by their names.
      */
     std::map<std::string, Ptr<OranQueryTrigger>> m_queryTriggers;
+    /**
+     * The number of worker threads used to run the Logic Modules in parallel.
+     */
+    uint32_t m_lmThreads;
+    /**
+     * The pool of worker threads used to run the Logic Modules in parallel.
+     */
+    std::unique_ptr<OranThreadPool> m_lmThreadPool;
 }; // class OranNearRtRic
 
 } // namespace ns3
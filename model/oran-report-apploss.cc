@@ -30,6 +30,7 @@
 
 #include "oran-report-apploss.h"
 
+#include "oran-data-repository.h"
 #include "oran-report.h"
 
 #include "ns3/abort.h"
@@ -82,6 +83,14 @@ OranReportAppLoss::ToString() const
     return ss.str();
 }
 
+void
+OranReportAppLoss::StoreIn(Ptr<OranDataRepository> data) const
+{
+    NS_LOG_FUNCTION(this << data);
+
+    data->SaveAppLoss(GetReporterE2NodeId(), GetLoss(), GetTime());
+}
+
 double
 OranReportAppLoss::GetLoss() const
 {
@@ -90,4 +99,12 @@ OranReportAppLoss::GetLoss() const
     return m_loss;
 }
 
+void
+OranReportAppLoss::SetLoss(double loss)
+{
+    NS_LOG_FUNCTION(this << loss);
+
+    m_loss = loss;
+}
+
 } // namespace ns3
@@ -66,12 +66,24 @@ class OranReportAppLoss : public OranReport
      * @return A string representation of this Report.
      */
     std::string ToString() const override;
+    /**
+     * Store the content of this Report in a Data Repository.
+     *
+     * @param data The Data Repository.
+     */
+    void StoreIn(Ptr<OranDataRepository> data) const override;
     /**
      * Gets the reported application packet loss.
      *
      * @return The reported application packet loss.
      */
     double GetLoss() const;
+    /**
+     * Sets the reported application packet loss.
+     *
+     * @param loss The reported application packet loss.
+     */
+    void SetLoss(double loss);
 
   private:
     /**
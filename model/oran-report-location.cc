@@ -30,6 +30,7 @@
 
 #include "oran-report-location.h"
 
+#include "oran-data-repository.h"
 #include "oran-report.h"
 
 #include "ns3/log.h"
@@ -84,6 +85,14 @@ OranReportLocation::ToString() const
     return ss.str();
 }
 
+void
+OranReportLocation::StoreIn(Ptr<OranDataRepository> data) const
+{
+    NS_LOG_FUNCTION(this << data);
+
+    data->SavePosition(GetReporterE2NodeId(), GetLocation(), GetTime());
+}
+
 Vector
 OranReportLocation::GetLocation() const
 {
@@ -92,4 +101,12 @@ OranReportLocation::GetLocation() const
     return m_location;
 }
 
+void
+OranReportLocation::SetLocation(Vector location)
+{
+    NS_LOG_FUNCTION(this << location);
+
+    m_location = location;
+}
+
 } // namespace ns3
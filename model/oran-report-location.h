@@ -69,6 +69,12 @@ class OranReportLocation : public OranReport
      * @return A string representation of this Report.
      */
     std::string ToString() const override;
+    /**
+     * Store the content of this Report in a Data Repository.
+     *
+     * @param data The Data Repository.
+     */
+    void StoreIn(Ptr<OranDataRepository> data) const override;
 
   private:
     /**
@@ -83,6 +89,12 @@ class OranReportLocation : public OranReport
      * @return The reported location.
      */
     Vector GetLocation() const;
+    /**
+     * Set the reported location.
+     *
+     * @param location The reported location.
+     */
+    void SetLocation(Vector location);
 }; // class OranReportLocation
 
 } // namespace ns3
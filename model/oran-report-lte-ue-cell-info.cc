@@ -30,6 +30,7 @@
 
 #include "oran-report-lte-ue-cell-info.h"
 
+#include "oran-data-repository.h"
 #include "oran-report.h"
 
 #include "ns3/log.h"
@@ -90,6 +91,14 @@ OranReportLteUeCellInfo::ToString() const
     return ss.str();
 }
 
+void
+OranReportLteUeCellInfo::StoreIn(Ptr<OranDataRepository> data) const
+{
+    NS_LOG_FUNCTION(this << data);
+
+    data->SaveLteUeCellInfo(GetReporterE2NodeId(), GetCellId(), GetRnti(), GetTime());
+}
+
 uint16_t
 OranReportLteUeCellInfo::GetCellId() const
 {
@@ -98,6 +107,14 @@ OranReportLteUeCellInfo::GetCellId() const
     return m_cellId;
 }
 
+void
+OranReportLteUeCellInfo::SetCellId(uint16_t cellId)
+{
+    NS_LOG_FUNCTION(this << cellId);
+
+    m_cellId = cellId;
+}
+
 uint16_t
 OranReportLteUeCellInfo::GetRnti() const
 {
@@ -106,4 +123,12 @@ OranReportLteUeCellInfo::GetRnti() const
     return m_rnti;
 }
 
+void
+OranReportLteUeCellInfo::SetRnti(uint16_t rnti)
+{
+    NS_LOG_FUNCTION(this << rnti);
+
+    m_rnti = rnti;
+}
+
 } // namespace ns3
@@ -66,6 +66,12 @@ class OranReportLteUeCellInfo : public OranReport
      * @return A string representation of this Report.
      */
     std::string ToString() const override;
+    /**
+     * Store the content of this Report in a Data Repository.
+     *
+     * @param data The Data Repository.
+     */
+    void StoreIn(Ptr<OranDataRepository> data) const override;
 
   private:
     /**
@@ -84,12 +90,24 @@ class OranReportLteUeCellInfo : public OranReport
      * @return The reported cell ID.
      */
     uint16_t GetCellId() const;
+    /**
+     * Set the reported cell ID.
+     *
+     * @param cellId The reported cell ID.
+     */
+    void SetCellId(uint16_t cellId);
     /**
      * Get the reported RNTI.
      *
      * @return The reported RNTI.
      */
     uint16_t GetRnti() const;
+    /**
+     * Set the reported RNTI.
+     *
+     * @param rnti The reported RNTI.
+     */
+    void SetRnti(uint16_t rnti);
 }; // class OranReportLteUeCellInfo
 
 } // namespace ns3
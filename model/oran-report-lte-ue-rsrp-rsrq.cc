@@ -30,6 +30,7 @@
 
 #include "oran-report-lte-ue-rsrp-rsrq.h"
 
+#include "oran-data-repository.h"
 #include "oran-report.h"
 
 #include "ns3/abort.h"
@@ -112,6 +113,21 @@ OranReportLteUeRsrpRsrq::ToString() const
     return ss.str();
 }
 
+void
+OranReportLteUeRsrpRsrq::StoreIn(Ptr<OranDataRepository> data) const
+{
+    NS_LOG_FUNCTION(this << data);
+
+    data->SaveLteUeRsrpRsrq(GetReporterE2NodeId(),
+                            GetTime(),
+                            GetRnti(),
+                            GetCellId(),
+                            GetRsrp(),
+                            GetRsrq(),
+                            GetIsServingCell(),
+                            GetComponentCarrierId());
+}
+
 uint16_t
 OranReportLteUeRsrpRsrq::GetRnti() const
 {
@@ -120,6 +136,14 @@ OranReportLteUeRsrpRsrq::GetRnti() const
     return m_rnti;
 }
 
+void
+OranReportLteUeRsrpRsrq::SetRnti(uint16_t rnti)
+{
+    NS_LOG_FUNCTION(this << rnti);
+
+    m_rnti = rnti;
+}
+
 uint16_t
 OranReportLteUeRsrpRsrq::GetCellId() const
 {
@@ -128,6 +152,14 @@ OranReportLteUeRsrpRsrq::GetCellId() const
     return m_cellId;
 }
 
+void
+OranReportLteUeRsrpRsrq::SetCellId(uint16_t cellId)
+{
+    NS_LOG_FUNCTION(this << cellId);
+
+    m_cellId = cellId;
+}
+
 double
 OranReportLteUeRsrpRsrq::GetRsrp() const
 {
@@ -136,6 +168,14 @@ OranReportLteUeRsrpRsrq::GetRsrp() const
     return m_rsrp;
 }
 
+void
+OranReportLteUeRsrpRsrq::SetRsrp(double rsrp)
+{
+    NS_LOG_FUNCTION(this << rsrp);
+
+    m_rsrp = rsrp;
+}
+
 double
 OranReportLteUeRsrpRsrq::GetRsrq() const
 {
@@ -144,6 +184,14 @@ OranReportLteUeRsrpRsrq::GetRsrq() const
     return m_rsrq;
 }
 
+void
+OranReportLteUeRsrpRsrq::SetRsrq(double rsrq)
+{
+    NS_LOG_FUNCTION(this << rsrq);
+
+    m_rsrq = rsrq;
+}
+
 bool
 OranReportLteUeRsrpRsrq::GetIsServingCell() const
 {
@@ -152,6 +200,14 @@ OranReportLteUeRsrpRsrq::GetIsServingCell() const
     return m_isServingCell;
 }
 
+void
+OranReportLteUeRsrpRsrq::SetIsServingCell(bool isServingCell)
+{
+    NS_LOG_FUNCTION(this << isServingCell);
+
+    m_isServingCell = isServingCell;
+}
+
 uint16_t
 OranReportLteUeRsrpRsrq::GetComponentCarrierId() const
 {
@@ -160,4 +216,12 @@ OranReportLteUeRsrpRsrq::GetComponentCarrierId() const
     return m_componentCarrierId;
 }
 
+void
+OranReportLteUeRsrpRsrq::SetComponentCarrierId(uint16_t componentCarrierId)
+{
+    NS_LOG_FUNCTION(this << componentCarrierId);
+
+    m_componentCarrierId = componentCarrierId;
+}
+
 } // namespace ns3
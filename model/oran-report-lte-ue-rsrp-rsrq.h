@@ -66,42 +66,84 @@ class OranReportLteUeRsrpRsrq : public OranReport
      * @return A string representation of this Report.
      */
     std::string ToString() const override;
+    /**
+     * Store the content of this Report in a Data Repository.
+     *
+     * @param data The Data Repository.
+     */
+    void StoreIn(Ptr<OranDataRepository> data) const override;
     /**
      * Gets the RNTI.
      *
      * @return The RNTI.
      */
     uint16_t GetRnti() const;
+    /**
+     * Sets the RNTI.
+     *
+     * @param rnti The RNTI.
+     */
+    void SetRnti(uint16_t rnti);
     /**
      * Gets the cell ID.
      *
      * @return The cell ID.
      */
     uint16_t GetCellId() const;
+    /**
+     * Sets the cell ID.
+     *
+     * @param cellId The cell ID.
+     */
+    void SetCellId(uint16_t cellId);
     /**
      * Gets the reported RSRP.
      *
      * @return The reported RSRP.
      */
     double GetRsrp() const;
+    /**
+     * Sets the reported RSRP.
+     *
+     * @param rsrp The reported RSRP.
+     */
+    void SetRsrp(double rsrp);
     /**
      * Gets the reported RSRQ.
      *
      * @return The reported RSRQ.
      */
     double GetRsrq() const;
+    /**
+     * Sets the reported RSRQ.
+     *
+     * @param rsrq The reported RSRQ.
+     */
+    void SetRsrq(double rsrq);
     /**
      * Gets the flag that indicates if this is for the serving cell.
      *
      * @return The flag.
      */
     bool GetIsServingCell() const;
+    /**
+     * Sets the flag that indicates if this is for the serving cell.
+     *
+     * @param isServingCell The flag.
+     */
+    void SetIsServingCell(bool isServingCell);
     /**
      * Gets the component carrier ID.
      *
      * @return The component carrier ID.
      */
     uint16_t GetComponentCarrierId() const;
+    /**
+     * Sets the component carrier ID.
+     *
+     * @param componentCarrierId The component carrier ID.
+     */
+    void SetComponentCarrierId(uint16_t componentCarrierId);
 
   private:
     /**
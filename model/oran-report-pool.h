@@ -0,0 +1,134 @@
+/**
+ * NIST-developed software is provided by NIST as a public service. You may
+ * use, copy and distribute copies of the software in any medium, provided that
+ * you keep intact this entire notice. You may improve, modify and create
+ * derivative works of the software or any portion of the software, and you may
+ * copy and distribute such modifications or works. Modified works should carry
+ * a notice stating that you changed the software and should note the date and
+ * nature of any such change. Please explicitly acknowledge the National
+ * Institute of Standards and Technology as the source of the software.
+ *
+ * NIST-developed software is expressly provided "AS IS." NIST MAKES NO
+ * WARRANTY OF ANY KIND, EXPRESS, IMPLIED, IN FACT OR ARISING BY OPERATION OF
+ * LAW, INCLUDING, WITHOUT LIMITATION, THE IMPLIED WARRANTY OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE, NON-INFRINGEMENT AND DATA ACCURACY. NIST
+ * NEITHER REPRESENTS NOR WARRANTS THAT THE OPERATION OF THE SOFTWARE WILL BE
+ * UNINTERRUPTED OR ERROR-FREE, OR THAT ANY DEFECTS WILL BE CORRECTED. NIST
+ * DOES NOT WARRANT OR MAKE ANY REPRESENTATIONS REGARDING THE USE OF THE
+ * SOFTWARE OR THE RESULTS THEREOF, INCLUDING BUT NOT LIMITED TO THE
+ * CORRECTNESS, ACCURACY, RELIABILITY, OR USEFULNESS OF THE SOFTWARE.
+ *
+ * You are solely responsible for determining the appropriateness of using and
+ * distributing the software and you assume all risks associated with its use,
+ * including but not limited to the risks and costs of program errors,
+ * compliance with applicable laws, damage to or loss of data, programs or
+ * equipment, and the unavailability or interruption of operation. This
+ * software is not intended to be used in any situation where a failure could
+ * cause risk of injury or damage to property. The software developed by NIST
+ * employees is not subject to copyright protection within the United States.
+ */
+
+#ifndef ORAN_REPORT_POOL_H
+#define ORAN_REPORT_POOL_H
+
+#include "ns3/object.h"
+#include "ns3/ptr.h"
+
+#include <algorithm>
+#include <cstddef>
+#include <vector>
+
+namespace ns3
+{
+
+/**
+ * @ingroup oran
+ *
+ * Pool of Reports of a given type, used by the Reporters that generate many
+ * Reports to recycle the ones that are no longer in use, instead of creating
+ * a new one for each measurement.
+ *
+ * A Report is no longer in use once the pool holds the only reference to it,
+ * that is, once it has been sent to the Near-RT RIC and stored in the Data
+ * Repository, and nothing else, such as a query trigger, kept it. The pool
+ * checks its Reports in the order they were handed out, since they are
+ * usually released in that order, and creates a new Report when the oldest
+ * ones are still in use. A recycled Report keeps the values of its last use,
+ * so all of them must be set again.
+ */
+template <typename T>
+class OranReportPool
+{
+  public:
+    /**
+     * The maximum number of Reports checked for reuse in each call to Get.
+     */
+    static constexpr std::size_t MAX_PROBES = 8;
+
+    /**
+     * Constructor of the OranReportPool class.
+     *
+     * @param capacity The maximum number of Reports kept for reuse.
+     */
+    OranReportPool(std::size_t capacity = 4096)
+        : m_capacity(capacity),
+          m_next(0)
+    {
+    }
+
+    /**
+     * Get a Report that is not in use, either recycled or new.
+     *
+     * @return The Report.
+     */
+    Ptr<T> Get()
+    {
+        std::size_t probes = std::min(m_reports.size(), MAX_PROBES);
+        for (std::size_t i = 0; i < probes; i++)
+        {
+            const Ptr<T>& report = m_reports[m_next];
+            m_next = (m_next + 1) % m_reports.size();
+            if (report->GetReferenceCount() == 1)
+            {
+                return report;
+            }
+        }
+
+        Ptr<T> report = CreateObject<T>();
+        if (m_reports.size() < m_capacity)
+        {
+            // The new Report is the last one to be checked
+            m_reports.insert(m_reports.begin() + m_next, report);
+            m_next = (m_next + 1) % m_reports.size();
+        }
+        return report;
+    }
+
+    /**
+     * Release all the Reports of the pool.
+     */
+    void Clear()
+    {
+        m_reports.clear();
+        m_next = 0;
+    }
+
+  private:
+    /**
+     * The maximum number of Reports kept for reuse.
+     */
+    std::size_t m_capacity;
+    /**
+     * The Reports kept for reuse, in the order they are checked, starting
+     * at m_next.
+     */
+    std::vector<Ptr<T>> m_reports;
+    /**
+     * The index of the next Report to check.
+     */
+    std::size_t m_next;
+}; // class OranReportPool
+
+} // namespace ns3
+
+#endif /* ORAN_REPORT_POOL_H */
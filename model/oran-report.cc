@@ -30,6 +30,8 @@
 
 #include "oran-report.h"
 
+#include "oran-data-repository.h"
+
 #include "ns3/log.h"
 #include "ns3/uinteger.h"
 
@@ -79,6 +81,12 @@ OranReport::ToString() const
     return "Parent OranReport. Should not be used.";
 }
 
+void
+OranReport::StoreIn(Ptr<OranDataRepository> data) const
+{
+    NS_LOG_FUNCTION(this << data);
+}
+
 uint64_t
 OranReport::GetReporterE2NodeId() const
 {
@@ -87,6 +95,14 @@ OranReport::GetReporterE2NodeId() const
     return m_reporterE2NodeId;
 }
 
+void
+OranReport::SetReporterE2NodeId(uint64_t e2NodeId)
+{
+    NS_LOG_FUNCTION(this << e2NodeId);
+
+    m_reporterE2NodeId = e2NodeId;
+}
+
 Time
 OranReport::GetTime() const
 {
@@ -95,4 +111,12 @@ OranReport::GetTime() const
     return m_time;
 }
 
+void
+OranReport::SetTime(Time time)
+{
+    NS_LOG_FUNCTION(this << time);
+
+    m_time = time;
+}
+
 } // namespace ns3
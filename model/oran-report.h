@@ -39,6 +39,8 @@
 namespace ns3
 {
 
+class OranDataRepository;
+
 /**
  * @ingroup oran
  *
@@ -71,18 +73,39 @@ class OranReport : public Object
      * @return A string representation of this Report.
      */
     virtual std::string ToString() const;
+    /**
+     * Store the content of this Report in a Data Repository. Each type of
+     * Report stores itself with the appropriate method of the repository, so
+     * that the Near-RT RIC does not need to check its type. The base
+     * implementation stores nothing.
+     *
+     * @param data The Data Repository.
+     */
+    virtual void StoreIn(Ptr<OranDataRepository> data) const;
     /**
      * Get the E2 Node ID of the reporter.
      *
      * @return The E2 Node ID of the reporter.
      */
     uint64_t GetReporterE2NodeId() const;
+    /**
+     * Set the E2 Node ID of the reporter.
+     *
+     * @param e2NodeId The E2 Node ID of the reporter.
+     */
+    void SetReporterE2NodeId(uint64_t e2NodeId);
     /**
      * Get the Time at which the Report was generated.
      *
      * @return The Time at which the Report was generated.
      */
     Time GetTime() const;
+    /**
+     * Set the Time at which the Report was generated.
+     *
+     * @param time The Time at which the Report was generated.
+     */
+    void SetTime(Time time);
 
   private:
     /**
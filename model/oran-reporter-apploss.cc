@@ -34,11 +34,9 @@
 
 #include "ns3/abort.h"
 #include "ns3/address.h"
-#include "ns3/double.h"
 #include "ns3/log.h"
 #include "ns3/packet.h"
 #include "ns3/simulator.h"
-#include "ns3/uinteger.h"
 
 namespace ns3
 {
@@ -69,6 +67,16 @@ OranReporterAppLoss::~OranReporterAppLoss()
     NS_LOG_FUNCTION(this);
 }
 
+void
+OranReporterAppLoss::DoDispose()
+{
+    NS_LOG_FUNCTION(this);
+
+    m_reportPool.Clear();
+
+    OranReporter::DoDispose();
+}
+
 void
 OranReporterAppLoss::AddTx(Ptr<const Packet> p)
 {
@@ -104,10 +112,10 @@ OranReporterAppLoss::GenerateReports()
             loss = static_cast<double>(m_tx - m_rx) / static_cast<double>(m_tx);
         }
 
-        Ptr<OranReportAppLoss> lossReport = CreateObject<OranReportAppLoss>();
-        lossReport->SetAttribute("ReporterE2NodeId", UintegerValue(m_terminator->GetE2NodeId()));
-        lossReport->SetAttribute("Time", TimeValue(Simulator::Now()));
-        lossReport->SetAttribute("Loss", DoubleValue(loss));
+        Ptr<OranReportAppLoss> lossReport = m_reportPool.Get();
+        lossReport->SetReporterE2NodeId(m_terminator->GetE2NodeId());
+        lossReport->SetTime(Simulator::Now());
+        lossReport->SetLoss(loss);
 
         reports.push_back(lossReport);
         m_tx = 0;
@@ -31,6 +31,8 @@
 #ifndef ORAN_REPORTER_APPLOSS
 #define ORAN_REPORTER_APPLOSS
 
+#include "oran-report-apploss.h"
+#include "oran-report-pool.h"
 #include "oran-report.h"
 #include "oran-reporter.h"
 
@@ -81,6 +83,10 @@ class OranReporterAppLoss : public OranReporter
     void AddRx(Ptr<const Packet> p, const Address& from);
 
   protected:
+    /**
+     * Dispose of the Reporter, releasing the reports kept for reuse.
+     */
+    void DoDispose() override;
     /**
      * Capture the application packet loss and instantiate an OranReportAppLoss.
      *
@@ -97,6 +103,10 @@ class OranReporterAppLoss : public OranReporter
      * The number of recived packets.
      */
     uint64_t m_rx;
+    /**
+     * The pool used to recycle the Reports.
+     */
+    OranReportPool<OranReportAppLoss> m_reportPool;
 };
 
 } // namespace ns3
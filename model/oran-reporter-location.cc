@@ -36,7 +36,6 @@
 #include "ns3/log.h"
 #include "ns3/mobility-model.h"
 #include "ns3/simulator.h"
-#include "ns3/uinteger.h"
 
 namespace ns3
 {
@@ -66,6 +65,16 @@ OranReporterLocation::~OranReporterLocation()
     NS_LOG_FUNCTION(this);
 }
 
+void
+OranReporterLocation::DoDispose()
+{
+    NS_LOG_FUNCTION(this);
+
+    m_reportPool.Clear();
+
+    OranReporter::DoDispose();
+}
+
 std::vector<Ptr<OranReport>>
 OranReporterLocation::GenerateReports()
 {
@@ -78,11 +87,10 @@ OranReporterLocation::GenerateReports()
                         "Attempting to generate reports in reporter with NULL E2 Terminator");
         Ptr<MobilityModel> mobility = m_terminator->GetNode()->GetObject<MobilityModel>();
 
-        Ptr<OranReportLocation> locationReport = CreateObject<OranReportLocation>();
-        locationReport->SetAttribute("ReporterE2NodeId",
-                                     UintegerValue(m_terminator->GetE2NodeId()));
-        locationReport->SetAttribute("Location", VectorValue(mobility->GetPosition()));
-        locationReport->SetAttribute("Time", TimeValue(Simulator::Now()));
+        Ptr<OranReportLocation> locationReport = m_reportPool.Get();
+        locationReport->SetReporterE2NodeId(m_terminator->GetE2NodeId());
+        locationReport->SetLocation(mobility->GetPosition());
+        locationReport->SetTime(Simulator::Now());
 
         reports.push_back(locationReport);
     }
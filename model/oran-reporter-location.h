@@ -31,6 +31,8 @@
 #ifndef ORAN_REPORTER_LOCATION_H
 #define ORAN_REPORTER_LOCATION_H
 
+#include "oran-report-location.h"
+#include "oran-report-pool.h"
 #include "oran-report.h"
 #include "oran-reporter.h"
 
@@ -65,12 +67,22 @@ class OranReporterLocation : public OranReporter
     ~OranReporterLocation() override;
 
   protected:
+    /**
+     * Dispose of the Reporter, releasing the reports kept for reuse.
+     */
+    void DoDispose() override;
     /**
      * Capture the position of the node and instantiate an OranReportLocation.
      *
      * @return The generated Report.
      */
     std::vector<Ptr<OranReport>> GenerateReports() override;
+
+  private:
+    /**
+     * The pool used to recycle the Reports.
+     */
+    OranReportPool<OranReportLocation> m_reportPool;
 }; // class OranReporterLocation
 
 } // namespace ns3
@@ -38,7 +38,6 @@
 #include "ns3/lte-ue-rrc.h"
 #include "ns3/mobility-model.h"
 #include "ns3/simulator.h"
-#include "ns3/uinteger.h"
 
 namespace ns3
 {
@@ -68,6 +67,16 @@ OranReporterLteUeCellInfo::~OranReporterLteUeCellInfo()
     NS_LOG_FUNCTION(this);
 }
 
+void
+OranReporterLteUeCellInfo::DoDispose()
+{
+    NS_LOG_FUNCTION(this);
+
+    m_reportPool.Clear();
+
+    OranReporter::DoDispose();
+}
+
 std::vector<Ptr<OranReport>>
 OranReporterLteUeCellInfo::GenerateReports()
 {
@@ -81,7 +90,7 @@ OranReporterLteUeCellInfo::GenerateReports()
 
         Ptr<LteUeNetDevice> lteUeNetDev = nullptr;
         Ptr<Node> node = m_terminator->GetNode();
-        Ptr<OranReportLteUeCellInfo> cellInfoReport = CreateObject<OranReportLteUeCellInfo>();
+        Ptr<OranReportLteUeCellInfo> cellInfoReport = m_reportPool.Get();
 
         for (uint32_t idx = 0; lteUeNetDev == nullptr && idx < node->GetNDevices(); idx++)
         {
@@ -92,11 +101,10 @@ OranReporterLteUeCellInfo::GenerateReports()
 
         Ptr<LteUeRrc> lteUeRrc = lteUeNetDev->GetRrc();
 
-        cellInfoReport->SetAttribute("ReporterE2NodeId",
-                                     UintegerValue(m_terminator->GetE2NodeId()));
-        cellInfoReport->SetAttribute("CellId", UintegerValue(lteUeRrc->GetCellId()));
-        cellInfoReport->SetAttribute("Rnti", UintegerValue(lteUeRrc->GetRnti()));
-        cellInfoReport->SetAttribute("Time", TimeValue(Simulator::Now()));
+        cellInfoReport->SetReporterE2NodeId(m_terminator->GetE2NodeId());
+        cellInfoReport->SetCellId(lteUeRrc->GetCellId());
+        cellInfoReport->SetRnti(lteUeRrc->GetRnti());
+        cellInfoReport->SetTime(Simulator::Now());
 
         reports.push_back(cellInfoReport);
     }
@@ -31,6 +31,8 @@
 #ifndef ORAN_REPORTER_LTE_UE_CELL_INFO_H
 #define ORAN_REPORTER_LTE_UE_CELL_INFO_H
 
+#include "oran-report-lte-ue-cell-info.h"
+#include "oran-report-pool.h"
 #include "oran-report.h"
 #include "oran-reporter.h"
 
@@ -66,6 +68,10 @@ class OranReporterLteUeCellInfo : public OranReporter
     ~OranReporterLteUeCellInfo() override;
 
   protected:
+    /**
+     * Dispose of the Reporter, releasing the reports kept for reuse.
+     */
+    void DoDispose() override;
     /**
      * Get the Cell ID of the attached LTE cell, and generate an
      * OranReportLteUeCEllInfo.
@@ -73,6 +79,12 @@ class OranReporterLteUeCellInfo : public OranReporter
      * @return The generated Report.
      */
     std::vector<Ptr<OranReport>> GenerateReports() override;
+
+  private:
+    /**
+     * The pool used to recycle the Reports.
+     */
+    OranReportPool<OranReportLteUeCellInfo> m_reportPool;
 }; // class OranReporterLteUeCellInfo
 
 } // namespace ns3
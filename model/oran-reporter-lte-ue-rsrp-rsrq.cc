@@ -34,12 +34,9 @@
 
 #include "ns3/abort.h"
 #include "ns3/address.h"
-#include "ns3/boolean.h"
-#include "ns3/double.h"
 #include "ns3/log.h"
 #include "ns3/packet.h"
 #include "ns3/simulator.h"
-#include "ns3/uinteger.h"
 
 namespace ns3
 {
@@ -67,6 +64,16 @@ OranReporterLteUeRsrpRsrq::~OranReporterLteUeRsrpRsrq()
     NS_LOG_FUNCTION(this);
 }
 
+void
+OranReporterLteUeRsrpRsrq::DoDispose()
+{
+    NS_LOG_FUNCTION(this);
+
+    m_reportPool.Clear();
+
+    OranReporter::DoDispose();
+}
+
 void
 OranReporterLteUeRsrpRsrq::ReportRsrpRsrq(uint16_t rnti,
                                           uint16_t cellId,
@@ -83,15 +90,15 @@ OranReporterLteUeRsrpRsrq::ReportRsrpRsrq(uint16_t rnti,
         NS_ABORT_MSG_IF(m_terminator == nullptr,
                         "Attempting to generate reports in reporter with NULL E2 Terminator");
 
-        Ptr<OranReportLteUeRsrpRsrq> report = CreateObject<OranReportLteUeRsrpRsrq>();
-        report->SetAttribute("ReporterE2NodeId", UintegerValue(m_terminator->GetE2NodeId()));
-        report->SetAttribute("Time", TimeValue(Simulator::Now()));
-        report->SetAttribute("Rnti", UintegerValue(rnti));
-        report->SetAttribute("CellId", UintegerValue(cellId));
-        report->SetAttribute("Rsrp", DoubleValue(rsrp));
-        report->SetAttribute("Rsrq", DoubleValue(rsrq));
-        report->SetAttribute("IsServingCell", BooleanValue(isServingCell));
-        report->SetAttribute("ComponentCarrierId", UintegerValue(componentCarrierId));
+        Ptr<OranReportLteUeRsrpRsrq> report = m_reportPool.Get();
+        report->SetReporterE2NodeId(m_terminator->GetE2NodeId());
+        report->SetTime(Simulator::Now());
+        report->SetRnti(rnti);
+        report->SetCellId(cellId);
+        report->SetRsrp(rsrp);
+        report->SetRsrq(rsrq);
+        report->SetIsServingCell(isServingCell);
+        report->SetComponentCarrierId(componentCarrierId);
 
         m_reports.push_back(report);
     }
@@ -31,6 +31,8 @@
 #ifndef ORAN_REPORTER_LTE_UE_RSRP_RSRQ
 #define ORAN_REPORTER_LTE_UE_RSRP_RSRQ
 
+#include "oran-report-lte-ue-rsrp-rsrq.h"
+#include "oran-report-pool.h"
 #include "oran-report.h"
 #include "oran-reporter.h"
 
@@ -84,6 +86,10 @@ class OranReporterLteUeRsrpRsrq : public OranReporter
                         uint8_t componentCarrierId);
 
   protected:
+    /**
+     * Dispose of the Reporter, releasing the reports kept for reuse.
+     */
+    void DoDispose() override;
     /**
      * Returns the genrated OranReportLteUeRsrpRsrq.
      *
@@ -96,6 +102,10 @@ class OranReporterLteUeRsrpRsrq : public OranReporter
      * The reports.
      */
     std::vector<Ptr<OranReport>> m_reports;
+    /**
+     * The pool used to recycle the Reports.
+     */
+    OranReportPool<OranReportLteUeRsrpRsrq> m_reportPool;
 };
 
 } // namespace ns3
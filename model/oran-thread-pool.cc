@@ -0,0 +1,167 @@
+/**
+ * NIST-developed software is provided by NIST as a public service. You may
+ * use, copy and distribute copies of the software in any medium, provided that
+ * you keep intact this entire notice. You may improve, modify and create
+ * derivative works of the software or any portion of the software, and you may
+ * copy and distribute such modifications or works. Modified works should carry
+ * a notice stating that you changed the software and should note the date and
+ * nature of any such change. Please explicitly acknowledge the National
+ * Institute of Standards and Technology as the source of the software.
+ *
+ * NIST-developed software is expressly provided "AS IS." NIST MAKES NO
+ * WARRANTY OF ANY KIND, EXPRESS, IMPLIED, IN FACT OR ARISING BY OPERATION OF
+ * LAW, INCLUDING, WITHOUT LIMITATION, THE IMPLIED WARRANTY OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE, NON-INFRINGEMENT AND DATA ACCURACY. NIST
+ * NEITHER REPRESENTS NOR WARRANTS THAT THE OPERATION OF THE SOFTWARE WILL BE
+ * UNINTERRUPTED OR ERROR-FREE, OR THAT ANY DEFECTS WILL BE CORRECTED. NIST
+ * DOES NOT WARRANT OR MAKE ANY REPRESENTATIONS REGARDING THE USE OF THE
+ * SOFTWARE OR THE RESULTS THEREOF, INCLUDING BUT NOT LIMITED TO THE
+ * CORRECTNESS, ACCURACY, RELIABILITY, OR USEFULNESS OF THE SOFTWARE.
+ *
+ * You are solely responsible for determining the appropriateness of using and
+ * distributing the software and you assume all risks associated with its use,
+ * including but not limited to the risks and costs of program errors,
+ * compliance with applicable laws, damage to or loss of data, programs or
+ * equipment, and the unavailability or interruption of operation. This
+ * software is not intended to be used in any situation where a failure could
+ * cause risk of injury or damage to property. The software developed by NIST
+ * employees is not subject to copyright protection within the United States.
+ */
+
+#include "oran-thread-pool.h"
+
+#include "ns3/abort.h"
+#include "ns3/log.h"
+
+#include <algorithm>
+
+namespace ns3
+{
+
+NS_LOG_COMPONENT_DEFINE("OranThreadPool");
+
+OranThreadPool::OranThreadPool(uint32_t numThreads)
+    : m_stop(false)
+{
+    NS_LOG_FUNCTION(this << numThreads);
+
+    for (uint32_t i = 0; i < numThreads; i++)
+    {
+        m_threads.emplace_back(&OranThreadPool::Work, this);
+    }
+}
+
+OranThreadPool::~OranThreadPool()
+{
+    NS_LOG_FUNCTION(this);
+
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_stop = true;
+    }
+    m_workCv.notify_all();
+
+    for (auto& thread : m_threads)
+    {
+        thread.join();
+    }
+}
+
+uint32_t
+OranThreadPool::GetNThreads() const
+{
+    NS_LOG_FUNCTION(this);
+
+    return m_threads.size();
+}
+
+void
+OranThreadPool::Run(const std::vector<std::function<void()>>& tasks)
+{
+    NS_LOG_FUNCTION(this << tasks.size());
+
+    RunBatch(tasks.size(), [&tasks](std::size_t i) { tasks[i](); });
+}
+
+void
+OranThreadPool::ParallelFor(std::size_t count,
+                            std::size_t chunkSize,
+                            const std::function<void(std::size_t, std::size_t)>& body)
+{
+    NS_LOG_FUNCTION(this << count << chunkSize);
+
+    NS_ABORT_MSG_IF(chunkSize == 0, "Attempting to run a parallel for with empty chunks");
+
+    RunBatch((count + chunkSize - 1) / chunkSize, [count, chunkSize, &body](std::size_t i) {
+        body(i * chunkSize, std::min(count, (i + 1) * chunkSize));
+    });
+}
+
+void
+OranThreadPool::RunBatch(std::size_t count, const std::function<void(std::size_t)>& task)
+{
+    NS_LOG_FUNCTION(this << count);
+
+    if (count == 0)
+    {
+        return;
+    }
+
+    Batch batch{&task, count, 0, count};
+
+    std::unique_lock<std::mutex> lock(m_mutex);
+
+    m_batches.push_back(&batch);
+    m_workCv.notify_all();
+
+    // Help the workers until every task of the batch has been handed out
+    while (batch.nextTask < batch.count)
+    {
+        RunNextTask(&batch, lock);
+    }
+
+    m_doneCv.wait(lock, [&batch]() { return batch.pendingTasks == 0; });
+}
+
+void
+OranThreadPool::Work()
+{
+    NS_LOG_FUNCTION(this);
+
+    std::unique_lock<std::mutex> lock(m_mutex);
+
+    while (true)
+    {
+        m_workCv.wait(lock, [this]() { return m_stop || !m_batches.empty(); });
+
+        if (m_stop)
+        {
+            return;
+        }
+
+        RunNextTask(m_batches.back(), lock);
+    }
+}
+
+void
+OranThreadPool::RunNextTask(Batch* batch, std::unique_lock<std::mutex>& lock)
+{
+    NS_LOG_FUNCTION(this << batch);
+
+    std::size_t i = batch->nextTask++;
+    if (batch->nextTask == batch->count)
+    {
+        m_batches.erase(std::find(m_batches.begin(), m_batches.end(), batch));
+    }
+
+    lock.unlock();
+    (*batch->task)(i);
+    lock.lock();
+
+    if (--batch->pendingTasks == 0)
+    {
+        m_doneCv.notify_all();
+    }
+}
+
+} // namespace ns3
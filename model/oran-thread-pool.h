@@ -0,0 +1,182 @@
+/**
+ * NIST-developed software is provided by NIST as a public service. You may
+ * use, copy and distribute copies of the software in any medium, provided that
+ * you keep intact this entire notice. You may improve, modify and create
+ * derivative works of the software or any portion of the software, and you may
+ * copy and distribute such modifications or works. Modified works should carry
+ * a notice stating that you changed the software and should note the date and
+ * nature of any such change. Please explicitly acknowledge the National
+ * Institute of Standards and Technology as the source of the software.
+ *
+ * NIST-developed software is expressly provided "AS IS." NIST MAKES NO
+ * WARRANTY OF ANY KIND, EXPRESS, IMPLIED, IN FACT OR ARISING BY OPERATION OF
+ * LAW, INCLUDING, WITHOUT LIMITATION, THE IMPLIED WARRANTY OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE, NON-INFRINGEMENT AND DATA ACCURACY. NIST
+ * NEITHER REPRESENTS NOR WARRANTS THAT THE OPERATION OF THE SOFTWARE WILL BE
+ * UNINTERRUPTED OR ERROR-FREE, OR THAT ANY DEFECTS WILL BE CORRECTED. NIST
+ * DOES NOT WARRANT OR MAKE ANY REPRESENTATIONS REGARDING THE USE OF THE
+ * SOFTWARE OR THE RESULTS THEREOF, INCLUDING BUT NOT LIMITED TO THE
+ * CORRECTNESS, ACCURACY, RELIABILITY, OR USEFULNESS OF THE SOFTWARE.
+ *
+ * You are solely responsible for determining the appropriateness of using and
+ * distributing the software and you assume all risks associated with its use,
+ * including but not limited to the risks and costs of program errors,
+ * compliance with applicable laws, damage to or loss of data, programs or
+ * equipment, and the unavailability or interruption of operation. This
+ * software is not intended to be used in any situation where a failure could
+ * cause risk of injury or damage to property. The software developed by NIST
+ * employees is not subject to copyright protection within the United States.
+ */
+
+#ifndef ORAN_THREAD_POOL_H
+#define ORAN_THREAD_POOL_H
+
+#include <condition_variable>
+#include <cstdint>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace ns3
+{
+
+/**
+ * @ingroup oran
+ *
+ * A fixed pool of worker threads that executes batches of independent tasks.
+ *
+ * A batch is either a list of tasks (Run) or the chunks of a range of
+ * indexes (ParallelFor). The tasks of a batch are handed out one at a time,
+ * in order, to the workers and to the thread that submitted the batch, which
+ * only executes tasks of its own batch while it waits. The call returns once
+ * every task of the batch has finished, so the results of the tasks can be
+ * collected in a deterministic order afterwards.
+ *
+ * Several batches can be submitted at the same time, including from the
+ * tasks of another batch (for example, a Logic Module that evaluates its UEs
+ * with ParallelFor while the Logic Modules run in parallel). Idle workers
+ * take the tasks of the most recently submitted batch first, so that nested
+ * batches finish as soon as possible and free the tasks that wait for them.
+ *
+ * The tasks run concurrently with each other, so they must not share state
+ * that is not protected against concurrent access. In particular, most ns-3
+ * objects (and the reference counts of the Ptr that point to them) are not
+ * thread-safe.
+ */
+class OranThreadPool
+{
+  public:
+    /**
+     * Create the pool and start its worker threads.
+     *
+     * @param numThreads The number of worker threads, besides the threads that
+     *                   submit the batches.
+     */
+    OranThreadPool(uint32_t numThreads);
+    /**
+     * Stop the worker threads and wait for them to finish.
+     */
+    ~OranThreadPool();
+    /**
+     * Copying the pool is not allowed.
+     */
+    OranThreadPool(const OranThreadPool&) = delete;
+    /**
+     * Copying the pool is not allowed.
+     *
+     * @return The pool.
+     */
+    OranThreadPool& operator=(const OranThreadPool&) = delete;
+    /**
+     * Get the number of worker threads of the pool.
+     *
+     * @return The number of worker threads.
+     */
+    uint32_t GetNThreads() const;
+    /**
+     * Execute a batch of tasks, and wait until all of them have finished.
+     *
+     * @param tasks The tasks.
+     */
+    void Run(const std::vector<std::function<void()>>& tasks);
+    /**
+     * Execute a function over the range of indexes [0, count), split into
+     * chunks of consecutive indexes, and wait until all the chunks have
+     * finished.
+     *
+     * @param count The number of indexes.
+     * @param chunkSize The maximum number of indexes of a chunk.
+     * @param body The function, called with the first index of a chunk and
+     *             the index after its last one.
+     */
+    void ParallelFor(std::size_t count,
+                     std::size_t chunkSize,
+                     const std::function<void(std::size_t, std::size_t)>& body);
+
+  private:
+    /**
+     * A batch of tasks submitted to the pool.
+     */
+    struct Batch
+    {
+        const std::function<void(std::size_t)>* task; //!< The function that runs a task.
+        std::size_t count;                            //!< The number of tasks.
+        std::size_t nextTask;                         //!< The next task to hand out.
+        std::size_t pendingTasks;                     //!< The tasks not finished yet.
+    };
+
+    /**
+     * Submit a batch, execute its tasks until all of them have been handed
+     * out, and wait until all of them have finished.
+     *
+     * @param count The number of tasks.
+     * @param task The function that runs a task, given its index.
+     */
+    void RunBatch(std::size_t count, const std::function<void(std::size_t)>& task);
+    /**
+     * The loop of the worker threads, which execute the tasks of the batches
+     * until the pool is destroyed.
+     */
+    void Work();
+    /**
+     * Execute the next task of a batch, removing the batch from the list of
+     * batches with tasks to hand out once its last task is handed out.
+     *
+     * @param batch The batch.
+     * @param lock The lock on the mutex of the pool, which is released while
+     *             the task is executed.
+     */
+    void RunNextTask(Batch* batch, std::unique_lock<std::mutex>& lock);
+
+    /**
+     * The worker threads.
+     */
+    std::vector<std::thread> m_threads;
+    /**
+     * The mutex that protects the state of the batches.
+     */
+    std::mutex m_mutex;
+    /**
+     * The condition used to wake up the workers when a batch is submitted or
+     * the pool is destroyed.
+     */
+    std::condition_variable m_workCv;
+    /**
+     * The condition used to wake up the threads that submitted the batches
+     * when the last task of a batch finishes.
+     */
+    std::condition_variable m_doneCv;
+    /**
+     * The batches with tasks to hand out, in the order they were submitted.
+     */
+    std::vector<Batch*> m_batches;
+    /**
+     * Flag that requests the worker threads to stop.
+     */
+    bool m_stop;
+}; // class OranThreadPool
+
+} // namespace ns3
+
+#endif /* ORAN_THREAD_POOL_H */
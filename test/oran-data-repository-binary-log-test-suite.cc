@@ -0,0 +1,325 @@
+/**
+ * NIST-developed software is provided by NIST as a public service. You may
+ * use, copy and distribute copies of the software in any medium, provided that
+ * you keep intact this entire notice. You may improve, modify and create
+ * derivative works of the software or any portion of the software, and you may
+ * copy and distribute such modifications or works. Modified works should carry
+ * a notice stating that you changed the software and should note the date and
+ * nature of any such change. Please explicitly acknowledge the National
+ * Institute of Standards and Technology as the source of the software.
+ *
+ * NIST-developed software is expressly provided "AS IS." NIST MAKES NO
+ * WARRANTY OF ANY KIND, EXPRESS, IMPLIED, IN FACT OR ARISING BY OPERATION OF
+ * LAW, INCLUDING, WITHOUT LIMITATION, THE IMPLIED WARRANTY OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE, NON-INFRINGEMENT AND DATA ACCURACY. NIST
+ * NEITHER REPRESENTS NOR WARRANTS THAT THE OPERATION OF THE SOFTWARE WILL BE
+ * UNINTERRUPTED OR ERROR-FREE, OR THAT ANY DEFECTS WILL BE CORRECTED. NIST
+ * DOES NOT WARRANT OR MAKE ANY REPRESENTATIONS REGARDING THE USE OF THE
+ * SOFTWARE OR THE RESULTS THEREOF, INCLUDING BUT NOT LIMITED TO THE
+ * CORRECTNESS, ACCURACY, RELIABILITY, OR USEFULNESS OF THE SOFTWARE.
+ *
+ * You are solely responsible for determining the appropriateness of using and
+ * distributing the software and you assume all risks associated with its use,
+ * including but not limited to the risks and costs of program errors,
+ * compliance with applicable laws, damage to or loss of data, programs or
+ * equipment, and the unavailability or interruption of operation. This
+ * software is not intended to be used in any situation where a failure could
+ * cause risk of injury or damage to property. The software developed by NIST
+ * employees is not subject to copyright protection within the United States.
+ */
+
+#include "ns3/core-module.h"
+#include "ns3/oran-module.h"
+#include "ns3/test.h"
+
+#include <cstdio>
+#include <fstream>
+#include <sqlite3.h>
+
+using namespace ns3;
+
+namespace
+{
+
+/**
+ * The event logged to the binary log.
+ */
+const OranDataRepository::LogEvent LOG_TEST_SHORTEST_DISTANCE =
+    OranDataRepository::RegisterLogEvent("ns3::OranTestLmBinaryLog",
+                                         "Distance to eNB with CellID %d is shortest so far");
+
+} // namespace
+
+/**
+ * @ingroup oran
+ *
+ * Class that tests that the binary log Data Repository serves the reads of
+ * the run from its index while rotating segments, and that the converted
+ * log holds every stored item in the schema of the SQLite Data Repository.
+ */
+class OranTestCaseDataRepositoryBinaryLog : public TestCase
+{
+  public:
+    /**
+     * Constructor of the test
+     */
+    OranTestCaseDataRepositoryBinaryLog();
+    /**
+     * Destructor of the test
+     */
+    virtual ~OranTestCaseDataRepositoryBinaryLog();
+
+  private:
+    /**
+     * Method that runs the test
+     */
+    virtual void DoRun();
+};
+
+OranTestCaseDataRepositoryBinaryLog::OranTestCaseDataRepositoryBinaryLog()
+    : TestCase("Oran Test Case Data Repository Binary Log")
+{
+}
+
+OranTestCaseDataRepositoryBinaryLog::~OranTestCaseDataRepositoryBinaryLog()
+{
+}
+
+void
+OranTestCaseDataRepositoryBinaryLog::DoRun()
+{
+    const uint64_t nUes = 3;
+    const uint32_t nSteps = 200;
+    std::string logFileName = CreateTempDirFilename("oran-repository.bin");
+    std::string dbFileName = CreateTempDirFilename("oran-binary-log-repository.db");
+
+    std::remove(dbFileName.c_str());
+
+    Ptr<OranDataRepositoryBinaryLog> repo = CreateObject<OranDataRepositoryBinaryLog>();
+    repo->SetAttribute("LogFile", StringValue(logFileName));
+    repo->SetAttribute("SegmentSize", UintegerValue(4096));
+    repo->Activate();
+
+    uint64_t enbId = repo->RegisterNodeLteEnb(0, 1);
+    std::vector<uint64_t> ueIds;
+    for (uint64_t i = 0; i < nUes; i++)
+    {
+        ueIds.push_back(repo->RegisterNodeLteUe(0, 100 + i));
+    }
+
+    for (uint32_t step = 1; step <= nSteps; step++)
+    {
+        Time t = MilliSeconds(10 * step);
+        for (uint64_t i = 0; i < nUes; i++)
+        {
+            repo->SavePosition(ueIds[i], Vector(step, i, 0), t);
+            repo->SaveAppLoss(ueIds[i], 0.001 * step, t);
+            repo->SaveLteUeCellInfo(ueIds[i], 1, i + 1, t);
+        }
+    }
+    repo->LogActionLm("LmBinaryLog", "Log action");
+    repo->LogEventLm("LmBinaryLog", LOG_TEST_SHORTEST_DISTANCE, 1, 0, 0, 0);
+
+    // The positions in the middle of the run are read from the log segments
+    std::map<Time, Vector> positions =
+        repo->GetNodePositions(ueIds[1], Seconds(0), MilliSeconds(1000), 3);
+    NS_TEST_EXPECT_MSG_EQ(positions.size(), 3, "Unexpected number of positions");
+    NS_TEST_EXPECT_MSG_EQ(positions.begin()->first,
+                          MilliSeconds(980),
+                          "Unexpected time of the oldest position");
+    NS_TEST_EXPECT_MSG_EQ(positions.rbegin()->second.x,
+                          100,
+                          "Unexpected x coordinate of the newest position");
+    NS_TEST_EXPECT_MSG_EQ(positions.rbegin()->second.y,
+                          1,
+                          "Unexpected y coordinate of the newest position");
+    NS_TEST_EXPECT_MSG_EQ(std::get<0>(repo->GetLteEnbCellInfo(enbId)),
+                          true,
+                          "Missing eNB cell information");
+    NS_TEST_EXPECT_MSG_EQ(repo->GetLteUeE2NodeIdFromCellInfo(1, 3),
+                          ueIds[2],
+                          "Unexpected E2 Node ID of the cell information");
+    NS_TEST_EXPECT_MSG_EQ_TOL(repo->GetAppLoss(ueIds[0]),
+                              0.001 * nSteps,
+                              1e-9,
+                              "Unexpected application loss");
+    NS_TEST_EXPECT_MSG_EQ(repo->GetLteUeSnapshot().e2NodeIds.size(),
+                          nUes,
+                          "Unexpected UEs in the snapshot");
+
+    repo->Deactivate();
+    repo->Dispose();
+
+    std::ifstream secondSegment(logFileName + ".1");
+    NS_TEST_EXPECT_MSG_EQ(secondSegment.good(), true, "The log was not rotated");
+
+    // Each node is logged with its registration and type, each report with a
+    // single record, and the event with the name of its module and its format
+    uint64_t records = OranDataRepositoryBinaryLog::Convert(logFileName, dbFileName);
+    NS_TEST_EXPECT_MSG_EQ(records,
+                          3 * (nUes + 1) + 3 * nUes * nSteps + 4,
+                          "Unexpected number of records");
+
+    sqlite3* db;
+    sqlite3_stmt* stmt;
+
+    NS_TEST_EXPECT_MSG_EQ(sqlite3_open(dbFileName.c_str(), &db), SQLITE_OK, "Cannot open DB");
+
+    std::vector<std::pair<std::string, uint64_t>> tables = {{"node", nUes + 1},
+                                                            {"lteue", nUes},
+                                                            {"lteenb", 1},
+                                                            {"noderegistration", nUes + 1},
+                                                            {"nodelocation", nUes * nSteps},
+                                                            {"nodeapploss", nUes * nSteps},
+                                                            {"lteuecell", nUes * nSteps},
+                                                            {"lmaction", 1},
+                                                            {"lmevent", 1},
+                                                            {"logevent", 1}};
+    for (const auto& table : tables)
+    {
+        std::string query = "SELECT COUNT(*) FROM " + table.first + ";";
+        sqlite3_prepare_v2(db, query.c_str(), -1, &stmt, nullptr);
+        NS_TEST_EXPECT_MSG_EQ(sqlite3_step(stmt), SQLITE_ROW, "Cannot count " << table.first);
+        NS_TEST_EXPECT_MSG_EQ((uint64_t)sqlite3_column_int64(stmt, 0),
+                              table.second,
+                              "Unexpected rows in " << table.first);
+        sqlite3_finalize(stmt);
+    }
+
+    sqlite3_prepare_v2(db,
+                       "SELECT x, y FROM nodelocation WHERE nodeid = ? AND simulationtime = ?;",
+                       -1,
+                       &stmt,
+                       nullptr);
+    sqlite3_bind_int64(stmt, 1, ueIds[2]);
+    sqlite3_bind_int64(stmt, 2, MilliSeconds(500).GetTimeStep());
+    NS_TEST_EXPECT_MSG_EQ(sqlite3_step(stmt), SQLITE_ROW, "Missing converted position");
+    NS_TEST_EXPECT_MSG_EQ(sqlite3_column_double(stmt, 0), 50, "Unexpected converted x");
+    NS_TEST_EXPECT_MSG_EQ(sqlite3_column_double(stmt, 1), 2, "Unexpected converted y");
+    sqlite3_finalize(stmt);
+
+    sqlite3_prepare_v2(db, "SELECT description FROM lmeventtext;", -1, &stmt, nullptr);
+    NS_TEST_EXPECT_MSG_EQ(sqlite3_step(stmt), SQLITE_ROW, "Missing converted event");
+    NS_TEST_EXPECT_MSG_EQ(std::string(reinterpret_cast<const char*>(sqlite3_column_text(stmt, 0))),
+                          "Distance to eNB with CellID 1 is shortest so far",
+                          "Unexpected text of the converted event");
+    sqlite3_finalize(stmt);
+
+    sqlite3_close(db);
+
+    std::remove(dbFileName.c_str());
+    for (uint32_t segment = 0;; segment++)
+    {
+        if (std::remove((logFileName + "." + std::to_string(segment)).c_str()) != 0)
+        {
+            break;
+        }
+    }
+}
+
+/**
+ * @ingroup oran
+ *
+ * Class that tests that a new binary log removes the segments of an earlier,
+ * longer log with the same name, so that the converted log only holds the
+ * items stored in the new one.
+ */
+class OranTestCaseDataRepositoryBinaryLogRerun : public TestCase
+{
+  public:
+    /**
+     * Constructor of the test
+     */
+    OranTestCaseDataRepositoryBinaryLogRerun();
+    /**
+     * Destructor of the test
+     */
+    virtual ~OranTestCaseDataRepositoryBinaryLogRerun();
+
+  private:
+    /**
+     * Method that runs the test
+     */
+    virtual void DoRun();
+};
+
+OranTestCaseDataRepositoryBinaryLogRerun::OranTestCaseDataRepositoryBinaryLogRerun()
+    : TestCase("Oran Test Case Data Repository Binary Log Rerun")
+{
+}
+
+OranTestCaseDataRepositoryBinaryLogRerun::~OranTestCaseDataRepositoryBinaryLogRerun()
+{
+}
+
+void
+OranTestCaseDataRepositoryBinaryLogRerun::DoRun()
+{
+    std::string logFileName = CreateTempDirFilename("oran-stale-repository.bin");
+    std::string dbFileName = CreateTempDirFilename("oran-stale-binary-log-repository.db");
+
+    std::remove(dbFileName.c_str());
+
+    // The first log is rotated a few times
+    Ptr<OranDataRepositoryBinaryLog> repo = CreateObject<OranDataRepositoryBinaryLog>();
+    repo->SetAttribute("LogFile", StringValue(logFileName));
+    repo->SetAttribute("SegmentSize", UintegerValue(4096));
+    repo->Activate();
+    uint64_t e2NodeId = repo->RegisterNode(OranNearRtRic::NodeType::WIRED, 0);
+    for (uint32_t step = 1; step <= 500; step++)
+    {
+        repo->SavePosition(e2NodeId, Vector(step, 0, 0), MilliSeconds(10 * step));
+    }
+    repo->Deactivate();
+    repo->Dispose();
+
+    std::ifstream thirdSegment(logFileName + ".2");
+    NS_TEST_ASSERT_MSG_EQ(thirdSegment.good(), true, "The first log was not rotated");
+    thirdSegment.close();
+
+    // The second log fits in its first segment
+    repo = CreateObject<OranDataRepositoryBinaryLog>();
+    repo->SetAttribute("LogFile", StringValue(logFileName));
+    repo->SetAttribute("SegmentSize", UintegerValue(4096));
+    repo->Activate();
+    repo->RegisterNode(OranNearRtRic::NodeType::WIRED, 0);
+    repo->Deactivate();
+    repo->Dispose();
+
+    std::ifstream secondSegment(logFileName + ".1");
+    NS_TEST_EXPECT_MSG_EQ(secondSegment.good(), false, "Stale segment of the first log kept");
+    secondSegment.close();
+
+    // The node is logged with its type and its registration
+    uint64_t records = OranDataRepositoryBinaryLog::Convert(logFileName, dbFileName);
+    NS_TEST_EXPECT_MSG_EQ(records, 2, "Unexpected number of records");
+
+    std::remove(dbFileName.c_str());
+    std::remove((logFileName + ".0").c_str());
+}
+
+/**
+ * @ingroup oran
+ *
+ * Binary log Data Repository test suite.
+ */
+class OranDataRepositoryBinaryLogTestSuite : public TestSuite
+{
+  public:
+    /**
+     * Constructor of the test suite
+     */
+    OranDataRepositoryBinaryLogTestSuite();
+};
+
+OranDataRepositoryBinaryLogTestSuite::OranDataRepositoryBinaryLogTestSuite()
+    : TestSuite("oran-data-repository-binary-log", Type::UNIT)
+{
+    AddTestCase(new OranTestCaseDataRepositoryBinaryLog(), Duration::QUICK);
+    AddTestCase(new OranTestCaseDataRepositoryBinaryLogRerun(), Duration::QUICK);
+}
+
+/**
+ * Static variable for test initialization
+ */
+static OranDataRepositoryBinaryLogTestSuite soranDataRepositoryBinaryLogTestSuite;
@@ -0,0 +1,267 @@
+/**
+ * NIST-developed software is provided by NIST as a public service. You may
+ * use, copy and distribute copies of the software in any medium, provided that
+ * you keep intact this entire notice. You may improve, modify and create
+ * derivative works of the software or any portion of the software, and you may
+ * copy and distribute such modifications or works. Modified works should carry
+ * a notice stating that you changed the software and should note the date and
+ * nature of any such change. Please explicitly acknowledge the National
+ * Institute of Standards and Technology as the source of the software.
+ *
+ * NIST-developed software is expressly provided "AS IS." NIST MAKES NO
+ * WARRANTY OF ANY KIND, EXPRESS, IMPLIED, IN FACT OR ARISING BY OPERATION OF
+ * LAW, INCLUDING, WITHOUT LIMITATION, THE IMPLIED WARRANTY OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE, NON-INFRINGEMENT AND DATA ACCURACY. NIST
+ * NEITHER REPRESENTS NOR WARRANTS THAT THE OPERATION OF THE SOFTWARE WILL BE
+ * UNINTERRUPTED OR ERROR-FREE, OR THAT ANY DEFECTS WILL BE CORRECTED. NIST
+ * DOES NOT WARRANT OR MAKE ANY REPRESENTATIONS REGARDING THE USE OF THE
+ * SOFTWARE OR THE RESULTS THEREOF, INCLUDING BUT NOT LIMITED TO THE
+ * CORRECTNESS, ACCURACY, RELIABILITY, OR USEFULNESS OF THE SOFTWARE.
+ *
+ * You are solely responsible for determining the appropriateness of using and
+ * distributing the software and you assume all risks associated with its use,
+ * including but not limited to the risks and costs of program errors,
+ * compliance with applicable laws, damage to or loss of data, programs or
+ * equipment, and the unavailability or interruption of operation. This
+ * software is not intended to be used in any situation where a failure could
+ * cause risk of injury or damage to property. The software developed by NIST
+ * employees is not subject to copyright protection within the United States.
+ */
+
+#include "ns3/core-module.h"
+#include "ns3/oran-module.h"
+#include "ns3/test.h"
+
+#include <cstdio>
+
+using namespace ns3;
+
+/**
+ * @ingroup oran
+ *
+ * Class that tests that the caching Data Repository answers the queries for
+ * the latest state of the nodes with the same results as its backend, while
+ * the reports are stored (including reports received out of order and
+ * deregistrations) and after loading the state from an existing database.
+ */
+class OranTestCaseDataRepositoryCache : public TestCase
+{
+  public:
+    /**
+     * Constructor of the test
+     */
+    OranTestCaseDataRepositoryCache();
+    /**
+     * Destructor of the test
+     */
+    virtual ~OranTestCaseDataRepositoryCache();
+
+  private:
+    /**
+     * Check that the cache and its backend return the same results.
+     *
+     * @param cache The caching Data Repository.
+     * @param backend The backend of the cache.
+     * @param e2NodeIds The E2 Node IDs to query, registered or not.
+     * @param step A description of the step of the test.
+     */
+    void CheckConsistency(Ptr<OranDataRepository> cache,
+                          Ptr<OranDataRepository> backend,
+                          const std::vector<uint64_t>& e2NodeIds,
+                          const std::string& step);
+    /**
+     * Method that runs the test
+     */
+    virtual void DoRun();
+};
+
+OranTestCaseDataRepositoryCache::OranTestCaseDataRepositoryCache()
+    : TestCase("Oran Test Case Data Repository Cache")
+{
+}
+
+OranTestCaseDataRepositoryCache::~OranTestCaseDataRepositoryCache()
+{
+}
+
+void
+OranTestCaseDataRepositoryCache::CheckConsistency(Ptr<OranDataRepository> cache,
+                                                  Ptr<OranDataRepository> backend,
+                                                  const std::vector<uint64_t>& e2NodeIds,
+                                                  const std::string& step)
+{
+    NS_TEST_EXPECT_MSG_EQ((cache->GetLastRegistrationRequests() ==
+                           backend->GetLastRegistrationRequests()),
+                          true,
+                          "Unexpected registrations " << step);
+    NS_TEST_EXPECT_MSG_EQ((cache->GetLteUeE2NodeIds() == backend->GetLteUeE2NodeIds()),
+                          true,
+                          "Unexpected LTE UEs " << step);
+    NS_TEST_EXPECT_MSG_EQ((cache->GetLteEnbE2NodeIds() == backend->GetLteEnbE2NodeIds()),
+                          true,
+                          "Unexpected LTE eNBs " << step);
+
+    for (auto e2NodeId : e2NodeIds)
+    {
+        NS_TEST_EXPECT_MSG_EQ(cache->IsNodeRegistered(e2NodeId),
+                              backend->IsNodeRegistered(e2NodeId),
+                              "Unexpected registration of node " << e2NodeId << " " << step);
+        NS_TEST_EXPECT_MSG_EQ((cache->GetLteUeCellInfo(e2NodeId) ==
+                               backend->GetLteUeCellInfo(e2NodeId)),
+                              true,
+                              "Unexpected cell information of node " << e2NodeId << " " << step);
+        NS_TEST_EXPECT_MSG_EQ((cache->GetLteEnbCellInfo(e2NodeId) ==
+                               backend->GetLteEnbCellInfo(e2NodeId)),
+                              true,
+                              "Unexpected cell ID of node " << e2NodeId << " " << step);
+        NS_TEST_EXPECT_MSG_EQ(cache->GetAppLoss(e2NodeId),
+                              backend->GetAppLoss(e2NodeId),
+                              "Unexpected loss of node " << e2NodeId << " " << step);
+        NS_TEST_EXPECT_MSG_EQ((cache->GetLteUeRsrpRsrq(e2NodeId) ==
+                               backend->GetLteUeRsrpRsrq(e2NodeId)),
+                              true,
+                              "Unexpected RSRP and RSRQ of node " << e2NodeId << " " << step);
+        NS_TEST_EXPECT_MSG_EQ((cache->GetNodePositions(e2NodeId, Seconds(0), Seconds(100), 1) ==
+                               backend->GetNodePositions(e2NodeId, Seconds(0), Seconds(100), 1)),
+                              true,
+                              "Unexpected latest position of node " << e2NodeId << " " << step);
+        NS_TEST_EXPECT_MSG_EQ((cache->GetNodePositions(e2NodeId, Seconds(0), Seconds(2), 1) ==
+                               backend->GetNodePositions(e2NodeId, Seconds(0), Seconds(2), 1)),
+                              true,
+                              "Unexpected earlier position of node " << e2NodeId << " " << step);
+        NS_TEST_EXPECT_MSG_EQ((cache->GetNodePositions(e2NodeId, Seconds(0), Seconds(100), 10) ==
+                               backend->GetNodePositions(e2NodeId, Seconds(0), Seconds(100), 10)),
+                              true,
+                              "Unexpected positions of node " << e2NodeId << " " << step);
+    }
+
+    for (uint16_t rnti = 1; rnti <= 3; rnti++)
+    {
+        NS_TEST_EXPECT_MSG_EQ(cache->GetLteUeE2NodeIdFromCellInfo(1, rnti),
+                              backend->GetLteUeE2NodeIdFromCellInfo(1, rnti),
+                              "Unexpected UE with RNTI " << rnti << " " << step);
+    }
+
+    OranDataRepository::LteUeSnapshot cachedUes = cache->GetLteUeSnapshot();
+    OranDataRepository::LteUeSnapshot storedUes = backend->GetLteUeSnapshot();
+    NS_TEST_EXPECT_MSG_EQ((cachedUes.e2NodeIds == storedUes.e2NodeIds &&
+                           cachedUes.cellIds == storedUes.cellIds &&
+                           cachedUes.rntis == storedUes.rntis &&
+                           cachedUes.positions == storedUes.positions &&
+                           cachedUes.appLosses == storedUes.appLosses),
+                          true,
+                          "Unexpected LTE UE snapshot " << step);
+
+    OranDataRepository::LteEnbSnapshot cachedEnbs = cache->GetLteEnbSnapshot();
+    OranDataRepository::LteEnbSnapshot storedEnbs = backend->GetLteEnbSnapshot();
+    NS_TEST_EXPECT_MSG_EQ((cachedEnbs.e2NodeIds == storedEnbs.e2NodeIds &&
+                           cachedEnbs.cellIds == storedEnbs.cellIds &&
+                           cachedEnbs.positions == storedEnbs.positions),
+                          true,
+                          "Unexpected LTE eNB snapshot " << step);
+}
+
+void
+OranTestCaseDataRepositoryCache::DoRun()
+{
+    std::string dbFileName = CreateTempDirFilename("oran-cache-repository.db");
+
+    std::remove(dbFileName.c_str());
+
+    Ptr<OranDataRepositorySqlite> backend = CreateObject<OranDataRepositorySqlite>();
+    backend->SetAttribute("DatabaseFile", StringValue(dbFileName));
+    Ptr<OranDataRepositoryCache> cache = CreateObject<OranDataRepositoryCache>();
+    cache->SetAttribute("Backend", PointerValue(backend));
+    cache->Activate();
+
+    std::vector<uint64_t> e2NodeIds;
+    uint64_t enbId = cache->RegisterNodeLteEnb(0, 1);
+    e2NodeIds.push_back(enbId);
+    for (uint32_t i = 0; i < 3; i++)
+    {
+        e2NodeIds.push_back(cache->RegisterNodeLteUe(0, 100 + i));
+    }
+    uint64_t nodeId = cache->RegisterNode(OranNearRtRic::NodeType::WIRED, 0);
+    e2NodeIds.push_back(nodeId);
+    // An ID that was never registered
+    e2NodeIds.push_back(nodeId + 1);
+
+    CheckConsistency(cache, backend, e2NodeIds, "after the registrations");
+
+    cache->SavePosition(enbId, Vector(0, 0, 30), Seconds(1));
+    cache->SavePosition(nodeId, Vector(5, 5, 0), Seconds(1));
+    for (uint32_t i = 1; i <= 3; i++)
+    {
+        uint64_t ueId = e2NodeIds[i];
+        cache->SavePosition(ueId, Vector(10 * i, 0, 1.5), Seconds(3));
+        // A position received out of order
+        cache->SavePosition(ueId, Vector(10 * i, 5, 1.5), Seconds(2));
+        cache->SaveLteUeCellInfo(ueId, 1, i, Seconds(3));
+        cache->SaveAppLoss(ueId, 0.1 * i, Seconds(3));
+        cache->SaveAppLoss(ueId, 0.2 * i, Seconds(2));
+        for (uint16_t cellId = 1; cellId <= 2; cellId++)
+        {
+            cache->SaveLteUeRsrpRsrq(ueId, Seconds(2), i, cellId, -90, -10, cellId == 1, 0);
+            cache->SaveLteUeRsrpRsrq(ueId, Seconds(3), i, cellId, -80, -9, cellId == 1, 0);
+        }
+        // A measurement older than the latest frame
+        cache->SaveLteUeRsrpRsrq(ueId, Seconds(1), i, 3, -100, -12, false, 0);
+    }
+    // The second UE is handed over to a cell with a different RNTI
+    cache->SaveLteUeCellInfo(e2NodeIds[2], 2, 7, Seconds(4));
+
+    CheckConsistency(cache, backend, e2NodeIds, "after the reports");
+
+    Simulator::Schedule(Seconds(5), [this, cache, backend, e2NodeIds]() {
+        cache->DeregisterNode(e2NodeIds[3]);
+        cache->SavePosition(e2NodeIds[3], Vector(0, 0, 0), Seconds(5));
+
+        CheckConsistency(cache, backend, e2NodeIds, "after the deregistration");
+    });
+    Simulator::Stop(Seconds(6));
+    Simulator::Run();
+
+    cache->Deactivate();
+    cache->Dispose();
+
+    // Load the state stored in the database
+    backend = CreateObject<OranDataRepositorySqlite>();
+    backend->SetAttribute("DatabaseFile", StringValue(dbFileName));
+    cache = CreateObject<OranDataRepositoryCache>();
+    cache->SetAttribute("Backend", PointerValue(backend));
+    cache->Activate();
+
+    CheckConsistency(cache, backend, e2NodeIds, "after reopening the database");
+
+    cache->Deactivate();
+    cache->Dispose();
+
+    Simulator::Destroy();
+
+    std::remove(dbFileName.c_str());
+}
+
+/**
+ * @ingroup oran
+ *
+ * Caching Data Repository test suite.
+ */
+class OranDataRepositoryCacheTestSuite : public TestSuite
+{
+  public:
+    /**
+     * Constructor of the test suite
+     */
+    OranDataRepositoryCacheTestSuite();
+};
+
+OranDataRepositoryCacheTestSuite::OranDataRepositoryCacheTestSuite()
+    : TestSuite("oran-data-repository-cache", Type::UNIT)
+{
+    AddTestCase(new OranTestCaseDataRepositoryCache(), Duration::QUICK);
+}
+
+/**
+ * Static variable for test initialization
+ */
+static OranDataRepositoryCacheTestSuite soranDataRepositoryCacheTestSuite;
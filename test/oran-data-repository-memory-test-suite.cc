@@ -0,0 +1,245 @@
+/**
+ * NIST-developed software is provided by NIST as a public service. You may
+ * use, copy and distribute copies of the software in any medium, provided that
+ * you keep intact this entire notice. You may improve, modify and create
+ * derivative works of the software or any portion of the software, and you may
+ * copy and distribute such modifications or works. Modified works should carry
+ * a notice stating that you changed the software and should note the date and
+ * nature of any such change. Please explicitly acknowledge the National
+ * Institute of Standards and Technology as the source of the software.
+ *
+ * NIST-developed software is expressly provided "AS IS." NIST MAKES NO
+ * WARRANTY OF ANY KIND, EXPRESS, IMPLIED, IN FACT OR ARISING BY OPERATION OF
+ * LAW, INCLUDING, WITHOUT LIMITATION, THE IMPLIED WARRANTY OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE, NON-INFRINGEMENT AND DATA ACCURACY. NIST
+ * NEITHER REPRESENTS NOR WARRANTS THAT THE OPERATION OF THE SOFTWARE WILL BE
+ * UNINTERRUPTED OR ERROR-FREE, OR THAT ANY DEFECTS WILL BE CORRECTED. NIST
+ * DOES NOT WARRANT OR MAKE ANY REPRESENTATIONS REGARDING THE USE OF THE
+ * SOFTWARE OR THE RESULTS THEREOF, INCLUDING BUT NOT LIMITED TO THE
+ * CORRECTNESS, ACCURACY, RELIABILITY, OR USEFULNESS OF THE SOFTWARE.
+ *
+ * You are solely responsible for determining the appropriateness of using and
+ * distributing the software and you assume all risks associated with its use,
+ * including but not limited to the risks and costs of program errors,
+ * compliance with applicable laws, damage to or loss of data, programs or
+ * equipment, and the unavailability or interruption of operation. This
+ * software is not intended to be used in any situation where a failure could
+ * cause risk of injury or damage to property. The software developed by NIST
+ * employees is not subject to copyright protection within the United States.
+ */
+
+#include "ns3/core-module.h"
+#include "ns3/oran-module.h"
+#include "ns3/test.h"
+
+#include <cstdio>
+#include <fstream>
+#include <sqlite3.h>
+
+using namespace ns3;
+
+/**
+ * @ingroup oran
+ *
+ * Class that tests that the in-memory Data Repository keeps the newest
+ * entries of each node, also when they are reported out of order, serves
+ * the latest reports of the registered nodes, and dumps what it holds to an
+ * SQLite database when it is deactivated.
+ */
+class OranTestCaseDataRepositoryMemory : public TestCase
+{
+  public:
+    /**
+     * Constructor of the test
+     */
+    OranTestCaseDataRepositoryMemory();
+    /**
+     * Destructor of the test
+     */
+    virtual ~OranTestCaseDataRepositoryMemory();
+
+  private:
+    /**
+     * Method that runs the test
+     */
+    virtual void DoRun();
+    /**
+     * Count the rows of a table of an SQLite database.
+     *
+     * @param dbFileName The database file path.
+     * @param table The name of the table.
+     *
+     * @return The number of rows of the table.
+     */
+    int CountRows(const std::string& dbFileName, const std::string& table);
+};
+
+OranTestCaseDataRepositoryMemory::OranTestCaseDataRepositoryMemory()
+    : TestCase("Oran Test Case Data Repository Memory")
+{
+}
+
+OranTestCaseDataRepositoryMemory::~OranTestCaseDataRepositoryMemory()
+{
+}
+
+int
+OranTestCaseDataRepositoryMemory::CountRows(const std::string& dbFileName,
+                                            const std::string& table)
+{
+    sqlite3* db;
+    sqlite3_stmt* stmt;
+    int count = -1;
+
+    NS_TEST_EXPECT_MSG_EQ(sqlite3_open(dbFileName.c_str(), &db), SQLITE_OK, "Cannot open DB");
+    std::string query = "SELECT COUNT(*) FROM " + table + ";";
+    sqlite3_prepare_v2(db, query.c_str(), -1, &stmt, nullptr);
+    if (sqlite3_step(stmt) == SQLITE_ROW)
+    {
+        count = sqlite3_column_int(stmt, 0);
+    }
+    sqlite3_finalize(stmt);
+    sqlite3_close(db);
+
+    return count;
+}
+
+void
+OranTestCaseDataRepositoryMemory::DoRun()
+{
+    const uint32_t maxEntries = 5;
+    std::string dbFileName = CreateTempDirFilename("oran-memory-repository.db");
+
+    std::remove(dbFileName.c_str());
+
+    Ptr<OranDataRepositoryMemory> repo = CreateObject<OranDataRepositoryMemory>();
+    repo->SetAttribute("MaxEntriesPerNode", UintegerValue(maxEntries));
+    repo->SetAttribute("DumpFile", StringValue(dbFileName));
+    repo->Activate();
+
+    uint64_t enbId = repo->RegisterNodeLteEnb(0, 7);
+    uint64_t ueId = repo->RegisterNodeLteUe(0, 100);
+    uint64_t otherUeId = repo->RegisterNodeLteUe(0, 101);
+
+    NS_TEST_EXPECT_MSG_EQ(enbId, 1, "Unexpected E2 Node ID of the eNB");
+    NS_TEST_EXPECT_MSG_EQ(ueId, 2, "Unexpected E2 Node ID of the UE");
+
+    // Eight positions, with the last one reported out of order, of which
+    // only the newest ones are kept
+    for (uint32_t i = 1; i <= 7; i++)
+    {
+        repo->SavePosition(ueId, Vector(i, 0, 0), Seconds(i));
+        repo->SaveAppLoss(ueId, 0.1 * i, Seconds(i));
+    }
+    repo->SavePosition(ueId, Vector(5.5, 0, 0), Seconds(5.5));
+    repo->SaveLteUeCellInfo(ueId, 7, 3, Seconds(1));
+    repo->SaveLteUeRsrpRsrq(ueId, Seconds(7), 3, 7, -80, -10, true, 0);
+    repo->SaveLteUeRsrpRsrq(ueId, Seconds(7), 3, 8, -90, -12, false, 0);
+
+    std::map<Time, Vector> positions = repo->GetNodePositions(ueId, Seconds(0), Seconds(10), 100);
+    NS_TEST_EXPECT_MSG_EQ(positions.size(), maxEntries, "Unexpected number of positions");
+    NS_TEST_EXPECT_MSG_EQ(positions.begin()->first,
+                          Seconds(4),
+                          "The oldest kept position is not the expected one");
+    NS_TEST_EXPECT_MSG_EQ(positions.count(Seconds(5.5)),
+                          1,
+                          "The position reported out of order is missing");
+
+    positions = repo->GetNodePositions(ueId, Seconds(0), Seconds(10), 2);
+    NS_TEST_EXPECT_MSG_EQ(positions.size(), 2, "Unexpected number of limited positions");
+    NS_TEST_EXPECT_MSG_EQ(positions.begin()->first,
+                          Seconds(6),
+                          "The limited positions are not the newest ones");
+
+    NS_TEST_EXPECT_MSG_EQ_TOL(repo->GetAppLoss(ueId), 0.7, 1e-9, "Unexpected app loss");
+    NS_TEST_EXPECT_MSG_EQ(std::get<1>(repo->GetLteUeCellInfo(ueId)), 7, "Unexpected cell ID");
+    NS_TEST_EXPECT_MSG_EQ(repo->GetLteUeE2NodeIdFromCellInfo(7, 3),
+                          ueId,
+                          "Unexpected UE found from its cell info");
+    NS_TEST_EXPECT_MSG_EQ(repo->GetLteUeRsrpRsrq(ueId).size(),
+                          2,
+                          "Unexpected number of RSRP/RSRQ measurements");
+
+    // A deregistered node is no longer served
+    repo->DeregisterNode(otherUeId);
+    NS_TEST_EXPECT_MSG_EQ(repo->IsNodeRegistered(otherUeId),
+                          false,
+                          "The deregistered UE is still registered");
+    NS_TEST_EXPECT_MSG_EQ(repo->GetLteUeE2NodeIds().size(), 1, "Unexpected number of UEs");
+
+    repo->LogActionLm("Lm", "Action");
+
+    repo->Deactivate();
+
+    // Everything that is kept in memory is dumped
+    NS_TEST_EXPECT_MSG_EQ(CountRows(dbFileName, "node"), 3, "Unexpected dumped nodes");
+    NS_TEST_EXPECT_MSG_EQ(CountRows(dbFileName, "nodelocation"),
+                          maxEntries,
+                          "Unexpected dumped positions");
+    NS_TEST_EXPECT_MSG_EQ(CountRows(dbFileName, "nodeapploss"),
+                          maxEntries,
+                          "Unexpected dumped app losses");
+    NS_TEST_EXPECT_MSG_EQ(CountRows(dbFileName, "noderegistration"),
+                          4,
+                          "Unexpected dumped registrations");
+    NS_TEST_EXPECT_MSG_EQ(CountRows(dbFileName, "lmaction"), 1, "Unexpected dumped actions");
+
+    // Raising the limit after the positions wrapped around keeps them in order
+    repo->Activate();
+    repo->SetAttribute("MaxEntriesPerNode", UintegerValue(maxEntries + 2));
+    for (uint32_t i = 8; i <= 12; i++)
+    {
+        repo->SavePosition(ueId, Vector(i, 0, 0), Seconds(i));
+    }
+    positions = repo->GetNodePositions(ueId, Seconds(0), Seconds(20), 100);
+    NS_TEST_EXPECT_MSG_EQ(positions.size(), maxEntries + 2, "Unexpected number of positions");
+    NS_TEST_EXPECT_MSG_EQ(positions.count(Seconds(6)),
+                          0,
+                          "An old position was kept instead of a newer one");
+    NS_TEST_EXPECT_MSG_EQ(positions.count(Seconds(8)), 1, "A newer position was overwritten");
+
+    repo->LogActionLm("Lm", "Another action");
+
+    // The second dump replaces the first one, instead of adding to it
+    repo->Deactivate();
+    NS_TEST_EXPECT_MSG_EQ(CountRows(dbFileName, "node"), 3, "Unexpected dumped nodes");
+    NS_TEST_EXPECT_MSG_EQ(CountRows(dbFileName, "nodelocation"),
+                          maxEntries + 2,
+                          "Unexpected dumped positions");
+    NS_TEST_EXPECT_MSG_EQ(CountRows(dbFileName, "lmaction"), 2, "Unexpected dumped actions");
+
+    // Nothing is dumped again until the repository is activated again
+    std::remove(dbFileName.c_str());
+    repo->Deactivate();
+    repo->Dispose();
+    std::ifstream dump(dbFileName);
+    NS_TEST_EXPECT_MSG_EQ(dump.good(), false, "The data was dumped again");
+    Simulator::Destroy();
+
+    std::remove(dbFileName.c_str());
+}
+
+/**
+ * @ingroup oran
+ *
+ * In-memory Data Repository test suite.
+ */
+class OranDataRepositoryMemoryTestSuite : public TestSuite
+{
+  public:
+    /**
+     * Constructor of the test suite
+     */
+    OranDataRepositoryMemoryTestSuite();
+};
+
+OranDataRepositoryMemoryTestSuite::OranDataRepositoryMemoryTestSuite()
+    : TestSuite("oran-data-repository-memory", Type::UNIT)
+{
+    AddTestCase(new OranTestCaseDataRepositoryMemory(), Duration::QUICK);
+}
+
+/**
+ * Static variable for test initialization
+ */
+static OranDataRepositoryMemoryTestSuite soranDataRepositoryMemoryTestSuite;
@@ -0,0 +1,1653 @@
+/**
+ * NIST-developed software is provided by NIST as a public service. You may
+ * use, copy and distribute copies of the software in any medium, provided that
+ * you keep intact this entire notice. You may improve, modify and create
+ * derivative works of the software or any portion of the software, and you may
+ * copy and distribute such modifications or works. Modified works should carry
+ * a notice stating that you changed the software and should note the date and
+ * nature of any such change. Please explicitly acknowledge the National
+ * Institute of Standards and Technology as the source of the software.
+ *
+ * NIST-developed software is expressly provided "AS IS." NIST MAKES NO
+ * WARRANTY OF ANY KIND, EXPRESS, IMPLIED, IN FACT OR ARISING BY OPERATION OF
+ * LAW, INCLUDING, WITHOUT LIMITATION, THE IMPLIED WARRANTY OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE, NON-INFRINGEMENT AND DATA ACCURACY. NIST
+ * NEITHER REPRESENTS NOR WARRANTS THAT THE OPERATION OF THE SOFTWARE WILL BE
+ * UNINTERRUPTED OR ERROR-FREE, OR THAT ANY DEFECTS WILL BE CORRECTED. NIST
+ * DOES NOT WARRANT OR MAKE ANY REPRESENTATIONS REGARDING THE USE OF THE
+ * SOFTWARE OR THE RESULTS THEREOF, INCLUDING BUT NOT LIMITED TO THE
+ * CORRECTNESS, ACCURACY, RELIABILITY, OR USEFULNESS OF THE SOFTWARE.
+ *
+ * You are solely responsible for determining the appropriateness of using and
+ * distributing the software and you assume all risks associated with its use,
+ * including but not limited to the risks and costs of program errors,
+ * compliance with applicable laws, damage to or loss of data, programs or
+ * equipment, and the unavailability or interruption of operation. This
+ * software is not intended to be used in any situation where a failure could
+ * cause risk of injury or damage to property. The software developed by NIST
+ * employees is not subject to copyright protection within the United States.
+ */
+
+#include "ns3/core-module.h"
+#include "ns3/oran-module.h"
+#include "ns3/test.h"
+
+#include <algorithm>
+#include <array>
+#include <chrono>
+#include <fstream>
+#include <functional>
+#include <sstream>
+
+using namespace ns3;
+
+NS_LOG_COMPONENT_DEFINE("OranDataRepositorySqliteTestSuite");
+
+/**
+ * @ingroup oran
+ *
+ * SQLite Data Repository that exposes the checks of the query plans of its
+ * prepared statements.
+ */
+class OranDataRepositorySqliteQueryPlan : public OranDataRepositorySqlite
+{
+  public:
+    /**
+     * Find the statements whose query plans do not use the indexes of the
+     * schema. A statement fails the check if any step of its plan scans a
+     * table, or, if requested, sorts the results in a temporary B-tree.
+     * Statements that return the data of every node are expected to scan
+     * and are not checked.
+     *
+     * @param checkTempBtree Flag to fail the statements that sort the results.
+     *
+     * @return A description of each statement that failed the check.
+     */
+    std::vector<std::string> FindUnindexedStatements(bool checkTempBtree)
+    {
+        std::vector<std::string> failures;
+
+        for (const auto& entry : ExplainQueryPlans())
+        {
+            if (entry.first == GET_ALL_LAST_REGISTRATION_TIMES ||
+                entry.first == GET_ALL_REGISTRATIONS || entry.first == GET_LOG_EVENTS ||
+                entry.first == GET_LOG_MODULES ||
+                entry.first == GET_LTE_ALL_ENB_E2NODEIDS ||
+                entry.first == GET_LTE_ALL_UE_E2NODEIDS || entry.first == GET_LTE_ENB_SNAPSHOT ||
+                entry.first == GET_LTE_UE_SNAPSHOT || entry.first == GET_MAX_SEQ)
+            {
+                continue;
+            }
+
+            for (const auto& step : entry.second.second)
+            {
+                bool scan = step.rfind("SCAN ", 0) == 0 && step != "SCAN CONSTANT ROW";
+                bool tempBtree = step.find("USE TEMP B-TREE") != std::string::npos;
+
+                if (scan || (checkTempBtree && tempBtree))
+                {
+                    failures.push_back("\"" + entry.second.first + "\": " + step);
+                }
+            }
+        }
+
+        return failures;
+    }
+};
+
+/**
+ * @ingroup oran
+ *
+ * Class that tests that the queries of the SQLite Data Repository use the
+ * indexes of the schema and, if requested, that their latency does not grow
+ * with the size of the history tables. The latency check depends on the load
+ * of the machine, so it is only requested for the longer runs. The latencies
+ * are logged at the info level.
+ */
+class OranTestCaseDataRepositorySqliteQueryPlan : public TestCase
+{
+  public:
+    /**
+     * Constructor of the test
+     *
+     * @param schemaVersion The version of the database schema.
+     * @param rows The number of rows to load in each history table.
+     * @param checkLatencies Flag to indicate if the latencies of the queries are checked.
+     */
+    OranTestCaseDataRepositorySqliteQueryPlan(uint32_t schemaVersion,
+                                              uint64_t rows,
+                                              bool checkLatencies);
+    /**
+     * Destructor of the test
+     */
+    virtual ~OranTestCaseDataRepositorySqliteQueryPlan();
+
+  private:
+    /**
+     * Method that runs the test
+     */
+    virtual void DoRun();
+    /**
+     * Load synthetic history rows into the repository, continuing from the
+     * rows already loaded.
+     *
+     * @param repo The Data Repository.
+     * @param rows The number of rows that each history table must have.
+     */
+    void Load(Ptr<OranDataRepositorySqlite> repo, uint64_t rows);
+    /**
+     * Measure the mean latency of each query of the Data Access API.
+     *
+     * @param repo The Data Repository.
+     *
+     * @return The latency of each query, in microseconds, indexed by query name.
+     */
+    std::map<std::string, double> MeasureLatencies(Ptr<OranDataRepositorySqlite> repo);
+
+    /**
+     * The version of the database schema.
+     */
+    uint32_t m_schemaVersion;
+    /**
+     * The number of rows to load in each history table.
+     */
+    uint64_t m_rows;
+    /**
+     * Flag to indicate if the latencies of the queries are checked.
+     */
+    bool m_checkLatencies;
+    /**
+     * The number of rows already loaded in each history table.
+     */
+    uint64_t m_loadedRows;
+    /**
+     * The number of LTE UEs.
+     */
+    static constexpr uint64_t N_UES = 100;
+    /**
+     * The number of LTE eNBs.
+     */
+    static constexpr uint64_t N_ENBS = 4;
+    /**
+     * The number of rows loaded before the first measurement of the latencies.
+     */
+    static constexpr uint64_t BASELINE_ROWS = 1000;
+    /**
+     * The number of times each query is run to measure its latency.
+     */
+    static constexpr uint32_t N_RUNS = 2000;
+};
+
+OranTestCaseDataRepositorySqliteQueryPlan::OranTestCaseDataRepositorySqliteQueryPlan(
+    uint32_t schemaVersion,
+    uint64_t rows,
+    bool checkLatencies)
+    : TestCase("Oran Test Case Data Repository SQLite Query Plan (schema v" +
+               std::to_string(schemaVersion) + ", " + std::to_string(rows) + " rows)"),
+      m_schemaVersion(schemaVersion),
+      m_rows(rows),
+      m_checkLatencies(checkLatencies),
+      m_loadedRows(0)
+{
+}
+
+OranTestCaseDataRepositorySqliteQueryPlan::~OranTestCaseDataRepositorySqliteQueryPlan()
+{
+}
+
+void
+OranTestCaseDataRepositorySqliteQueryPlan::Load(Ptr<OranDataRepositorySqlite> repo, uint64_t rows)
+{
+    if (m_loadedRows == 0)
+    {
+        // E2 Node IDs 1 to N_ENBS are the eNBs, and the rest are the UEs
+        for (uint64_t id = 1; id <= N_ENBS + N_UES; id++)
+        {
+            if (id <= N_ENBS)
+            {
+                repo->ImportNode(id, OranNearRtRic::NodeType::LTEENB);
+                repo->ImportNodeLteEnb(id, id);
+            }
+            else
+            {
+                repo->ImportNode(id, OranNearRtRic::NodeType::LTEUE);
+                repo->ImportNodeLteUe(id, id);
+            }
+            repo->ImportNodeRegistration(id, true, Seconds(0));
+        }
+    }
+
+    // Every UE reports once per second, so each row has a different time
+    // for its node
+    for (uint64_t row = m_loadedRows; row < rows; row++)
+    {
+        uint64_t e2NodeId = N_ENBS + 1 + row % N_UES;
+        Time t = Seconds(1 + row / N_UES);
+        uint16_t cellId = 1 + row % N_ENBS;
+        uint16_t rnti = 1 + e2NodeId;
+
+        repo->ImportPosition(e2NodeId, Vector(row, row, 0), t);
+        repo->ImportLteUeCellInfo(e2NodeId, cellId, rnti, t);
+        repo->ImportAppLoss(e2NodeId, 0.01, t);
+        repo->ImportLteUeRsrpRsrq(e2NodeId, t, rnti, cellId, -90, -10, true, 0);
+    }
+    repo->FlushWrites();
+
+    m_loadedRows = rows;
+}
+
+std::map<std::string, double>
+OranTestCaseDataRepositorySqliteQueryPlan::MeasureLatencies(Ptr<OranDataRepositorySqlite> repo)
+{
+    Time lastTime = Seconds(m_loadedRows / N_UES);
+    std::map<std::string, std::function<void(uint32_t)>> queries = {
+        {"GetLteEnbCellInfo",
+         [repo](uint32_t i) { repo->GetLteEnbCellInfo(1 + i % N_ENBS); }},
+        {"GetLteUeCellInfo",
+         [repo](uint32_t i) { repo->GetLteUeCellInfo(N_ENBS + 1 + i % N_UES); }},
+        {"GetLteUeE2NodeIdFromCellInfo",
+         [repo](uint32_t i) {
+             repo->GetLteUeE2NodeIdFromCellInfo(1 + i % N_ENBS, N_ENBS + 2 + i % N_UES);
+         }},
+        {"GetLteEnbSnapshot", [repo](uint32_t) { repo->GetLteEnbSnapshot(); }},
+        {"GetLteUeE2NodeIds", [repo](uint32_t) { repo->GetLteUeE2NodeIds(); }},
+        {"GetLteUeRsrpRsrq",
+         [repo](uint32_t i) { repo->GetLteUeRsrpRsrq(N_ENBS + 1 + i % N_UES); }},
+        {"GetLteUeSnapshot", [repo](uint32_t) { repo->GetLteUeSnapshot(); }},
+        {"GetAppLoss", [repo](uint32_t i) { repo->GetAppLoss(N_ENBS + 1 + i % N_UES); }},
+        {"GetNodePositions", [repo, lastTime](uint32_t i) {
+             repo->GetNodePositions(N_ENBS + 1 + i % N_UES,
+                                    lastTime - Seconds(10),
+                                    lastTime,
+                                    10);
+         }}};
+
+    std::map<std::string, double> latencies;
+    for (const auto& query : queries)
+    {
+        auto start = std::chrono::steady_clock::now();
+        for (uint32_t i = 0; i < N_RUNS; i++)
+        {
+            query.second(i);
+        }
+        std::chrono::duration<double, std::micro> elapsed =
+            std::chrono::steady_clock::now() - start;
+
+        latencies[query.first] = elapsed.count() / N_RUNS;
+    }
+
+    return latencies;
+}
+
+void
+OranTestCaseDataRepositorySqliteQueryPlan::DoRun()
+{
+    std::string dbFileName = CreateTempDirFilename("oran-query-plan-repository.db");
+    std::remove(dbFileName.c_str());
+
+    Ptr<OranDataRepositorySqliteQueryPlan> repo = CreateObject<OranDataRepositorySqliteQueryPlan>();
+    repo->SetAttribute("DatabaseFile", StringValue(dbFileName));
+    repo->SetAttribute("SchemaVersion", UintegerValue(m_schemaVersion));
+    repo->SetAttribute("WriteBatching", BooleanValue(true));
+    repo->SetAttribute("WriteBatchMaxRows", UintegerValue(10000));
+    repo->Activate();
+
+    std::map<std::string, double> baseline;
+    if (m_checkLatencies)
+    {
+        Load(repo, BASELINE_ROWS);
+        baseline = MeasureLatencies(repo);
+    }
+
+    Load(repo, m_rows);
+
+    // Only the clustered schema is expected to return ordered results
+    // without sorting them
+    for (const auto& failure : repo->FindUnindexedStatements(m_schemaVersion >= 2))
+    {
+        NS_TEST_EXPECT_MSG_EQ(true, false, "Query does not use an index: " << failure);
+    }
+
+    // With indexed lookups, the latency grows with the logarithm of the
+    // number of rows. Fail if it grows at a quarter of the rate of a scan.
+    if (m_checkLatencies)
+    {
+        double maxRatio = std::max(4.0, 0.25 * m_rows / BASELINE_ROWS);
+        std::map<std::string, double> latencies = MeasureLatencies(repo);
+        for (const auto& latency : latencies)
+        {
+            double ratio = latency.second / baseline[latency.first];
+
+            NS_LOG_INFO("Schema v" << m_schemaVersion << ", " << m_rows << " rows, "
+                                   << latency.first << ": " << latency.second << " us ("
+                                   << baseline[latency.first] << " us with " << BASELINE_ROWS
+                                   << " rows)");
+
+            NS_TEST_EXPECT_MSG_LT(ratio,
+                                  maxRatio,
+                                  "Latency of " << latency.first << " grew from "
+                                                << baseline[latency.first] << " us to "
+                                                << latency.second << " us");
+        }
+    }
+
+    repo->Deactivate();
+    repo->Dispose();
+    std::remove(dbFileName.c_str());
+}
+
+/**
+ * @ingroup oran
+ *
+ * Class that tests that the asynchronous writes of the SQLite Data Repository,
+ * with or without write-ahead logging, produce the same database, and the same
+ * results for the reads interleaved with the writes, as the synchronous writes
+ * with the default journal. The same is checked for statements that are
+ * compiled for every use instead of being cached.
+ */
+class OranTestCaseDataRepositorySqliteWriteModes : public TestCase
+{
+  public:
+    /**
+     * Constructor of the test
+     *
+     * @param schemaVersion The version of the database schema.
+     * @param writeBatching Flag that indicates if write batching is enabled.
+     * @param queueCapacity The capacity of the queue of the writer thread.
+     * @param walMode Flag that indicates if write-ahead logging is enabled.
+     */
+    OranTestCaseDataRepositorySqliteWriteModes(uint32_t schemaVersion,
+                                               bool writeBatching,
+                                               uint32_t queueCapacity,
+                                               bool walMode);
+    /**
+     * Destructor of the test
+     */
+    virtual ~OranTestCaseDataRepositorySqliteWriteModes();
+
+  private:
+    /**
+     * Method that runs the test
+     */
+    virtual void DoRun();
+    /**
+     * Write and read a synthetic workload through the Data Repository API.
+     *
+     * @param dbFileName The database file path.
+     * @param asyncWrites Flag that indicates if asynchronous writes are enabled.
+     * @param walMode Flag that indicates if write-ahead logging is enabled.
+     * @param cacheStatements Flag that indicates if the statements are cached.
+     *
+     * @return The results of the reads, followed by the contents of every
+     *         table of the database.
+     */
+    std::string RunWorkload(const std::string& dbFileName,
+                            bool asyncWrites,
+                            bool walMode,
+                            bool cacheStatements);
+
+    /**
+     * The version of the database schema.
+     */
+    uint32_t m_schemaVersion;
+    /**
+     * Flag that indicates if write batching is enabled.
+     */
+    bool m_writeBatching;
+    /**
+     * The capacity of the queue of the writer thread.
+     */
+    uint32_t m_queueCapacity;
+    /**
+     * Flag that indicates if write-ahead logging is enabled.
+     */
+    bool m_walMode;
+};
+
+OranTestCaseDataRepositorySqliteWriteModes::OranTestCaseDataRepositorySqliteWriteModes(
+    uint32_t schemaVersion,
+    bool writeBatching,
+    uint32_t queueCapacity,
+    bool walMode)
+    : TestCase("Oran Test Case Data Repository SQLite Write Modes (schema v" +
+               std::to_string(schemaVersion) + ", batching " + std::to_string(writeBatching) +
+               ", queue " + std::to_string(queueCapacity) + ", WAL " + std::to_string(walMode) +
+               ")"),
+      m_schemaVersion(schemaVersion),
+      m_writeBatching(writeBatching),
+      m_queueCapacity(queueCapacity),
+      m_walMode(walMode)
+{
+}
+
+OranTestCaseDataRepositorySqliteWriteModes::~OranTestCaseDataRepositorySqliteWriteModes()
+{
+}
+
+std::string
+OranTestCaseDataRepositorySqliteWriteModes::RunWorkload(const std::string& dbFileName,
+                                                        bool asyncWrites,
+                                                        bool walMode,
+                                                        bool cacheStatements)
+{
+    const uint64_t nUes = 20;
+    std::stringstream ss;
+
+    std::remove(dbFileName.c_str());
+
+    Ptr<OranDataRepositorySqlite> repo = CreateObject<OranDataRepositorySqlite>();
+    repo->SetAttribute("DatabaseFile", StringValue(dbFileName));
+    repo->SetAttribute("SchemaVersion", UintegerValue(m_schemaVersion));
+    repo->SetAttribute("WriteBatching", BooleanValue(m_writeBatching));
+    repo->SetAttribute("WriteBatchMaxRows", UintegerValue(7));
+    repo->SetAttribute("AsyncWrites", BooleanValue(asyncWrites));
+    repo->SetAttribute("AsyncQueueCapacity", UintegerValue(m_queueCapacity));
+    repo->SetAttribute("WalMode", BooleanValue(walMode));
+    repo->SetAttribute("WalAutoCheckpoint", UintegerValue(10));
+    repo->SetAttribute("CacheStatements", BooleanValue(cacheStatements));
+    repo->Activate();
+
+    // E2 Node IDs 1 to 3 are the eNBs, and the rest are the UEs
+    for (uint64_t id = 1; id <= 3 + nUes; id++)
+    {
+        if (id <= 3)
+        {
+            repo->ImportNode(id, OranNearRtRic::NodeType::LTEENB);
+            repo->ImportNodeLteEnb(id, id);
+        }
+        else
+        {
+            repo->ImportNode(id, OranNearRtRic::NodeType::LTEUE);
+            repo->ImportNodeLteUe(id, id);
+        }
+        repo->ImportNodeRegistration(id, true, Seconds(0));
+    }
+
+    for (uint32_t step = 1; step <= 50; step++)
+    {
+        Time t = MilliSeconds(100 * step);
+        for (uint64_t id = 4; id <= 3 + nUes; id++)
+        {
+            uint16_t cellId = 1 + id % 3;
+
+            repo->ImportPosition(id, Vector(step, id, 0), t);
+            repo->ImportLteUeCellInfo(id, cellId, id, t);
+            repo->ImportAppLoss(id, 0.01 * step, t);
+            repo->ImportLteUeRsrpRsrq(id, t, id, cellId, -80.0 - step, -10, true, 0);
+        }
+        repo->ImportActionLm("Lm", t, "Step " + std::to_string(step));
+
+        if (step == 25)
+        {
+            repo->ImportNodeRegistration(9, false, t);
+        }
+
+        // The reads must see every write issued before them
+        if (step % 10 == 0)
+        {
+            ss << repo->GetNodePositions(4 + step % nUes, Seconds(0), t, 1000).size() << ","
+               << repo->GetAppLoss(6) << "," << repo->GetLteUeSnapshot().e2NodeIds.size()
+               << ";";
+        }
+    }
+
+    repo->Deactivate();
+    repo->Dispose();
+
+    sqlite3* db;
+    sqlite3_stmt* stmt;
+    std::vector<std::string> tables;
+
+    NS_TEST_EXPECT_MSG_EQ(sqlite3_open(dbFileName.c_str(), &db), SQLITE_OK, "Cannot open DB");
+    sqlite3_prepare_v2(db,
+                       "SELECT name FROM sqlite_master WHERE type = 'table' ORDER BY name;",
+                       -1,
+                       &stmt,
+                       nullptr);
+    while (sqlite3_step(stmt) == SQLITE_ROW)
+    {
+        tables.push_back(reinterpret_cast<const char*>(sqlite3_column_text(stmt, 0)));
+    }
+    sqlite3_finalize(stmt);
+
+    std::string journalMode;
+    sqlite3_prepare_v2(db, "PRAGMA journal_mode;", -1, &stmt, nullptr);
+    if (sqlite3_step(stmt) == SQLITE_ROW)
+    {
+        journalMode = reinterpret_cast<const char*>(sqlite3_column_text(stmt, 0));
+    }
+    sqlite3_finalize(stmt);
+    NS_TEST_EXPECT_MSG_EQ(journalMode,
+                          (walMode ? "wal" : "delete"),
+                          "Unexpected journal mode of the database");
+
+    for (const auto& table : tables)
+    {
+        std::string query = "SELECT * FROM " + table + ";";
+
+        ss << std::endl << table << ":";
+        sqlite3_prepare_v2(db, query.c_str(), -1, &stmt, nullptr);
+        while (sqlite3_step(stmt) == SQLITE_ROW)
+        {
+            for (int i = 0; i < sqlite3_column_count(stmt); i++)
+            {
+                const unsigned char* value = sqlite3_column_text(stmt, i);
+                ss << (value == nullptr ? "NULL" : reinterpret_cast<const char*>(value)) << ",";
+            }
+            ss << ";";
+        }
+        sqlite3_finalize(stmt);
+    }
+    sqlite3_close(db);
+
+    std::remove(dbFileName.c_str());
+
+    return ss.str();
+}
+
+void
+OranTestCaseDataRepositorySqliteWriteModes::DoRun()
+{
+    std::string syncResult =
+        RunWorkload(CreateTempDirFilename("oran-sync-writes-repository.db"), false, false, true);
+    std::string asyncResult = RunWorkload(CreateTempDirFilename("oran-async-writes-repository.db"),
+                                          true,
+                                          m_walMode,
+                                          true);
+    std::string uncachedResult =
+        RunWorkload(CreateTempDirFilename("oran-uncached-writes-repository.db"),
+                    true,
+                    m_walMode,
+                    false);
+
+    NS_TEST_EXPECT_MSG_EQ(asyncResult,
+                          syncResult,
+                          "Asynchronous writes produced different results than synchronous ones");
+    NS_TEST_EXPECT_MSG_EQ(uncachedResult,
+                          syncResult,
+                          "Statements that are not cached produced different results");
+}
+
+/**
+ * @ingroup oran
+ *
+ * Class that tests that the write batches of the SQLite Data Repository are
+ * committed once they hold the maximum number of rows, and once the events
+ * of the simulation time at which they were started have been processed,
+ * without waiting for a later write.
+ */
+class OranTestCaseDataRepositorySqliteWriteBatching : public TestCase
+{
+  public:
+    /**
+     * Constructor of the test
+     */
+    OranTestCaseDataRepositorySqliteWriteBatching();
+    /**
+     * Destructor of the test
+     */
+    virtual ~OranTestCaseDataRepositorySqliteWriteBatching();
+
+  private:
+    /**
+     * Method that runs the test
+     */
+    virtual void DoRun();
+};
+
+OranTestCaseDataRepositorySqliteWriteBatching::OranTestCaseDataRepositorySqliteWriteBatching()
+    : TestCase("Oran Test Case Data Repository SQLite Write Batching")
+{
+}
+
+OranTestCaseDataRepositorySqliteWriteBatching::~OranTestCaseDataRepositorySqliteWriteBatching()
+{
+}
+
+void
+OranTestCaseDataRepositorySqliteWriteBatching::DoRun()
+{
+    std::string dbFileName = CreateTempDirFilename("oran-write-batching-repository.db");
+
+    std::remove(dbFileName.c_str());
+
+    Ptr<OranDataRepositorySqlite> repo = CreateObject<OranDataRepositorySqlite>();
+    repo->SetAttribute("DatabaseFile", StringValue(dbFileName));
+    repo->SetAttribute("WriteBatching", BooleanValue(true));
+    repo->SetAttribute("WriteBatchMaxRows", UintegerValue(3));
+    repo->Activate();
+
+    // A second connection only sees the writes of the committed batches
+    sqlite3* db;
+    NS_TEST_EXPECT_MSG_EQ(sqlite3_open(dbFileName.c_str(), &db), SQLITE_OK, "Cannot open DB");
+
+    std::vector<int> counts;
+    auto countRows = [db, &counts]() {
+        sqlite3_stmt* stmt;
+        sqlite3_prepare_v2(db, "SELECT COUNT(*) FROM lmaction;", -1, &stmt, nullptr);
+        sqlite3_step(stmt);
+        counts.push_back(sqlite3_column_int(stmt, 0));
+        sqlite3_finalize(stmt);
+    };
+
+    // Two writes at 1 s are seen once the events at that time are done,
+    // even though no write follows them
+    Simulator::Schedule(Seconds(1), [repo]() {
+        repo->LogActionLm("Lm", "First");
+        repo->LogActionLm("Lm", "Second");
+    });
+    Simulator::Schedule(Seconds(1), countRows);
+    Simulator::Schedule(Seconds(1.5), countRows);
+
+    // Seven writes at 2 s are committed in batches of three
+    Simulator::Schedule(Seconds(2), [repo, &countRows]() {
+        for (uint32_t i = 1; i <= 7; i++)
+        {
+            repo->LogActionLm("Lm", "Write " + std::to_string(i));
+            countRows();
+        }
+    });
+    Simulator::Schedule(Seconds(2.5), countRows);
+
+    Simulator::Stop(Seconds(3));
+    Simulator::Run();
+
+    std::vector<int> expected = {0, 2, 2, 2, 5, 5, 5, 8, 8, 9};
+    NS_TEST_EXPECT_MSG_EQ(counts.size(), expected.size(), "Unexpected number of counts");
+    for (uint32_t i = 0; i < counts.size() && i < expected.size(); i++)
+    {
+        NS_TEST_EXPECT_MSG_EQ(counts[i],
+                              expected[i],
+                              "Unexpected committed rows (count " << i << ")");
+    }
+
+    sqlite3_close(db);
+    repo->Deactivate();
+    repo->Dispose();
+    Simulator::Destroy();
+
+    std::remove(dbFileName.c_str());
+}
+
+/**
+ * @ingroup oran
+ *
+ * Class that tests that the retention policies of the SQLite Data Repository
+ * bound the history tables while the simulation runs, and that the latest
+ * information of each node is kept.
+ */
+class OranTestCaseDataRepositorySqliteRetention : public TestCase
+{
+  public:
+    /**
+     * Constructor of the test
+     *
+     * @param schemaVersion The version of the database schema.
+     * @param asyncWrites Flag that indicates if asynchronous writes are enabled.
+     */
+    OranTestCaseDataRepositorySqliteRetention(uint32_t schemaVersion, bool asyncWrites);
+    /**
+     * Destructor of the test
+     */
+    virtual ~OranTestCaseDataRepositorySqliteRetention();
+
+  private:
+    /**
+     * Method that runs the test
+     */
+    virtual void DoRun();
+
+    /**
+     * The version of the database schema.
+     */
+    uint32_t m_schemaVersion;
+    /**
+     * Flag that indicates if asynchronous writes are enabled.
+     */
+    bool m_asyncWrites;
+};
+
+OranTestCaseDataRepositorySqliteRetention::OranTestCaseDataRepositorySqliteRetention(
+    uint32_t schemaVersion,
+    bool asyncWrites)
+    : TestCase("Oran Test Case Data Repository SQLite Retention (schema v" +
+               std::to_string(schemaVersion) + ", async " + std::to_string(asyncWrites) + ")"),
+      m_schemaVersion(schemaVersion),
+      m_asyncWrites(asyncWrites)
+{
+}
+
+OranTestCaseDataRepositorySqliteRetention::~OranTestCaseDataRepositorySqliteRetention()
+{
+}
+
+void
+OranTestCaseDataRepositorySqliteRetention::DoRun()
+{
+    const uint64_t nUes = 20;
+    const uint64_t maxPositions = 5;
+    std::string dbFileName = CreateTempDirFilename("oran-retention-repository.db");
+
+    std::remove(dbFileName.c_str());
+
+    Ptr<OranDataRepositorySqlite> repo = CreateObject<OranDataRepositorySqlite>();
+    repo->SetAttribute("DatabaseFile", StringValue(dbFileName));
+    repo->SetAttribute("SchemaVersion", UintegerValue(m_schemaVersion));
+    repo->SetAttribute("AsyncWrites", BooleanValue(m_asyncWrites));
+    repo->SetAttribute("PruneInterval", TimeValue(Seconds(1)));
+    repo->SetRetentionPolicy(OranDataRepository::NODE_LOCATION, Seconds(0), maxPositions);
+    repo->SetRetentionPolicy(OranDataRepository::NODE_APPLOSS, Seconds(1), 0);
+    repo->SetRetentionPolicy(OranDataRepository::NODE_REGISTRATION, Seconds(0), 1);
+    repo->Activate();
+
+    for (uint64_t id = 1; id <= nUes; id++)
+    {
+        repo->ImportNode(id, OranNearRtRic::NodeType::LTEUE);
+        repo->ImportNodeLteUe(id, id);
+        repo->ImportNodeRegistration(id, true, Seconds(0));
+    }
+
+    // Node 1 stops reporting after one second, and node 2 deregisters
+    for (uint32_t step = 1; step <= 50; step++)
+    {
+        Time t = MilliSeconds(100 * step);
+        for (uint64_t id = (step > 10 ? 2 : 1); id <= nUes; id++)
+        {
+            Simulator::Schedule(t, [repo, id, step, t]() {
+                repo->ImportPosition(id, Vector(step, id, 0), t);
+                repo->ImportAppLoss(id, 0.01 * step, t);
+            });
+        }
+    }
+    Simulator::Schedule(Seconds(2.5), [repo]() {
+        repo->ImportNodeRegistration(2, false, Simulator::Now());
+    });
+
+    Simulator::Stop(MilliSeconds(5050));
+    Simulator::Run();
+
+    // The latest information of the node that stopped reporting is kept
+    std::map<Time, Vector> positions = repo->GetNodePositions(1, Seconds(0), Seconds(10), 1000);
+    NS_TEST_EXPECT_MSG_EQ(positions.size(), maxPositions, "Unexpected positions of node 1");
+    NS_TEST_EXPECT_MSG_EQ(positions.rbegin()->first,
+                          Seconds(1),
+                          "The latest position of node 1 was removed");
+    NS_TEST_EXPECT_MSG_EQ_TOL(repo->GetAppLoss(1), 0.1, 1e-9, "Unexpected loss of node 1");
+
+    std::vector<std::tuple<uint64_t, Time>> registrations = repo->GetLastRegistrationRequests();
+    NS_TEST_EXPECT_MSG_EQ(registrations.size(), nUes - 1, "Unexpected registered nodes");
+
+    repo->Deactivate();
+    repo->Dispose();
+    Simulator::Destroy();
+
+    sqlite3* db;
+    sqlite3_stmt* stmt;
+
+    NS_TEST_EXPECT_MSG_EQ(sqlite3_open(dbFileName.c_str(), &db), SQLITE_OK, "Cannot open DB");
+
+    // The entries of each node beyond the newest ones are removed
+    sqlite3_prepare_v2(db,
+                       "SELECT nodeid, COUNT(*) FROM nodelocation GROUP BY nodeid;",
+                       -1,
+                       &stmt,
+                       nullptr);
+    while (sqlite3_step(stmt) == SQLITE_ROW)
+    {
+        NS_TEST_EXPECT_MSG_EQ((uint64_t)sqlite3_column_int64(stmt, 1),
+                              maxPositions,
+                              "Unexpected positions of node " << sqlite3_column_int64(stmt, 0));
+    }
+    sqlite3_finalize(stmt);
+
+    // The entries older than one second before the last pruning are removed,
+    // except the latest one of each node
+    sqlite3_prepare_v2(db,
+                       "SELECT nodeid, MIN(simulationtime), COUNT(*) FROM nodeapploss "
+                       "GROUP BY nodeid;",
+                       -1,
+                       &stmt,
+                       nullptr);
+    while (sqlite3_step(stmt) == SQLITE_ROW)
+    {
+        uint64_t id = sqlite3_column_int64(stmt, 0);
+        Time minTime = TimeStep(sqlite3_column_int64(stmt, 1));
+
+        NS_TEST_EXPECT_MSG_EQ((id == 1 ? minTime == Seconds(1) : minTime >= Seconds(4)),
+                              true,
+                              "Unexpected oldest loss of node " << id << ": " << minTime);
+        NS_TEST_EXPECT_MSG_EQ((id != 1 || sqlite3_column_int64(stmt, 2) == 1),
+                              true,
+                              "Unexpected losses of node 1");
+    }
+    sqlite3_finalize(stmt);
+
+    sqlite3_prepare_v2(db, "SELECT COUNT(*) FROM noderegistration;", -1, &stmt, nullptr);
+    NS_TEST_EXPECT_MSG_EQ(sqlite3_step(stmt), SQLITE_ROW, "Cannot count the registrations");
+    NS_TEST_EXPECT_MSG_EQ((uint64_t)sqlite3_column_int64(stmt, 0),
+                          nUes,
+                          "Unexpected registrations");
+    sqlite3_finalize(stmt);
+
+    sqlite3_close(db);
+
+    std::remove(dbFileName.c_str());
+}
+
+/**
+ * @ingroup oran
+ *
+ * Class that tests that the rows removed by the retention policies of the
+ * SQLite Data Repository are not returned by the reads made right after the
+ * pruning, when the reads use a separate connection in WAL mode and the
+ * pruning is part of a write batch.
+ */
+class OranTestCaseDataRepositorySqliteRetentionReads : public TestCase
+{
+  public:
+    /**
+     * Constructor of the test
+     */
+    OranTestCaseDataRepositorySqliteRetentionReads();
+    /**
+     * Destructor of the test
+     */
+    virtual ~OranTestCaseDataRepositorySqliteRetentionReads();
+
+  private:
+    /**
+     * Method that runs the test
+     */
+    virtual void DoRun();
+};
+
+OranTestCaseDataRepositorySqliteRetentionReads::OranTestCaseDataRepositorySqliteRetentionReads()
+    : TestCase("Oran Test Case Data Repository SQLite Retention Reads")
+{
+}
+
+OranTestCaseDataRepositorySqliteRetentionReads::~OranTestCaseDataRepositorySqliteRetentionReads()
+{
+}
+
+void
+OranTestCaseDataRepositorySqliteRetentionReads::DoRun()
+{
+    const uint64_t maxPositions = 2;
+    std::string dbFileName = CreateTempDirFilename("oran-retention-reads-repository.db");
+
+    std::remove(dbFileName.c_str());
+    std::remove((dbFileName + "-wal").c_str());
+    std::remove((dbFileName + "-shm").c_str());
+
+    Ptr<OranDataRepositorySqlite> repo = CreateObject<OranDataRepositorySqlite>();
+    repo->SetAttribute("DatabaseFile", StringValue(dbFileName));
+    repo->SetAttribute("WalMode", BooleanValue(true));
+    repo->SetAttribute("WriteBatching", BooleanValue(true));
+    repo->SetAttribute("PruneInterval", TimeValue(Seconds(1)));
+    repo->SetRetentionPolicy(OranDataRepository::NODE_LOCATION, Seconds(0), maxPositions);
+    repo->Activate();
+
+    repo->ImportNode(1, OranNearRtRic::NodeType::WIRED);
+    repo->ImportNodeRegistration(1, true, Seconds(0));
+    for (uint32_t step = 1; step <= 4; step++)
+    {
+        Time t = MilliSeconds(100 * step);
+        Simulator::Schedule(t, [repo, step, t]() {
+            repo->ImportPosition(1, Vector(step, 0, 0), t);
+        });
+    }
+
+    // The history is pruned at 1 s before this read, and no other write is
+    // made at that time
+    std::size_t positions = 0;
+    Simulator::Schedule(Seconds(1), [repo, &positions]() {
+        positions = repo->GetNodePositions(1, Seconds(0), Seconds(10), 1000).size();
+    });
+
+    Simulator::Stop(Seconds(1.5));
+    Simulator::Run();
+
+    NS_TEST_EXPECT_MSG_EQ(positions, maxPositions, "Pruned positions read");
+
+    repo->Deactivate();
+    repo->Dispose();
+    Simulator::Destroy();
+
+    std::remove(dbFileName.c_str());
+    std::remove((dbFileName + "-wal").c_str());
+    std::remove((dbFileName + "-shm").c_str());
+}
+
+/**
+ * @ingroup oran
+ *
+ * Class that tests that the compression of the location history of the
+ * SQLite Data Repository stores a fraction of the reported locations, and
+ * that the reported locations are rebuilt within twice the tolerance.
+ */
+class OranTestCaseDataRepositorySqlitePositionCompression : public TestCase
+{
+  public:
+    /**
+     * Constructor of the test
+     *
+     * @param schemaVersion The version of the database schema.
+     */
+    OranTestCaseDataRepositorySqlitePositionCompression(uint32_t schemaVersion);
+    /**
+     * Destructor of the test
+     */
+    virtual ~OranTestCaseDataRepositorySqlitePositionCompression();
+
+  private:
+    /**
+     * Method that runs the test
+     */
+    virtual void DoRun();
+
+    /**
+     * The version of the database schema.
+     */
+    uint32_t m_schemaVersion;
+};
+
+OranTestCaseDataRepositorySqlitePositionCompression::
+    OranTestCaseDataRepositorySqlitePositionCompression(uint32_t schemaVersion)
+    : TestCase("Oran Test Case Data Repository SQLite Position Compression (schema v" +
+               std::to_string(schemaVersion) + ")"),
+      m_schemaVersion(schemaVersion)
+{
+}
+
+OranTestCaseDataRepositorySqlitePositionCompression::
+    ~OranTestCaseDataRepositorySqlitePositionCompression()
+{
+}
+
+void
+OranTestCaseDataRepositorySqlitePositionCompression::DoRun()
+{
+    const uint64_t nNodes = 2;
+    const uint32_t nSteps = 10000;
+    const double tolerance = 0.5;
+    std::string dbFileName = CreateTempDirFilename("oran-position-compression-repository.db");
+    std::map<uint64_t, std::vector<std::pair<Time, Vector>>> reported;
+
+    std::remove(dbFileName.c_str());
+
+    Ptr<OranDataRepositorySqlite> repo = CreateObject<OranDataRepositorySqlite>();
+    repo->SetAttribute("DatabaseFile", StringValue(dbFileName));
+    repo->SetAttribute("SchemaVersion", UintegerValue(m_schemaVersion));
+    repo->SetAttribute("PositionTolerance", DoubleValue(tolerance));
+    repo->Activate();
+
+    for (uint64_t id = 1; id <= nNodes; id++)
+    {
+        repo->ImportNode(id, OranNearRtRic::NodeType::LTEUE);
+        repo->ImportNodeLteUe(id, id);
+        repo->ImportNodeRegistration(id, true, Seconds(0));
+    }
+
+    // A walk that changes direction every 5 seconds, reported every 10 ms
+    // with a small deterministic jitter
+    for (uint64_t id = 1; id <= nNodes; id++)
+    {
+        Vector pos(0, 0, 1.5);
+        for (uint32_t step = 1; step <= nSteps; step++)
+        {
+            double angle = 0.7 * id * (step / 500);
+            double jitter = 0.1 * std::sin(step * 12.9898 * id);
+            pos.x += 0.01 * 3 * std::cos(angle);
+            pos.y += 0.01 * 3 * std::sin(angle);
+
+            Time t = MilliSeconds(10 * step);
+            Vector sample(pos.x + jitter, pos.y - jitter, pos.z);
+            repo->ImportPosition(id, sample, t);
+            reported[id].emplace_back(t, sample);
+        }
+    }
+
+    for (uint64_t id = 1; id <= nNodes; id++)
+    {
+        double maxError = 0;
+        for (const auto& sample : reported[id])
+        {
+            std::map<Time, Vector> positions =
+                repo->GetNodePositions(id, sample.first, sample.first, 1);
+
+            NS_TEST_ASSERT_MSG_EQ(positions.size(), 1, "No location of node " << id);
+            NS_TEST_EXPECT_MSG_EQ(positions.begin()->first,
+                                  sample.first,
+                                  "Unexpected time of the location of node " << id);
+            maxError =
+                std::max(maxError, CalculateDistance(positions.begin()->second, sample.second));
+        }
+        NS_TEST_EXPECT_MSG_LT_OR_EQ(maxError,
+                                    2 * tolerance,
+                                    "Location of node " << id << " rebuilt with a large error");
+
+        // The latest location is exact
+        std::map<Time, Vector> latest = repo->GetNodePositions(id, Seconds(0), Seconds(1000), 1);
+        NS_TEST_ASSERT_MSG_EQ(latest.size(), 1, "No latest location of node " << id);
+        NS_TEST_EXPECT_MSG_EQ(latest.begin()->first,
+                              reported[id].back().first,
+                              "Unexpected time of the latest location of node " << id);
+        NS_TEST_EXPECT_MSG_EQ(CalculateDistance(latest.begin()->second, reported[id].back().second),
+                              0,
+                              "Unexpected latest location of node " << id);
+    }
+
+    repo->Deactivate();
+    repo->Dispose();
+
+    sqlite3* db;
+    sqlite3_stmt* stmt;
+
+    NS_TEST_EXPECT_MSG_EQ(sqlite3_open(dbFileName.c_str(), &db), SQLITE_OK, "Cannot open DB");
+    sqlite3_prepare_v2(db, "SELECT COUNT(*) FROM nodelocation;", -1, &stmt, nullptr);
+    NS_TEST_EXPECT_MSG_EQ(sqlite3_step(stmt), SQLITE_ROW, "Cannot count the locations");
+    NS_TEST_EXPECT_MSG_LT((uint64_t)sqlite3_column_int64(stmt, 0),
+                          nNodes * nSteps / 10,
+                          "The location history was not compressed");
+    sqlite3_finalize(stmt);
+    sqlite3_close(db);
+
+    std::remove(dbFileName.c_str());
+}
+
+namespace
+{
+
+/**
+ * An LM event with integer and real arguments.
+ */
+const OranDataRepository::LogEvent LOG_TEST_DISTANCE = OranDataRepository::RegisterLogEvent(
+    "ns3::OranTestLm",
+    "Distance from UE with RNTI %d in CellID %d to eNB with CellID %d is %f");
+/**
+ * An LM event with a quote in its format.
+ */
+const OranDataRepository::LogEvent LOG_TEST_HANDOVER =
+    OranDataRepository::RegisterLogEvent("ns3::OranTestLm",
+                                         "eNB (CellID %d) isn't the attached eNB (CellID %d)");
+/**
+ * An LM event that is first stored after reopening the database.
+ */
+const OranDataRepository::LogEvent LOG_TEST_MOVE =
+    OranDataRepository::RegisterLogEvent("ns3::OranTestLm", "Moving UE %d to Cell ID %d");
+/**
+ * A CMM event.
+ */
+const OranDataRepository::LogEvent LOG_TEST_IGNORING = OranDataRepository::RegisterLogEvent(
+    "ns3::OranTestCmm",
+    "The new command has lower precedence (old default? %d; new default? %d)");
+
+} // namespace
+
+/**
+ * @ingroup oran
+ *
+ * Class that tests that the structured LM and CMM events stored by the SQLite
+ * Data Repository are rendered by its views with the same text as the one
+ * formatted by the Data Repository, that the names of the modules and the
+ * formats of the events are stored once across reopenings of the database,
+ * and that the log views hold the free-form logs and the events with the
+ * same text that the modules used to log.
+ */
+class OranTestCaseDataRepositorySqliteEvents : public TestCase
+{
+  public:
+    /**
+     * Constructor of the test
+     */
+    OranTestCaseDataRepositorySqliteEvents();
+    /**
+     * Destructor of the test
+     */
+    virtual ~OranTestCaseDataRepositorySqliteEvents();
+
+  private:
+    /**
+     * Method that runs the test
+     */
+    virtual void DoRun();
+};
+
+OranTestCaseDataRepositorySqliteEvents::OranTestCaseDataRepositorySqliteEvents()
+    : TestCase("Oran Test Case Data Repository SQLite Events")
+{
+}
+
+OranTestCaseDataRepositorySqliteEvents::~OranTestCaseDataRepositorySqliteEvents()
+{
+}
+
+void
+OranTestCaseDataRepositorySqliteEvents::DoRun()
+{
+    std::string dbFileName = CreateTempDirFilename("oran-events-repository.db");
+    std::vector<std::tuple<std::string, OranDataRepository::LogEvent, std::array<double, 4>>>
+        lmEvents = {{"LmA", LOG_TEST_DISTANCE, {3, 1, 2, 12.5}},
+                    {"LmA", OranDataRepository::LOG_NO_ACTION, {0, 0, 0, 0}},
+                    {"LmB", LOG_TEST_HANDOVER, {2, 1, 0, 0}},
+                    {"LmA", LOG_TEST_MOVE, {3, 2, 0, 0}}};
+    // The free-form log of an LM, with the prefix that the LMs add
+    std::string lmAction = std::to_string(Seconds(0.5).GetSeconds()) + " -- LmA -- Free text";
+
+    std::remove(dbFileName.c_str());
+
+    // The second half of the events is stored after reopening the database
+    for (uint32_t run = 0; run < 2; run++)
+    {
+        Ptr<OranDataRepositorySqlite> repo = CreateObject<OranDataRepositorySqlite>();
+        repo->SetAttribute("DatabaseFile", StringValue(dbFileName));
+        repo->Activate();
+
+        for (uint32_t i = 2 * run; i < 2 * run + 2; i++)
+        {
+            const auto& args = std::get<2>(lmEvents[i]);
+            repo->ImportEventLm(std::get<0>(lmEvents[i]),
+                                Seconds(i),
+                                std::get<1>(lmEvents[i]),
+                                args[0],
+                                args[1],
+                                args[2],
+                                args[3]);
+        }
+        repo->ImportEventCmm("Cmm", Seconds(run), LOG_TEST_IGNORING, run, 1, 0, 0);
+        if (run == 0)
+        {
+            repo->ImportActionLm("LmA", Seconds(0.5), lmAction);
+        }
+
+        repo->Deactivate();
+        repo->Dispose();
+    }
+
+    sqlite3* db;
+    sqlite3_stmt* stmt;
+
+    NS_TEST_EXPECT_MSG_EQ(sqlite3_open(dbFileName.c_str(), &db), SQLITE_OK, "Cannot open DB");
+
+    sqlite3_prepare_v2(db, "SELECT COUNT(*) FROM logmodule;", -1, &stmt, nullptr);
+    NS_TEST_EXPECT_MSG_EQ(sqlite3_step(stmt), SQLITE_ROW, "Cannot count the modules");
+    NS_TEST_EXPECT_MSG_EQ(sqlite3_column_int(stmt, 0), 3, "Unexpected number of modules");
+    sqlite3_finalize(stmt);
+
+    sqlite3_prepare_v2(db, "SELECT COUNT(*) FROM logevent;", -1, &stmt, nullptr);
+    NS_TEST_EXPECT_MSG_EQ(sqlite3_step(stmt), SQLITE_ROW, "Cannot count the event formats");
+    NS_TEST_EXPECT_MSG_EQ(sqlite3_column_int(stmt, 0), 5, "Unexpected number of event formats");
+    sqlite3_finalize(stmt);
+
+    sqlite3_prepare_v2(db,
+                       "SELECT lmname, simulationtime, description FROM lmeventtext "
+                       "ORDER BY entryid;",
+                       -1,
+                       &stmt,
+                       nullptr);
+    for (uint32_t i = 0; i < lmEvents.size(); i++)
+    {
+        const auto& args = std::get<2>(lmEvents[i]);
+        NS_TEST_ASSERT_MSG_EQ(sqlite3_step(stmt), SQLITE_ROW, "Missing LM event " << i);
+        NS_TEST_EXPECT_MSG_EQ(std::string(reinterpret_cast<const char*>(
+                                  sqlite3_column_text(stmt, 0))),
+                              std::get<0>(lmEvents[i]),
+                              "Unexpected LM name of event " << i);
+        NS_TEST_EXPECT_MSG_EQ(sqlite3_column_int64(stmt, 1),
+                              Seconds(i).GetTimeStep(),
+                              "Unexpected time of LM event " << i);
+        NS_TEST_EXPECT_MSG_EQ(
+            std::string(reinterpret_cast<const char*>(sqlite3_column_text(stmt, 2))),
+            OranDataRepository::FormatLogEvent(std::get<1>(lmEvents[i]),
+                                               args[0],
+                                               args[1],
+                                               args[2],
+                                               args[3]),
+            "Unexpected text of LM event " << i);
+    }
+    NS_TEST_EXPECT_MSG_EQ(sqlite3_step(stmt), SQLITE_DONE, "Unexpected LM events");
+    sqlite3_finalize(stmt);
+
+    sqlite3_prepare_v2(db,
+                       "SELECT description FROM cmmeventtext ORDER BY entryid;",
+                       -1,
+                       &stmt,
+                       nullptr);
+    for (uint32_t run = 0; run < 2; run++)
+    {
+        NS_TEST_ASSERT_MSG_EQ(sqlite3_step(stmt), SQLITE_ROW, "Missing CMM event " << run);
+        NS_TEST_EXPECT_MSG_EQ(
+            std::string(reinterpret_cast<const char*>(sqlite3_column_text(stmt, 0))),
+            OranDataRepository::FormatLogEvent(LOG_TEST_IGNORING, run, 1, 0, 0),
+            "Unexpected text of CMM event " << run);
+    }
+    sqlite3_finalize(stmt);
+
+    // The free-form log is found between the events of the first and the second second
+    sqlite3_prepare_v2(db,
+                       "SELECT lmname, simulationtime, description FROM lmlog;",
+                       -1,
+                       &stmt,
+                       nullptr);
+    for (uint32_t i = 0; i <= lmEvents.size(); i++)
+    {
+        std::string name = "LmA";
+        Time t = Seconds(0.5);
+        std::string description = lmAction;
+        if (i != 1)
+        {
+            uint32_t event = (i == 0 ? 0 : i - 1);
+            const auto& args = std::get<2>(lmEvents[event]);
+            name = std::get<0>(lmEvents[event]);
+            t = Seconds(event);
+            description = std::to_string(t.GetSeconds()) + " -- " + name + " -- " +
+                          OranDataRepository::FormatLogEvent(std::get<1>(lmEvents[event]),
+                                                             args[0],
+                                                             args[1],
+                                                             args[2],
+                                                             args[3]);
+        }
+        NS_TEST_ASSERT_MSG_EQ(sqlite3_step(stmt), SQLITE_ROW, "Missing LM log " << i);
+        NS_TEST_EXPECT_MSG_EQ(std::string(reinterpret_cast<const char*>(
+                                  sqlite3_column_text(stmt, 0))),
+                              name,
+                              "Unexpected LM name of log " << i);
+        NS_TEST_EXPECT_MSG_EQ(sqlite3_column_int64(stmt, 1),
+                              t.GetTimeStep(),
+                              "Unexpected time of LM log " << i);
+        NS_TEST_EXPECT_MSG_EQ(
+            std::string(reinterpret_cast<const char*>(sqlite3_column_text(stmt, 2))),
+            description,
+            "Unexpected text of LM log " << i);
+    }
+    NS_TEST_EXPECT_MSG_EQ(sqlite3_step(stmt), SQLITE_DONE, "Unexpected LM logs");
+    sqlite3_finalize(stmt);
+
+    sqlite3_close(db);
+
+    std::remove(dbFileName.c_str());
+}
+
+/**
+ * @ingroup oran
+ *
+ * Class that tests that the SQLite Data Repository counts the executions of
+ * each type of prepared statement, with a latency histogram, and writes the
+ * summary of the statistics when the database is closed.
+ */
+class OranTestCaseDataRepositorySqliteQueryStats : public TestCase
+{
+  public:
+    /**
+     * Constructor of the test
+     *
+     * @param asyncWrites Flag to execute the writes in the writer thread.
+     */
+    OranTestCaseDataRepositorySqliteQueryStats(bool asyncWrites);
+    /**
+     * Destructor of the test
+     */
+    virtual ~OranTestCaseDataRepositorySqliteQueryStats();
+
+  private:
+    /**
+     * Method that runs the test
+     */
+    virtual void DoRun();
+    /**
+     * Flag to execute the writes in the writer thread.
+     */
+    bool m_asyncWrites;
+};
+
+OranTestCaseDataRepositorySqliteQueryStats::OranTestCaseDataRepositorySqliteQueryStats(
+    bool asyncWrites)
+    : TestCase("Oran Test Case Data Repository SQLite Query Stats (async writes " +
+               std::to_string(asyncWrites) + ")"),
+      m_asyncWrites(asyncWrites)
+{
+}
+
+OranTestCaseDataRepositorySqliteQueryStats::~OranTestCaseDataRepositorySqliteQueryStats()
+{
+}
+
+void
+OranTestCaseDataRepositorySqliteQueryStats::DoRun()
+{
+    std::string dbFileName = CreateTempDirFilename("oran-query-stats-repository.db");
+    std::string statsFileName = CreateTempDirFilename("oran-query-stats.csv");
+    uint32_t numPositions = 20;
+
+    std::remove(dbFileName.c_str());
+    std::remove(statsFileName.c_str());
+
+    Ptr<OranDataRepositorySqlite> repo = CreateObject<OranDataRepositorySqlite>();
+    repo->SetAttribute("DatabaseFile", StringValue(dbFileName));
+    repo->SetAttribute("AsyncWrites", BooleanValue(m_asyncWrites));
+    repo->SetAttribute("QueryStats", BooleanValue(true));
+    repo->SetAttribute("QueryStatsFile", StringValue(statsFileName));
+    repo->Activate();
+
+    uint64_t e2NodeId = repo->RegisterNode(OranNearRtRic::NodeType::WIRED, 1);
+    for (uint32_t i = 0; i < numPositions; i++)
+    {
+        repo->SavePosition(e2NodeId, Vector(i, 0, 0), Seconds(i));
+    }
+    repo->GetNodePositions(e2NodeId, Seconds(0), Seconds(numPositions), numPositions);
+
+    std::map<std::string, OranDataRepositorySqlite::QueryStats> stats = repo->GetQueryStats();
+    NS_TEST_ASSERT_MSG_EQ(stats.count("INSERT_NODE_LOCATION"), 1, "Missing location inserts");
+    NS_TEST_ASSERT_MSG_EQ(stats.count("GET_NODE_ALL_POSITIONS"), 1, "Missing location reads");
+    NS_TEST_EXPECT_MSG_EQ(stats["INSERT_NODE_LOCATION"].count,
+                          numPositions,
+                          "Unexpected number of location inserts");
+    NS_TEST_EXPECT_MSG_EQ(stats["GET_NODE_ALL_POSITIONS"].count,
+                          1,
+                          "Unexpected number of location reads");
+    NS_TEST_EXPECT_MSG_EQ(stats.count("GET_LTE_UE_RSRP_RSRQ"), 0, "Unexpected RSRP reads");
+
+    for (const auto& entry : stats)
+    {
+        uint64_t histogramCount = 0;
+        for (auto bucket : entry.second.histogram)
+        {
+            histogramCount += bucket;
+        }
+
+        NS_TEST_EXPECT_MSG_EQ(histogramCount,
+                              entry.second.count,
+                              "Unexpected histogram of " << entry.first);
+        NS_TEST_EXPECT_MSG_EQ((entry.second.minTime <= entry.second.maxTime),
+                              true,
+                              "Unexpected latency bounds of " << entry.first);
+        NS_TEST_EXPECT_MSG_EQ((entry.second.maxTime <= entry.second.totalTime),
+                              true,
+                              "Unexpected total latency of " << entry.first);
+    }
+
+    repo->Deactivate();
+    repo->Dispose();
+
+    std::ifstream statsFile(statsFileName);
+    std::string line;
+    bool foundInserts = false;
+
+    NS_TEST_ASSERT_MSG_EQ(statsFile.is_open(), true, "Missing the query statistics file");
+    NS_TEST_EXPECT_MSG_EQ(bool(std::getline(statsFile, line)), true, "Missing the header");
+    NS_TEST_EXPECT_MSG_EQ(line.rfind("statement,count,", 0), 0, "Unexpected header");
+    while (std::getline(statsFile, line))
+    {
+        if (line.rfind("INSERT_NODE_LOCATION,", 0) == 0)
+        {
+            foundInserts = true;
+            NS_TEST_EXPECT_MSG_EQ(line.rfind("INSERT_NODE_LOCATION," +
+                                                 std::to_string(numPositions) + ",",
+                                             0),
+                                  0,
+                                  "Unexpected summary of the location inserts");
+        }
+    }
+    NS_TEST_EXPECT_MSG_EQ(foundInserts, true, "Missing the summary of the location inserts");
+
+    // The statistics are not collected by default
+    repo = CreateObject<OranDataRepositorySqlite>();
+    repo->SetAttribute("DatabaseFile", StringValue(dbFileName));
+    repo->Activate();
+    repo->SavePosition(e2NodeId, Vector(0, 0, 0), Seconds(numPositions));
+    NS_TEST_EXPECT_MSG_EQ(repo->GetQueryStats().empty(), true, "Unexpected query statistics");
+    repo->Deactivate();
+    repo->Dispose();
+
+    std::remove(dbFileName.c_str());
+    std::remove(statsFileName.c_str());
+}
+
+/**
+ * @ingroup oran
+ *
+ * Class that tests that the methods of the Data Access API that visit the
+ * stored data, and the accessor of the latest position, return the same data
+ * as the methods that build a collection.
+ */
+class OranTestCaseDataRepositoryVisitors : public TestCase
+{
+  public:
+    /**
+     * Constructor of the test
+     *
+     * @param backend The type of Data Repository to test ("sqlite", "memory",
+     *                "binary-log", or "cache").
+     */
+    OranTestCaseDataRepositoryVisitors(std::string backend);
+    /**
+     * Destructor of the test
+     */
+    virtual ~OranTestCaseDataRepositoryVisitors();
+
+  private:
+    /**
+     * Method that runs the test
+     */
+    virtual void DoRun();
+
+    /**
+     * The type of Data Repository to test.
+     */
+    std::string m_backend;
+};
+
+OranTestCaseDataRepositoryVisitors::OranTestCaseDataRepositoryVisitors(std::string backend)
+    : TestCase("Oran Test Case Data Repository Visitors (" + backend + ")"),
+      m_backend(backend)
+{
+}
+
+OranTestCaseDataRepositoryVisitors::~OranTestCaseDataRepositoryVisitors()
+{
+}
+
+void
+OranTestCaseDataRepositoryVisitors::DoRun()
+{
+    std::string fileName = CreateTempDirFilename("oran-visitors-repository");
+
+    Ptr<OranDataRepository> repo;
+    if (m_backend == "memory")
+    {
+        repo = CreateObject<OranDataRepositoryMemory>();
+        repo->SetAttribute("MaxEntriesPerNode", UintegerValue(100));
+    }
+#ifndef _WIN32
+    else if (m_backend == "binary-log")
+    {
+        repo = CreateObject<OranDataRepositoryBinaryLog>();
+        repo->SetAttribute("LogFile", StringValue(fileName + ".bin"));
+    }
+#endif // _WIN32
+    else
+    {
+        std::remove((fileName + ".db").c_str());
+        repo = CreateObject<OranDataRepositorySqlite>();
+        repo->SetAttribute("DatabaseFile", StringValue(fileName + ".db"));
+        if (m_backend == "cache")
+        {
+            Ptr<OranDataRepository> backend = repo;
+            repo = CreateObject<OranDataRepositoryCache>();
+            repo->SetAttribute("Backend", PointerValue(backend));
+        }
+    }
+    repo->Activate();
+
+    // The positions of the second UE are received out of order
+    uint64_t enbId = repo->RegisterNodeLteEnb(0, 1);
+    std::vector<uint64_t> ueIds = {repo->RegisterNodeLteUe(0, 100),
+                                   repo->RegisterNodeLteUe(0, 101)};
+    std::vector<std::vector<uint32_t>> positionTimes = {{1, 2, 3, 4, 5}, {1, 4, 2, 5, 3}};
+
+    repo->SavePosition(enbId, Vector(0, 0, 30), Seconds(1));
+    for (uint32_t i = 0; i < ueIds.size(); i++)
+    {
+        for (auto t : positionTimes[i])
+        {
+            repo->SavePosition(ueIds[i], Vector(t, i, 1.5), Seconds(t));
+        }
+        for (uint16_t cellId = 1; cellId <= 3; cellId++)
+        {
+            repo->SaveLteUeRsrpRsrq(ueIds[i],
+                                    Seconds(5),
+                                    i + 1,
+                                    cellId,
+                                    -80 - cellId,
+                                    -9,
+                                    cellId == 1,
+                                    0);
+        }
+    }
+
+    std::vector<uint64_t> e2NodeIds = {enbId, ueIds[0], ueIds[1], ueIds[1] + 1};
+    std::vector<std::tuple<Time, Time, uint64_t>> intervals = {{Seconds(0), Seconds(100), 1},
+                                                               {Seconds(0), Seconds(100), 10},
+                                                               {Seconds(2), Seconds(4), 10},
+                                                               {Seconds(2), Seconds(4), 2},
+                                                               {Seconds(6), Seconds(100), 10}};
+    for (auto e2NodeId : e2NodeIds)
+    {
+        std::map<Time, Vector> positions =
+            repo->GetNodePositions(e2NodeId, Seconds(0), Seconds(100), 1);
+        bool found;
+        Time t;
+        Vector pos;
+        std::tie(found, t, pos) = repo->GetLatestNodePosition(e2NodeId);
+        NS_TEST_EXPECT_MSG_EQ(found,
+                              !positions.empty(),
+                              "Unexpected latest position of node " << e2NodeId);
+        if (found && !positions.empty())
+        {
+            NS_TEST_EXPECT_MSG_EQ(t,
+                                  positions.rbegin()->first,
+                                  "Unexpected time of the latest position of node " << e2NodeId);
+            NS_TEST_EXPECT_MSG_EQ((pos == positions.rbegin()->second),
+                                  true,
+                                  "Unexpected latest position of node " << e2NodeId);
+        }
+
+        for (const auto& interval : intervals)
+        {
+            Time fromTime = std::get<0>(interval);
+            Time toTime = std::get<1>(interval);
+            uint64_t maxEntries = std::get<2>(interval);
+            std::vector<std::pair<Time, Vector>> visited;
+            repo->ForEachNodePosition(e2NodeId,
+                                      fromTime,
+                                      toTime,
+                                      maxEntries,
+                                      [&visited](Time t, const Vector& pos) {
+                                          visited.emplace_back(t, pos);
+                                      });
+
+            std::map<Time, Vector> expected =
+                repo->GetNodePositions(e2NodeId, fromTime, toTime, maxEntries);
+            NS_TEST_EXPECT_MSG_EQ(visited.size(),
+                                  expected.size(),
+                                  "Unexpected number of positions of node "
+                                      << e2NodeId << " between " << fromTime << " and "
+                                      << toTime);
+            auto it = expected.rbegin();
+            for (std::size_t i = 0; i < visited.size() && it != expected.rend(); i++, it++)
+            {
+                NS_TEST_EXPECT_MSG_EQ((visited[i].first == it->first &&
+                                       visited[i].second == it->second),
+                                      true,
+                                      "Unexpected position " << i << " of node " << e2NodeId
+                                                             << " between " << fromTime
+                                                             << " and " << toTime);
+            }
+        }
+
+        std::vector<std::tuple<uint16_t, uint16_t, double, double, bool, uint8_t>> measurements;
+        repo->ForEachLteUeRsrpRsrq(e2NodeId,
+                                   [&measurements](uint16_t rnti,
+                                                   uint16_t cellId,
+                                                   double rsrp,
+                                                   double rsrq,
+                                                   bool isServingCell,
+                                                   uint8_t componentCarrierId) {
+                                       measurements.emplace_back(rnti,
+                                                                 cellId,
+                                                                 rsrp,
+                                                                 rsrq,
+                                                                 isServingCell,
+                                                                 componentCarrierId);
+                                   });
+        NS_TEST_EXPECT_MSG_EQ((measurements == repo->GetLteUeRsrpRsrq(e2NodeId)),
+                              true,
+                              "Unexpected RSRP and RSRQ of node " << e2NodeId);
+    }
+
+    repo->Deactivate();
+    repo->Dispose();
+
+    std::remove((fileName + ".db").c_str());
+    std::remove((fileName + ".bin.0").c_str());
+}
+
+/**
+ * @ingroup oran
+ *
+ * Test suite for the SQLite Data Repository
+ */
+class OranDataRepositorySqliteTestSuite : public TestSuite
+{
+  public:
+    /**
+     * Constructor for the test suite
+     */
+    OranDataRepositorySqliteTestSuite();
+};
+
+OranDataRepositorySqliteTestSuite::OranDataRepositorySqliteTestSuite()
+    : TestSuite("oran-data-repository-sqlite", Type::UNIT)
+{
+    for (uint32_t schemaVersion = 1; schemaVersion <= 2; schemaVersion++)
+    {
+        AddTestCase(new OranTestCaseDataRepositorySqliteQueryPlan(schemaVersion, 10000, false),
+                    Duration::QUICK);
+        AddTestCase(new OranTestCaseDataRepositorySqliteQueryPlan(schemaVersion, 100000, true),
+                    Duration::EXTENSIVE);
+        AddTestCase(new OranTestCaseDataRepositorySqliteQueryPlan(schemaVersion, 1000000, true),
+                    Duration::TAKES_FOREVER);
+        AddTestCase(new OranTestCaseDataRepositorySqliteWriteModes(schemaVersion, false, 1, false),
+                    Duration::QUICK);
+        AddTestCase(new OranTestCaseDataRepositorySqliteWriteModes(schemaVersion, true, 4, false),
+                    Duration::QUICK);
+        AddTestCase(
+            new OranTestCaseDataRepositorySqliteWriteModes(schemaVersion, true, 65536, false),
+            Duration::QUICK);
+        AddTestCase(new OranTestCaseDataRepositorySqliteWriteModes(schemaVersion, false, 1, true),
+                    Duration::QUICK);
+        AddTestCase(
+            new OranTestCaseDataRepositorySqliteWriteModes(schemaVersion, true, 65536, true),
+            Duration::QUICK);
+        AddTestCase(new OranTestCaseDataRepositorySqliteRetention(schemaVersion, false),
+                    Duration::QUICK);
+        AddTestCase(new OranTestCaseDataRepositorySqliteRetention(schemaVersion, true),
+                    Duration::QUICK);
+        AddTestCase(new OranTestCaseDataRepositorySqlitePositionCompression(schemaVersion),
+                    Duration::QUICK);
+    }
+    AddTestCase(new OranTestCaseDataRepositorySqliteWriteBatching(), Duration::QUICK);
+    AddTestCase(new OranTestCaseDataRepositorySqliteRetentionReads(), Duration::QUICK);
+    AddTestCase(new OranTestCaseDataRepositorySqliteEvents(), Duration::QUICK);
+    AddTestCase(new OranTestCaseDataRepositorySqliteQueryStats(false), Duration::QUICK);
+    AddTestCase(new OranTestCaseDataRepositorySqliteQueryStats(true), Duration::QUICK);
+    AddTestCase(new OranTestCaseDataRepositoryVisitors("sqlite"), Duration::QUICK);
+    AddTestCase(new OranTestCaseDataRepositoryVisitors("memory"), Duration::QUICK);
+    AddTestCase(new OranTestCaseDataRepositoryVisitors("cache"), Duration::QUICK);
+#ifndef _WIN32
+    AddTestCase(new OranTestCaseDataRepositoryVisitors("binary-log"), Duration::QUICK);
+#endif // _WIN32
+}
+
+static OranDataRepositorySqliteTestSuite soranDataRepositorySqliteTestSuite;
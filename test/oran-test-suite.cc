@@ -34,6 +34,15 @@
 #include "ns3/oran-module.h"
 #include "ns3/test.h"
 
+#include <algorithm>
+#include <atomic>
+#include <cstdio>
+#include <functional>
+#include <sqlite3.h>
+#include <string>
+#include <tuple>
+#include <vector>
+
 using namespace ns3;
 
 /**
@@ -177,6 +186,835 @@ OranTestCaseMobility1::DoRun()
     Simulator::Destroy();
 }
 
+/**
+ * @ingroup oran
+ *
+ * Class that tests that the thread pool used to run the Logic Modules in
+ * parallel executes every task of a batch, and every index of a parallel
+ * for, exactly once before returning, also when the batches are nested.
+ */
+class OranTestCaseThreadPool : public TestCase
+{
+  public:
+    /**
+     * Constructor of the test
+     */
+    OranTestCaseThreadPool();
+    /**
+     * Destructor of the test
+     */
+    virtual ~OranTestCaseThreadPool();
+
+  private:
+    /**
+     * Method that runs the test
+     */
+    virtual void DoRun();
+};
+
+OranTestCaseThreadPool::OranTestCaseThreadPool()
+    : TestCase("Oran Test Case Thread Pool")
+{
+}
+
+OranTestCaseThreadPool::~OranTestCaseThreadPool()
+{
+}
+
+void
+OranTestCaseThreadPool::DoRun()
+{
+    for (uint32_t numThreads : {0, 1, 3})
+    {
+        OranThreadPool pool(numThreads);
+        NS_TEST_ASSERT_MSG_EQ(pool.GetNThreads(), numThreads, "Unexpected number of threads");
+
+        for (uint32_t numTasks : {0, 1, 7, 100})
+        {
+            std::vector<std::atomic<uint32_t>> runs(numTasks);
+            std::vector<uint64_t> results(numTasks, 0);
+            std::vector<std::function<void()>> tasks;
+            for (uint32_t i = 0; i < numTasks; i++)
+            {
+                runs[i] = 0;
+                tasks.push_back([i, &runs, &results]() {
+                    runs[i]++;
+                    results[i] = static_cast<uint64_t>(i) * i;
+                });
+            }
+
+            pool.Run(tasks);
+
+            for (uint32_t i = 0; i < numTasks; i++)
+            {
+                NS_TEST_EXPECT_MSG_EQ(runs[i].load(),
+                                      1,
+                                      "Task " << i << " of " << numTasks << " with " << numThreads
+                                              << " threads not run once");
+                NS_TEST_EXPECT_MSG_EQ(results[i],
+                                      static_cast<uint64_t>(i) * i,
+                                      "Unexpected result of task " << i);
+            }
+        }
+
+        // Parallel for loops, run from the tasks of a batch
+        uint32_t numTasks = 4;
+        std::vector<std::vector<std::atomic<uint32_t>>> indexRuns(numTasks);
+        std::vector<std::function<void()>> tasks;
+        for (uint32_t task = 0; task < numTasks; task++)
+        {
+            std::size_t count = 10 + 31 * task;
+            indexRuns[task] = std::vector<std::atomic<uint32_t>>(count);
+            for (auto& runs : indexRuns[task])
+            {
+                runs = 0;
+            }
+
+            tasks.push_back([&pool, &indexRuns, task, count]() {
+                pool.ParallelFor(count, task + 1, [&indexRuns, task](std::size_t b, std::size_t e) {
+                    for (std::size_t i = b; i < e; i++)
+                    {
+                        indexRuns[task][i]++;
+                    }
+                });
+            });
+        }
+
+        pool.Run(tasks);
+
+        for (uint32_t task = 0; task < numTasks; task++)
+        {
+            for (std::size_t i = 0; i < indexRuns[task].size(); i++)
+            {
+                NS_TEST_EXPECT_MSG_EQ(indexRuns[task][i].load(),
+                                      1,
+                                      "Index " << i << " of loop " << task << " with "
+                                               << numThreads << " threads not run once");
+            }
+        }
+    }
+}
+
+/**
+ * @ingroup oran
+ *
+ * Class that tests that the pool used by the Reporters hands out Reports that
+ * are not in use, recycles the ones that are no longer referenced, and that
+ * the values set in the Reports with their setters are kept.
+ */
+class OranTestCaseReportPool : public TestCase
+{
+  public:
+    /**
+     * Constructor of the test
+     */
+    OranTestCaseReportPool();
+    /**
+     * Destructor of the test
+     */
+    virtual ~OranTestCaseReportPool();
+
+  private:
+    /**
+     * Method that runs the test
+     */
+    virtual void DoRun();
+};
+
+OranTestCaseReportPool::OranTestCaseReportPool()
+    : TestCase("Oran Test Case Report Pool")
+{
+}
+
+OranTestCaseReportPool::~OranTestCaseReportPool()
+{
+}
+
+void
+OranTestCaseReportPool::DoRun()
+{
+    OranReportPool<OranReportLteUeRsrpRsrq> pool(2);
+
+    Ptr<OranReportLteUeRsrpRsrq> first = pool.Get();
+    Ptr<OranReportLteUeRsrpRsrq> second = pool.Get();
+    NS_TEST_ASSERT_MSG_NE(first, second, "Report in use handed out twice");
+
+    first->SetReporterE2NodeId(3);
+    first->SetTime(Seconds(1.5));
+    first->SetRnti(4);
+    first->SetCellId(5);
+    first->SetRsrp(-90.5);
+    first->SetRsrq(-10.25);
+    first->SetIsServingCell(true);
+    first->SetComponentCarrierId(1);
+
+    NS_TEST_EXPECT_MSG_EQ(first->GetReporterE2NodeId(), 3, "Unexpected reporter E2 Node ID");
+    NS_TEST_EXPECT_MSG_EQ(first->GetTime(), Seconds(1.5), "Unexpected time");
+    NS_TEST_EXPECT_MSG_EQ(first->GetRnti(), 4, "Unexpected RNTI");
+    NS_TEST_EXPECT_MSG_EQ(first->GetCellId(), 5, "Unexpected cell ID");
+    NS_TEST_EXPECT_MSG_EQ(first->GetRsrp(), -90.5, "Unexpected RSRP");
+    NS_TEST_EXPECT_MSG_EQ(first->GetRsrq(), -10.25, "Unexpected RSRQ");
+    NS_TEST_EXPECT_MSG_EQ(first->GetIsServingCell(), true, "Unexpected serving cell flag");
+    NS_TEST_EXPECT_MSG_EQ(first->GetComponentCarrierId(), 1, "Unexpected component carrier ID");
+
+    // The first report is no longer referenced, so it is recycled
+    OranReportLteUeRsrpRsrq* released = PeekPointer(first);
+    first = nullptr;
+    Ptr<OranReportLteUeRsrpRsrq> recycled = pool.Get();
+    NS_TEST_EXPECT_MSG_EQ(PeekPointer(recycled), released, "Unused report not recycled");
+
+    // Both reports of the full pool are in use, so a new one is created
+    Ptr<OranReportLteUeRsrpRsrq> third = pool.Get();
+    NS_TEST_EXPECT_MSG_NE(third, second, "Report in use handed out twice");
+    NS_TEST_EXPECT_MSG_NE(third, recycled, "Report in use handed out twice");
+}
+
+/**
+ * @ingroup oran
+ *
+ * Class that tests that the Near-RT RIC deregisters the E2 Nodes whose last
+ * registration request is older than the inactivity threshold, in order of
+ * E2 Node ID, including the nodes registered directly in the Data
+ * Repository, and that the earlier requests of a node that registered again
+ * or was deregistered do not deregister it.
+ */
+class OranTestCaseE2NodeInactivity : public TestCase
+{
+  public:
+    /**
+     * Constructor of the test
+     */
+    OranTestCaseE2NodeInactivity();
+    /**
+     * Destructor of the test
+     */
+    virtual ~OranTestCaseE2NodeInactivity();
+
+  private:
+    /**
+     * Method that runs the test
+     */
+    virtual void DoRun();
+    /**
+     * Trace sink for the deregistrations of the Data Repository.
+     *
+     * @param e2NodeId The E2 Node ID of the deregistered node.
+     */
+    void NodeDeregistered(uint64_t e2NodeId);
+
+    /**
+     * The deregistered E2 Node IDs, with the time of the deregistration.
+     */
+    std::vector<std::pair<uint64_t, Time>> m_deregistrations;
+};
+
+OranTestCaseE2NodeInactivity::OranTestCaseE2NodeInactivity()
+    : TestCase("Oran Test Case E2 Node Inactivity")
+{
+}
+
+OranTestCaseE2NodeInactivity::~OranTestCaseE2NodeInactivity()
+{
+}
+
+void
+OranTestCaseE2NodeInactivity::NodeDeregistered(uint64_t e2NodeId)
+{
+    m_deregistrations.emplace_back(e2NodeId, Simulator::Now());
+}
+
+void
+OranTestCaseE2NodeInactivity::DoRun()
+{
+    Ptr<OranHelper> oranHelper = CreateObject<OranHelper>();
+    oranHelper->SetAttribute("LmQueryInterval", TimeValue(Seconds(100)));
+    oranHelper->SetAttribute("E2NodeInactivityThreshold", TimeValue(Seconds(2)));
+    oranHelper->SetAttribute("E2NodeInactivityIntervalRv",
+                             StringValue("ns3::ConstantRandomVariable[Constant=1]"));
+    // The nodes have no E2 Node Terminator, so the deregistration responses
+    // must not be delivered before the end of the test
+    oranHelper->SetAttribute("RicTransmissionDelayRv",
+                             StringValue("ns3::ConstantRandomVariable[Constant=100]"));
+    oranHelper->SetDataRepository("ns3::OranDataRepositoryMemory");
+    oranHelper->SetDefaultLogicModule("ns3::OranLmNoop");
+    oranHelper->SetConflictMitigationModule("ns3::OranCmmNoop");
+
+    Ptr<OranNearRtRic> nearRtRic = oranHelper->CreateNearRtRic();
+    Ptr<OranDataRepository> data = nearRtRic->Data();
+    data->TraceConnectWithoutContext(
+        "NodeDeregistered",
+        MakeCallback(&OranTestCaseE2NodeInactivity::NodeDeregistered, this));
+
+    // The inactivity is checked every second, starting at 1 s
+    Simulator::Schedule(Seconds(0), &OranHelper::ActivateAndStartNearRtRic, oranHelper, nearRtRic);
+
+    // Nodes 1 to 3 register at 0.5 s, and node 2 registers again at 1.5 s
+    Simulator::Schedule(Seconds(0.5), [data]() {
+        for (uint32_t i = 0; i < 3; i++)
+        {
+            data->RegisterNode(OranNearRtRic::NodeType::WIRED, 0);
+        }
+    });
+    Simulator::Schedule(Seconds(1.5), [data]() {
+        data->RegisterNode(OranNearRtRic::NodeType::WIRED, 2);
+    });
+
+    // Node 4 registers at 1.2 s, is deregistered at 1.8 s, and registers
+    // again at 2.6 s, which is within the threshold at the end of the test
+    Simulator::Schedule(Seconds(1.2), [data]() {
+        data->RegisterNode(OranNearRtRic::NodeType::WIRED, 0);
+    });
+    Simulator::Schedule(Seconds(1.8), [data]() { data->DeregisterNode(4); });
+    Simulator::Schedule(Seconds(2.6), [data]() {
+        data->RegisterNode(OranNearRtRic::NodeType::WIRED, 4);
+    });
+
+    Simulator::Stop(Seconds(4.5));
+    Simulator::Run();
+
+    std::vector<std::pair<uint64_t, Time>> expected = {{4, Seconds(1.8)},
+                                                       {1, Seconds(3)},
+                                                       {3, Seconds(3)},
+                                                       {2, Seconds(4)}};
+    NS_TEST_EXPECT_MSG_EQ(m_deregistrations.size(),
+                          expected.size(),
+                          "Unexpected number of deregistrations");
+    for (uint32_t i = 0; i < m_deregistrations.size() && i < expected.size(); i++)
+    {
+        NS_TEST_EXPECT_MSG_EQ(m_deregistrations[i].first,
+                              expected[i].first,
+                              "Unexpected E2 Node deregistered in position " << i);
+        NS_TEST_EXPECT_MSG_EQ(m_deregistrations[i].second,
+                              expected[i].second,
+                              "Unexpected time of deregistration " << i);
+    }
+    NS_TEST_EXPECT_MSG_EQ(data->IsNodeRegistered(4), true, "Registered E2 Node deregistered");
+
+    Simulator::Destroy();
+}
+
+/**
+ * @ingroup oran
+ *
+ * Logic Module that records, every time it runs, the E2 Nodes that changed
+ * since the previous LM query cycle and if the run is incremental.
+ */
+class OranTestLmChangeTracking : public OranLm
+{
+  public:
+    /**
+     * Get the TypeId of the OranTestLmChangeTracking class.
+     *
+     * @return The TypeId
+     */
+    static TypeId GetTypeId();
+    /**
+     * Constructor of the OranTestLmChangeTracking class.
+     */
+    OranTestLmChangeTracking();
+    /**
+     * Destructor of the OranTestLmChangeTracking class.
+     */
+    ~OranTestLmChangeTracking() override;
+    /**
+     * Record the changed E2 Nodes and if the run is incremental.
+     *
+     * @return An empty vector of commands.
+     */
+    std::vector<Ptr<OranCommand>> Run() override;
+    /**
+     * Get the time, the sorted IDs of the changed E2 Nodes, and the
+     * incremental flag of each run.
+     *
+     * @return The recorded runs.
+     */
+    const std::vector<std::tuple<Time, std::vector<uint64_t>, bool>>& GetRuns() const;
+
+  private:
+    /**
+     * The time, the sorted IDs of the changed E2 Nodes, and the incremental
+     * flag of each run.
+     */
+    std::vector<std::tuple<Time, std::vector<uint64_t>, bool>> m_runs;
+};
+
+TypeId
+OranTestLmChangeTracking::GetTypeId()
+{
+    static TypeId tid = TypeId("ns3::OranTestLmChangeTracking").SetParent<OranLm>();
+
+    return tid;
+}
+
+OranTestLmChangeTracking::OranTestLmChangeTracking()
+    : OranLm()
+{
+    m_name = "OranTestLmChangeTracking";
+}
+
+OranTestLmChangeTracking::~OranTestLmChangeTracking()
+{
+}
+
+std::vector<Ptr<OranCommand>>
+OranTestLmChangeTracking::Run()
+{
+    std::vector<uint64_t> changed(GetChangedE2NodeIds().begin(), GetChangedE2NodeIds().end());
+    std::sort(changed.begin(), changed.end());
+    m_runs.emplace_back(Simulator::Now(), changed, IsIncrementalRun());
+
+    return {};
+}
+
+const std::vector<std::tuple<Time, std::vector<uint64_t>, bool>>&
+OranTestLmChangeTracking::GetRuns() const
+{
+    return m_runs;
+}
+
+/**
+ * @ingroup oran
+ *
+ * Class that tests that the Logic Modules get the E2 Nodes that sent a
+ * report, registered for the first time, or were deregistered since the
+ * previous LM query cycle, and that their runs are only incremental if they
+ * also ran in the previous cycle and the Near-RT RIC was not stopped since.
+ */
+class OranTestCaseLmChangeTracking : public TestCase
+{
+  public:
+    /**
+     * Constructor of the test
+     */
+    OranTestCaseLmChangeTracking();
+    /**
+     * Destructor of the test
+     */
+    virtual ~OranTestCaseLmChangeTracking();
+
+  private:
+    /**
+     * Method that runs the test
+     */
+    virtual void DoRun();
+};
+
+OranTestCaseLmChangeTracking::OranTestCaseLmChangeTracking()
+    : TestCase("Oran Test Case LM Change Tracking")
+{
+}
+
+OranTestCaseLmChangeTracking::~OranTestCaseLmChangeTracking()
+{
+}
+
+void
+OranTestCaseLmChangeTracking::DoRun()
+{
+    Ptr<OranHelper> oranHelper = CreateObject<OranHelper>();
+    oranHelper->SetAttribute("LmQueryInterval", TimeValue(Seconds(1)));
+    oranHelper->SetAttribute("E2NodeInactivityThreshold", TimeValue(Seconds(100)));
+    // The nodes have no E2 Node Terminator, so the responses must not be
+    // delivered before the end of the test
+    oranHelper->SetAttribute("RicTransmissionDelayRv",
+                             StringValue("ns3::ConstantRandomVariable[Constant=100]"));
+    oranHelper->SetDataRepository("ns3::OranDataRepositoryMemory");
+    oranHelper->SetDefaultLogicModule("ns3::OranLmNoop");
+    oranHelper->SetConflictMitigationModule("ns3::OranCmmNoop");
+
+    Ptr<OranNearRtRic> nearRtRic = oranHelper->CreateNearRtRic();
+    Ptr<OranDataRepository> data = nearRtRic->Data();
+    Ptr<OranNearRtRicE2Terminator> e2Terminator = nearRtRic->GetE2Terminator();
+
+    Ptr<OranTestLmChangeTracking> lm = CreateObject<OranTestLmChangeTracking>();
+    lm->SetAttribute("NearRtRic", PointerValue(nearRtRic));
+    nearRtRic->AddLogicModule(lm);
+
+    // The reports are received as if they were sent by the E2 Node Terminators
+    auto receive = [e2Terminator](uint64_t e2NodeId) {
+        Ptr<OranReportLocation> location = CreateObject<OranReportLocation>();
+        location->SetAttribute("ReporterE2NodeId", UintegerValue(e2NodeId));
+        location->SetAttribute("Time", TimeValue(Simulator::Now()));
+        location->SetAttribute("Location", VectorValue(Vector(0, 0, 0)));
+        e2Terminator->ReceiveReport(location);
+    };
+
+    // The LMs are queried every second, starting at 1 s
+    Simulator::Schedule(Seconds(0), &OranHelper::ActivateAndStartNearRtRic, oranHelper, nearRtRic);
+
+    // Nodes 1 to 3 register at 0.5 s, and node 2 reports at 1.5 s
+    Simulator::Schedule(Seconds(0.5), [data]() {
+        for (uint32_t i = 0; i < 3; i++)
+        {
+            data->RegisterNode(OranNearRtRic::NodeType::WIRED, 0);
+        }
+    });
+    Simulator::Schedule(Seconds(1.5), [receive]() { receive(2); });
+
+    // Node 3 is deregistered at 3.5 s, when node 1 registers again, which is
+    // not a change
+    Simulator::Schedule(Seconds(3.5), [data]() {
+        data->DeregisterNode(3);
+        data->RegisterNode(OranNearRtRic::NodeType::WIRED, 1);
+    });
+
+    // The Near-RT RIC is stopped at 4.5 s and started again at 4.6 s, so the
+    // next cycle is at 5.6 s, and node 1 reports in between
+    Simulator::Schedule(Seconds(4.5), &OranNearRtRic::Stop, nearRtRic);
+    Simulator::Schedule(Seconds(4.6), &OranNearRtRic::Start, nearRtRic);
+    Simulator::Schedule(Seconds(5), [receive]() { receive(1); });
+
+    Simulator::Stop(Seconds(7));
+    Simulator::Run();
+
+    std::vector<std::tuple<Time, std::vector<uint64_t>, bool>> expected = {
+        {Seconds(1), {1, 2, 3}, false},
+        {Seconds(2), {2}, true},
+        {Seconds(3), {}, true},
+        {Seconds(4), {3}, true},
+        {Seconds(5.6), {1}, false},
+        {Seconds(6.6), {}, true}};
+    const auto& runs = lm->GetRuns();
+    NS_TEST_EXPECT_MSG_EQ(runs.size(), expected.size(), "Unexpected number of LM runs");
+    for (uint32_t i = 0; i < runs.size() && i < expected.size(); i++)
+    {
+        NS_TEST_EXPECT_MSG_EQ(std::get<0>(runs[i]),
+                              std::get<0>(expected[i]),
+                              "Unexpected time of LM run " << i);
+        NS_TEST_EXPECT_MSG_EQ((std::get<1>(runs[i]) == std::get<1>(expected[i])),
+                              true,
+                              "Unexpected changed E2 Nodes in LM run " << i);
+        NS_TEST_EXPECT_MSG_EQ(std::get<2>(runs[i]),
+                              std::get<2>(expected[i]),
+                              "Unexpected incremental flag in LM run " << i);
+    }
+
+    Simulator::Destroy();
+}
+
+/**
+ * @ingroup oran
+ *
+ * Base class of the tests that run a scenario with LTE UEs and eNBs, and
+ * compare the commands and logs that the Logic Modules of the Near-RT RIC
+ * store in the Data Repository.
+ */
+class OranTestCaseLmScenario : public TestCase
+{
+  protected:
+    /**
+     * Constructor of the test
+     *
+     * @param name The name of the test.
+     */
+    OranTestCaseLmScenario(std::string name);
+    /**
+     * Destructor of the test
+     */
+    virtual ~OranTestCaseLmScenario();
+    /**
+     * Run the scenario of the test and get the commands and logs of the Logic
+     * Modules stored in the Data Repository.
+     *
+     * @param lmThreads The number of worker threads of the Near-RT RIC.
+     * @param verbose Flag to indicate if the Logic Modules are verbose.
+     * @param incremental Flag to indicate if the distance based Logic Module
+     *                    only evaluates again the UEs that changed.
+     * @param toggleVerbose Flag to indicate if the distance based Logic Module
+     *                      stops being verbose for one LM query cycle.
+     *
+     * @return The stored commands, actions, and events, in the order they were stored.
+     */
+    std::vector<std::string> RunScenario(uint32_t lmThreads,
+                                         bool verbose,
+                                         bool incremental,
+                                         bool toggleVerbose);
+    /**
+     * Check that the commands and logs of two runs of the scenario are the same.
+     *
+     * @param rows The commands and logs of the run under test.
+     * @param expectedRows The commands and logs of the reference run.
+     * @param description The description of the run under test.
+     */
+    void CheckRows(const std::vector<std::string>& rows,
+                   const std::vector<std::string>& expectedRows,
+                   const std::string& description);
+};
+
+OranTestCaseLmScenario::OranTestCaseLmScenario(std::string name)
+    : TestCase(name)
+{
+}
+
+OranTestCaseLmScenario::~OranTestCaseLmScenario()
+{
+}
+
+std::vector<std::string>
+OranTestCaseLmScenario::RunScenario(uint32_t lmThreads,
+                                    bool verbose,
+                                    bool incremental,
+                                    bool toggleVerbose)
+{
+    std::string dbFileName =
+        CreateTempDirFilename("oran-lm-scenario-" + std::to_string(lmThreads) +
+                              (verbose ? "-verbose" : "") + (incremental ? "-incremental" : "") +
+                              (toggleVerbose ? "-toggle" : "") + ".db");
+
+    std::remove(dbFileName.c_str());
+
+    Ptr<OranHelper> oranHelper = CreateObject<OranHelper>();
+    oranHelper->SetAttribute("Verbose", BooleanValue(verbose));
+    oranHelper->SetAttribute("LmQueryInterval", TimeValue(Seconds(1)));
+    oranHelper->SetAttribute("LmThreads", UintegerValue(lmThreads));
+    oranHelper->SetAttribute("E2NodeInactivityThreshold", TimeValue(Seconds(100)));
+    // The nodes have no E2 Node Terminator, so the commands must not be
+    // delivered before the end of the test
+    oranHelper->SetAttribute("RicTransmissionDelayRv",
+                             StringValue("ns3::ConstantRandomVariable[Constant=100]"));
+    oranHelper->SetDataRepository("ns3::OranDataRepositorySqlite",
+                                  "DatabaseFile",
+                                  StringValue(dbFileName));
+    oranHelper->SetDefaultLogicModule("ns3::OranLmLte2LteDistanceHandover",
+                                      "Incremental",
+                                      BooleanValue(incremental));
+    oranHelper->AddLogicModule("ns3::OranLmLte2LteRsrpHandover");
+    oranHelper->SetConflictMitigationModule("ns3::OranCmmNoop");
+
+    Ptr<OranNearRtRic> nearRtRic = oranHelper->CreateNearRtRic();
+    Ptr<OranDataRepository> data = nearRtRic->Data();
+    Ptr<OranNearRtRicE2Terminator> e2Terminator = nearRtRic->GetE2Terminator();
+
+    // The reports are received as if they were sent by the E2 Node Terminators
+    auto receive = [e2Terminator](Ptr<OranReport> report, uint64_t e2NodeId) {
+        report->SetAttribute("ReporterE2NodeId", UintegerValue(e2NodeId));
+        report->SetAttribute("Time", TimeValue(Simulator::Now()));
+        e2Terminator->ReceiveReport(report);
+    };
+
+    Simulator::Schedule(Seconds(0), &OranHelper::ActivateAndStartNearRtRic, oranHelper, nearRtRic);
+
+    // Two eNBs, 100 m apart
+    Simulator::Schedule(Seconds(0.5), [data, receive]() {
+        for (uint16_t cellId = 1; cellId <= 2; cellId++)
+        {
+            Ptr<OranReportLocation> location = CreateObject<OranReportLocation>();
+            location->SetAttribute("Location", VectorValue(Vector(100 * (cellId - 1), 0, 0)));
+            receive(location, data->RegisterNodeLteEnb(cellId, cellId));
+        }
+    });
+
+    // All the UEs report at 0.5 s, and then a third of them every second, so
+    // that the distance based LM also reuses the evaluation of some UEs
+    const uint32_t numUes = 30;
+    for (uint32_t step = 0; step < 4; step++)
+    {
+        Simulator::Schedule(Seconds(0.5 + step), [data, receive, step, numUes]() {
+            for (uint32_t i = 0; i < numUes; i++)
+            {
+                if (step > 0 && i % 3 != step % 3)
+                {
+                    continue;
+                }
+
+                uint64_t e2NodeId = data->RegisterNodeLteUe(10 + i, 100 + i);
+                double x = (i * 17 + step * 23) % 100;
+                uint16_t servingCellId = (i + step) % 2 + 1;
+
+                Ptr<OranReportLocation> location = CreateObject<OranReportLocation>();
+                location->SetAttribute("Location", VectorValue(Vector(x, 10, 0)));
+                receive(location, e2NodeId);
+
+                Ptr<OranReportLteUeCellInfo> cellInfo = CreateObject<OranReportLteUeCellInfo>();
+                cellInfo->SetAttribute("CellId", UintegerValue(servingCellId));
+                cellInfo->SetAttribute("Rnti", UintegerValue(i + 1));
+                receive(cellInfo, e2NodeId);
+
+                for (uint16_t cellId = 1; cellId <= 2; cellId++)
+                {
+                    double rsrp = cellId == 1 ? -70 - x / 4 : -65 - (100 - x) / 4;
+                    Ptr<OranReportLteUeRsrpRsrq> rsrpRsrq =
+                        CreateObject<OranReportLteUeRsrpRsrq>();
+                    rsrpRsrq->SetAttribute("Rnti", UintegerValue(i + 1));
+                    rsrpRsrq->SetAttribute("CellId", UintegerValue(cellId));
+                    rsrpRsrq->SetAttribute("Rsrp", DoubleValue(rsrp));
+                    rsrpRsrq->SetAttribute("Rsrq", DoubleValue(-10));
+                    rsrpRsrq->SetAttribute("IsServingCell",
+                                           BooleanValue(cellId == servingCellId));
+                    receive(rsrpRsrq, e2NodeId);
+                }
+            }
+        });
+    }
+
+    // The distance based LM is not verbose in the cycle at 3 s, so the UEs
+    // evaluated in the cycle at 2 s must be evaluated again at 3 s and 4 s
+    if (toggleVerbose)
+    {
+        Ptr<OranLm> lm = nearRtRic->GetDefaultLogicModule();
+        Simulator::Schedule(Seconds(2.2),
+                            [lm]() { lm->SetAttribute("Verbose", BooleanValue(false)); });
+        Simulator::Schedule(Seconds(3.2),
+                            [lm]() { lm->SetAttribute("Verbose", BooleanValue(true)); });
+    }
+
+    Simulator::Stop(Seconds(4.8));
+    Simulator::Run();
+    Simulator::Destroy();
+
+    std::vector<std::string> rows;
+
+    sqlite3* db;
+    NS_TEST_EXPECT_MSG_EQ(sqlite3_open(dbFileName.c_str(), &db), SQLITE_OK, "Cannot open DB");
+    for (const auto& table : {"lmcommand", "lmaction", "lmeventtext"})
+    {
+        std::string column = table == std::string("lmcommand") ? "cmdname" : "description";
+        std::string query = "SELECT lmname, simulationtime, " + column + " FROM " + table +
+                            " ORDER BY entryid;";
+        sqlite3_stmt* stmt;
+        sqlite3_prepare_v2(db, query.c_str(), -1, &stmt, nullptr);
+        while (sqlite3_step(stmt) == SQLITE_ROW)
+        {
+            rows.push_back(std::string(table) + ": " +
+                           reinterpret_cast<const char*>(sqlite3_column_text(stmt, 0)) + " " +
+                           std::to_string(sqlite3_column_int64(stmt, 1)) + " " +
+                           reinterpret_cast<const char*>(sqlite3_column_text(stmt, 2)));
+        }
+        sqlite3_finalize(stmt);
+    }
+    sqlite3_close(db);
+
+    return rows;
+}
+
+void
+OranTestCaseLmScenario::CheckRows(const std::vector<std::string>& rows,
+                                  const std::vector<std::string>& expectedRows,
+                                  const std::string& description)
+{
+    NS_TEST_EXPECT_MSG_EQ(rows.size(),
+                          expectedRows.size(),
+                          "Unexpected number of commands and logs " << description);
+    for (std::size_t i = 0; i < rows.size() && i < expectedRows.size(); i++)
+    {
+        NS_TEST_EXPECT_MSG_EQ(rows[i],
+                              expectedRows[i],
+                              "Unexpected command or log in position " << i << " " << description);
+    }
+}
+
+/**
+ * @ingroup oran
+ *
+ * Class that tests that the Logic Modules of the Near-RT RIC generate the same
+ * commands, and store the same logs in the Data Repository, whether they are
+ * run one after another or in parallel on worker threads, also when they are
+ * not verbose and evaluate the UEs in a different way when run serially.
+ */
+class OranTestCaseLmThreads : public OranTestCaseLmScenario
+{
+  public:
+    /**
+     * Constructor of the test
+     */
+    OranTestCaseLmThreads();
+    /**
+     * Destructor of the test
+     */
+    virtual ~OranTestCaseLmThreads();
+
+  private:
+    /**
+     * Method that runs the test
+     */
+    virtual void DoRun();
+};
+
+OranTestCaseLmThreads::OranTestCaseLmThreads()
+    : OranTestCaseLmScenario("Oran Test Case LM Threads")
+{
+}
+
+OranTestCaseLmThreads::~OranTestCaseLmThreads()
+{
+}
+
+void
+OranTestCaseLmThreads::DoRun()
+{
+    for (bool verbose : {true, false})
+    {
+        std::vector<std::string> serialRows = RunScenario(0, verbose, true, false);
+        std::vector<std::string> parallelRows = RunScenario(2, verbose, true, false);
+
+        auto countRows = [&serialRows](const std::string& table) {
+            return std::count_if(serialRows.begin(),
+                                 serialRows.end(),
+                                 [&table](const std::string& row) { return row.find(table) == 0; });
+        };
+        NS_TEST_ASSERT_MSG_GT(countRows("lmcommand: "), 0, "No commands were generated");
+        NS_TEST_ASSERT_MSG_EQ((countRows("lmeventtext: ") > 0),
+                              verbose,
+                              "Unexpected events logged with verbose " << verbose);
+
+        CheckRows(parallelRows,
+                  serialRows,
+                  "in parallel with verbose " + std::to_string(verbose));
+    }
+}
+
+/**
+ * @ingroup oran
+ *
+ * Class that tests that the distance based Logic Module generates the same
+ * commands, and stores the same logs in the Data Repository, whether it only
+ * evaluates again the UEs that changed since the previous LM query cycle or
+ * all of them, also when it stops being verbose for one cycle.
+ */
+class OranTestCaseLmIncremental : public OranTestCaseLmScenario
+{
+  public:
+    /**
+     * Constructor of the test
+     */
+    OranTestCaseLmIncremental();
+    /**
+     * Destructor of the test
+     */
+    virtual ~OranTestCaseLmIncremental();
+
+  private:
+    /**
+     * Method that runs the test
+     */
+    virtual void DoRun();
+};
+
+OranTestCaseLmIncremental::OranTestCaseLmIncremental()
+    : OranTestCaseLmScenario("Oran Test Case LM Incremental")
+{
+}
+
+OranTestCaseLmIncremental::~OranTestCaseLmIncremental()
+{
+}
+
+void
+OranTestCaseLmIncremental::DoRun()
+{
+    for (bool toggleVerbose : {false, true})
+    {
+        std::vector<std::string> fullRows = RunScenario(0, true, false, toggleVerbose);
+        std::vector<std::string> incrementalRows = RunScenario(0, true, true, toggleVerbose);
+
+        NS_TEST_ASSERT_MSG_EQ(fullRows.empty(), false, "No commands or logs were stored");
+
+        CheckRows(incrementalRows,
+                  fullRows,
+                  "when incremental with toggled verbose " + std::to_string(toggleVerbose));
+    }
+}
+
 /**
  * @ingroup oran
  *
@@ -195,6 +1033,12 @@ OranTestSuite::OranTestSuite()
     : TestSuite("oran", Type::UNIT)
 {
     AddTestCase(new OranTestCaseMobility1, Duration::QUICK);
+    AddTestCase(new OranTestCaseThreadPool, Duration::QUICK);
+    AddTestCase(new OranTestCaseReportPool, Duration::QUICK);
+    AddTestCase(new OranTestCaseE2NodeInactivity, Duration::QUICK);
+    AddTestCase(new OranTestCaseLmChangeTracking, Duration::QUICK);
+    AddTestCase(new OranTestCaseLmThreads, Duration::QUICK);
+    AddTestCase(new OranTestCaseLmIncremental, Duration::QUICK);
 }
 
 static OranTestSuite soranTestSuite;